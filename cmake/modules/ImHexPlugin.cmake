@@ -157,6 +157,12 @@ macro(add_imhex_plugin)
             add_dependencies(plugins_test ${IMHEX_PLUGIN_NAME})
             add_dependencies(unit_tests ${IMHEX_PLUGIN_NAME})
         endif()
+
+        if (EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/CMakeLists.txt AND IMHEX_ENABLE_BENCHMARKS AND NOT IMHEX_STATIC_LINK_PLUGINS)
+            add_subdirectory(${CMAKE_CURRENT_SOURCE_DIR}/benchmarks)
+            target_link_libraries(${IMHEX_PLUGIN_NAME} PUBLIC ${IMHEX_PLUGIN_NAME}_benchmarks)
+            add_dependencies(benchmarks ${IMHEX_PLUGIN_NAME})
+        endif()
     endif()
 endmacro()
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+EXPORT_MODULE namespace hex {
+
+    #if !defined(HEX_MODULE_EXPORT)
+        namespace prv { class Provider; }
+    #endif
+
+    /* Batch Analysis Registry. Allows adding new analyses to the headless --analyze command */
+    namespace ContentRegistry::BatchAnalysis {
+
+        namespace impl {
+
+            /**
+             * @brief Function running an analysis over the entire data of a provider
+             * @note Analyses of different files run concurrently on multiple threads, so the function has to be thread-safe.
+             * It should read the data in chunks instead of loading it into memory all at once
+             */
+            using Callback = std::function<nlohmann::json(prv::Provider *provider, const std::string &argument)>;
+
+            struct Analysis {
+                std::string name;
+                std::string description;
+                Callback callback;
+                u32 maxConcurrentRuns;
+            };
+
+            const std::vector<Analysis>& getAnalyses();
+
+        }
+
+        /**
+         * @brief Adds a new analysis that can be selected using --analyze --analysis=<name>[:<argument>]
+         * @param name Name of the analysis, used as the key of its result in the output
+         * @param description Short description shown in the help text of the command
+         * @param callback Function running the analysis and returning its result
+         * @param maxConcurrentRuns Maximum number of files the analysis may run on at the same time or 0 if there's no limit
+         */
+        void addAnalysis(const std::string &name, const std::string &description, impl::Callback callback, u32 maxConcurrentRuns = 0);
+
+    }
+
+}
@@ -156,7 +156,7 @@ EXPORT_MODULE namespace hex {
                 void load(const nlohmann::json &data) override;
                 nlohmann::json store() override;
 
-                [[nodiscard]] i32 getValue() const { return m_value; }
+                [[nodiscard]] u64 getValue() const { return m_value; }
 
             protected:
                 u64 m_value;
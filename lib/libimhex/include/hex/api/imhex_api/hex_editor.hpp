@@ -60,15 +60,28 @@ EXPORT_MODULE namespace hex {
 
             using HighlightingFunction = std::function<std::optional<color_t>(u64, const u8*, size_t, bool)>;
             using HoveringFunction = std::function<std::set<Region>(const prv::Provider *, u64, size_t)>;
+            using HighlightSourceFunction = std::function<std::vector<Highlighting>(const prv::Provider *, const Region &)>;
+
+            struct HighlightSource {
+                HighlightSourceFunction function;
+                u64 version = 0;
+            };
 
             const std::map<u32, Highlighting>& getBackgroundHighlights();
             const std::map<u32, HighlightingFunction>& getBackgroundHighlightingFunctions();
             const std::map<u32, Highlighting>& getForegroundHighlights();
             const std::map<u32, HighlightingFunction>& getForegroundHighlightingFunctions();
+            const std::map<u32, HighlightSource>& getBackgroundHighlightSources();
+            const std::map<u32, HighlightSource>& getForegroundHighlightSources();
             const std::map<u32, HoveringFunction>& getHoveringFunctions();
             const std::map<u32, Tooltip>& getTooltips();
             const std::map<u32, TooltipFunction>& getTooltipFunctions();
 
+            /**
+             * @brief Gets a counter that changes every time a static highlighting is added or removed
+             */
+            u64 getHighlightsVersion();
+
             void setCurrentSelection(const std::optional<ProviderRegion> &region);
             void setHoveredRegion(const prv::Provider *provider, const Region &region);
         }
@@ -159,6 +172,42 @@ EXPORT_MODULE namespace hex {
          */
         void removeForegroundHighlightingProvider(u32 id);
 
+        /**
+         * @brief Adds a source of background highlightings to the Hex Editor.
+         * Instead of being called for every cell, the function is queried at most once per frame with the
+         * visible region and has to return all highlighted intervals overlapping it
+         * @param function Function returning the highlighted intervals overlapping the given region
+         * @return Unique ID used to invalidate or remove the source again later
+         */
+        u32 addBackgroundHighlightSource(const impl::HighlightSourceFunction &function);
+
+        /**
+         * @brief Removes a background highlight source from the Hex Editor
+         * @param id The ID of the source to remove
+         */
+        void removeBackgroundHighlightSource(u32 id);
+
+        /**
+         * @brief Adds a source of foreground highlightings to the Hex Editor.
+         * Instead of being called for every cell, the function is queried at most once per frame with the
+         * visible region and has to return all highlighted intervals overlapping it
+         * @param function Function returning the highlighted intervals overlapping the given region
+         * @return Unique ID used to invalidate or remove the source again later
+         */
+        u32 addForegroundHighlightSource(const impl::HighlightSourceFunction &function);
+
+        /**
+         * @brief Removes a foreground highlight source from the Hex Editor
+         * @param id The ID of the source to remove
+         */
+        void removeForegroundHighlightSource(u32 id);
+
+        /**
+         * @brief Bumps the version of a highlight source so the Hex Editor queries its intervals again
+         * @param id The ID of the source whose intervals changed
+         */
+        void invalidateHighlightSource(u32 id);
+
         /**
          * @brief Adds a hovering provider to the Hex Editor using a callback function
          * @param function Function that draws the highlighting based on the hovered region
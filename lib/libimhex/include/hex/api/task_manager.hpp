@@ -115,6 +115,9 @@ EXPORT_MODULE namespace hex {
         std::atomic<bool> m_background = true;
         std::atomic<bool> m_blocking = false;
 
+        // Time the task was added to the queue, only set while the profiler is enabled
+        u64 m_queuedTimestamp = 0;
+
         std::atomic_flag m_interrupted;
         std::atomic_flag m_finished;
         std::atomic_flag m_hadException;
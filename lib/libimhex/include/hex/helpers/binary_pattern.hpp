@@ -23,6 +23,8 @@ namespace hex {
             u8 mask, value;
         };
 
+        [[nodiscard]] const std::vector<Pattern>& getPatterns() const { return m_patterns; }
+
     private:
         std::vector<Pattern> m_patterns;
     };
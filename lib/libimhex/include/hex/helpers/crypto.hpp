@@ -5,6 +5,8 @@
 #include <wolv/utils/expected.hpp>
 
 #include <array>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,6 +25,7 @@ namespace hex::crypt {
     u8 crc8(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut);
     u16 crc16(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut);
     u32 crc32(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut);
+    u64 crc(prv::Provider *&data, u64 offset, size_t size, u32 width, u64 polynomial, u64 init, u64 xorOut, bool reflectIn, bool reflectOut);
 
     std::array<u8, 16> md5(prv::Provider *&data, u64 offset, size_t size);
     std::array<u8, 20> sha1(prv::Provider *&data, u64 offset, size_t size);
@@ -38,6 +41,27 @@ namespace hex::crypt {
     std::array<u8, 48> sha384(const std::vector<u8> &data);
     std::array<u8, 64> sha512(const std::vector<u8> &data);
 
+    enum class Digest : u8 {
+        MD5,
+        SHA1,
+        SHA224,
+        SHA256,
+        SHA384,
+        SHA512,
+        CRC32
+    };
+
+    /**
+     * @brief Calculates multiple digests of the same data while only reading it once
+     * @param data Provider to read the data from
+     * @param offset Address of the first byte to hash
+     * @param size Number of bytes to hash
+     * @param algorithms Digests to calculate. CRC32 uses the common zlib parameters and is returned as four big endian bytes
+     * @param progress Called with the number of bytes hashed so far after every chunk. Exceptions thrown by it stop the calculation
+     * @return The digests in the same order as the requested algorithms
+     */
+    std::vector<std::vector<u8>> digests(prv::Provider *&data, u64 offset, size_t size, std::span<const Digest> algorithms, const std::function<void(u64)> &progress = { });
+
     std::vector<u8> decode64(const std::vector<u8> &input);
     std::vector<u8> encode64(const std::vector<u8> &input);
     std::vector<u8> decode16(const std::string &input);
@@ -2,7 +2,7 @@
 
 #include <hex.hpp>
 
-#include <map>
+#include <limits>
 #include <string_view>
 #include <vector>
 #include <span>
@@ -44,13 +44,32 @@ namespace hex {
         [[nodiscard]] const std::string& getName() const { return m_name; }
 
     private:
+        /**
+         * @brief Node of the byte trie all mappings are compiled into. The children of a node are stored as a contiguous
+         * range of node indices covering the bytes from firstByte to firstByte + childCount - 1, zero meaning no child
+         */
+        struct TrieNode {
+            u32 childrenOffset = 0;
+            u32 value = NoValue;
+            u16 childCount = 0;
+            u8 firstByte = 0;
+        };
+
+        constexpr static u32 NoValue = std::numeric_limits<u32>::max();
+
         void parse(const std::string &content);
+        u32 buildTrie(std::span<const std::pair<std::vector<u8>, std::string>> entries, size_t depth);
+
+        [[nodiscard]] std::pair<u32, size_t> findLongestMatch(std::span<const u8> buffer) const;
 
         bool m_valid = false;
 
         std::string m_name;
         std::string m_tableContent;
-        std::unique_ptr<std::map<size_t, std::map<std::vector<u8>, std::string>>> m_mapping;
+
+        std::vector<TrieNode> m_trieNodes;
+        std::vector<u32> m_trieChildren;
+        std::vector<std::string> m_values;
 
         u64 m_shortestSequence = std::numeric_limits<u64>::max();
         u64 m_longestSequence  = std::numeric_limits<u64>::min();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace hex {
+
+    /**
+     * @brief A set of address ranges that are kept sorted, non-overlapping and non-adjacent.
+     * Inserting a region merges it with all neighbouring regions so the set always contains
+     * the smallest possible number of intervals, independent of how many bytes they cover
+     */
+    class IntervalSet {
+    public:
+        IntervalSet() = default;
+
+        /**
+         * @brief Adds a region to the set, merging it with any overlapping or adjacent intervals
+         * @param region Region to add
+         */
+        void insert(const Region &region);
+
+        /**
+         * @brief Removes a region from the set, splitting intervals that only partially overlap it
+         * @param region Region to remove
+         */
+        void erase(const Region &region);
+
+        void clear() { m_intervals.clear(); }
+
+        [[nodiscard]] bool contains(u64 address) const;
+        [[nodiscard]] bool overlaps(const Region &region) const;
+
+        /**
+         * @brief Finds the interval containing the given address
+         * @param address Address to look up
+         * @return The containing interval or std::nullopt if the address isn't part of the set
+         */
+        [[nodiscard]] std::optional<Region> find(u64 address) const;
+
+        /**
+         * @brief Finds the first interval that contains the given address or starts after it
+         * @param address Address to start searching at
+         * @return The found interval or std::nullopt if there are no more intervals
+         */
+        [[nodiscard]] std::optional<Region> findNext(u64 address) const;
+
+        /**
+         * @brief Gets all intervals overlapping the given region, clipped to it
+         * @param region Region to query
+         * @return List of clipped intervals in ascending order
+         */
+        [[nodiscard]] std::vector<Region> getOverlapping(const Region &region) const;
+
+        [[nodiscard]] std::vector<Region> getIntervals() const;
+
+        [[nodiscard]] bool empty() const { return m_intervals.empty(); }
+        [[nodiscard]] size_t size() const { return m_intervals.size(); }
+        [[nodiscard]] u64 getTotalSize() const;
+
+    private:
+        // Maps the start address of each interval to its inclusive end address
+        std::map<u64, u64> m_intervals;
+    };
+
+}
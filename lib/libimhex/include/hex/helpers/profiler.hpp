@@ -0,0 +1,138 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hex::prof {
+
+    enum class Category : u8 {
+        View,               // Drawing a view
+        Highlighting,       // Highlighting callbacks of the hex editor
+        Tooltip,            // Tooltip callbacks of the hex editor
+        MiniMap,            // Minimap visualizers
+        ProviderRead,       // Provider::read() including overlays
+        ProviderReadRaw,    // Provider::readRaw() only
+        TaskWait,           // Time a task spent in the queue before a worker picked it up
+        TaskRun             // Time a task spent running
+    };
+
+    constexpr static auto CategoryCount = size_t(Category::TaskRun) + 1;
+
+    /**
+     * @brief Timing statistics of one instrumented piece of code, e.g. one view or the reads of one provider
+     */
+    struct Statistics {
+        constexpr static size_t SampleCount = 256;
+
+        Category category;
+        std::string name;
+        u64 id;
+
+        u64 count = 0;
+        u64 bytes = 0;
+        u64 totalNanoseconds = 0;
+        u64 maxNanoseconds = 0;
+
+        // Durations of the most recent calls in microseconds, used for the rolling histograms
+        std::array<float, SampleCount> samples = { };
+        size_t sampleCount = 0;
+    };
+
+    /**
+     * @brief Single timed event as it's written to a trace
+     */
+    struct TraceEvent {
+        Category category;
+        std::string name;
+        u64 id;
+
+        u64 startNanoseconds;
+        u64 durationNanoseconds;
+        u64 bytes;
+        u32 threadId;
+    };
+
+    namespace impl {
+
+        extern std::atomic<bool> s_enabled;
+
+        [[nodiscard]] u64 getTimestamp();
+
+    }
+
+    /**
+     * @brief Enables or disables the profiler. While it's disabled, instrumented code only checks a single flag
+     * @param enabled Whether timings should be recorded
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Checks if the profiler is currently recording timings
+     * @return True if timings are recorded
+     */
+    [[nodiscard]] inline bool isEnabled() {
+        return impl::s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a timing
+     * @param category Category of the timed code
+     * @param name Name of the timed code. Together with the category and the id it identifies the statistics the timing gets added to
+     * @param id Additional id to tell apart multiple instances with the same name, e.g. the id of a provider
+     * @param startNanoseconds Timestamp when the code started running as returned by impl::getTimestamp()
+     * @param durationNanoseconds Time the code took to run
+     * @param bytes Number of bytes processed by the code
+     */
+    void record(Category category, std::string_view name, u64 id, u64 startNanoseconds, u64 durationNanoseconds, u64 bytes = 0);
+
+    /**
+     * @brief Measures the time between its construction and destruction and records it if the profiler is enabled
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(Category category, std::string_view name, u64 id = 0, u64 bytes = 0)
+            : m_category(category), m_name(name), m_id(id), m_bytes(bytes), m_start(isEnabled() ? impl::getTimestamp() : 0) { }
+
+        ~ScopedTimer() {
+            if (m_start != 0)
+                record(m_category, m_name, m_id, m_start, impl::getTimestamp() - m_start, m_bytes);
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    private:
+        Category m_category;
+        std::string_view m_name;
+        u64 m_id, m_bytes;
+        u64 m_start;
+    };
+
+    /**
+     * @brief Returns a copy of the statistics of everything recorded so far
+     * @return Statistics, sorted by category and name
+     */
+    [[nodiscard]] std::vector<Statistics> getStatistics();
+
+    /**
+     * @brief Removes all recorded statistics and trace events
+     */
+    void reset();
+
+    /**
+     * @brief Creates a trace of the most recent events in the Chrome trace event format
+     * @note The result can be opened in chrome://tracing, Perfetto or Speedscope. Events shorter than a few microseconds
+     * only count towards the statistics and are not part of the trace
+     * @return Trace as JSON
+     */
+    [[nodiscard]] std::string exportChromeTrace();
+
+    [[nodiscard]] std::string_view getCategoryName(Category category);
+
+}
@@ -1,42 +1,165 @@
 #pragma once
 
-#include <hex/helpers/literals.hpp>
+#include <hex.hpp>
+
+#include <hex/helpers/binary_pattern.hpp>
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace hex { class Task; }
+namespace hex::prv { class Provider; }
 
 namespace hex {
 
-auto searchInterruptable(const auto &haystackBegin, const auto &haystackEnd, const auto &needleBegin, const auto &needleEnd, auto predicate, Task &task) {
-  if (needleBegin == needleEnd)
-    return haystackBegin;
+    /**
+     * @brief Finds exact occurrences of a byte sequence
+     * @details Short sequences are found by comparing the first and last byte of the sequence against 32 positions of the data
+     * at once and only checking the full sequence where both of them match. Longer sequences use the Boyer-Moore-Horspool
+     * algorithm, which skips ahead by up to the length of the sequence after every mismatch.
+     *
+     * Searching a provider reads it in chunks that overlap by the length of the sequence and searches them on multiple threads
+     */
+    class SequenceSearcher {
+    public:
+        /**
+         * @brief Prepares a search for a sequence
+         * @param sequence Sequence to search for
+         * @param ignoreCase Treat upper and lower case ASCII letters as equal
+         */
+        explicit SequenceSearcher(std::span<const u8> sequence, bool ignoreCase = false);
 
-  for (auto current = haystackBegin; current != haystackEnd; ++current) {
-    auto haystackIt = current;
-    auto needleIt = needleBegin;
+        /**
+         * @brief Finds the first occurrence of the sequence in a buffer
+         * @param data Data to search
+         * @param offset Offset to start searching at
+         * @return Offset of the occurrence, if any
+         */
+        [[nodiscard]] std::optional<size_t> findFirst(std::span<const u8> data, size_t offset = 0) const;
 
-    while (haystackIt != haystackEnd && needleIt != needleEnd && predicate(*haystackIt, *needleIt)) {
-      ++haystackIt;
-      ++needleIt;
-    }
+        /**
+         * @brief Finds the last occurrence of the sequence in a buffer
+         * @param data Data to search
+         * @return Offset of the occurrence, if any
+         */
+        [[nodiscard]] std::optional<size_t> findLast(std::span<const u8> data) const;
 
-    if (needleIt == needleEnd)
-      return current;
+        /**
+         * @brief Finds all occurrences of the sequence in a region of a provider, including overlapping ones
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param chunkSize Size of the chunks the region is read and searched in
+         * @return Addresses of all occurrences, sorted
+         */
+        [[nodiscard]] std::vector<u64> findAll(Task &task, prv::Provider *provider, Region region, size_t chunkSize = 0x40'0000) const;
 
-    if (haystackIt == haystackEnd)
-      return haystackEnd;
+        /**
+         * @brief Finds all occurrences of the sequence in a region of a provider and hands them out while the search is still running
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param callback Function called with the addresses found in each chunk, in address order
+         * @param chunkSize Size of the chunks the region is read and searched in
+         */
+        void findAll(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const u64>)> &callback, size_t chunkSize = 0x40'0000) const;
 
-    using namespace hex::literals;
-    // Important: Keep this aligned to a power of 2 so it gets optimized nicely
-    if (const auto address = current.getAddress(); (address % 16_MiB) == 0) [[unlikely]] {
-      task.update(address);
-    }
-  }
+        /**
+         * @brief Finds the first occurrence of the sequence in a region of a provider
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param chunkSize Size of the chunks the region is read and searched in
+         * @return Address of the occurrence, if any
+         */
+        [[nodiscard]] std::optional<u64> findNext(Task &task, prv::Provider *provider, Region region, size_t chunkSize = 0x40'0000) const;
 
-  return haystackEnd;
-}
+        /**
+         * @brief Finds the last occurrence of the sequence in a region of a provider
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param chunkSize Size of the chunks the region is read and searched in
+         * @return Address of the occurrence, if any
+         */
+        [[nodiscard]] std::optional<u64> findPrevious(Task &task, prv::Provider *provider, Region region, size_t chunkSize = 0x40'0000) const;
 
-auto searchInterruptable(const auto &haystackBegin, const auto &haystackEnd, const auto &needleBegin, const auto &needleEnd, Task &task) {
-  return searchInterruptable(haystackBegin, haystackEnd, needleBegin, needleEnd, [](auto left, auto right) {
-    return left == right;
-  }, task);
-}
+        [[nodiscard]] size_t getSize() const { return m_sequence.size(); }
+
+    private:
+        [[nodiscard]] bool matchesAt(const u8 *data) const;
+        [[nodiscard]] std::optional<size_t> findFirstShort(std::span<const u8> data, size_t offset) const;
+        [[nodiscard]] std::optional<size_t> findFirstHorspool(std::span<const u8> data, size_t offset) const;
+
+    private:
+        // Stored with all letters in lower case if the case is ignored
+        std::vector<u8> m_sequence;
+        bool m_ignoreCase;
+
+        std::array<u8, 256> m_foldTable = { };
+        std::array<size_t, 256> m_shiftTable = { };
+    };
+
+    /**
+     * @brief Finds occurrences of a BinaryPattern
+     * @details Instead of checking every offset, the searcher looks for the fully specified run of bytes in the pattern
+     * that is least likely to show up in regular data using a SequenceSearcher and only checks the rest of the pattern
+     * where that run was found. Patterns without such a run compare the two most specific masked bytes of the pattern
+     * against 32 offsets at once instead
+     */
+    class BinaryPatternSearcher {
+    public:
+        explicit BinaryPatternSearcher(const BinaryPattern &pattern);
 
-}
\ No newline at end of file
+        /**
+         * @brief Finds the first occurrence of the pattern in a buffer
+         * @param data Data to search
+         * @param offset Offset to start searching at
+         * @return Offset of the occurrence, if any
+         */
+        [[nodiscard]] std::optional<size_t> findFirst(std::span<const u8> data, size_t offset = 0) const;
+
+        /**
+         * @brief Finds all occurrences of the pattern in a region of a provider, including overlapping ones
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param alignment Only report occurrences whose distance to the start of the region is a multiple of this
+         * @param chunkSize Size of the chunks the region is read and searched in
+         * @return Addresses of all occurrences, sorted
+         */
+        [[nodiscard]] std::vector<u64> findAll(Task &task, prv::Provider *provider, Region region, u64 alignment = 1, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all occurrences of the pattern in a region of a provider and hands them out while the search is still running
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only occurrences that lie fully inside of it are reported
+         * @param alignment Only report occurrences whose distance to the start of the region is a multiple of this
+         * @param callback Function called with the addresses found in each chunk, in address order
+         * @param chunkSize Size of the chunks the region is read and searched in
+         */
+        void findAll(Task &task, prv::Provider *provider, Region region, u64 alignment, const std::function<void(std::span<const u64>)> &callback, size_t chunkSize = 0x40'0000) const;
+
+        [[nodiscard]] size_t getSize() const { return m_patterns.size(); }
+
+    private:
+        [[nodiscard]] bool matchesAt(const u8 *data) const;
+        [[nodiscard]] std::optional<size_t> findFirstAnchored(std::span<const u8> data, size_t offset) const;
+        [[nodiscard]] std::optional<size_t> findFirstMasked(std::span<const u8> data, size_t offset) const;
+
+    private:
+        std::vector<BinaryPattern::Pattern> m_patterns;
+
+        // Fully specified run of bytes the search is anchored on and its offset in the pattern
+        std::optional<SequenceSearcher> m_anchor;
+        size_t m_anchorOffset = 0;
+
+        // Offsets of the two bytes with the most specific masks, used if there's no anchor
+        std::array<size_t, 2> m_filterOffsets = { };
+    };
+
+}
@@ -39,12 +39,20 @@ namespace hex::prv {
         void writeRaw(u64, const void*, size_t) override { }
         [[nodiscard]] u64 getActualSize() const override { return m_size; }
 
+        [[nodiscard]] std::pair<Region, bool> getRegionValidity(u64 address) const override;
+
         [[nodiscard]] std::string getName() const override { return "ConcatenatedProvider"; }
         [[nodiscard]] UnlocalizedString getTypeName() const override { return "ConcatenatedProvider"_untranslated; }
         [[nodiscard]] const char *getIcon() const override { return ""; }
 
+    private:
+        [[nodiscard]] size_t findSegment(u64 offset) const;
+
     private:
         std::vector<Segment> m_segments;
+
+        // Start offset of each segment inside of the concatenated address space, kept sorted for binary search
+        std::vector<u64> m_segmentOffsets;
         u64 m_size = 0;
     };
 
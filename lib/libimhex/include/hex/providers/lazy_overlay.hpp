@@ -0,0 +1,69 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <span>
+#include <vector>
+
+namespace hex::prv {
+
+    /**
+     * @brief Modification of a region that gets computed while the data is being read instead of being written to the provider
+     * @note This allows filling or transforming huge regions using a constant amount of memory. A lazy overlay can get split
+     * into multiple pieces when parts of it are written over, all pieces share the same id and the same origin, so every byte
+     * keeps its value no matter how the overlay has been split up
+     */
+    class LazyOverlay {
+    public:
+        enum class Type : u8 {
+            Fill,       // Repeats the key
+            Random,     // Pseudo random bytes generated from the key as seed
+            Xor,        // XORs the data with the repeated key
+            Add         // Adds the repeated key to the data byte by byte
+        };
+
+        LazyOverlay(Type type, Region region, std::vector<u8> key);
+
+        [[nodiscard]] u64 getId() const { return m_id; }
+        [[nodiscard]] Type getType() const { return m_type; }
+        [[nodiscard]] const Region& getRegion() const { return m_region; }
+        [[nodiscard]] const std::vector<u8>& getKey() const { return m_key; }
+
+        /**
+         * @brief Gets the address the overlay started at when it got created. It moves together with the overlay, so the
+         * distance between it and the start of a piece stays the same
+         */
+        [[nodiscard]] u64 getOrigin() const { return m_origin; }
+
+        /**
+         * @brief Applies the overlay to a buffer of data
+         * @param offset Offset of the first byte of the buffer, relative to the provider's base address
+         * @param buffer Data to modify. Only the part that overlaps with the overlay is changed
+         */
+        void apply(u64 offset, std::span<u8> buffer) const;
+
+        /**
+         * @brief Creates a piece of this overlay covering only part of its region
+         * @param region Region of the piece. Has to lie within the region of this overlay
+         * @return The new piece
+         */
+        [[nodiscard]] LazyOverlay slice(const Region &region) const;
+
+        /**
+         * @brief Moves the overlay along with the data it covers
+         * @param delta Number of bytes to move the overlay by
+         */
+        void move(i64 delta);
+
+    private:
+        u64 m_id;
+        Type m_type;
+        Region m_region;
+
+        // Address the key pattern started at when the overlay got created
+        u64 m_origin;
+        std::vector<u8> m_key;
+        u64 m_seed = 0;
+    };
+
+}
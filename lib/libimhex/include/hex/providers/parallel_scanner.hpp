@@ -0,0 +1,93 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hex::prv {
+
+    /**
+     * @brief Scans a region of a provider chunk by chunk on multiple threads
+     * @details Providers aren't safe to read from multiple threads at once, so the chunks are read sequentially in batches
+     * of one chunk per thread. Every chunk of a batch is then processed on its own thread and the results are passed to
+     * the merge function one after another in address order, before the next batch gets read.
+     *
+     * Each chunk is passed together with up to `overlap` bytes that follow it, so matches crossing the end of a chunk can
+     * be found. Only matches that start inside the chunk itself should be reported to not find them twice
+     *
+     * @param task Task to report the progress to. Scanning stops with the task once it gets interrupted
+     * @param provider Provider to read from
+     * @param region Region to scan
+     * @param process Function called as process(address, chunkSize, data) for every chunk. data contains the chunk followed by the overlap bytes.
+     * Runs on multiple threads at once
+     * @param merge Function called as merge(address, data, result) with the result of every chunk, in address order. data contains the chunk
+     * without the overlap bytes and stays valid until merge returns. If merge returns a bool, scanning stops as soon as it returns false
+     * @param chunkSize Size of each chunk
+     * @param overlap Number of bytes following each chunk that are passed to process as well
+     */
+    template<typename Process, typename Merge>
+    void scanParallel(Task &task, Provider *provider, Region region, Process &&process, Merge &&merge, size_t chunkSize = 0x40'0000, size_t overlap = 0) {
+        using Result = std::invoke_result_t<Process&, u64, size_t, std::span<const u8>>;
+        constexpr static bool CanStop = std::is_same_v<std::invoke_result_t<Merge&, u64, std::span<const u8>, Result&&>, bool>;
+
+        if (region.getSize() == 0)
+            return;
+
+        chunkSize = std::max<size_t>(chunkSize, 1);
+        const auto threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 16);
+        const auto chunkCount  = std::clamp<size_t>((region.getSize() + chunkSize - 1) / chunkSize, 1, threadCount);
+
+        std::vector<std::vector<u8>> buffers(chunkCount);
+        std::vector<u64> chunkAddresses(chunkCount);
+        std::vector<size_t> chunkSizes(chunkCount);
+        std::vector<std::optional<Result>> results(chunkCount);
+
+        for (u64 offset = 0; offset < region.getSize();) {
+            // Read the next batch of chunks
+            size_t batchSize = 0;
+            for (; batchSize < chunkCount && offset < region.getSize(); batchSize += 1) {
+                chunkAddresses[batchSize] = region.getStartAddress() + offset;
+                chunkSizes[batchSize]     = std::min<u64>(chunkSize, region.getSize() - offset);
+
+                buffers[batchSize].resize(std::min<u64>(chunkSizes[batchSize] + overlap, region.getSize() - offset));
+                provider->read(chunkAddresses[batchSize], buffers[batchSize].data(), buffers[batchSize].size());
+
+                offset += chunkSizes[batchSize];
+            }
+
+            // Process all chunks of the batch in parallel
+            {
+                std::vector<std::jthread> workers;
+                for (size_t i = 1; i < batchSize; i += 1) {
+                    workers.emplace_back([&, i] {
+                        results[i].emplace(process(chunkAddresses[i], chunkSizes[i], std::span<const u8>(buffers[i])));
+                    });
+                }
+
+                results[0].emplace(process(chunkAddresses[0], chunkSizes[0], std::span<const u8>(buffers[0])));
+            }
+
+            for (size_t i = 0; i < batchSize; i += 1) {
+                const auto data = std::span<const u8>(buffers[i]).first(chunkSizes[i]);
+                if constexpr (CanStop) {
+                    if (!merge(chunkAddresses[i], data, std::move(*results[i])))
+                        return;
+                } else {
+                    merge(chunkAddresses[i], data, std::move(*results[i]));
+                }
+                results[i].reset();
+            }
+
+            task.update(offset);
+        }
+    }
+
+}
@@ -3,12 +3,15 @@
 #include <hex.hpp>
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <variant>
 #include <vector>
 
+#include <hex/providers/lazy_overlay.hpp>
 #include <hex/providers/overlay.hpp>
 #include <hex/helpers/fs.hpp>
 
@@ -254,11 +257,11 @@ namespace hex::prv {
         [[nodiscard]] virtual bool isSavableAsRecent() const { return true; }
 
         /**
-         * @brief Read data from this provider, applying overlays and patches
+         * @brief Read data from this provider, applying lazy overlays, overlays and patches
          * @param offset offset to start reading the data
          * @param buffer buffer to write read data
          * @param size number of bytes to read
-         * @param overlays apply overlays and patches is true. Same as readRaw() if false
+         * @param overlays apply overlays and patches is true. Lazy overlays are part of the data and always get applied
          */
         virtual void read(u64 offset, void *buffer, size_t size, bool overlays = true);
         
@@ -330,6 +333,49 @@ namespace hex::prv {
         void applyOverlays(u64 offset, void *buffer, size_t size) const;
         [[nodiscard]] const std::list<std::unique_ptr<Overlay>> &getOverlays() const;
 
+        /**
+         * @brief Adds a lazy overlay on top of the data of this provider
+         * @note Unlike regular overlays, lazy overlays are part of the provider's data. They're applied by read() in the
+         * order they were created and only get written to the provider by materializeLazyOverlays()
+         * @param overlay Overlay or piece of an overlay to add
+         */
+        void addLazyOverlay(const LazyOverlay &overlay);
+
+        /**
+         * @brief Removes all pieces of a lazy overlay
+         * @param id Id of the overlay
+         */
+        void removeLazyOverlay(u64 id);
+
+        /**
+         * @brief Writes the result of all lazy overlays covering a region to the provider and removes them from that region
+         * @param region Region relative to the base address
+         * @return Pieces of the overlays that were removed, they can be added again to undo this
+         */
+        std::vector<LazyOverlay> materializeLazyOverlays(const Region &region);
+
+        /**
+         * @brief Writes the result of all lazy overlays to the provider and removes them
+         * @note Operations on the undo stack get the chance to keep the data the overlays replaced first, so they can still be undone
+         */
+        void materializeLazyOverlays();
+
+        /**
+         * @brief Moves the lazy overlays along with the data after inserting or removing bytes
+         * @param offset Offset relative to the base address. Overlays starting at or after it are moved, overlays spanning it are split
+         * @param delta Number of bytes to move the overlays by
+         */
+        void moveLazyOverlays(u64 offset, i64 delta);
+
+        void applyLazyOverlays(u64 offset, void *buffer, size_t size) const;
+        [[nodiscard]] bool hasLazyOverlays(const Region &region) const;
+
+        /**
+         * @brief Gets the current lazy overlays, sorted by their id
+         * @note The returned list doesn't change anymore, so it can be used while the overlays get modified on another thread
+         */
+        [[nodiscard]] std::shared_ptr<const std::vector<LazyOverlay>> getLazyOverlays() const;
+
         [[nodiscard]] u64 getPageSize() const;
         void setPageSize(u64 pageSize);
 
@@ -383,6 +429,10 @@ namespace hex::prv {
 
         std::list<std::unique_ptr<Overlay>> m_overlays;
 
+        // Lazy overlays are changed by the undo stack while background tasks read through them, so changes replace the whole list
+        mutable std::mutex m_lazyOverlayMutex;
+        std::shared_ptr<const std::vector<LazyOverlay>> m_lazyOverlays = std::make_shared<const std::vector<LazyOverlay>>();
+
         u32 m_id;
 
         /**
@@ -405,6 +455,9 @@ namespace hex::prv {
         bool m_skipLoadInterface = false;
 
         u64 m_pageSize = MaxPageSize;
+
+    private:
+        void setLazyOverlays(std::vector<LazyOverlay> overlays);
     };
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,25 @@ namespace hex::prv::undo {
         }
 
         [[nodiscard]] virtual bool shouldHighlight() const { return true; }
+
+        /**
+         * @brief Gets the amount of memory in bytes this operation currently keeps resident
+         */
+        [[nodiscard]] virtual size_t getMemoryUsage() const { return 0; }
+
+        /**
+         * @brief Moves the data of this operation out of memory
+         * @note Called by the undo stack on old operations once it exceeds its memory budget.
+         * Undoing or redoing the operation afterwards has to keep working
+         */
+        virtual void offload() { }
+
+        /**
+         * @brief Called right before all lazy overlays of the provider get written to its data, e.g. when it's being saved
+         * @note Operations that rely on their lazy overlay still being there when they get undone have to keep the data it replaced
+         * @param keepResident Called with the size of every block of data the operation stores. If it returns false, the block has to be offloaded right away
+         */
+        virtual void materializeLazyOverlays(Provider *, const std::function<bool(u64)> &) { }
     };
 
 }
\ No newline at end of file
@@ -58,6 +58,24 @@ namespace hex::prv::undo {
             return m_formattedContent;
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            size_t result = 0;
+            for (const auto &operation : m_operations)
+                result += operation->getMemoryUsage();
+
+            return result;
+        }
+
+        void offload() override {
+            for (auto &operation : m_operations)
+                operation->offload();
+        }
+
+        void materializeLazyOverlays(Provider *provider, const std::function<bool(u64)> &keepResident) override {
+            for (auto &operation : m_operations)
+                operation->materializeLazyOverlays(provider, keepResident);
+        }
+
     private:
         UnlocalizedString m_unlocalizedName;
         std::vector<std::unique_ptr<Operation>> m_operations;
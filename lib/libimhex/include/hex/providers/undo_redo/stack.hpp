@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace hex::prv {
@@ -29,9 +30,20 @@ namespace hex::prv::undo {
         void apply(const Stack &otherStack);
         void reapply();
 
+        /**
+         * @brief Lets all applied operations prepare for the lazy overlays of the provider getting written to its data
+         */
+        void materializeLazyOverlays();
+
         [[nodiscard]] bool canUndo() const;
         [[nodiscard]] bool canRedo() const;
 
+        /**
+         * @brief Gets the region of the operation whose change is currently being announced through EventDataChanged
+         * @return Region of the operation or std::nullopt if the event wasn't posted by the stack for a single operation
+         */
+        [[nodiscard]] std::optional<Region> getChangedRegion() const;
+
         template<std::derived_from<Operation> T>
         bool add(auto && ... args) {
             auto result = this->add(std::make_unique<T>(std::forward<decltype(args)>(args)...));
@@ -43,6 +55,15 @@ namespace hex::prv::undo {
 
         static std::recursive_mutex& getMutex();
 
+        /**
+         * @brief Sets the amount of memory the operations of a single stack may use before old ones get offloaded
+         * @param budget Memory budget in bytes
+         */
+        static void setMemoryBudget(u64 budget);
+        [[nodiscard]] static u64 getMemoryBudget();
+
+        [[nodiscard]] u64 getMemoryUsage() const;
+
         const std::vector<std::unique_ptr<Operation>> &getAppliedOperations() const {
             return m_undoStack;
         }
@@ -54,6 +75,8 @@ namespace hex::prv::undo {
         void reset() {
             m_undoStack.clear();
             m_redoStack.clear();
+            m_memoryUsage = 0;
+            m_firstResidentOperation = 0;
         }
 
     private:
@@ -61,9 +84,20 @@ namespace hex::prv::undo {
             return m_undoStack.back().get();
         }
 
+        void enforceMemoryBudget();
+        void postDataChanged(const Operation &operation);
+
     private:
         std::vector<std::unique_ptr<Operation>> m_undoStack, m_redoStack;
         Provider *m_provider;
+
+        // Memory used by all operations on both stacks, kept up to date so it doesn't need to be summed up on every edit
+        u64 m_memoryUsage = 0;
+
+        // All applied operations before this index have already been offloaded
+        size_t m_firstResidentOperation = 0;
+
+        std::optional<Region> m_changedRegion;
     };
 
 }
\ No newline at end of file
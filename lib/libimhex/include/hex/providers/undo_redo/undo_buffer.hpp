@@ -0,0 +1,59 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace hex::prv::undo {
+
+    /**
+     * @brief Immutable byte buffer used by undo operations to store their data
+     * @note Large buffers are stored run-length encoded if that makes them smaller. When the undo stack
+     * exceeds its memory budget, the buffer can additionally be offloaded to a temporary file on disk.
+     * Copies of a buffer share the same underlying storage
+     */
+    class UndoBuffer {
+    public:
+        UndoBuffer() = default;
+        explicit UndoBuffer(std::span<const u8> data);
+
+        /**
+         * @brief Decodes the stored data, reading it back from disk if it has been offloaded
+         * @param maxSize Maximum number of bytes to decode from the start of the data
+         * @return The original data, truncated to maxSize bytes
+         */
+        [[nodiscard]] std::vector<u8> get(size_t maxSize = std::numeric_limits<size_t>::max()) const;
+
+        /**
+         * @brief Gets the size of the original data
+         */
+        [[nodiscard]] size_t getSize() const { return m_size; }
+
+        /**
+         * @brief Gets the amount of memory currently used to store the data
+         */
+        [[nodiscard]] size_t getMemoryUsage() const;
+
+        [[nodiscard]] bool isOffloaded() const;
+
+        /**
+         * @brief Moves the stored data to a temporary file on disk, freeing its memory
+         */
+        void offload();
+
+        /**
+         * @brief Gets the current size of the temporary file that offloaded buffers are stored in
+         */
+        [[nodiscard]] static u64 getOffloadFileSize();
+
+    private:
+        struct Storage;
+
+        std::shared_ptr<const Storage> m_storage;
+        size_t m_size = 0;
+    };
+
+}
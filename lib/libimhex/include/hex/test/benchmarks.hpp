@@ -0,0 +1,110 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <wolv/utils/preproc.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#define BENCHMARK(...) static auto WOLV_ANONYMOUS_VARIABLE(BENCHMARK) = ::hex::test::BenchmarkExecutor(__VA_ARGS__) + [](::hex::test::BenchmarkState &state) -> void
+
+namespace hex::test {
+
+    struct BenchmarkResult {
+        std::string name;
+        std::string variant;
+
+        // Number of bytes processed by one iteration, zero if a throughput doesn't make sense for the benchmark
+        u64 bytes = 0;
+        u32 iterations = 0;
+
+        double minSeconds = 0, medianSeconds = 0, meanSeconds = 0;
+        std::map<std::string, double> counters;
+    };
+
+    class BenchmarkState {
+    public:
+        BenchmarkState(std::string name, u32 repetitions) : m_name(std::move(name)), m_repetitions(repetitions) { }
+
+        /**
+         * @brief Measures how long a piece of code takes to execute
+         * @param variant Name of the measured variant. A benchmark can measure multiple variants of the same operation
+         * @param bytes Number of bytes processed by one call of the function, used to calculate the throughput
+         * @param function Function to measure. It's called once to warm up caches and then once per repetition
+         */
+        void measure(const std::string &variant, u64 bytes, const std::function<void()> &function);
+
+        /**
+         * @brief Attaches an additional value to the last measurement, e.g. the memory used or the number of results found
+         * @param name Name of the value
+         * @param value Value
+         */
+        void setCounter(const std::string &name, double value);
+
+        [[nodiscard]] const std::string& getName() const { return m_name; }
+        [[nodiscard]] const std::vector<BenchmarkResult>& getResults() const { return m_results; }
+
+    private:
+        std::string m_name;
+        u32 m_repetitions;
+        std::vector<BenchmarkResult> m_results;
+    };
+
+    using BenchmarkFunction = void(*)(BenchmarkState &);
+
+    class Benchmarks {
+    public:
+        static int addBenchmark(const std::string &name, BenchmarkFunction function) noexcept;
+
+        static std::map<std::string, BenchmarkFunction> &get() noexcept;
+    };
+
+    struct BenchmarkExecutor {
+        explicit BenchmarkExecutor(std::string name) noexcept : m_name(std::move(name)) { }
+
+        [[nodiscard]] const auto &getName() const noexcept {
+            return m_name;
+        }
+
+    private:
+        std::string m_name;
+    };
+
+    template<typename F>
+    int operator+(const BenchmarkExecutor &executor, F &&f) noexcept {
+        return Benchmarks::addBenchmark(executor.getName(), std::forward<F>(f));
+    }
+
+    enum class BenchmarkData {
+        Random,     // Uniformly distributed random bytes
+        Text,       // Printable ASCII text made of words, spaces and line feeds
+        Binary      // Mix of zero runs, small integers, ASCII and UTF-16 strings and random bytes, similar to an executable
+    };
+
+    /**
+     * @brief Generates synthetic data for benchmarks. The same size and seed always produce the same data
+     * @param type Kind of data to generate
+     * @param size Number of bytes to generate
+     * @param seed Seed for the random number generator
+     * @return Generated data
+     */
+    [[nodiscard]] std::vector<u8> generateBenchmarkData(BenchmarkData type, size_t size, u64 seed = 0x1337);
+
+    /**
+     * @brief Prevents the compiler from optimizing away the computation of a value that's otherwise unused
+     * @param value Value to keep
+     */
+    template<typename T>
+    void doNotOptimize(const T &value) {
+        #if defined(_MSC_VER)
+            static volatile const void *sink;
+            sink = &value;
+        #else
+            asm volatile("" : : "r,m"(value) : "memory");
+        #endif
+    }
+
+}
@@ -91,6 +91,15 @@ namespace ImGuiExt {
         [[nodiscard]] static Texture fromSVG(const std::fs::path &path, int width = 0, int height = 0, Filter filter = Filter::Nearest);
         [[nodiscard]] static Texture fromSVG(std::span<const std::byte> buffer, int width = 0, int height = 0, Filter filter = Filter::Nearest);
 
+        /**
+         * @brief Decodes an image into RGBA8 pixels without creating a texture from it, so it can be done on a background thread
+         * @param buffer Encoded image data
+         * @param width Set to the width of the decoded image
+         * @param height Set to the height of the decoded image
+         * @return Decoded pixels or an empty vector if the image couldn't be decoded
+         */
+        [[nodiscard]] static std::vector<u8> decodeImage(std::span<const std::byte> buffer, int &width, int &height);
+
         ~Texture();
 
         Texture& operator=(const Texture&) = delete;
@@ -1,4 +1,5 @@
 #include <hex/api/content_registry/background_services.hpp>
+#include <hex/api/content_registry/batch_analysis.hpp>
 #include <hex/api/content_registry/command_palette.hpp>
 #include <hex/api/content_registry/communication_interface.hpp>
 #include <hex/api/content_registry/data_formatter.hpp>
@@ -1532,6 +1533,23 @@ namespace hex {
 
     }
 
+    namespace ContentRegistry::BatchAnalysis {
+
+        namespace impl {
+
+            static AutoReset<std::vector<Analysis>> s_analyses;
+            const std::vector<Analysis>& getAnalyses() {
+                return *s_analyses;
+            }
+
+        }
+
+        void addAnalysis(const std::string &name, const std::string &description, impl::Callback callback, u32 maxConcurrentRuns) {
+            impl::s_analyses->push_back(impl::Analysis { name, description, std::move(callback), maxConcurrentRuns });
+        }
+
+    }
+
     namespace ContentRegistry::DataInformation {
 
         void InformationSection::load(const nlohmann::json &data) {
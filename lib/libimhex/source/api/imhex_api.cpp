@@ -96,6 +96,21 @@ namespace hex {
                 return *s_tooltipFunctions;
             }
 
+            static AutoReset<std::map<u32, HighlightSource>> s_backgroundHighlightSources;
+            const std::map<u32, HighlightSource>& getBackgroundHighlightSources() {
+                return *s_backgroundHighlightSources;
+            }
+
+            static AutoReset<std::map<u32, HighlightSource>> s_foregroundHighlightSources;
+            const std::map<u32, HighlightSource>& getForegroundHighlightSources() {
+                return *s_foregroundHighlightSources;
+            }
+
+            static u64 s_highlightsVersion = 0;
+            u64 getHighlightsVersion() {
+                return s_highlightsVersion;
+            }
+
             static AutoReset<std::map<u32, HoveringFunction>> s_hoveringFunctions;
             const std::map<u32, HoveringFunction>& getHoveringFunctions() {
                 return *s_hoveringFunctions;
@@ -131,6 +146,7 @@ namespace hex {
             impl::s_backgroundHighlights->insert({
                 id, Highlighting { region, color }
             });
+            impl::s_highlightsVersion++;
 
             TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
 
@@ -139,6 +155,7 @@ namespace hex {
 
         void removeBackgroundHighlight(u32 id) {
             impl::s_backgroundHighlights->erase(id);
+            impl::s_highlightsVersion++;
 
             TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
         }
@@ -169,6 +186,7 @@ namespace hex {
             impl::s_foregroundHighlights->insert({
                 id, Highlighting { region, color }
             });
+            impl::s_highlightsVersion++;
 
             TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
 
@@ -177,6 +195,7 @@ namespace hex {
 
         void removeForegroundHighlight(u32 id) {
             impl::s_foregroundHighlights->erase(id);
+            impl::s_highlightsVersion++;
 
             TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
         }
@@ -199,6 +218,45 @@ namespace hex {
             TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
         }
 
+        static u32 s_highlightSourceId = 0;
+        u32 addBackgroundHighlightSource(const impl::HighlightSourceFunction &function) {
+            s_highlightSourceId++;
+            impl::s_backgroundHighlightSources->insert({ s_highlightSourceId, { function } });
+
+            TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
+
+            return s_highlightSourceId;
+        }
+
+        void removeBackgroundHighlightSource(u32 id) {
+            impl::s_backgroundHighlightSources->erase(id);
+
+            TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
+        }
+
+        u32 addForegroundHighlightSource(const impl::HighlightSourceFunction &function) {
+            s_highlightSourceId++;
+            impl::s_foregroundHighlightSources->insert({ s_highlightSourceId, { function } });
+
+            TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
+
+            return s_highlightSourceId;
+        }
+
+        void removeForegroundHighlightSource(u32 id) {
+            impl::s_foregroundHighlightSources->erase(id);
+
+            TaskManager::doLaterOnce([]{ EventHighlightingChanged::post(); });
+        }
+
+        void invalidateHighlightSource(u32 id) {
+            // Source IDs are shared between both layers so a single lookup in each map is enough
+            if (auto it = impl::s_backgroundHighlightSources->find(id); it != impl::s_backgroundHighlightSources->end())
+                it->second.version++;
+            if (auto it = impl::s_foregroundHighlightSources->find(id); it != impl::s_foregroundHighlightSources->end())
+                it->second.version++;
+        }
+
         u32 addHoverHighlightProvider(const impl::HoveringFunction &function) {
             static u32 id = 0;
 
@@ -2,6 +2,7 @@
 
 #include <hex/api/localization_manager.hpp>
 #include <hex/helpers/logger.hpp>
+#include <hex/helpers/profiler.hpp>
 
 #include <algorithm>
 #include <ranges>
@@ -83,6 +84,7 @@ namespace hex {
 
             m_function = std::move(other.m_function);
             m_unlocalizedName = std::move(other.m_unlocalizedName);
+            m_queuedTimestamp = other.m_queuedTimestamp;
         }
 
         m_maxValue.store(other.m_maxValue.load());
@@ -325,8 +327,17 @@ namespace hex {
                         // Set the thread name to the name of the task
                         TaskManager::setCurrentThreadName(Lang(task->m_unlocalizedName));
 
+                        const auto &taskName = task->m_unlocalizedName.get();
+                        if (task->m_queuedTimestamp != 0) {
+                            const auto now = prof::impl::getTimestamp();
+                            prof::record(prof::Category::TaskWait, taskName, 0, task->m_queuedTimestamp, now - task->m_queuedTimestamp);
+                        }
+
                         // Execute the task
-                        task->m_function(*task);
+                        {
+                            prof::ScopedTimer timer(prof::Category::TaskRun, taskName);
+                            task->m_function(*task);
+                        }
 
                         log::debug("Task '{}' finished", task->m_unlocalizedName.get());
 
@@ -398,6 +409,8 @@ namespace hex {
 
         // Construct new task
         auto task = std::make_shared<Task>(unlocalizedName, maxValue, background, blocking, std::move(function));
+        if (prof::isEnabled())
+            task->m_queuedTimestamp = prof::impl::getTimestamp();
 
         s_tasks.emplace_back(task);
 
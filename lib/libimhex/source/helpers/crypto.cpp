@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <hex/helpers/crypto.hpp>
 
+#include <hex/helpers/utils.hpp>
 #include <hex/providers/provider.hpp>
 
 #include <wolv/utils/guards.hpp>
@@ -30,15 +31,35 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <bit>
+#include <functional>
+#include <memory>
 #include <span>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+
+    #define CRC_FOLDING_AVAILABLE
+    #define CRC_FOLDING_X86
+    #define CRC_FOLDING_TARGET __attribute__((target("pclmul,ssse3")))
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_AES)
+    #include <arm_neon.h>
+
+    #define CRC_FOLDING_AVAILABLE
+    #define CRC_FOLDING_ARM
+    #define CRC_FOLDING_TARGET
+#endif
 
 namespace hex::crypt {
     using namespace std::placeholders;
 
+    constexpr static size_t ChunkSize = 1024 * 1024;
+
     template<std::invocable<unsigned char *, size_t> Func>
     void processDataByChunks(prv::Provider *data, u64 offset, size_t size, Func func) {
-        std::array<u8, 512> buffer = { 0 };
+        std::vector<u8> buffer(std::min(ChunkSize, size));
         for (size_t bufferOffset = 0; bufferOffset < size; bufferOffset += buffer.size()) {
             const auto readSize = std::min(buffer.size(), size - bufferOffset);
             data->read(offset + bufferOffset, buffer.data(), readSize);
@@ -74,90 +95,363 @@ namespace hex::crypt {
         }
     }
 
-    template<size_t NumBits> requires (std::has_single_bit(NumBits))
-    class Crc {
-        // Use reflected algorithm, so we reflect only if refin / refout is FALSE
-        // mask values, 0b1 << 64 is UB, so use 0b10 << 63
+    /**
+     * @brief Reverses the bits of each of the eight bytes in a 64 bit value individually
+     */
+    constexpr u64 reflectBytes(u64 value) {
+        value = ((value >> 1) & 0x5555'5555'5555'5555ULL) | ((value & 0x5555'5555'5555'5555ULL) << 1);
+        value = ((value >> 2) & 0x3333'3333'3333'3333ULL) | ((value & 0x3333'3333'3333'3333ULL) << 2);
+        value = ((value >> 4) & 0x0F0F'0F0F'0F0F'0F0FULL) | ((value & 0x0F0F'0F0F'0F0F'0F0FULL) << 4);
 
+        return value;
+    }
+
+    u64 loadLittleEndian(const u8 *data) {
+        u64 value;
+        std::memcpy(&value, data, sizeof(value));
+
+        return changeEndianness(value, std::endian::little);
+    }
+
+    /**
+     * @brief Table driven CRC engine supporting every width between 1 and 64 bits
+     *
+     * Internally all CRCs are calculated using the reflected algorithm with a 64 bit register. A CRC with a width of N bits
+     * and polynomial P behaves exactly like a 64 bit CRC with the polynomial P * x^(64 - N), so only the lowest N bits of the
+     * register are ever used. Because of this, the same slice-by-16 tables, carry-less multiplication folding constants and
+     * combine operation work for every width.
+     */
+    class Crc {
     public:
-        constexpr Crc(u64 polynomial, u64 init, u64 xorOut, bool reflectInput, bool reflectOutput)
-            :  m_init(init & ((0b10ull << (NumBits - 1)) - 1)), m_xorOut(xorOut & ((0b10ull << (NumBits - 1)) - 1)),
+        Crc(u32 width, u64 polynomial, u64 init, u64 xorOut, bool reflectInput, bool reflectOutput)
+            : m_width(std::clamp<u32>(width, 1, 64)), m_mask(u64(-1) >> (64 - m_width)),
+              m_init(init & m_mask), m_xorOut(xorOut & m_mask),
               m_reflectInput(reflectInput), m_reflectOutput(reflectOutput),
-              m_table([polynomial] {
-                auto reflectedPoly = reflect(polynomial & ((0b10ull << (NumBits - 1)) - 1), NumBits);
-                std::array<uint64_t, 256> table = { 0 };
-
-                for (uint32_t i = 0; i < 256; i++) {
-                    uint64_t c = i;
-                    for (std::size_t j = 0; j < 8; j++) {
-                        if (c & 0b1)
-                            c = reflectedPoly ^ (c >> 1);
-                        else
-                            c >>= 1;
-                    }
-                    table[i] = c;
+              m_reflectedPolynomial(reflect(polynomial & m_mask, m_width)) {
+
+            // Table k contains the register contribution of a byte that is followed by k zero bytes
+            for (u32 i = 0; i < 256; i++) {
+                u64 c = i;
+                for (std::size_t j = 0; j < 8; j++) {
+                    if (c & 0b1)
+                        c = m_reflectedPolynomial ^ (c >> 1);
+                    else
+                        c >>= 1;
                 }
+                m_tables[0][i] = c;
+            }
+
+            for (size_t k = 1; k < m_tables.size(); k++) {
+                for (u32 i = 0; i < 256; i++)
+                    m_tables[k][i] = (m_tables[k - 1][i] >> 8) ^ m_tables[0][m_tables[k - 1][i] & 0xFF];
+            }
+
+            // Folding constants x^(n - 1) mod P. The - 1 compensates for the product of two reflected
+            // 64 bit values ending up one bit lower than a reflected 128 bit value would
+            m_foldConstants = {
+                .fold128Low  = this->power(128 + 64 - 1),
+                .fold128High = this->power(128 - 1),
+                .fold512Low  = this->power(512 + 64 - 1),
+                .fold512High = this->power(512 - 1)
+            };
+        }
+
+        // Use reflected algorithm, so we reflect only if refin / refout is FALSE
+        [[nodiscard]] u64 initialValue() const {
+            return reflect(m_init, m_width);
+        }
+
+        [[nodiscard]] u64 finalize(u64 value) const {
+            if (m_reflectOutput)
+                return value ^ m_xorOut;
+            else
+                return reflect(value, m_width) ^ m_xorOut;
+        }
+
+        [[nodiscard]] u64 update(u64 value, const u8 *data, size_t size) const {
+            #if defined(CRC_FOLDING_AVAILABLE)
+                if (size >= 256 && isFoldingSupported())
+                    return this->updateFolded(value, data, size);
+            #endif
+
+            return this->updateSliced(value, data, size, !m_reflectInput);
+        }
 
-                return table;
-         }()) {
-            reset();
+        /**
+         * @brief Calculates the CRC register of the concatenation of two blocks of data
+         * @param first Register after processing the first block
+         * @param second Register after processing the second block, starting with a register of zero
+         * @param secondSize Size of the second block in bytes
+         */
+        [[nodiscard]] u64 combine(u64 first, u64 second, u64 secondSize) const {
+            return this->multiply(first, this->power(secondSize * 8)) ^ second;
         }
 
-        constexpr void reset() {
-            m_value = reflect(m_init, NumBits);
+    private:
+        u64 updateSliced(u64 value, const u8 *data, size_t size, bool reflectInput) const {
+            const auto &t = m_tables;
+
+            while (size >= 16) {
+                u64 low  = loadLittleEndian(data);
+                u64 high = loadLittleEndian(data + 8);
+                if (reflectInput) {
+                    low  = reflectBytes(low);
+                    high = reflectBytes(high);
+                }
+
+                low ^= value;
+                value = t[15][(low  >>  0) & 0xFF] ^ t[14][(low  >>  8) & 0xFF] ^ t[13][(low  >> 16) & 0xFF] ^ t[12][(low  >> 24) & 0xFF] ^
+                        t[11][(low  >> 32) & 0xFF] ^ t[10][(low  >> 40) & 0xFF] ^ t[ 9][(low  >> 48) & 0xFF] ^ t[ 8][(low  >> 56) & 0xFF] ^
+                        t[ 7][(high >>  0) & 0xFF] ^ t[ 6][(high >>  8) & 0xFF] ^ t[ 5][(high >> 16) & 0xFF] ^ t[ 4][(high >> 24) & 0xFF] ^
+                        t[ 3][(high >> 32) & 0xFF] ^ t[ 2][(high >> 40) & 0xFF] ^ t[ 1][(high >> 48) & 0xFF] ^ t[ 0][(high >> 56) & 0xFF];
+
+                data += 16;
+                size -= 16;
+            }
+
+            for (size_t i = 0; i < size; i++) {
+                const u8 byte = reflectInput ? reflect(data[i]) : data[i];
+                value = t[0][(value ^ byte) & 0xFF] ^ (value >> 8);
+            }
+
+            return value;
         }
 
-        constexpr void processBytes(const unsigned char *data, std::size_t size) {
-            for (std::size_t i = 0; i < size; i++) {
-                u8 byte;
-                if (m_reflectInput)
-                    byte = data[i];
-                else
-                    byte = reflect(data[i]);
+        /**
+         * @brief Multiplies two polynomials in reflected representation modulo the CRC polynomial
+         */
+        [[nodiscard]] u64 multiply(u64 a, u64 b) const {
+            if (a == 0)
+                return 0;
+
+            u64 mask = 1ULL << 63;
+            u64 product = 0;
+            while (true) {
+                if (a & mask) {
+                    product ^= b;
+                    if ((a & (mask - 1)) == 0)
+                        break;
+                }
 
-                m_value = m_table[(m_value ^ byte) & 0xFFL] ^ (m_value >> 8);
+                mask >>= 1;
+                b = (b & 0b1) ? (b >> 1) ^ m_reflectedPolynomial : b >> 1;
             }
+
+            return product;
         }
 
-        [[nodiscard]]
-        constexpr u64 checksum() const {
-            if (m_reflectOutput)
-                return m_value ^ m_xorOut;
-            else
-                return reflect(m_value, NumBits) ^ m_xorOut;
+        /**
+         * @brief Calculates x^exponent modulo the CRC polynomial in reflected representation
+         */
+        [[nodiscard]] u64 power(u64 exponent) const {
+            u64 result = 1ULL << 63;
+            u64 base   = 1ULL << 62;
+            while (exponent != 0) {
+                if (exponent & 0b1)
+                    result = this->multiply(result, base);
+
+                base = this->multiply(base, base);
+                exponent >>= 1;
+            }
+
+            return result;
         }
 
+        #if defined(CRC_FOLDING_AVAILABLE)
+            static bool isFoldingSupported() {
+                #if defined(CRC_FOLDING_X86)
+                    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+                    return supported;
+                #else
+                    return true;
+                #endif
+            }
+
+            /**
+             * @brief Processes data by folding 128 bit blocks using carry-less multiplication
+             * @note The folded remainder is 16 bytes that have the same CRC as all the data folded into it. It's then
+             * processed together with the trailing bytes using the regular table driven algorithm
+             */
+            CRC_FOLDING_TARGET u64 updateFolded(u64 value, const u8 *data, size_t size) const {
+                const auto constants128 = makeConstants(m_foldConstants.fold128Low, m_foldConstants.fold128High);
+                const auto constants512 = makeConstants(m_foldConstants.fold512Low, m_foldConstants.fold512High);
+
+                Block blocks[4];
+                for (size_t i = 0; i < std::size(blocks); i++)
+                    blocks[i] = this->loadBlock(data + i * 16);
+                blocks[0] = xorBlocks(blocks[0], makeConstants(value, 0));
+
+                data += 64;
+                size -= 64;
+
+                while (size >= 64) {
+                    for (size_t i = 0; i < std::size(blocks); i++)
+                        blocks[i] = xorBlocks(foldBlock(blocks[i], constants512), this->loadBlock(data + i * 16));
+
+                    data += 64;
+                    size -= 64;
+                }
+
+                auto block = blocks[0];
+                for (size_t i = 1; i < std::size(blocks); i++)
+                    block = xorBlocks(foldBlock(block, constants128), blocks[i]);
+
+                while (size >= 16) {
+                    block = xorBlocks(foldBlock(block, constants128), this->loadBlock(data));
+
+                    data += 16;
+                    size -= 16;
+                }
+
+                std::array<u8, 16> remainder;
+                storeBlock(remainder.data(), block);
+
+                value = this->updateSliced(0, remainder.data(), remainder.size(), false);
+                return this->updateSliced(value, data, size, !m_reflectInput);
+            }
+
+            #if defined(CRC_FOLDING_X86)
+                using Block = __m128i;
+
+                CRC_FOLDING_TARGET static Block makeConstants(u64 low, u64 high) {
+                    return _mm_set_epi64x(i64(high), i64(low));
+                }
+
+                CRC_FOLDING_TARGET static Block xorBlocks(Block a, Block b) {
+                    return _mm_xor_si128(a, b);
+                }
+
+                CRC_FOLDING_TARGET static Block foldBlock(Block block, Block constants) {
+                    return _mm_xor_si128(_mm_clmulepi64_si128(block, constants, 0x00), _mm_clmulepi64_si128(block, constants, 0x11));
+                }
+
+                CRC_FOLDING_TARGET Block loadBlock(const u8 *data) const {
+                    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                    if (!m_reflectInput) {
+                        const auto lowNibbles  = _mm_setr_epi8(0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E, 0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F);
+                        const auto highNibbles = _mm_slli_epi16(lowNibbles, 4);
+                        const auto mask = _mm_set1_epi8(0x0F);
+
+                        block = _mm_or_si128(
+                            _mm_shuffle_epi8(highNibbles, _mm_and_si128(block, mask)),
+                            _mm_shuffle_epi8(lowNibbles, _mm_and_si128(_mm_srli_epi16(block, 4), mask))
+                        );
+                    }
+
+                    return block;
+                }
+
+                CRC_FOLDING_TARGET static void storeBlock(u8 *data, Block block) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block);
+                }
+            #elif defined(CRC_FOLDING_ARM)
+                using Block = uint64x2_t;
+
+                static Block makeConstants(u64 low, u64 high) {
+                    return vcombine_u64(vcreate_u64(low), vcreate_u64(high));
+                }
+
+                static Block xorBlocks(Block a, Block b) {
+                    return veorq_u64(a, b);
+                }
+
+                static Block foldBlock(Block block, Block constants) {
+                    return veorq_u64(
+                        vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(block, 0), vgetq_lane_u64(constants, 0))),
+                        vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(block, 1), vgetq_lane_u64(constants, 1)))
+                    );
+                }
+
+                Block loadBlock(const u8 *data) const {
+                    auto block = vld1q_u8(data);
+                    if (!m_reflectInput)
+                        block = vrbitq_u8(block);
+
+                    return vreinterpretq_u64_u8(block);
+                }
+
+                static void storeBlock(u8 *data, Block block) {
+                    vst1q_u8(data, vreinterpretq_u8_u64(block));
+                }
+            #endif
+        #endif
+
     private:
-        u64 m_value = 0x00;
+        u32 m_width;
+        u64 m_mask;
 
         u64 m_init;
         u64 m_xorOut;
         bool m_reflectInput;
         bool m_reflectOutput;
 
-        std::array<uint64_t, 256> m_table;
+        u64 m_reflectedPolynomial;
+        std::array<std::array<u64, 256>, 16> m_tables = { };
+
+        struct FoldConstants {
+            u64 fold128Low, fold128High;
+            u64 fold512Low, fold512High;
+        } m_foldConstants = { };
     };
 
-    template<size_t NumBits>
-    auto calcCrc(prv::Provider *data, u64 offset, std::size_t size, u32 polynomial, u32 init, u32 xorout, bool reflectIn, bool reflectOut) {
-        using Crc = Crc<NumBits>;
-        Crc crc(polynomial, init, xorout, reflectIn, reflectOut);
+    u64 calcCrc(prv::Provider *data, u64 offset, std::size_t size, u32 width, u64 polynomial, u64 init, u64 xorOut, bool reflectIn, bool reflectOut) {
+        const Crc crc(width, polynomial, init, xorOut, reflectIn, reflectOut);
+
+        // Providers aren't necessarily safe to read from multiple threads at once, so the data is read sequentially
+        // in large batches of chunks. The CRC of each chunk is then calculated in parallel and combined afterward
+        const auto threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 16);
+        const auto chunkCount  = std::clamp<size_t>((size + ChunkSize - 1) / ChunkSize, 1, threadCount);
+        std::vector<std::vector<u8>> buffers(chunkCount, std::vector<u8>(std::min(ChunkSize, size)));
+        std::vector<u64> chunkValues(chunkCount);
+        std::vector<size_t> chunkSizes(chunkCount);
+
+        u64 value = crc.initialValue();
+        for (size_t processed = 0; processed < size;) {
+            size_t batchSize = 0;
+            for (; batchSize < chunkCount && processed < size; batchSize++) {
+                chunkSizes[batchSize] = std::min(ChunkSize, size - processed);
+                data->read(offset + processed, buffers[batchSize].data(), chunkSizes[batchSize]);
+                processed += chunkSizes[batchSize];
+            }
+
+            if (batchSize == 1) {
+                value = crc.update(value, buffers[0].data(), chunkSizes[0]);
+                continue;
+            }
+
+            {
+                std::vector<std::jthread> workers;
+                for (size_t i = 1; i < batchSize; i++) {
+                    workers.emplace_back([&, i] {
+                        chunkValues[i] = crc.update(0, buffers[i].data(), chunkSizes[i]);
+                    });
+                }
+
+                chunkValues[0] = crc.update(value, buffers[0].data(), chunkSizes[0]);
+            }
 
-        processDataByChunks(data, offset, size, [&crc](auto && data, auto && size) { crc.processBytes(data, size); });
+            value = chunkValues[0];
+            for (size_t i = 1; i < batchSize; i++)
+                value = crc.combine(value, chunkValues[i], chunkSizes[i]);
+        }
 
-        return crc.checksum();
+        return crc.finalize(value);
     }
 
     u8 crc8(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut) {
-        return calcCrc<8>(data, offset, size, polynomial, init, xorOut, reflectIn, reflectOut);
+        return calcCrc(data, offset, size, 8, polynomial, init, xorOut, reflectIn, reflectOut);
     }
 
     u16 crc16(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut) {
-        return calcCrc<16>(data, offset, size, polynomial, init, xorOut, reflectIn, reflectOut);
+        return calcCrc(data, offset, size, 16, polynomial, init, xorOut, reflectIn, reflectOut);
     }
 
     u32 crc32(prv::Provider *&data, u64 offset, size_t size, u32 polynomial, u32 init, u32 xorOut, bool reflectIn, bool reflectOut) {
-        return calcCrc<32>(data, offset, size, polynomial, init, xorOut, reflectIn, reflectOut);
+        return calcCrc(data, offset, size, 32, polynomial, init, xorOut, reflectIn, reflectOut);
+    }
+
+    u64 crc(prv::Provider *&data, u64 offset, size_t size, u32 width, u64 polynomial, u64 init, u64 xorOut, bool reflectIn, bool reflectOut) {
+        return calcCrc(data, offset, size, width, polynomial, init, xorOut, reflectIn, reflectOut);
     }
 
 
@@ -353,6 +647,95 @@ namespace hex::crypt {
         return result;
     }
 
+    namespace {
+
+        struct DigestState {
+            std::function<void(const u8 *, size_t)> update;
+            std::function<std::vector<u8>()> finish;
+        };
+
+        template<typename Context>
+        DigestState createDigestState(size_t digestSize, void (*initialize)(Context *), void (*destroy)(Context *), auto starts, auto update, auto finish) {
+            auto context = std::shared_ptr<Context>(new Context(), [destroy](Context *context) {
+                destroy(context);
+                delete context;
+            });
+
+            initialize(context.get());
+            starts(context.get());
+
+            return {
+                [context, update](const u8 *data, size_t size) { update(context.get(), data, size); },
+                [context, finish, digestSize] {
+                    std::vector<u8> result(digestSize);
+                    finish(context.get(), result.data());
+
+                    return result;
+                }
+            };
+        }
+
+    }
+
+    std::vector<std::vector<u8>> digests(prv::Provider *&data, u64 offset, size_t size, std::span<const Digest> algorithms, const std::function<void(u64)> &progress) {
+        std::vector<DigestState> states;
+        states.reserve(algorithms.size());
+
+        for (const auto algorithm : algorithms) {
+            switch (algorithm) {
+                case Digest::MD5:
+                    states.push_back(createDigestState<mbedtls_md5_context>(16, mbedtls_md5_init, mbedtls_md5_free, mbedtls_md5_starts, mbedtls_md5_update, mbedtls_md5_finish));
+                    break;
+                case Digest::SHA1:
+                    states.push_back(createDigestState<mbedtls_sha1_context>(20, mbedtls_sha1_init, mbedtls_sha1_free, mbedtls_sha1_starts, mbedtls_sha1_update, mbedtls_sha1_finish));
+                    break;
+                case Digest::SHA224:
+                    states.push_back(createDigestState<mbedtls_sha256_context>(28, mbedtls_sha256_init, mbedtls_sha256_free, [](auto *ctx) { return mbedtls_sha256_starts(ctx, true); }, mbedtls_sha256_update, mbedtls_sha256_finish));
+                    break;
+                case Digest::SHA256:
+                    states.push_back(createDigestState<mbedtls_sha256_context>(32, mbedtls_sha256_init, mbedtls_sha256_free, [](auto *ctx) { return mbedtls_sha256_starts(ctx, false); }, mbedtls_sha256_update, mbedtls_sha256_finish));
+                    break;
+                case Digest::SHA384:
+                    states.push_back(createDigestState<mbedtls_sha512_context>(48, mbedtls_sha512_init, mbedtls_sha512_free, [](auto *ctx) { return mbedtls_sha512_starts(ctx, true); }, mbedtls_sha512_update, mbedtls_sha512_finish));
+                    break;
+                case Digest::SHA512:
+                    states.push_back(createDigestState<mbedtls_sha512_context>(64, mbedtls_sha512_init, mbedtls_sha512_free, [](auto *ctx) { return mbedtls_sha512_starts(ctx, false); }, mbedtls_sha512_update, mbedtls_sha512_finish));
+                    break;
+                case Digest::CRC32: {
+                    auto crc   = std::make_shared<const Crc>(32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+                    auto value = std::make_shared<u64>(crc->initialValue());
+
+                    states.push_back({
+                        [crc, value](const u8 *data, size_t size) { *value = crc->update(*value, data, size); },
+                        [crc, value] {
+                            const auto result = u32(crc->finalize(*value));
+                            return std::vector<u8> { u8(result >> 24), u8(result >> 16), u8(result >> 8), u8(result) };
+                        }
+                    });
+                    break;
+                }
+            }
+        }
+
+        // Every chunk is fed to all algorithms before the next one is read
+        u64 processed = 0;
+        processDataByChunks(data, offset, size, [&](auto && data, auto && size) {
+            for (const auto &state : states)
+                state.update(data, size);
+
+            processed += size;
+            if (progress)
+                progress(processed);
+        });
+
+        std::vector<std::vector<u8>> result;
+        result.reserve(states.size());
+        for (const auto &state : states)
+            result.push_back(state.finish());
+
+        return result;
+    }
+
 
     std::vector<u8> decode64(const std::vector<u8> &input) {
 
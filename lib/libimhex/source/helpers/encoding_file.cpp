@@ -2,7 +2,8 @@
 
 #include <hex/helpers/utils.hpp>
 
-#include <ranges>
+#include <algorithm>
+#include <map>
 #include <wolv/io/file.hpp>
 #include <wolv/utils/string.hpp>
 
@@ -17,27 +18,12 @@ namespace hex {
 
     }
 
-    EncodingFile::EncodingFile() : m_mapping(std::make_unique<std::map<size_t, std::map<std::vector<u8>, std::string>>>()) {
+    EncodingFile::EncodingFile() : m_trieNodes(1) {
 
     }
 
-    EncodingFile::EncodingFile(const hex::EncodingFile &other) {
-        m_mapping = std::make_unique<std::map<size_t, std::map<std::vector<u8>, std::string>>>(*other.m_mapping);
-        m_tableContent = other.m_tableContent;
-        m_longestSequence = other.m_longestSequence;
-        m_shortestSequence = other.m_shortestSequence;
-        m_valid = other.m_valid;
-        m_name = other.m_name;
-    }
-
-    EncodingFile::EncodingFile(EncodingFile &&other) noexcept {
-        m_mapping = std::move(other.m_mapping);
-        m_tableContent = std::move(other.m_tableContent);
-        m_longestSequence = other.m_longestSequence;
-        m_shortestSequence = other.m_shortestSequence;
-        m_valid = other.m_valid;
-        m_name = std::move(other.m_name);
-    }
+    EncodingFile::EncodingFile(const hex::EncodingFile &other) = default;
+    EncodingFile::EncodingFile(EncodingFile &&other) noexcept = default;
 
     EncodingFile::EncodingFile(Type type, const std::fs::path &path) : EncodingFile() {
         auto file = wolv::io::File(path, wolv::io::File::Mode::Read);
@@ -74,59 +60,52 @@ namespace hex {
     }
 
 
-    EncodingFile &EncodingFile::operator=(const hex::EncodingFile &other) {
-        if(this == &other) {
-            return *this;
-        }
-        m_mapping = std::make_unique<std::map<size_t, std::map<std::vector<u8>, std::string>>>(*other.m_mapping);
-        m_tableContent = other.m_tableContent;
-        m_longestSequence = other.m_longestSequence;
-        m_shortestSequence = other.m_shortestSequence;
-        m_valid = other.m_valid;
-        m_name = other.m_name;
-
-        return *this;
-    }
+    EncodingFile &EncodingFile::operator=(const hex::EncodingFile &other) = default;
+    EncodingFile &EncodingFile::operator=(EncodingFile &&other) noexcept = default;
 
-    EncodingFile &EncodingFile::operator=(EncodingFile &&other) noexcept {
-        m_mapping = std::move(other.m_mapping);
-        m_tableContent = std::move(other.m_tableContent);
-        m_longestSequence = other.m_longestSequence;
-        m_shortestSequence = other.m_shortestSequence;
-        m_valid = other.m_valid;
-        m_name = std::move(other.m_name);
 
-        return *this;
-    }
+    std::pair<u32, size_t> EncodingFile::findLongestMatch(std::span<const u8> buffer) const {
+        if (m_trieNodes.empty())
+            return { NoValue, 0 };
 
+        // Walk down the trie as far as the buffer allows and remember the deepest node that completes a mapping
+        std::pair<u32, size_t> result = { NoValue, 0 };
+        u32 nodeIndex = 0;
+        for (size_t i = 0; i < buffer.size(); i += 1) {
+            const auto &node = m_trieNodes[nodeIndex];
 
+            const u32 childIndex = u32(buffer[i]) - node.firstByte;
+            if (childIndex >= node.childCount)
+                break;
 
-    std::pair<std::string_view, size_t> EncodingFile::getEncodingFor(std::span<const u8> buffer) const {
-        for (const auto &[size, mapping] : std::ranges::reverse_view(*m_mapping)) {
-            if (size > buffer.size()) continue;
+            nodeIndex = m_trieChildren[node.childrenOffset + childIndex];
+            if (nodeIndex == 0)
+                break;
 
-            std::vector key(buffer.begin(), buffer.begin() + size);
-            if (mapping.contains(key))
-                return { mapping.at(key), size };
+            if (const auto value = m_trieNodes[nodeIndex].value; value != NoValue)
+                result = { value, i + 1 };
         }
 
+        return result;
+    }
+
+    std::pair<std::string_view, size_t> EncodingFile::getEncodingFor(std::span<const u8> buffer) const {
+        if (const auto [value, size] = findLongestMatch(buffer); value != NoValue)
+            return { m_values[value], size };
+
         return { ".", 1 };
     }
 
     u64 EncodingFile::getEncodingLengthFor(std::span<u8> buffer) const {
-        for (const auto& [size, mapping] : std::ranges::reverse_view(*m_mapping)) {
-            if (size > buffer.size()) continue;
-
-            std::vector key(buffer.begin(), buffer.begin() + size);
-            if (mapping.contains(key))
-                return size;
-        }
+        if (const auto [value, size] = findLongestMatch(buffer); value != NoValue)
+            return size;
 
         return 1;
     }
 
     std::string EncodingFile::decodeAll(std::span<const u8> buffer) const {
         std::string result;
+        result.reserve(buffer.size());
 
         while (!buffer.empty()) {
             const auto [character, size] = getEncodingFor(buffer);
@@ -137,9 +116,47 @@ namespace hex {
         return result;
     }
 
+    u32 EncodingFile::buildTrie(std::span<const std::pair<std::vector<u8>, std::string>> entries, size_t depth) {
+        const auto nodeIndex = u32(m_trieNodes.size());
+        m_trieNodes.emplace_back();
+
+        // Entries are sorted, so a mapping ending at this node always comes before all longer ones sharing its prefix
+        if (!entries.empty() && entries.front().first.size() == depth) {
+            m_trieNodes[nodeIndex].value = u32(m_values.size());
+            m_values.push_back(entries.front().second);
+            entries = entries.subspan(1);
+        }
+
+        if (entries.empty())
+            return nodeIndex;
+
+        const u8 firstByte = entries.front().first[depth];
+        const u8 lastByte  = entries.back().first[depth];
+        const auto childrenOffset = u32(m_trieChildren.size());
+        m_trieChildren.resize(childrenOffset + (lastByte - firstByte) + 1, 0);
+
+        m_trieNodes[nodeIndex].childrenOffset = childrenOffset;
+        m_trieNodes[nodeIndex].childCount     = u16((lastByte - firstByte) + 1);
+        m_trieNodes[nodeIndex].firstByte      = firstByte;
+
+        while (!entries.empty()) {
+            const u8 byte = entries.front().first[depth];
+            const auto groupEnd = std::ranges::find_if(entries, [&](const auto &entry) { return entry.first[depth] != byte; });
+            const auto groupSize = size_t(groupEnd - entries.begin());
+
+            const auto childIndex = buildTrie(entries.subspan(0, groupSize), depth + 1);
+            m_trieChildren[childrenOffset + (byte - firstByte)] = childIndex;
+
+            entries = entries.subspan(groupSize);
+        }
+
+        return nodeIndex;
+    }
 
     void EncodingFile::parse(const std::string &content) {
         m_tableContent = content;
+
+        std::map<std::vector<u8>, std::string> mappings;
         for (const auto &line : wolv::util::splitString(m_tableContent, "\n")) {
 
             std::string from, to;
@@ -163,15 +180,19 @@ namespace hex {
             if (to.empty())
                 to = " ";
 
-            if (!m_mapping->contains(fromBytes.size()))
-                m_mapping->insert({ fromBytes.size(), {} });
-
             u64 keySize = fromBytes.size();
-            (*m_mapping)[keySize].insert({ std::move(fromBytes), to });
+            mappings.insert({ std::move(fromBytes), to });
 
             m_longestSequence = std::max(m_longestSequence, keySize);
             m_shortestSequence = std::min(m_shortestSequence, keySize);
         }
+
+        // Compile all mappings into a trie so looking up the longest matching sequence needs no allocations
+        const std::vector<std::pair<std::vector<u8>, std::string>> entries(mappings.begin(), mappings.end());
+        m_trieNodes.clear();
+        m_trieChildren.clear();
+        m_values.clear();
+        buildTrie(entries, 0);
     }
 
 }
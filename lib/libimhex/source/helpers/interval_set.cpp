@@ -0,0 +1,143 @@
+#include <hex/helpers/interval_set.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace hex {
+
+    void IntervalSet::insert(const Region &region) {
+        if (region.getSize() == 0)
+            return;
+
+        u64 start = region.getStartAddress();
+        u64 end   = region.getEndAddress();
+
+        auto it = m_intervals.upper_bound(start);
+
+        // Merge with the previous interval if it overlaps or directly touches the new one
+        if (it != m_intervals.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second >= start || prev->second + 1 == start) {
+                start = prev->first;
+                end   = std::max(end, prev->second);
+                it    = m_intervals.erase(prev);
+            }
+        }
+
+        // Swallow all following intervals that start inside of or directly after the new one
+        while (it != m_intervals.end() && (end == std::numeric_limits<u64>::max() || it->first <= end + 1)) {
+            end = std::max(end, it->second);
+            it  = m_intervals.erase(it);
+        }
+
+        m_intervals.emplace_hint(it, start, end);
+    }
+
+    void IntervalSet::erase(const Region &region) {
+        if (region.getSize() == 0)
+            return;
+
+        const u64 start = region.getStartAddress();
+        const u64 end   = region.getEndAddress();
+
+        auto it = m_intervals.upper_bound(start);
+        if (it != m_intervals.begin())
+            it = std::prev(it);
+
+        while (it != m_intervals.end() && it->first <= end) {
+            if (it->second < start) {
+                ++it;
+                continue;
+            }
+
+            const auto [intervalStart, intervalEnd] = *it;
+            it = m_intervals.erase(it);
+
+            if (intervalStart < start)
+                m_intervals.emplace_hint(it, intervalStart, start - 1);
+
+            if (intervalEnd > end) {
+                m_intervals.emplace_hint(it, end + 1, intervalEnd);
+                break;
+            }
+        }
+    }
+
+    bool IntervalSet::contains(u64 address) const {
+        return this->find(address).has_value();
+    }
+
+    bool IntervalSet::overlaps(const Region &region) const {
+        if (region.getSize() == 0)
+            return false;
+
+        const auto next = this->findNext(region.getStartAddress());
+        return next.has_value() && next->getStartAddress() <= region.getEndAddress();
+    }
+
+    std::optional<Region> IntervalSet::find(u64 address) const {
+        auto it = m_intervals.upper_bound(address);
+        if (it == m_intervals.begin())
+            return std::nullopt;
+
+        it = std::prev(it);
+        if (it->second < address)
+            return std::nullopt;
+
+        return Region { .address=it->first, .size=(it->second - it->first) + 1 };
+    }
+
+    std::optional<Region> IntervalSet::findNext(u64 address) const {
+        if (auto containing = this->find(address); containing.has_value())
+            return containing;
+
+        auto it = m_intervals.upper_bound(address);
+        if (it == m_intervals.end())
+            return std::nullopt;
+
+        return Region { .address=it->first, .size=(it->second - it->first) + 1 };
+    }
+
+    std::vector<Region> IntervalSet::getOverlapping(const Region &region) const {
+        std::vector<Region> result;
+        if (region.getSize() == 0)
+            return result;
+
+        const u64 start = region.getStartAddress();
+        const u64 end   = region.getEndAddress();
+
+        auto it = m_intervals.upper_bound(start);
+        if (it != m_intervals.begin())
+            it = std::prev(it);
+
+        for (; it != m_intervals.end() && it->first <= end; ++it) {
+            if (it->second < start)
+                continue;
+
+            const auto clippedStart = std::max(start, it->first);
+            const auto clippedEnd   = std::min(end, it->second);
+            result.push_back({ .address=clippedStart, .size=(clippedEnd - clippedStart) + 1 });
+        }
+
+        return result;
+    }
+
+    std::vector<Region> IntervalSet::getIntervals() const {
+        std::vector<Region> result;
+        result.reserve(m_intervals.size());
+
+        for (const auto &[start, end] : m_intervals)
+            result.push_back({ .address=start, .size=(end - start) + 1 });
+
+        return result;
+    }
+
+    u64 IntervalSet::getTotalSize() const {
+        u64 result = 0;
+        for (const auto &[start, end] : m_intervals)
+            result += (end - start) + 1;
+
+        return result;
+    }
+
+}
@@ -5,11 +5,15 @@
 
 #include <hex/providers/provider.hpp>
 
+#include <wolv/literals.hpp>
+
 #include <cstring>
 
 
 namespace hex {
 
+    using namespace wolv::literals;
+
     namespace {
 
         class PatchesGenerator : public hex::prv::Provider {
@@ -35,7 +39,7 @@ namespace hex {
 
             void writeRaw(u64 offset, const void *buffer, size_t size) override {
                 for (u64 i = 0; i < size; i += 1)
-                    m_patches[offset] = static_cast<const u8*>(buffer)[i];
+                    m_patches[offset + i] = static_cast<const u8*>(buffer)[i];
             }
 
             [[nodiscard]] u64 getActualSize() const override {
@@ -211,6 +215,24 @@ namespace hex {
 
         generator.getUndoStack().apply(provider->getUndoStack());
 
+        // Replaying the operations only leaves the lazy overlays behind without their data. The bytes they cover are
+        // taken from the provider instead, which has gone through the same operations
+        std::vector<u8> buffer;
+        for (const auto &overlay : *generator.getLazyOverlays()) {
+            const auto &region = overlay.getRegion();
+            if (region.getEndAddress() > 0xFFFF'FFFF)
+                return wolv::util::Unexpected(IPSError::PatchTooLarge);
+
+            buffer.resize(std::min<u64>(region.getSize(), 1_MiB));
+            for (u64 offset = 0; offset < region.getSize(); offset += buffer.size()) {
+                const auto chunkSize = std::min<u64>(buffer.size(), region.getSize() - offset);
+                const auto address   = region.getStartAddress() + offset;
+
+                provider->read(provider->getBaseAddress() + address, buffer.data(), chunkSize, false);
+                generator.writeRaw(address, buffer.data(), chunkSize);
+            }
+        }
+
         if (generator.getActualSize() > 0xFFFF'FFFF)
             return wolv::util::Unexpected(IPSError::PatchTooLarge);
 
@@ -0,0 +1,178 @@
+#include <hex/helpers/profiler.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/helpers/fmt.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace hex::prof {
+
+    namespace impl {
+
+        std::atomic<bool> s_enabled = false;
+
+        u64 getTimestamp() {
+            static const auto epoch = std::chrono::steady_clock::now();
+
+            // Offset by one so a valid timestamp is never zero
+            return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count()) + 1;
+        }
+
+    }
+
+    namespace {
+
+        // Events shorter than this only count towards the statistics. Otherwise per-byte callbacks and small reads
+        // would push everything else out of the trace buffer
+        constexpr static u64 TraceThresholdNanoseconds = 10'000;
+        constexpr static size_t MaxTraceEvents = 100'000;
+
+        using StatisticsKey = std::tuple<Category, std::string, u64>;
+
+        std::mutex s_mutex;
+        std::map<StatisticsKey, Statistics, std::less<>> s_statistics;
+
+        std::vector<TraceEvent> s_traceEvents;
+        size_t s_nextTraceEvent = 0;
+
+        std::atomic<u32> s_nextThreadId = 1;
+        std::map<u32, std::string> s_threadNames;
+
+        u32 getThreadId() {
+            thread_local u32 threadId = 0;
+            if (threadId == 0) {
+                threadId = s_nextThreadId++;
+                s_threadNames[threadId] = TaskManager::isMainThread() ? "Main Thread" : fmt::format("Thread {}", threadId);
+            }
+
+            return threadId;
+        }
+
+    }
+
+    void setEnabled(bool enabled) {
+        impl::s_enabled = enabled;
+    }
+
+    void record(Category category, std::string_view name, u64 id, u64 startNanoseconds, u64 durationNanoseconds, u64 bytes) {
+        std::scoped_lock lock(s_mutex);
+
+        auto it = s_statistics.find(std::tuple(category, name, id));
+        if (it == s_statistics.end())
+            it = s_statistics.emplace(StatisticsKey(category, name, id), Statistics { .category = category, .name = std::string(name), .id = id }).first;
+
+        auto &statistics = it->second;
+        statistics.count += 1;
+        statistics.bytes += bytes;
+        statistics.totalNanoseconds += durationNanoseconds;
+        statistics.maxNanoseconds = std::max(statistics.maxNanoseconds, durationNanoseconds);
+        statistics.samples[statistics.sampleCount % Statistics::SampleCount] = float(durationNanoseconds) / 1000.0F;
+        statistics.sampleCount += 1;
+
+        if (durationNanoseconds < TraceThresholdNanoseconds)
+            return;
+
+        TraceEvent event = {
+            .category = category,
+            .name = std::string(name),
+            .id = id,
+            .startNanoseconds = startNanoseconds,
+            .durationNanoseconds = durationNanoseconds,
+            .bytes = bytes,
+            // Waiting tasks don't run on any thread yet, they all get a track of their own
+            .threadId = category == Category::TaskWait ? 0 : getThreadId()
+        };
+
+        // Keep the most recent events, overwriting the oldest ones once the buffer is full
+        if (s_traceEvents.size() < MaxTraceEvents)
+            s_traceEvents.push_back(std::move(event));
+        else
+            s_traceEvents[s_nextTraceEvent] = std::move(event);
+        s_nextTraceEvent = (s_nextTraceEvent + 1) % MaxTraceEvents;
+    }
+
+    std::vector<Statistics> getStatistics() {
+        std::scoped_lock lock(s_mutex);
+
+        std::vector<Statistics> result;
+        result.reserve(s_statistics.size());
+        for (const auto &[key, statistics] : s_statistics)
+            result.push_back(statistics);
+
+        return result;
+    }
+
+    void reset() {
+        std::scoped_lock lock(s_mutex);
+
+        s_statistics.clear();
+        s_traceEvents.clear();
+        s_nextTraceEvent = 0;
+    }
+
+    std::string exportChromeTrace() {
+        std::scoped_lock lock(s_mutex);
+
+        auto events = nlohmann::json::array();
+
+        auto threadNames = s_threadNames;
+        threadNames[0] = "Task Queue";
+        for (const auto &[threadId, name] : threadNames) {
+            events.push_back({
+                { "name", "thread_name" },
+                { "ph",   "M" },
+                { "pid",  1 },
+                { "tid",  threadId },
+                { "args", { { "name", name } } }
+            });
+        }
+
+        // Once the buffer wrapped around, the oldest event is the one that would be overwritten next
+        const auto firstEvent = s_traceEvents.size() < MaxTraceEvents ? 0 : s_nextTraceEvent;
+        for (size_t i = 0; i < s_traceEvents.size(); i += 1) {
+            const auto &event = s_traceEvents[(firstEvent + i) % s_traceEvents.size()];
+
+            nlohmann::json args = { { "id", event.id } };
+            if (event.bytes != 0)
+                args["bytes"] = event.bytes;
+
+            events.push_back({
+                { "name", event.id != 0 ? fmt::format("{} #{}", event.name, event.id) : event.name },
+                { "cat",  getCategoryName(event.category) },
+                { "ph",   "X" },
+                { "ts",   double(event.startNanoseconds) / 1000.0 },
+                { "dur",  double(event.durationNanoseconds) / 1000.0 },
+                { "pid",  1 },
+                { "tid",  event.threadId },
+                { "args", std::move(args) }
+            });
+        }
+
+        return nlohmann::json({
+            { "traceEvents", std::move(events) },
+            { "displayTimeUnit", "ms" }
+        }).dump();
+    }
+
+    std::string_view getCategoryName(Category category) {
+        switch (category) {
+            using enum Category;
+            case View:            return "View";
+            case Highlighting:    return "Highlighting";
+            case Tooltip:         return "Tooltip";
+            case MiniMap:         return "MiniMap";
+            case ProviderRead:    return "ProviderRead";
+            case ProviderReadRaw: return "ProviderReadRaw";
+            case TaskWait:        return "TaskWait";
+            case TaskRun:         return "TaskRun";
+        }
+
+        return "Unknown";
+    }
+
+}
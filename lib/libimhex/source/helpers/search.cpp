@@ -0,0 +1,433 @@
+#include <hex/helpers/search.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/providers/parallel_scanner.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <functional>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+
+    #define SEQUENCE_SEARCH_VECTORIZED
+    #define SEQUENCE_SEARCH_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace hex {
+
+    namespace {
+
+        // Sequences up to this length are found using the first and last byte filter, longer ones using Horspool
+        constexpr static size_t MaxShortSequenceSize = 32;
+
+        #if defined(SEQUENCE_SEARCH_VECTORIZED)
+
+            bool isVectorizationSupported() {
+                static const bool supported = __builtin_cpu_supports("avx2");
+                return supported;
+            }
+
+            /**
+             * @brief Finds positions whose first and last byte match those of the sequence, 32 positions at a time
+             * @details Every byte is compared against two values so letters can match both in upper and lower case
+             * @return Offset of the first candidate at which isMatch returned true, or the offset scanning stopped at
+             * if there were less than 32 positions left
+             */
+            SEQUENCE_SEARCH_TARGET std::pair<size_t, bool> findCandidatesVectorized(const u8 *data, size_t offset, size_t endOffset, size_t lastOffset, const std::array<u8, 4> &bytes, auto &&isMatch) {
+                const auto first0 = _mm256_set1_epi8(char(bytes[0]));
+                const auto first1 = _mm256_set1_epi8(char(bytes[1]));
+                const auto last0  = _mm256_set1_epi8(char(bytes[2]));
+                const auto last1  = _mm256_set1_epi8(char(bytes[3]));
+
+                for (; offset + 32 <= endOffset; offset += 32) {
+                    const auto firstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                    const auto lastBlock  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + lastOffset));
+
+                    const auto firstMatches = _mm256_or_si256(_mm256_cmpeq_epi8(firstBlock, first0), _mm256_cmpeq_epi8(firstBlock, first1));
+                    const auto lastMatches  = _mm256_or_si256(_mm256_cmpeq_epi8(lastBlock, last0), _mm256_cmpeq_epi8(lastBlock, last1));
+
+                    auto candidates = u32(_mm256_movemask_epi8(_mm256_and_si256(firstMatches, lastMatches)));
+                    while (candidates != 0) {
+                        const auto candidate = offset + std::countr_zero(candidates);
+                        if (isMatch(candidate))
+                            return { candidate, true };
+
+                        candidates &= candidates - 1;
+                    }
+                }
+
+                return { offset, false };
+            }
+
+            /**
+             * @brief Finds positions at which two masked bytes of a pattern match, 32 positions at a time
+             * @return Offset of the first candidate at which isMatch returned true, or the offset scanning stopped at
+             * if there were less than 32 positions left
+             */
+            SEQUENCE_SEARCH_TARGET std::pair<size_t, bool> findMaskedCandidatesVectorized(const u8 *data, size_t offset, size_t endOffset, const std::array<size_t, 2> &offsets, const std::array<BinaryPattern::Pattern, 2> &patterns, auto &&isMatch) {
+                const auto mask0  = _mm256_set1_epi8(char(patterns[0].mask));
+                const auto value0 = _mm256_set1_epi8(char(patterns[0].value));
+                const auto mask1  = _mm256_set1_epi8(char(patterns[1].mask));
+                const auto value1 = _mm256_set1_epi8(char(patterns[1].value));
+
+                for (; offset + 32 <= endOffset; offset += 32) {
+                    const auto block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + offsets[0]));
+                    const auto block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + offsets[1]));
+
+                    const auto matches0 = _mm256_cmpeq_epi8(_mm256_and_si256(block0, mask0), value0);
+                    const auto matches1 = _mm256_cmpeq_epi8(_mm256_and_si256(block1, mask1), value1);
+
+                    auto candidates = u32(_mm256_movemask_epi8(_mm256_and_si256(matches0, matches1)));
+                    while (candidates != 0) {
+                        const auto candidate = offset + std::countr_zero(candidates);
+                        if (isMatch(candidate))
+                            return { candidate, true };
+
+                        candidates &= candidates - 1;
+                    }
+                }
+
+                return { offset, false };
+            }
+
+        #endif
+
+        // Rough estimate of how unlikely it is to find a byte in typical binary data
+        constexpr u32 getByteRarity(u8 byte) {
+            if (byte == 0x00 || byte == 0xFF)
+                return 1;
+            else if (byte >= 0x20 && byte <= 0x7E)
+                return 3;
+            else
+                return 4;
+        }
+
+    }
+
+    SequenceSearcher::SequenceSearcher(std::span<const u8> sequence, bool ignoreCase) : m_sequence(sequence.begin(), sequence.end()), m_ignoreCase(ignoreCase) {
+        for (u32 byte = 0; byte < 256; byte += 1)
+            m_foldTable[byte] = ignoreCase && std::isupper(int(byte)) ? u8(std::tolower(int(byte))) : u8(byte);
+
+        for (auto &byte : m_sequence)
+            byte = m_foldTable[byte];
+
+        // Horspool shift table: how far the sequence may be moved ahead depending on the byte below its last position
+        std::ranges::fill(m_shiftTable, std::max<size_t>(m_sequence.size(), 1));
+        for (size_t i = 0; i + 1 < m_sequence.size(); i += 1)
+            m_shiftTable[m_sequence[i]] = m_sequence.size() - 1 - i;
+    }
+
+    bool SequenceSearcher::matchesAt(const u8 *data) const {
+        if (!m_ignoreCase)
+            return std::memcmp(data, m_sequence.data(), m_sequence.size()) == 0;
+
+        for (size_t i = 0; i < m_sequence.size(); i += 1) {
+            if (m_foldTable[data[i]] != m_sequence[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    std::optional<size_t> SequenceSearcher::findFirst(std::span<const u8> data, size_t offset) const {
+        if (m_sequence.empty() || data.size() < m_sequence.size() || offset > data.size() - m_sequence.size())
+            return std::nullopt;
+
+        if (m_sequence.size() <= MaxShortSequenceSize)
+            return this->findFirstShort(data, offset);
+        else
+            return this->findFirstHorspool(data, offset);
+    }
+
+    std::optional<size_t> SequenceSearcher::findLast(std::span<const u8> data) const {
+        std::optional<size_t> result;
+        for (auto offset = this->findFirst(data); offset.has_value(); offset = this->findFirst(data, *offset + 1))
+            result = offset;
+
+        return result;
+    }
+
+    std::optional<size_t> SequenceSearcher::findFirstShort(std::span<const u8> data, size_t offset) const {
+        const auto lastOffset = m_sequence.size() - 1;
+        const auto endOffset  = data.size() - lastOffset;
+
+        const auto first = m_sequence.front();
+        const auto last  = m_sequence.back();
+
+        #if defined(SEQUENCE_SEARCH_VECTORIZED)
+            if (isVectorizationSupported()) {
+                const auto otherCase = [this](u8 byte) { return m_ignoreCase ? u8(std::toupper(byte)) : byte; };
+                const std::array<u8, 4> bytes = { first, otherCase(first), last, otherCase(last) };
+
+                const auto [stopOffset, found] = findCandidatesVectorized(data.data(), offset, endOffset, lastOffset, bytes, [&](size_t candidate) {
+                    return this->matchesAt(data.data() + candidate);
+                });
+
+                if (found)
+                    return stopOffset;
+                offset = stopOffset;
+            }
+        #endif
+
+        if (!m_ignoreCase) {
+            while (offset < endOffset) {
+                const auto candidate = static_cast<const u8*>(std::memchr(data.data() + offset, first, endOffset - offset));
+                if (candidate == nullptr)
+                    break;
+
+                offset = candidate - data.data();
+                if (candidate[lastOffset] == last && this->matchesAt(candidate))
+                    return offset;
+
+                offset += 1;
+            }
+        } else {
+            for (; offset < endOffset; offset += 1) {
+                if (m_foldTable[data[offset]] == first && m_foldTable[data[offset + lastOffset]] == last && this->matchesAt(data.data() + offset))
+                    return offset;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<size_t> SequenceSearcher::findFirstHorspool(std::span<const u8> data, size_t offset) const {
+        const auto lastOffset = m_sequence.size() - 1;
+        const auto last = m_sequence.back();
+
+        while (offset + m_sequence.size() <= data.size()) {
+            const auto byte = m_foldTable[data[offset + lastOffset]];
+            if (byte == last && this->matchesAt(data.data() + offset))
+                return offset;
+
+            offset += m_shiftTable[byte];
+        }
+
+        return std::nullopt;
+    }
+
+    std::vector<u64> SequenceSearcher::findAll(Task &task, prv::Provider *provider, Region region, size_t chunkSize) const {
+        std::vector<u64> result;
+        this->findAll(task, provider, region, [&](std::span<const u64> occurrences) {
+            result.insert(result.end(), occurrences.begin(), occurrences.end());
+        }, chunkSize);
+
+        return result;
+    }
+
+    void SequenceSearcher::findAll(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const u64>)> &callback, size_t chunkSize) const {
+        if (m_sequence.empty() || region.getSize() < m_sequence.size())
+            return;
+
+        prv::scanParallel(task, provider, region,
+            [this](u64 address, size_t size, std::span<const u8> data) {
+                std::vector<u64> occurrences;
+                for (auto offset = this->findFirst(data); offset.has_value() && *offset < size; offset = this->findFirst(data, *offset + 1))
+                    occurrences.push_back(address + *offset);
+
+                return occurrences;
+            },
+            [&](u64, std::span<const u8>, std::vector<u64> &&occurrences) {
+                if (!occurrences.empty())
+                    callback(occurrences);
+            },
+            chunkSize, m_sequence.size() - 1
+        );
+    }
+
+    std::optional<u64> SequenceSearcher::findNext(Task &task, prv::Provider *provider, Region region, size_t chunkSize) const {
+        std::optional<u64> result;
+        if (m_sequence.empty() || region.getSize() < m_sequence.size())
+            return result;
+
+        prv::scanParallel(task, provider, region,
+            [this](u64 address, size_t size, std::span<const u8> data) -> std::optional<u64> {
+                if (auto offset = this->findFirst(data); offset.has_value() && *offset < size)
+                    return address + *offset;
+
+                return std::nullopt;
+            },
+            [&](u64, std::span<const u8>, std::optional<u64> &&occurrence) {
+                result = occurrence;
+                return !result.has_value();
+            },
+            chunkSize, m_sequence.size() - 1
+        );
+
+        return result;
+    }
+
+    std::optional<u64> SequenceSearcher::findPrevious(Task &task, prv::Provider *provider, Region region, size_t chunkSize) const {
+        if (m_sequence.empty() || region.getSize() < m_sequence.size())
+            return std::nullopt;
+
+        // Walk backwards through the region. Consecutive chunks overlap so occurrences crossing a chunk boundary are found as well
+        const auto blockSize = std::max<u64>(chunkSize, m_sequence.size() * 2);
+        std::vector<u8> buffer;
+
+        u64 endAddress = region.getEndAddress() + 1;
+        while (true) {
+            const auto startAddress = endAddress - region.getStartAddress() > blockSize ? endAddress - blockSize : region.getStartAddress();
+
+            buffer.resize(endAddress - startAddress);
+            provider->read(startAddress, buffer.data(), buffer.size());
+
+            if (const auto offset = this->findLast(buffer); offset.has_value())
+                return startAddress + *offset;
+
+            if (startAddress == region.getStartAddress())
+                break;
+
+            endAddress = startAddress + m_sequence.size() - 1;
+            task.update(region.getEndAddress() + 1 - endAddress);
+        }
+
+        return std::nullopt;
+    }
+
+    BinaryPatternSearcher::BinaryPatternSearcher(const BinaryPattern &pattern) : m_patterns(pattern.getPatterns()) {
+        // Anchor the search on the run of fully specified bytes with the highest combined rarity
+        u32 bestScore = 0;
+        size_t bestOffset = 0, bestSize = 0;
+        for (size_t start = 0; start < m_patterns.size(); ) {
+            if (m_patterns[start].mask != 0xFF) {
+                start += 1;
+                continue;
+            }
+
+            size_t end = start;
+            u32 score = 0;
+            for (; end < m_patterns.size() && m_patterns[end].mask == 0xFF; end += 1)
+                score += getByteRarity(m_patterns[end].value);
+
+            if (score > bestScore) {
+                bestScore  = score;
+                bestOffset = start;
+                bestSize   = end - start;
+            }
+
+            start = end;
+        }
+
+        if (bestSize > 0) {
+            std::vector<u8> anchor(bestSize);
+            for (size_t i = 0; i < bestSize; i += 1)
+                anchor[i] = m_patterns[bestOffset + i].value;
+
+            m_anchor.emplace(anchor);
+            m_anchorOffset = bestOffset;
+        } else if (!m_patterns.empty()) {
+            std::vector<size_t> offsets(m_patterns.size());
+            for (size_t i = 0; i < offsets.size(); i += 1)
+                offsets[i] = i;
+
+            std::ranges::stable_sort(offsets, std::greater(), [this](size_t offset) { return std::popcount(m_patterns[offset].mask); });
+            m_filterOffsets = { offsets[0], offsets.size() > 1 ? offsets[1] : offsets[0] };
+        }
+    }
+
+    bool BinaryPatternSearcher::matchesAt(const u8 *data) const {
+        for (size_t i = 0; i < m_patterns.size(); i += 1) {
+            if ((data[i] & m_patterns[i].mask) != m_patterns[i].value)
+                return false;
+        }
+
+        return true;
+    }
+
+    std::optional<size_t> BinaryPatternSearcher::findFirst(std::span<const u8> data, size_t offset) const {
+        if (m_patterns.empty() || data.size() < m_patterns.size() || offset > data.size() - m_patterns.size())
+            return std::nullopt;
+
+        if (m_anchor.has_value())
+            return this->findFirstAnchored(data, offset);
+        else
+            return this->findFirstMasked(data, offset);
+    }
+
+    std::optional<size_t> BinaryPatternSearcher::findFirstAnchored(std::span<const u8> data, size_t offset) const {
+        // Only look for the anchor where the rest of the pattern still fits behind it
+        const auto anchorData = data.first(data.size() - (m_patterns.size() - m_anchorOffset - m_anchor->getSize()));
+
+        for (auto anchor = m_anchor->findFirst(anchorData, offset + m_anchorOffset); anchor.has_value(); anchor = m_anchor->findFirst(anchorData, *anchor + 1)) {
+            const auto candidate = *anchor - m_anchorOffset;
+            if (this->matchesAt(data.data() + candidate))
+                return candidate;
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<size_t> BinaryPatternSearcher::findFirstMasked(std::span<const u8> data, size_t offset) const {
+        const auto endOffset = data.size() - m_patterns.size() + 1;
+
+        #if defined(SEQUENCE_SEARCH_VECTORIZED)
+            if (isVectorizationSupported()) {
+                const std::array patterns = { m_patterns[m_filterOffsets[0]], m_patterns[m_filterOffsets[1]] };
+
+                const auto [stopOffset, found] = findMaskedCandidatesVectorized(data.data(), offset, endOffset, m_filterOffsets, patterns, [&](size_t candidate) {
+                    return this->matchesAt(data.data() + candidate);
+                });
+
+                if (found)
+                    return stopOffset;
+                offset = stopOffset;
+            }
+        #endif
+
+        for (; offset < endOffset; offset += 1) {
+            if (this->matchesAt(data.data() + offset))
+                return offset;
+        }
+
+        return std::nullopt;
+    }
+
+    std::vector<u64> BinaryPatternSearcher::findAll(Task &task, prv::Provider *provider, Region region, u64 alignment, size_t chunkSize) const {
+        std::vector<u64> result;
+        this->findAll(task, provider, region, alignment, [&](std::span<const u64> occurrences) {
+            result.insert(result.end(), occurrences.begin(), occurrences.end());
+        }, chunkSize);
+
+        return result;
+    }
+
+    void BinaryPatternSearcher::findAll(Task &task, prv::Provider *provider, Region region, u64 alignment, const std::function<void(std::span<const u64>)> &callback, size_t chunkSize) const {
+        if (m_patterns.empty() || alignment == 0 || region.getSize() < m_patterns.size())
+            return;
+
+        prv::scanParallel(task, provider, region,
+            [this, region, alignment](u64 address, size_t size, std::span<const u8> data) {
+                // Moves an offset in the chunk forward to the next position that's aligned relative to the start of the region
+                const auto alignUp = [&](size_t offset) -> size_t {
+                    const auto misalignment = (address + offset - region.getStartAddress()) % alignment;
+                    return misalignment == 0 ? offset : offset + (alignment - misalignment);
+                };
+
+                std::vector<u64> occurrences;
+                for (size_t offset = alignUp(0); offset < size; ) {
+                    const auto occurrence = this->findFirst(data, offset);
+                    if (!occurrence.has_value() || *occurrence >= size)
+                        break;
+
+                    if (alignUp(*occurrence) == *occurrence)
+                        occurrences.push_back(address + *occurrence);
+
+                    offset = alignUp(*occurrence + 1);
+                }
+
+                return occurrences;
+            },
+            [&](u64, std::span<const u8>, std::vector<u64> &&occurrences) {
+                if (!occurrences.empty())
+                    callback(occurrences);
+            },
+            chunkSize, m_patterns.size() - 1
+        );
+    }
+
+}
@@ -1,11 +1,32 @@
 #include <hex/providers/concatenated_provider.hpp>
 
+#include <wolv/literals.hpp>
+
 #include <algorithm>
 #include <cstring>
+#include <future>
 #include <limits>
+#include <ranges>
 
 namespace hex::prv {
 
+    using namespace wolv::literals;
+
+    namespace {
+
+        // Reads spanning multiple source providers are only split up into parallel reads if they're at least this large.
+        // Below that, the overhead of spawning threads outweighs the gains
+        constexpr static u64 ParallelReadThreshold = 1_MiB;
+
+        struct SegmentRead {
+            Provider *provider;
+            u64 address;
+            u8 *output;
+            size_t size;
+        };
+
+    }
+
     ConcatenatedProvider::ConcatenatedProvider(std::vector<Segment> segments) {
         for (const auto &[provider, region] : segments)
             this->add(provider, region);
@@ -21,6 +42,7 @@ namespace hex::prv {
             return;
 
         m_segments.push_back({ provider, region });
+        m_segmentOffsets.push_back(m_size);
         m_size += region.size;
     }
 
@@ -41,27 +63,101 @@ namespace hex::prv {
         });
     }
 
+    size_t ConcatenatedProvider::findSegment(u64 offset) const {
+        // Find the last segment that starts at or before the requested offset
+        const auto it = std::ranges::upper_bound(m_segmentOffsets, offset);
+        return std::distance(m_segmentOffsets.begin(), it) - 1;
+    }
+
     void ConcatenatedProvider::readRaw(u64 offset, void *buffer, size_t size) {
         if (buffer == nullptr || size == 0 || offset > m_size || size > m_size - offset)
             return;
 
+        const auto totalSize = size;
+
+        // Split the read up into one read per segment that's touched by it
+        std::vector<SegmentRead> reads;
         auto output = static_cast<u8*>(buffer);
-        for (const auto &[provider, region] : m_segments) {
-            if (offset >= region.size) {
-                offset -= region.size;
-                continue;
-            }
+        for (auto index = this->findSegment(offset); index < m_segments.size() && size > 0; index += 1) {
+            const auto &[provider, region] = m_segments[index];
+            const auto segmentOffset = offset - m_segmentOffsets[index];
+            const auto readSize = static_cast<size_t>(std::min<u64>(size, region.size - segmentOffset));
 
-            const auto readSize = std::min<u64>(size, region.size - offset);
-            provider->read(region.address + offset, output, static_cast<size_t>(readSize));
+            reads.push_back({ provider, region.address + segmentOffset, output, readSize });
 
             output += readSize;
-            size -= static_cast<size_t>(readSize);
-            offset = 0;
+            offset += readSize;
+            size   -= readSize;
+        }
+
+        const auto readSequentially = [](const std::vector<SegmentRead> &segmentReads) {
+            for (const auto &[provider, address, readOutput, readSize] : segmentReads)
+                provider->read(address, readOutput, readSize);
+        };
+
+        if (reads.size() == 1 || totalSize < ParallelReadThreshold) {
+            readSequentially(reads);
+            return;
+        }
+
+        // Providers are generally not safe to be read from multiple threads at once.
+        // Group all reads by their source provider so each provider is only ever accessed by a single thread
+        std::vector<std::vector<SegmentRead>> groups;
+        for (const auto &read : reads) {
+            auto it = std::ranges::find_if(groups, [&read](const auto &group) {
+                return group.front().provider == read.provider;
+            });
 
-            if (size == 0)
-                break;
+            if (it == groups.end())
+                groups.push_back({ read });
+            else
+                it->push_back(read);
         }
+
+        if (groups.size() == 1) {
+            readSequentially(groups.front());
+            return;
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(groups.size() - 1);
+        for (const auto &group : groups | std::views::drop(1)) {
+            futures.emplace_back(std::async(std::launch::async, [&group, &readSequentially] {
+                readSequentially(group);
+            }));
+        }
+
+        readSequentially(groups.front());
+
+        for (auto &future : futures)
+            future.get();
+    }
+
+    std::pair<Region, bool> ConcatenatedProvider::getRegionValidity(u64 address) const {
+        const auto baseAddress = this->getBaseAddress();
+        if (address < baseAddress || address - baseAddress >= m_size)
+            return Provider::getRegionValidity(address);
+
+        const auto offset = address - baseAddress;
+        const auto index = this->findSegment(offset);
+        const auto &[provider, region] = m_segments[index];
+
+        const auto segmentOffset = offset - m_segmentOffsets[index];
+        const auto sourceAddress = region.address + segmentOffset;
+        const auto remainingSize = region.size - segmentOffset;
+
+        // Ask the source provider about the validity of the data and map the result back into our own address space,
+        // making sure the returned region never extends past the end of the current segment
+        const auto [sourceRegion, valid] = provider->getRegionValidity(sourceAddress);
+
+        u64 size = remainingSize;
+        if (sourceRegion != Region::Invalid() && sourceRegion.getStartAddress() <= sourceAddress) {
+            const auto sourceEnd = sourceRegion.getStartAddress() + sourceRegion.getSize();
+            if (sourceEnd > sourceAddress)
+                size = std::min(remainingSize, sourceEnd - sourceAddress);
+        }
+
+        return { Region { .address=address, .size=size }, valid };
     }
 
 }
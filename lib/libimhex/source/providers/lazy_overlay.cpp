@@ -0,0 +1,88 @@
+#include <hex/providers/lazy_overlay.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace hex::prv {
+
+    namespace {
+
+        std::atomic<u64> s_nextId = 1;
+
+        constexpr u64 splitMix64(u64 value) {
+            value += 0x9E3779B97F4A7C15;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+            return value ^ (value >> 31);
+        }
+
+    }
+
+    LazyOverlay::LazyOverlay(Type type, Region region, std::vector<u8> key)
+        : m_id(s_nextId++), m_type(type), m_region(region), m_origin(region.getStartAddress()), m_key(std::move(key)) {
+        if (m_key.empty())
+            m_key = { 0x00 };
+
+        for (const auto byte : m_key)
+            m_seed = (m_seed << 8 | m_seed >> 56) ^ byte;
+    }
+
+    void LazyOverlay::apply(u64 offset, std::span<u8> buffer) const {
+        const auto start = std::max(offset, m_region.getStartAddress());
+        const auto end   = std::min(offset + buffer.size(), m_region.getStartAddress() + m_region.getSize());
+        if (start >= end)
+            return;
+
+        auto data = buffer.subspan(start - offset, end - start);
+
+        // Position of the first byte within the overlay as it was created, independent of how it was split or moved since
+        const u64 position = start - m_origin;
+        const auto keySize = m_key.size();
+
+        switch (m_type) {
+            case Type::Fill:
+                if (keySize == 1) {
+                    std::memset(data.data(), m_key.front(), data.size());
+                } else {
+                    for (size_t i = 0, keyIndex = position % keySize; i < data.size(); i += 1) {
+                        data[i] = m_key[keyIndex];
+                        keyIndex = keyIndex + 1 == keySize ? 0 : keyIndex + 1;
+                    }
+                }
+                break;
+            case Type::Xor:
+                for (size_t i = 0, keyIndex = position % keySize; i < data.size(); i += 1) {
+                    data[i] ^= m_key[keyIndex];
+                    keyIndex = keyIndex + 1 == keySize ? 0 : keyIndex + 1;
+                }
+                break;
+            case Type::Add:
+                for (size_t i = 0, keyIndex = position % keySize; i < data.size(); i += 1) {
+                    data[i] += m_key[keyIndex];
+                    keyIndex = keyIndex + 1 == keySize ? 0 : keyIndex + 1;
+                }
+                break;
+            case Type::Random:
+                // Every group of eight bytes is generated from its index, so any byte can be computed without the ones before it
+                for (size_t i = 0; i < data.size(); i += 1) {
+                    const u64 bytePosition = position + i;
+                    data[i] = u8(splitMix64(m_seed + bytePosition / 8) >> ((bytePosition % 8) * 8));
+                }
+                break;
+        }
+    }
+
+    LazyOverlay LazyOverlay::slice(const Region &region) const {
+        LazyOverlay result = *this;
+        result.m_region = region;
+
+        return result;
+    }
+
+    void LazyOverlay::move(i64 delta) {
+        m_region.address += delta;
+        m_origin += delta;
+    }
+
+}
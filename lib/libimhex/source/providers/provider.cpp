@@ -8,10 +8,12 @@
 
 #include <hex/helpers/magic.hpp>
 #include <hex/helpers/auto_reset.hpp>
+#include <hex/helpers/profiler.hpp>
 #include <wolv/io/file.hpp>
 #include <wolv/literals.hpp>
 #include <wolv/utils/string.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <optional>
@@ -139,7 +141,13 @@ namespace hex::prv {
     }
 
     void Provider::read(u64 offset, void *buffer, size_t size, bool overlays) {
-        this->readRaw(offset - this->getBaseAddress(), buffer, size);
+        prof::ScopedTimer timer(prof::Category::ProviderRead, "Provider", m_id, size);
+
+        {
+            prof::ScopedTimer rawTimer(prof::Category::ProviderReadRaw, "Provider", m_id, size);
+            this->readRaw(offset - this->getBaseAddress(), buffer, size);
+        }
+        this->applyLazyOverlays(offset - this->getBaseAddress(), buffer, size);
 
         if (overlays)
             this->applyOverlays(offset, buffer, size);
@@ -157,6 +165,8 @@ namespace hex::prv {
         if (!this->isWritable())
             return;
 
+        this->materializeLazyOverlays();
+
         this->markDataDirty(false);
         EventProviderSaved::post(this);
     }
@@ -288,6 +298,129 @@ namespace hex::prv {
         return m_overlays;
     }
 
+    void Provider::addLazyOverlay(const LazyOverlay &overlay) {
+        auto overlays = *this->getLazyOverlays();
+
+        // Keep the overlays in the order they were created in so pieces that get added back end up where they were before
+        const auto position = std::ranges::upper_bound(overlays, overlay.getId(), {}, &LazyOverlay::getId);
+        overlays.insert(position, overlay);
+
+        this->setLazyOverlays(std::move(overlays));
+    }
+
+    void Provider::removeLazyOverlay(u64 id) {
+        auto overlays = *this->getLazyOverlays();
+        std::erase_if(overlays, [id](const LazyOverlay &overlay) {
+            return overlay.getId() == id;
+        });
+
+        this->setLazyOverlays(std::move(overlays));
+    }
+
+    std::vector<LazyOverlay> Provider::materializeLazyOverlays(const Region &region) {
+        std::vector<LazyOverlay> removedPieces;
+        if (region.getSize() == 0 || !this->hasLazyOverlays(region))
+            return removedPieces;
+
+        const auto overlays = this->getLazyOverlays();
+
+        std::vector<u8> buffer(std::min<u64>(region.getSize(), 1_MiB));
+        for (u64 offset = 0; offset < region.getSize(); offset += buffer.size()) {
+            const auto chunkSize = std::min<u64>(buffer.size(), region.getSize() - offset);
+            const auto address   = region.getStartAddress() + offset;
+
+            this->readRaw(address, buffer.data(), chunkSize);
+            for (const auto &overlay : *overlays)
+                overlay.apply(address, { buffer.data(), chunkSize });
+            this->writeRaw(address, buffer.data(), chunkSize);
+        }
+
+        // Cut the region out of all overlays, keeping the parts before and after it
+        std::vector<LazyOverlay> remainingPieces;
+        for (const auto &overlay : *overlays) {
+            const auto &overlayRegion = overlay.getRegion();
+            if (!overlayRegion.overlaps(region)) {
+                remainingPieces.push_back(overlay);
+                continue;
+            }
+
+            const auto start = std::max(overlayRegion.getStartAddress(), region.getStartAddress());
+            const auto end   = std::min(overlayRegion.getEndAddress(), region.getEndAddress());
+
+            if (overlayRegion.getStartAddress() < start)
+                remainingPieces.push_back(overlay.slice({ overlayRegion.getStartAddress(), start - overlayRegion.getStartAddress() }));
+            if (overlayRegion.getEndAddress() > end)
+                remainingPieces.push_back(overlay.slice({ end + 1, overlayRegion.getEndAddress() - end }));
+
+            removedPieces.push_back(overlay.slice({ start, (end - start) + 1 }));
+        }
+
+        this->setLazyOverlays(std::move(remainingPieces));
+
+        return removedPieces;
+    }
+
+    void Provider::materializeLazyOverlays() {
+        if (this->getLazyOverlays()->empty())
+            return;
+
+        this->getUndoStack().materializeLazyOverlays();
+
+        while (true) {
+            const auto overlays = this->getLazyOverlays();
+            if (overlays->empty())
+                break;
+
+            std::ignore = this->materializeLazyOverlays(overlays->front().getRegion());
+        }
+    }
+
+    void Provider::moveLazyOverlays(u64 offset, i64 delta) {
+        std::vector<LazyOverlay> result;
+        for (auto overlay : *this->getLazyOverlays()) {
+            const auto &region = overlay.getRegion();
+
+            if (region.getStartAddress() >= offset) {
+                overlay.move(delta);
+                result.push_back(overlay);
+            } else if (region.getEndAddress() >= offset) {
+                result.push_back(overlay.slice({ region.getStartAddress(), offset - region.getStartAddress() }));
+
+                auto movedPiece = overlay.slice({ offset, region.getEndAddress() - offset + 1 });
+                movedPiece.move(delta);
+                result.push_back(movedPiece);
+            } else {
+                result.push_back(overlay);
+            }
+        }
+
+        this->setLazyOverlays(std::move(result));
+    }
+
+    void Provider::applyLazyOverlays(u64 offset, void *buffer, size_t size) const {
+        for (const auto &overlay : *this->getLazyOverlays())
+            overlay.apply(offset, { static_cast<u8*>(buffer), size });
+    }
+
+    bool Provider::hasLazyOverlays(const Region &region) const {
+        return std::ranges::any_of(*this->getLazyOverlays(), [&region](const LazyOverlay &overlay) {
+            return overlay.getRegion().overlaps(region);
+        });
+    }
+
+    std::shared_ptr<const std::vector<LazyOverlay>> Provider::getLazyOverlays() const {
+        std::scoped_lock lock(m_lazyOverlayMutex);
+
+        return m_lazyOverlays;
+    }
+
+    void Provider::setLazyOverlays(std::vector<LazyOverlay> overlays) {
+        auto newOverlays = std::make_shared<const std::vector<LazyOverlay>>(std::move(overlays));
+
+        std::scoped_lock lock(m_lazyOverlayMutex);
+        m_lazyOverlays = std::move(newOverlays);
+    }
+
 
     u64 Provider::getPageSize() const {
         return m_pageSize;
@@ -5,14 +5,20 @@
 #include <hex/providers/provider.hpp>
 
 #include <wolv/utils/guards.hpp>
+#include <wolv/literals.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <utility>
 
 namespace hex::prv::undo {
 
+    using namespace wolv::literals;
+
     namespace {
 
         std::recursive_mutex s_mutex;
+        std::atomic<u64> s_memoryBudget = 512_MiB;
 
     }
 
@@ -24,6 +30,52 @@ namespace hex::prv::undo {
         return s_mutex;
     }
 
+    void Stack::setMemoryBudget(u64 budget) {
+        s_memoryBudget = budget;
+    }
+
+    u64 Stack::getMemoryBudget() {
+        return s_memoryBudget;
+    }
+
+    u64 Stack::getMemoryUsage() const {
+        std::lock_guard lock(s_mutex);
+
+        return m_memoryUsage;
+    }
+
+    void Stack::enforceMemoryBudget() {
+        std::lock_guard lock(s_mutex);
+
+        const u64 budget = s_memoryBudget;
+        if (m_memoryUsage <= budget)
+            return;
+
+        const auto offloadOperation = [&](const std::unique_ptr<Operation> &operation) {
+            const auto previousUsage = operation->getMemoryUsage();
+            operation->offload();
+            m_memoryUsage -= previousUsage - std::min(previousUsage, operation->getMemoryUsage());
+
+            return m_memoryUsage <= budget;
+        };
+
+        // Offload the coldest operations first. These are the oldest applied operations
+        // followed by the undone operations that are the furthest away from being redone
+        m_firstResidentOperation = std::min(m_firstResidentOperation, m_undoStack.size());
+        while (m_firstResidentOperation < m_undoStack.size()) {
+            const auto &operation = m_undoStack[m_firstResidentOperation];
+            m_firstResidentOperation += 1;
+
+            if (offloadOperation(operation))
+                return;
+        }
+
+        for (const auto &operation : m_redoStack) {
+            if (offloadOperation(operation))
+                return;
+        }
+    }
+
 
     void Stack::undo(u32 count) {
         std::lock_guard lock(s_mutex);
@@ -42,7 +94,10 @@ namespace hex::prv::undo {
             m_redoStack.emplace_back(std::move(m_undoStack.back()));
             m_redoStack.back()->undo(m_provider);
             m_undoStack.pop_back();
-            EventDataChanged::post(m_provider);
+
+            // Operations added in its place later on haven't been offloaded yet
+            m_firstResidentOperation = std::min(m_firstResidentOperation, m_undoStack.size());
+            this->postDataChanged(*m_redoStack.back());
         }
     }
 
@@ -63,7 +118,7 @@ namespace hex::prv::undo {
             m_undoStack.emplace_back(std::move(m_redoStack.back()));
             m_undoStack.back()->redo(m_provider);
             m_redoStack.pop_back();
-            EventDataChanged::post(m_provider);
+            this->postDataChanged(*m_undoStack.back());
         }
     }
 
@@ -86,11 +141,13 @@ namespace hex::prv::undo {
             }
 
             m_undoStack[index]->undo(m_provider);
+            m_memoryUsage -= m_undoStack[index]->getMemoryUsage();
             operation->addOperation(std::move(m_undoStack[index]));
         }
 
         // Remove the empty operations from the stack
         m_undoStack.resize(startIndex);
+        m_firstResidentOperation = std::min<size_t>(m_firstResidentOperation, startIndex);
         this->add(std::move(operation));
     }
 
@@ -107,8 +164,34 @@ namespace hex::prv::undo {
 
         for (const auto &operation : m_undoStack) {
             operation->redo(m_provider);
-            EventDataChanged::post(m_provider);
+            this->postDataChanged(*operation);
+        }
+    }
+
+    void Stack::materializeLazyOverlays() {
+        std::lock_guard lock(s_mutex);
+
+        const u64 budget = s_memoryBudget;
+        for (size_t i = 0; i < m_undoStack.size(); i += 1) {
+            const auto &operation = m_undoStack[i];
+
+            const auto previousStackUsage = m_memoryUsage;
+            const auto previousUsage = operation->getMemoryUsage();
+
+            // The replaced data can be as large as the provider, so every block that doesn't fit into the budget anymore gets
+            // offloaded as soon as it has been read. Operations that have already been offloaded shouldn't start using memory again
+            operation->materializeLazyOverlays(m_provider, [&](u64 size) {
+                if (i < m_firstResidentOperation || m_memoryUsage + size > budget)
+                    return false;
+
+                m_memoryUsage += size;
+                return true;
+            });
+
+            m_memoryUsage = (previousStackUsage - previousUsage) + operation->getMemoryUsage();
         }
+
+        this->enforceMemoryBudget();
     }
 
 
@@ -118,6 +201,8 @@ namespace hex::prv::undo {
         std::lock_guard lock(s_mutex);
 
         // Clear the redo stack
+        for (const auto &undoneOperation : m_redoStack)
+            m_memoryUsage -= undoneOperation->getMemoryUsage();
         m_redoStack.clear();
 
         // Insert the new operation at the end of the list
@@ -125,12 +210,29 @@ namespace hex::prv::undo {
 
         // Do the operation
         this->getLastOperation()->redo(m_provider);
+        m_memoryUsage += this->getLastOperation()->getMemoryUsage();
 
-        EventDataChanged::post(m_provider);
+        this->enforceMemoryBudget();
+
+        this->postDataChanged(*this->getLastOperation());
 
         return true;
     }
 
+    void Stack::postDataChanged(const Operation &operation) {
+        // Subscribers may add operations themselves, the outer event needs to keep its region
+        const auto previousRegion = std::exchange(m_changedRegion, operation.getRegion());
+        ON_SCOPE_EXIT { m_changedRegion = previousRegion; };
+
+        EventDataChanged::post(m_provider);
+    }
+
+    std::optional<Region> Stack::getChangedRegion() const {
+        std::lock_guard lock(s_mutex);
+
+        return m_changedRegion;
+    }
+
     bool Stack::canUndo() const {
         std::lock_guard lock(s_mutex);
 
@@ -0,0 +1,326 @@
+#include <hex/providers/undo_redo/undo_buffer.hpp>
+
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/fs.hpp>
+#include <hex/helpers/logger.hpp>
+
+#include <wolv/io/file.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+
+namespace hex::prv::undo {
+
+    namespace {
+
+        // Buffers smaller than this are always stored as-is, the encoding overhead isn't worth it
+        constexpr static size_t MinEncodedSize = 64;
+
+        constexpr static u8 MaxLiteralLength = 128;
+        constexpr static u8 MinRepeatLength  = 3;
+        constexpr static u8 MaxRepeatLength  = 130;
+
+        /**
+         * @brief Run-length encodes data using a PackBits-like scheme
+         * @note Control bytes below 0x80 are followed by (c + 1) literal bytes. Control bytes of 0x80 and above are
+         * followed by a single byte that gets repeated (c - 0x80 + MinRepeatLength) times.
+         * @return The encoded data or std::nullopt if encoding wouldn't make the data smaller
+         */
+        std::optional<std::vector<u8>> runLengthEncode(std::span<const u8> data) {
+            std::vector<u8> result;
+
+            size_t literalStart = 0, literalLength = 0;
+            const auto flushLiterals = [&] {
+                while (literalLength > 0) {
+                    const auto length = std::min<size_t>(literalLength, MaxLiteralLength);
+                    result.push_back(u8(length - 1));
+                    result.insert(result.end(), data.begin() + literalStart, data.begin() + literalStart + length);
+
+                    literalStart  += length;
+                    literalLength -= length;
+                }
+            };
+
+            size_t offset = 0;
+            while (offset < data.size()) {
+                const auto value = data[offset];
+
+                size_t runLength = 1;
+                while (offset + runLength < data.size() && runLength < MaxRepeatLength && data[offset + runLength] == value)
+                    runLength += 1;
+
+                if (runLength >= MinRepeatLength) {
+                    flushLiterals();
+                    result.push_back(u8(0x80 + (runLength - MinRepeatLength)));
+                    result.push_back(value);
+
+                    offset += runLength;
+                    literalStart = offset;
+                } else {
+                    literalLength += runLength;
+                    offset += runLength;
+                }
+
+                // Give up as soon as it's clear that the encoded data won't be any smaller
+                if (result.size() + literalLength >= data.size())
+                    return std::nullopt;
+            }
+
+            flushLiterals();
+
+            if (result.size() >= data.size())
+                return std::nullopt;
+
+            return result;
+        }
+
+        void runLengthDecode(std::span<const u8> encoded, std::span<u8> output) {
+            size_t inputOffset = 0, outputOffset = 0;
+            while (inputOffset < encoded.size() && outputOffset < output.size()) {
+                const auto control = encoded[inputOffset];
+                inputOffset += 1;
+
+                if (control < 0x80) {
+                    const auto length = std::min<size_t>({ size_t(control) + 1, encoded.size() - inputOffset, output.size() - outputOffset });
+                    std::copy_n(encoded.begin() + inputOffset, length, output.begin() + outputOffset);
+
+                    inputOffset  += length;
+                    outputOffset += length;
+                } else {
+                    if (inputOffset >= encoded.size())
+                        break;
+
+                    const auto length = std::min<size_t>(size_t(control - 0x80) + MinRepeatLength, output.size() - outputOffset);
+                    std::fill_n(output.begin() + outputOffset, length, encoded[inputOffset]);
+
+                    inputOffset  += 1;
+                    outputOffset += length;
+                }
+            }
+        }
+
+        /**
+         * @brief Temporary file that offloaded undo buffers get appended to
+         * @note Entries are referenced by an ID instead of their offset so they can be moved around. Once more than
+         * half of the file is taken up by released entries, the remaining ones get moved to the front and the file
+         * is shrunk again
+         */
+        class OffloadFile {
+        public:
+            // Don't bother compacting files that only waste a little bit of space
+            constexpr static u64 MinCompactionSize = 16 * 1024 * 1024;
+
+            ~OffloadFile() {
+                if (m_file != nullptr)
+                    m_file->remove();
+            }
+
+            static std::shared_ptr<OffloadFile> get() {
+                static auto instance = std::make_shared<OffloadFile>();
+
+                return instance;
+            }
+
+            std::optional<u64> write(std::span<const u8> data) {
+                std::scoped_lock lock(m_mutex);
+
+                if (m_file == nullptr) {
+                    const auto path = std::fs::temp_directory_path() / fmt::format("imhex_undo_{:016X}.tmp", std::random_device()() | (u64(std::random_device()()) << 32));
+                    auto file = std::make_unique<wolv::io::File>(path, wolv::io::File::Mode::Create);
+                    if (!file->isValid()) {
+                        log::warn("Failed to create undo history file at {}", wolv::util::toUTF8String(path));
+                        return std::nullopt;
+                    }
+
+                    m_file = std::move(file);
+                }
+
+                const auto id = m_nextId;
+                m_nextId += 1;
+
+                m_file->writeBufferAtomic(m_endOffset, data.data(), data.size());
+                m_entries[id] = { m_endOffset, data.size() };
+
+                m_endOffset += data.size();
+                m_usedSize  += data.size();
+
+                return id;
+            }
+
+            void read(u64 id, std::span<u8> buffer) {
+                std::scoped_lock lock(m_mutex);
+
+                const auto it = m_entries.find(id);
+                if (m_file == nullptr || it == m_entries.end())
+                    return;
+
+                m_file->readBufferAtomic(it->second.offset, buffer.data(), std::min<u64>(buffer.size(), it->second.size));
+            }
+
+            void release(u64 id) {
+                std::scoped_lock lock(m_mutex);
+
+                const auto it = m_entries.find(id);
+                if (it == m_entries.end())
+                    return;
+
+                m_usedSize -= it->second.size;
+                m_entries.erase(it);
+
+                if (m_file == nullptr)
+                    return;
+
+                if (m_entries.empty()) {
+                    m_file->setSize(0);
+                    m_endOffset = 0;
+                } else if (m_endOffset - m_usedSize > std::max(m_usedSize, MinCompactionSize)) {
+                    this->compact();
+                }
+            }
+
+            [[nodiscard]] u64 getFileSize() {
+                std::scoped_lock lock(m_mutex);
+
+                return m_endOffset;
+            }
+
+        private:
+            void compact() {
+                // IDs are handed out in increasing order and entries are only ever moved towards the front, so iterating
+                // them by ID visits them in the order they're laid out in the file
+                std::vector<u8> buffer;
+                u64 offset = 0;
+                for (auto &[id, entry] : m_entries) {
+                    if (entry.offset != offset) {
+                        buffer.resize(entry.size);
+                        m_file->readBufferAtomic(entry.offset, buffer.data(), buffer.size());
+                        m_file->writeBufferAtomic(offset, buffer.data(), buffer.size());
+                        entry.offset = offset;
+                    }
+
+                    offset += entry.size;
+                }
+
+                m_endOffset = offset;
+                m_file->setSize(m_endOffset);
+            }
+
+        private:
+            struct Entry {
+                u64 offset, size;
+            };
+
+            std::mutex m_mutex;
+            std::unique_ptr<wolv::io::File> m_file;
+            std::map<u64, Entry> m_entries;
+            u64 m_nextId = 0;
+            u64 m_endOffset = 0;
+            u64 m_usedSize = 0;
+        };
+
+    }
+
+    struct UndoBuffer::Storage {
+        Storage() = default;
+        Storage(const Storage&) = delete;
+        Storage& operator=(const Storage&) = delete;
+
+        ~Storage() {
+            if (offloadFile != nullptr)
+                offloadFile->release(offloadId);
+        }
+
+        bool runLengthEncoded = false;
+
+        // Stored bytes, possibly encoded. Empty if the data has been offloaded to disk
+        std::vector<u8> data;
+
+        std::shared_ptr<OffloadFile> offloadFile;
+        u64 offloadId = 0;
+        u64 offloadSize = 0;
+    };
+
+    UndoBuffer::UndoBuffer(std::span<const u8> data) : m_size(data.size()) {
+        auto storage = std::make_shared<Storage>();
+
+        if (data.size() >= MinEncodedSize) {
+            if (auto encoded = runLengthEncode(data); encoded.has_value()) {
+                storage->data = std::move(*encoded);
+                storage->runLengthEncoded = true;
+            }
+        }
+
+        if (!storage->runLengthEncoded)
+            storage->data.assign(data.begin(), data.end());
+
+        m_storage = std::move(storage);
+    }
+
+    std::vector<u8> UndoBuffer::get(size_t maxSize) const {
+        if (m_storage == nullptr)
+            return { };
+
+        const auto size = std::min(m_size, maxSize);
+
+        // Every encoded byte expands to at least one decoded byte except for control bytes, which at worst
+        // precede every single literal byte. Twice the decoded size is therefore always enough encoded data
+        const auto storedSize = m_storage->runLengthEncoded ? size * 2 + 2 : size;
+
+        std::vector<u8> stored;
+        std::span<const u8> source = m_storage->data;
+
+        if (m_storage->offloadFile != nullptr) {
+            stored.resize(std::min<u64>(m_storage->offloadSize, storedSize));
+            m_storage->offloadFile->read(m_storage->offloadId, stored);
+            source = stored;
+        }
+
+        if (!m_storage->runLengthEncoded) {
+            source = source.first(std::min(source.size(), size));
+            return { source.begin(), source.end() };
+        }
+
+        std::vector<u8> result(size);
+        runLengthDecode(source, result);
+
+        return result;
+    }
+
+    size_t UndoBuffer::getMemoryUsage() const {
+        if (m_storage == nullptr)
+            return 0;
+
+        return m_storage->data.size();
+    }
+
+    bool UndoBuffer::isOffloaded() const {
+        return m_storage != nullptr && m_storage->offloadFile != nullptr;
+    }
+
+    void UndoBuffer::offload() {
+        if (m_storage == nullptr || this->isOffloaded() || m_storage->data.empty())
+            return;
+
+        auto offloadFile = OffloadFile::get();
+        const auto id = offloadFile->write(m_storage->data);
+        if (!id.has_value())
+            return;
+
+        auto storage = std::make_shared<Storage>();
+        storage->runLengthEncoded = m_storage->runLengthEncoded;
+        storage->offloadFile = std::move(offloadFile);
+        storage->offloadId   = *id;
+        storage->offloadSize = m_storage->data.size();
+
+        m_storage = std::move(storage);
+    }
+
+    u64 UndoBuffer::getOffloadFileSize() {
+        return OffloadFile::get()->getFileSize();
+    }
+
+}
@@ -0,0 +1,117 @@
+#include <hex/test/benchmarks.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <string_view>
+
+namespace hex::test {
+
+    static std::map<std::string, BenchmarkFunction> s_benchmarks;
+    int Benchmarks::addBenchmark(const std::string &name, BenchmarkFunction function) noexcept {
+        s_benchmarks.insert({ name, function });
+
+        return 0;
+    }
+
+    std::map<std::string, BenchmarkFunction> &Benchmarks::get() noexcept {
+        return s_benchmarks;
+    }
+
+    void BenchmarkState::measure(const std::string &variant, u64 bytes, const std::function<void()> &function) {
+        function();
+
+        std::vector<double> durations;
+        for (u32 i = 0; i < std::max<u32>(m_repetitions, 1); i += 1) {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            durations.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::ranges::sort(durations);
+
+        BenchmarkResult result;
+        result.name          = m_name;
+        result.variant       = variant;
+        result.bytes         = bytes;
+        result.iterations    = u32(durations.size());
+        result.minSeconds    = durations.front();
+        result.medianSeconds = durations[durations.size() / 2];
+        result.meanSeconds   = std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size();
+
+        m_results.push_back(std::move(result));
+    }
+
+    void BenchmarkState::setCounter(const std::string &name, double value) {
+        if (m_results.empty())
+            return;
+
+        m_results.back().counters[name] = value;
+    }
+
+    std::vector<u8> generateBenchmarkData(BenchmarkData type, size_t size, u64 seed) {
+        std::vector<u8> data;
+        data.reserve(size);
+
+        std::mt19937_64 random(seed);
+
+        constexpr static std::array Words = { "the", "data", "header", "offset", "size", "value", "error", "file", "section", "table", "string", "buffer" };
+        const auto appendWord = [&] {
+            const std::string_view word = Words[random() % Words.size()];
+            data.insert(data.end(), word.begin(), word.end());
+        };
+
+        switch (type) {
+            case BenchmarkData::Random:
+                while (data.size() < size)
+                    data.push_back(u8(random()));
+                break;
+            case BenchmarkData::Text:
+                while (data.size() < size) {
+                    appendWord();
+                    data.push_back(random() % 12 == 0 ? '\n' : ' ');
+                }
+                break;
+            case BenchmarkData::Binary:
+                while (data.size() < size) {
+                    switch (random() % 5) {
+                        case 0:
+                            data.resize(data.size() + random() % 256, 0x00);
+                            break;
+                        case 1:
+                            for (u32 i = random() % 64; i > 0; i -= 1) {
+                                const auto value = u32(random() % 0x1000);
+                                data.insert(data.end(), { u8(value), u8(value >> 8), 0x00, 0x00 });
+                            }
+                            break;
+                        case 2:
+                            for (u32 i = random() % 8 + 1; i > 0; i -= 1) {
+                                appendWord();
+                                data.push_back(i == 1 ? 0x00 : ' ');
+                            }
+                            break;
+                        case 3:
+                            for (u32 i = random() % 8 + 1; i > 0; i -= 1) {
+                                const std::string_view word = Words[random() % Words.size()];
+                                for (const char c : word)
+                                    data.insert(data.end(), { u8(c), 0x00 });
+                            }
+                            data.insert(data.end(), { 0x00, 0x00 });
+                            break;
+                        default:
+                            for (u32 i = random() % 512; i > 0; i -= 1)
+                                data.push_back(u8(random()));
+                            break;
+                    }
+                }
+                break;
+        }
+
+        data.resize(size);
+
+        return data;
+    }
+
+}
@@ -195,6 +195,21 @@ namespace ImGuiExt {
         return result;
     }
 
+    std::vector<u8> Texture::decodeImage(std::span<const std::byte> buffer, int &width, int &height) {
+        width = height = 0;
+        if (buffer.empty())
+            return {};
+
+        unsigned char *imageData = stbi_load_from_memory(reinterpret_cast<const ImU8*>(buffer.data()), buffer.size(), &width, &height, nullptr, 4);
+        if (imageData == nullptr)
+            return {};
+
+        std::vector<u8> result(imageData, imageData + size_t(width) * size_t(height) * 4);
+        STBI_FREE(imageData);
+
+        return result;
+    }
+
     Texture Texture::fromGLTexture(unsigned int glTexture, int width, int height) {
         Texture texture;
         texture.m_textureId = glTexture;
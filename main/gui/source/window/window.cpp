@@ -19,6 +19,7 @@
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/logger.hpp>
 #include <hex/helpers/default_paths.hpp>
+#include <hex/helpers/profiler.hpp>
 
 #include <hex/providers/provider.hpp>
 
@@ -786,7 +787,10 @@ namespace hex {
                 }
 
                 // Draw view
-                view->draw();
+                {
+                    prof::ScopedTimer timer(prof::Category::View, view->getUnlocalizedName().get());
+                    view->draw();
+                }
 
                 // If the window was just opened, it wasn't found above, so try to find it again
                 if (window == nullptr)
@@ -0,0 +1,38 @@
+#include <hex/test/benchmarks.hpp>
+
+#include <hex/helpers/literals.hpp>
+
+#include <content/helpers/diagrams.hpp>
+
+#include <fmt/format.h>
+
+using namespace hex;
+using namespace hex::literals;
+using namespace hex::plugin::builtin;
+
+BENCHMARK("Analysis/Entropy") {
+    const auto data = test::generateBenchmarkData(test::BenchmarkData::Binary, 32_MiB);
+
+    for (const u64 chunkSize : { 256_Bytes, 4_KiB }) {
+        state.measure(fmt::format("Chunk based entropy, {} byte chunks", chunkSize), data.size(), [&] {
+            DiagramChunkBasedEntropyAnalysis analysis;
+            analysis.process(data, chunkSize);
+            test::doNotOptimize(analysis.getHighestEntropyBlockValue());
+        });
+    }
+
+    // The information view feeds the analysis one byte at a time while it reads the data
+    state.measure("Chunk based entropy, streamed", data.size(), [&] {
+        DiagramChunkBasedEntropyAnalysis analysis;
+        analysis.reset(256, 0, data.size(), 0, data.size());
+        for (const u8 byte : data)
+            analysis.update(byte);
+        test::doNotOptimize(analysis.getHighestEntropyBlockValue());
+    });
+
+    state.measure("Byte distribution", data.size(), [&] {
+        DiagramByteDistribution distribution;
+        distribution.process(data);
+        test::doNotOptimize(distribution);
+    });
+}
@@ -0,0 +1,93 @@
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/test_provider.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/helpers/literals.hpp>
+
+#include <content/views/view_find.hpp>
+
+using namespace hex;
+using namespace hex::literals;
+
+namespace hex::plugin::builtin {
+
+    // Calls the search functions of the find view directly, without going through its UI and task handling
+    struct ViewFindBenchmark {
+        using Settings = ViewFind::SearchSettings;
+
+        static void run(test::BenchmarkState &state) {
+            auto data = test::generateBenchmarkData(test::BenchmarkData::Binary, 32_MiB);
+            test::TestProvider provider(&data);
+
+            const Region region = { 0x00, data.size() };
+            Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+
+            const auto measure = [&](const std::string &variant, auto searchFunction, const auto &settings) {
+                size_t occurrences = 0;
+                state.measure(variant, data.size(), [&] {
+                    occurrences = searchFunction(task, &provider, region, settings).size();
+                });
+                state.setCounter("occurrences", double(occurrences));
+            };
+
+            {
+                Settings::Strings settings;
+                measure("Strings, ASCII", &ViewFind::searchStrings, settings);
+
+                settings.type = Settings::StringType::UTF8;
+                measure("Strings, UTF-8", &ViewFind::searchStrings, settings);
+
+                settings.type = Settings::StringType::UTF16LE;
+                measure("Strings, UTF-16LE", &ViewFind::searchStrings, settings);
+            }
+
+            {
+                Settings::Sequence settings;
+                settings.sequence = "section";
+                measure("Sequence", &ViewFind::searchSequence, settings);
+
+                settings.ignoreCase = true;
+                measure("Sequence, ignore case", &ViewFind::searchSequence, settings);
+            }
+
+            {
+                Settings::Regex settings;
+                settings.pattern = "(header|section)_?[a-z]+";
+                settings.fullMatch = false;
+                measure("Regex", &ViewFind::searchRegex, settings);
+
+                settings.rawBytes = true;
+                measure("Regex, raw bytes", &ViewFind::searchRegex, settings);
+            }
+
+            {
+                Settings::BinaryPattern settings;
+                settings.input = "00 ?? 00 00 ?0";
+                settings.pattern = hex::BinaryPattern(settings.input);
+                measure("Binary pattern", &ViewFind::searchBinaryPattern, settings);
+            }
+
+            {
+                Settings::Value settings;
+                settings.inputMin = "250";
+                settings.inputMax = "1000";
+                settings.range = true;
+                settings.type = Settings::Value::Type::U32;
+                measure("Value, u32 range", &ViewFind::searchValue, settings);
+
+                settings.aligned = true;
+                measure("Value, u32 range, aligned", &ViewFind::searchValue, settings);
+            }
+
+            {
+                Settings::Constants settings;
+                measure("Constants", &ViewFind::searchConstants, settings);
+            }
+        }
+    };
+
+}
+
+BENCHMARK("Find/SearchModes") {
+    plugin::builtin::ViewFindBenchmark::run(state);
+}
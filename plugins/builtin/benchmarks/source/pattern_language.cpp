@@ -0,0 +1,73 @@
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/test_provider.hpp>
+
+#include <hex/api/content_registry/pattern_language.hpp>
+
+#include <pl/pattern_language.hpp>
+
+using namespace hex;
+
+namespace {
+
+    // Has to match the size of the arrays in the patterns below
+    constexpr static auto EntryCount = 1'000'000;
+
+    // Every entry has the same layout, the runtime can create the entries without evaluating each one
+    constexpr static auto StaticStructArray = R"(
+        #pragma array_limit 2000000
+        #pragma pattern_limit 20000000
+
+        struct Entry {
+            u32 id;
+            u16 type;
+            u16 flags;
+            float value;
+            char name[4];
+        };
+
+        Entry entries[1000000] @ 0x00;
+    )";
+
+    // The layout depends on the data, every entry has to be evaluated on its own
+    constexpr static auto DynamicStructArray = R"(
+        #pragma array_limit 2000000
+        #pragma pattern_limit 20000000
+
+        struct Entry {
+            u32 id;
+            u16 type;
+            u16 flags;
+            if (type & 1)
+                float value;
+            else
+                u32 value;
+            char name[4];
+        };
+
+        Entry entries[1000000] @ 0x00;
+    )";
+
+}
+
+BENCHMARK("PatternLanguage/StructArray") {
+    auto data = test::generateBenchmarkData(test::BenchmarkData::Binary, EntryCount * 16);
+    test::TestProvider provider(&data);
+
+    const auto measure = [&](const std::string &variant, const char *pattern) {
+        u64 patternCount = 0;
+        state.measure(variant, data.size(), [&] {
+            pl::PatternLanguage runtime;
+            ContentRegistry::PatternLanguage::configureRuntime(runtime, &provider);
+            runtime.setDangerousFunctionCallHandler([] { return false; });
+
+            if (runtime.executeString(pattern) != 0)
+                return;
+
+            patternCount = runtime.getCreatedPatternCount();
+        });
+        state.setCounter("created_patterns", double(patternCount));
+    };
+
+    measure("Static struct array", StaticStructArray);
+    measure("Dynamic struct array", DynamicStructArray);
+}
@@ -0,0 +1,126 @@
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/test_provider.hpp>
+
+#include <hex/helpers/literals.hpp>
+#include <hex/helpers/patches.hpp>
+
+#include <content/providers/file_provider.hpp>
+#include <content/providers/undo_operations/operation_write.hpp>
+
+#include <wolv/io/file.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace hex;
+using namespace hex::literals;
+using namespace hex::plugin::builtin;
+
+namespace {
+
+    void benchmarkFileProviderReads(test::BenchmarkState &state, const std::string &mode, prv::Provider &provider, const std::vector<u64> &offsets) {
+        const auto size = provider.getActualSize();
+
+        state.measure(fmt::format("{}, sequential 4 KiB reads", mode), size, [&] {
+            std::array<u8, 4_KiB> buffer = { };
+            for (u64 offset = 0; offset + buffer.size() <= size; offset += buffer.size()) {
+                provider.read(offset, buffer.data(), buffer.size());
+                test::doNotOptimize(buffer);
+            }
+        });
+
+        state.measure(fmt::format("{}, random 16 byte reads", mode), offsets.size() * 16, [&] {
+            std::array<u8, 16> buffer = { };
+            for (const auto offset : offsets) {
+                provider.read(offset, buffer.data(), buffer.size());
+                test::doNotOptimize(buffer);
+            }
+        });
+    }
+
+}
+
+BENCHMARK("Provider/FileProvider") {
+    const auto data = test::generateBenchmarkData(test::BenchmarkData::Binary, 64_MiB);
+    const auto path = std::fs::temp_directory_path() / "imhex_benchmark_file_provider.bin";
+    {
+        wolv::io::File file(path, wolv::io::File::Mode::Create);
+        file.writeVector(data);
+    }
+
+    std::mt19937_64 random(0x5EED);
+    std::vector<u64> offsets(200'000);
+    std::ranges::generate(offsets, [&] { return random() % (data.size() - 16); });
+
+    // Reads go straight to the file
+    {
+        FileProvider provider;
+        provider.setPickedPath(path);
+        if (provider.openReadOnly().isSuccess())
+            benchmarkFileProviderReads(state, "Direct access", provider, offsets);
+        provider.close();
+    }
+
+    // The whole file is loaded into memory when it's opened
+    {
+        FileProvider provider;
+        provider.setPickedPath(path);
+        state.measure("In memory, open", data.size(), [&] {
+            provider.close();
+            std::ignore = provider.open();
+        });
+
+        benchmarkFileProviderReads(state, "In memory", provider, offsets);
+        provider.close();
+    }
+
+    std::error_code error;
+    std::fs::remove(path, error);
+}
+
+BENCHMARK("Provider/UndoStack") {
+    auto data = test::generateBenchmarkData(test::BenchmarkData::Random, 16_MiB);
+    test::TestProvider provider(&data);
+
+    std::mt19937_64 random(0x5EED);
+
+    // Many small edits, the way they're created when typing in the hex editor
+    constexpr static auto EditCount = 100'000;
+    state.measure("Add 100k single byte writes", 0, [&] {
+        provider.getUndoStack().reset();
+
+        for (u32 i = 0; i < EditCount; i += 1) {
+            const auto offset = random() % data.size();
+            const u8 oldValue = data[offset], newValue = u8(random());
+            provider.getUndoStack().add<undo::OperationWrite>(offset, 1, &oldValue, &newValue);
+        }
+    });
+    state.setCounter("memory_usage", double(provider.getUndoStack().getMemoryUsage()));
+
+    state.measure("Generate patches from 100k writes", 0, [&] {
+        test::doNotOptimize(Patches::fromProvider(&provider));
+    });
+
+    state.measure("Undo and redo 100k writes", 0, [&] {
+        provider.getUndoStack().undo(EditCount);
+        provider.getUndoStack().redo(EditCount);
+    });
+
+    // Few large edits, like pasting or filling big regions
+    constexpr static auto LargeEditSize = 1_MiB;
+    const auto largeEdit = test::generateBenchmarkData(test::BenchmarkData::Random, LargeEditSize, 2);
+    state.measure("Add 64 writes of 1 MiB", 64 * LargeEditSize, [&] {
+        provider.getUndoStack().reset();
+
+        for (u32 i = 0; i < 64; i += 1) {
+            const auto offset = random() % (data.size() - LargeEditSize);
+            provider.getUndoStack().add<undo::OperationWrite>(offset, LargeEditSize, data.data() + offset, largeEdit.data());
+        }
+    });
+    state.setCounter("memory_usage", double(provider.getUndoStack().getMemoryUsage()));
+
+    provider.getUndoStack().reset();
+}
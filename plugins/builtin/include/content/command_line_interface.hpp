@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <span>
 
 namespace hex::plugin::builtin {
@@ -22,8 +23,10 @@ namespace hex::plugin::builtin {
     int handleEncodeCommand(std::span<const std::string> args);
     int handleDecodeCommand(std::span<const std::string> args);
     int handleMagicCommand(std::span<const std::string> args);
+    int handleAnalyzeCommand(std::span<const std::string> args);
     int handlePatternLanguageCommand(std::span<const std::string> args);
     int handleHexdumpCommand(std::span<const std::string> args);
+    int handleFindCommand(std::span<const std::string> args);
     int handleDemangleCommand(std::span<const std::string> args);
     int handleSettingsResetCommand(std::span<const std::string> args);
     int handleDebugModeCommand(std::span<const std::string> args);
@@ -35,4 +38,10 @@ namespace hex::plugin::builtin {
 
     void registerCommandForwarders();
 
+    /**
+     * @brief Matches a path against a glob pattern as used by the --analyze command
+     * @note * and ? match any characters except for a path separator, ** matches across separators
+     */
+    bool matchesGlob(std::string_view pattern, std::string_view string);
+
 }
\ No newline at end of file
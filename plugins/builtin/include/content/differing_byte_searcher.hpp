@@ -1,19 +1,23 @@
 #pragma once
 
-#include <functional>
 #include <hex/providers/provider.hpp>
 #include <wolv/types.hpp>
 
+#include <optional>
+
 namespace hex::plugin::builtin {
 
-    void findNextDifferingByte(
-        const std::function< u64(prv::Provider*) >& lastValidAddressProvider,
-        const std::function< bool(u64, u64) >& addressComparator,
-        const std::function< void(u64*) >& addressStepper,
-        bool *didFindNextValue,
-        bool *didReachEndAddress,
-        u64* foundAddress
-    );
+    enum class SearchDirection {
+        Forward,
+        Backward
+    };
+
+    /**
+     * @brief Searches for the closest byte that differs from the currently selected one
+     * @param direction Direction to search in, starting at the selected byte
+     * @return Address of the differing byte or std::nullopt if the start or end of the data has been reached
+     */
+    std::optional<u64> findNextDifferingByte(SearchDirection direction);
 
     bool canSearchForDifferingByte();
-}
\ No newline at end of file
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <bitset>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hex { class Task; }
+namespace hex::prv { class Provider; }
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Regular expression that is matched against raw bytes instead of extracted strings
+     * @details The expression is compiled into an NFA that is turned into a DFA lazily while scanning, so every byte
+     * is only looked at once and there's no backtracking. DFA states are cached, the cache is flushed once it grows
+     * too large. Matches follow the leftmost-longest rule and never overlap. A match is only replaced by a longer one if
+     * that one ends at most MaxMatchExtension bytes after it, which bounds how much data has to be held back while scanning.
+     *
+     * Supported syntax: literals, `.` (any byte), `[...]` and `[^...]` classes, `\\xHH`, `\\d \\w \\s` and their negations,
+     * `\\n \\r \\t \\f \\v \\0`, groups `(...)` and `(?:...)`, alternation `|` and the quantifiers `* + ? {n} {n,} {n,m}`.
+     * Anchors, backreferences and lazy quantifiers are not supported
+     */
+    class ByteRegex {
+    public:
+        constexpr static size_t MaxMatchExtension = 0x1'0000;
+
+        /**
+         * @brief Compiles a regular expression
+         * @param pattern Expression to compile
+         * @throws std::invalid_argument if the pattern is invalid, uses unsupported syntax or matches empty data
+         */
+        explicit ByteRegex(std::string_view pattern);
+
+        /**
+         * @brief Finds all matches in a region of a provider
+         * @details The region is split into chunks that are scanned in parallel. Matches crossing the boundary of a chunk
+         * are found by continuing the scan of the previous chunk until it is in sync with the scan of the next one again
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search
+         * @param chunkSize Size of the chunks that get processed in parallel
+         * @return Matches sorted by their address
+         */
+        [[nodiscard]] std::vector<Region> search(Task &task, prv::Provider *provider, Region region, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all matches in a region of a provider and hands them out while the search is still running
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search
+         * @param callback Function called with the matches completed by each chunk, in address order
+         * @param chunkSize Size of the chunks that get processed in parallel
+         */
+        void search(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const Region>)> &callback, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all matches in a buffer on the calling thread
+         * @param data Data to search
+         * @param address Address of the first byte of the data
+         * @return Matches sorted by their address
+         */
+        [[nodiscard]] std::vector<Region> search(std::span<const u8> data, u64 address) const;
+
+    private:
+        constexpr static u32 InvalidNode = 0xFFFF'FFFF;
+
+        struct Node {
+            enum class Type : u8 { Bytes, Split, Match } type;
+            std::bitset<256> bytes = { };
+            u32 next = InvalidNode;
+            u32 alternative = InvalidNode;
+        };
+
+        class Parser;
+        class LazyDfa;
+        class Scanner;
+
+        u32 addNode(Node node);
+        void computeByteClasses();
+
+    private:
+        std::vector<Node> m_nodes;
+        u32 m_startNode = InvalidNode, m_matchNode = InvalidNode;
+
+        // Bytes that are treated the same way by every node share a class, which keeps the DFA transition tables small
+        std::array<u8, 256> m_byteClasses = { };
+        std::vector<u8> m_classRepresentatives;
+    };
+
+}
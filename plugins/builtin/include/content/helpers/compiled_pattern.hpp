@@ -0,0 +1,49 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <pl/pattern_language.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Pattern language code that is compiled once and can then be evaluated many times
+     * @details executeString() preprocesses, parses and validates the code again on every call. This keeps the AST instead
+     * and only repeats what executeString() does around the evaluation: resetting the runtime and running the handlers of
+     * the code's pragmas, which change settings like the default endianness or the evaluation limits
+     */
+    class CompiledPattern {
+    public:
+        /**
+         * @brief Compiles code
+         * @param runtime Runtime to compile the code with
+         * @param code Code to compile
+         * @return The compiled code or std::nullopt if it failed to compile. The runtime's compile errors describe why
+         */
+        static std::optional<CompiledPattern> compile(pl::PatternLanguage &runtime, const std::string &code);
+
+        /**
+         * @brief Evaluates the compiled code
+         * @param runtime Runtime to evaluate the code with. The patterns it creates are held by the runtime's evaluator
+         * @param inVariables Values of the code's in variables
+         * @return True if the evaluation succeeded, otherwise the last hard error of the evaluator's console describes why
+         */
+        [[nodiscard]] bool execute(pl::PatternLanguage &runtime, const std::map<std::string, pl::core::Token::Literal> &inVariables) const;
+
+    private:
+        CompiledPattern() = default;
+
+    private:
+        std::vector<std::shared_ptr<pl::core::ast::ASTNode>> m_ast;
+
+        // The code's pragma directives on their own
+        std::string m_pragmas;
+    };
+
+}
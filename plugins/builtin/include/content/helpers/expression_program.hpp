@@ -0,0 +1,84 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief A math expression compiled into a flat stack-based program
+     * @note Only supports the integer operators, number literals and the `value` and `offset` variables that can be used
+     * in highlight rules. This allows the expression to be parsed once and then evaluated for many inputs at once
+     * instead of re-parsing the expression string for every single evaluation
+     */
+    class ExpressionProgram {
+    public:
+        /**
+         * @brief Compiles an expression into a program
+         * @param expression Expression to compile
+         * @return The compiled program or std::nullopt if the expression is invalid or uses unsupported features
+         */
+        [[nodiscard]] static std::optional<ExpressionProgram> compile(std::string_view expression);
+
+        /**
+         * @brief Evaluates the program for a single set of inputs
+         * @return The result or std::nullopt if the evaluation failed, e.g. due to a division by zero
+         */
+        [[nodiscard]] std::optional<i128> evaluate(i128 value, i128 offset) const;
+
+        /**
+         * @brief Evaluates the program for many sets of inputs at once
+         * @param values Values of the `value` variable
+         * @param offsets Values of the `offset` variable, must have the same size as values
+         * @param results Output. Set to 1 for every input where the program evaluated to a non-zero result
+         */
+        void evaluate(std::span<const i128> values, std::span<const i128> offsets, std::span<u8> results) const;
+
+    private:
+        enum class OpCode : u8 {
+            PushConstant,
+            PushValue,
+            PushOffset,
+
+            Negate,
+            BitwiseNot,
+            LogicalNot,
+
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo,
+            BitwiseAnd,
+            BitwiseOr,
+            BitwiseXor,
+            ShiftLeft,
+            ShiftRight,
+            Equal,
+            NotEqual,
+            Less,
+            Greater,
+            LessEqual,
+            GreaterEqual,
+            LogicalAnd,
+            LogicalOr
+        };
+
+        struct Instruction {
+            OpCode opCode;
+            i128 constant = 0;
+        };
+
+        class Compiler;
+
+        static bool applyBinary(OpCode opCode, i128 lhs, i128 rhs, i128 &result);
+
+        std::vector<Instruction> m_instructions;
+        size_t m_maxStackDepth = 0;
+    };
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <ui/hex_editor.hpp>
+
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Resolves all interval based highlight sources and static highlights of one layer into a sorted list
+     * of non-overlapping color runs covering the visible region of the hex editor
+     * @note The result is cached and only rebuilt when the visible region, the provider or the version of any highlight
+     * source changes, so a frame without changes costs a handful of comparisons. Everything else, like a change of the
+     * hovered regions, has to be signalled through invalidate()
+     */
+    class HighlightCompositor {
+    public:
+        enum class Layer {
+            Foreground,
+            Background
+        };
+
+        explicit HighlightCompositor(Layer layer) : m_layer(layer) { }
+
+        /**
+         * @brief Resolves the color runs of the given region
+         * @param provider Provider the region belongs to
+         * @param visibleRegion Region that is currently visible in the hex editor
+         * @param hoveredRegions Regions that should be emphasized because they're currently hovered
+         * @return Sorted, non-overlapping list of color runs. Stays valid until the next call
+         */
+        std::span<const ui::HexEditor::HighlightRun> resolve(const prv::Provider *provider, const Region &visibleRegion, const std::set<Region> &hoveredRegions = { });
+
+        /**
+         * @brief Forces the runs to be rebuilt on the next call to resolve()
+         */
+        void invalidate() { m_valid = false; }
+
+    private:
+        [[nodiscard]] std::vector<std::pair<u32, u64>> getSourceVersions() const;
+        void rebuild(const prv::Provider *provider, const Region &visibleRegion, const std::set<Region> &hoveredRegions);
+
+        Layer m_layer;
+
+        bool m_valid = false;
+        const prv::Provider *m_provider = nullptr;
+        Region m_region = Region::Invalid();
+        u64 m_highlightsVersion = 0;
+        std::vector<std::pair<u32, u64>> m_sourceVersions;
+
+        std::vector<ui::HexEditor::HighlightRun> m_runs;
+    };
+
+}
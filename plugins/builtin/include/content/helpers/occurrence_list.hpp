@@ -0,0 +1,159 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/api/content_registry/data_formatter.hpp>
+
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hex { class Task; }
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Compact storage for the results of a search
+     * @details Occurrences are stored column by column instead of as an array of FindOccurrence structs. Decode type, endianness
+     * and selection state are packed into a single byte, sizes are only stored per occurrence once they differ and labels are
+     * interned so all occurrences of the same constant share a single string. Values aren't stored at all, they get decoded
+     * from the provider whenever they're needed
+     */
+    class OccurrenceList {
+    public:
+        using Occurrence = ContentRegistry::DataFormatter::impl::FindOccurrence;
+        using value_type = Occurrence;
+
+        class Iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = Occurrence;
+            using difference_type   = std::ptrdiff_t;
+
+            Iterator() = default;
+            Iterator(const OccurrenceList *list, size_t index) : m_list(list), m_index(index) { }
+
+            Occurrence operator*() const { return (*m_list)[m_index]; }
+            Iterator& operator++() { m_index += 1; return *this; }
+            Iterator operator++(int) { auto copy = *this; m_index += 1; return copy; }
+            bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+
+        private:
+            const OccurrenceList *m_list = nullptr;
+            size_t m_index = 0;
+        };
+
+        void push_back(const Occurrence &occurrence);
+        void reserve(size_t count);
+        void clear();
+
+        [[nodiscard]] size_t size() const { return m_addresses.size(); }
+        [[nodiscard]] bool empty() const { return m_addresses.empty(); }
+
+        [[nodiscard]] Occurrence operator[](size_t index) const;
+        [[nodiscard]] Iterator begin() const { return { this, 0 }; }
+        [[nodiscard]] Iterator end() const { return { this, this->size() }; }
+
+        [[nodiscard]] Region getRegion(size_t index) const { return { m_addresses[index], this->getSize(index) }; }
+        [[nodiscard]] bool isSelected(size_t index) const { return (m_flags[index] & SelectedFlag) != 0; }
+        void setSelected(size_t index, bool selected);
+        void clearSelection();
+
+        /**
+         * @brief Sorts the occurrences by their address and prepares the lookup of overlapping occurrences
+         */
+        void sort();
+
+        /**
+         * @brief Finds all occurrences that overlap a region
+         * @note Only valid after sort() has been called
+         * @param region Region to check
+         * @return Indices of the overlapping occurrences
+         */
+        [[nodiscard]] std::vector<u32> findOverlapping(Region region) const;
+
+        /**
+         * @brief Checks whether any occurrence overlaps a region
+         * @note Only valid after sort() has been called
+         * @param region Region to check
+         * @return True if at least one occurrence overlaps the region
+         */
+        [[nodiscard]] bool hasOverlapping(Region region) const;
+
+    private:
+        [[nodiscard]] u64 getSize(size_t index) const;
+        [[nodiscard]] u32 encodeSize(u64 size);
+
+    private:
+        constexpr static u8 DecodeTypeMask        = 0x0F;
+        constexpr static u8 NonNativeEndianFlag   = 0x10;
+        constexpr static u8 SelectedFlag          = 0x20;
+        constexpr static std::endian NonNativeEndian = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+
+        // Sizes with this bit set are an index into m_largeSizes
+        constexpr static u32 LargeSizeFlag = 0x8000'0000;
+
+        // Number of occurrences that share an entry in m_maxEndAddresses
+        constexpr static size_t MaxEndAddressStride = 64;
+
+        std::vector<u64> m_addresses;
+        std::vector<u8> m_flags;
+
+        // Size of the first occurrence. The size column is only filled once an occurrence with a different size gets added
+        u64 m_uniformSize = 0;
+        std::vector<u32> m_sizes;
+        std::vector<u64> m_largeSizes;
+
+        // Highest end address of all occurrences up to the end of each group of MaxEndAddressStride occurrences.
+        // It's sorted as well once the occurrences are
+        std::vector<u64> m_maxEndAddresses;
+
+        // Label 0 means no label. The column is only filled once the first label gets added
+        std::vector<u32> m_labelIndices;
+        std::vector<std::string> m_labels = { "" };
+        std::unordered_map<std::string, u32> m_labelLookup;
+    };
+
+    /**
+     * @brief Trigram index over the decoded values of a list of occurrences
+     * @details Filtering only needs to decode occurrences that contain every trigram of the filter instead of all of them.
+     * Building the index decodes every value once, which happens in the background once the results of a search get filtered for the first time
+     */
+    class OccurrenceFilterIndex {
+    public:
+        // Occurrences larger than this aren't indexed and always need to be checked
+        constexpr static size_t MaxIndexedSize = 256;
+
+        // Filtering fewer occurrences than this by decoding all of them is fast enough to not need an index
+        constexpr static size_t MinOccurrenceCount = 0x1'0000;
+
+        // Indexing gets aborted once the index would use more memory than this many entries
+        constexpr static size_t MaxEntryCount = 0x400'0000;
+
+        /**
+         * @brief Builds the index
+         * @param task Task to report the progress to
+         * @param occurrences Occurrences to index
+         * @param decode Function that decodes the value of an occurrence
+         * @return Whether the index has been built. Fails if the index would grow too large
+         */
+        bool build(Task &task, const OccurrenceList &occurrences, const std::function<std::string(const OccurrenceList::Occurrence&)> &decode);
+
+        /**
+         * @brief Finds the occurrences that may contain a filter, ignoring case
+         * @param filter Filter string
+         * @return Sorted indices of the occurrences that may contain the filter or std::nullopt if the filter is too short to use the index
+         */
+        [[nodiscard]] std::optional<std::vector<u32>> getCandidates(std::string_view filter) const;
+
+    private:
+        std::unordered_map<u32, std::vector<u32>> m_entries;
+        std::vector<u32> m_unindexed;
+    };
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace hex { class Task; }
+namespace hex::prv { class Provider; }
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Finds runs of characters in binary data, the engine behind the string search of the find view
+     * @details Bytes are classified 64 at a time into valid characters, null bytes and non-ASCII bytes. Runs are then found
+     * by scanning these bit masks instead of looking at every byte individually. Large regions are split into chunks that are
+     * processed on multiple threads. Every chunk starts scanning at the first byte that ends a string in any state, everything
+     * before that is scanned once the end state of the previous chunk is known
+     */
+    class StringExtractor {
+    public:
+        enum class Encoding : u8 { ASCII, UTF8, UTF16LE, UTF16BE };
+
+        struct Run {
+            u64 address;
+            u64 size;
+
+            bool operator==(const Run &) const = default;
+        };
+
+        /**
+         * @brief Creates a new extractor
+         * @param encoding Encoding of the strings
+         * @param validCharacters Table of the ASCII characters that may be part of a string
+         * @param minLength Minimum number of bytes a string needs to have to be reported
+         * @param nullTermination Only report strings that are followed by a null byte
+         */
+        StringExtractor(Encoding encoding, const std::array<bool, 256> &validCharacters, i64 minLength, bool nullTermination);
+
+        /**
+         * @brief Finds all strings in a region of a provider
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search
+         * @param chunkSize Size of the chunks that get processed in parallel
+         * @return Strings sorted by their address
+         */
+        [[nodiscard]] std::vector<Run> extract(Task &task, prv::Provider *provider, Region region, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all strings in a region of a provider and hands them out while the search is still running
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search
+         * @param callback Function called with the strings completed by each chunk, in address order
+         * @param chunkSize Size of the chunks that get processed in parallel
+         */
+        void extract(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const Run>)> &callback, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all strings in a buffer on the calling thread
+         * @param data Data to search
+         * @param address Address of the first byte of the data
+         * @return Strings sorted by their address
+         */
+        [[nodiscard]] std::vector<Run> extract(std::span<const u8> data, u64 address) const;
+
+    private:
+        struct State {
+            u64 startAddress = 0;
+            u64 count = 0;
+            u8 remainingContinuationBytes = 0;
+        };
+
+        struct Masks {
+            u64 valid, zero, high;
+        };
+
+        [[nodiscard]] Masks classify(const u8 *data, size_t size) const;
+        [[nodiscard]] bool isSynchronizationPoint(u8 byte) const;
+        [[nodiscard]] std::optional<size_t> findSynchronizationPoint(std::span<const u8> data) const;
+
+        void scan(State &state, std::span<const u8> data, u64 address, std::vector<Run> &runs) const;
+        void scanUtf8Byte(State &state, u8 byte, u64 address, std::vector<Run> &runs) const;
+        void endRun(State &state, u8 terminator, u64 address, std::vector<Run> &runs) const;
+        void finish(State &state, u8 lastByte, std::vector<Run> &runs) const;
+
+    private:
+        Encoding m_encoding;
+        std::array<bool, 256> m_validCharacters;
+        u64 m_minLength;
+        bool m_nullTermination;
+
+        // Lookup tables used to classify 16 bytes at once. Only usable if no byte above 0x7F is a valid character
+        bool m_vectorizable = false;
+        std::array<u8, 16> m_lowNibbleTable = { };
+    };
+
+}
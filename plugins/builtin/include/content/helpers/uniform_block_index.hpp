@@ -0,0 +1,120 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/api/task_manager.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Index that stores for every block of a provider whether all of its bytes have the same value
+     * @note The index of a provider is created the first time it's requested and then built in the background. Blocks are
+     * queued up again whenever an operation on the provider's undo stack changes their data. Code walking through data can use it
+     * to skip over zero filled or erased regions without reading them
+     */
+    class UniformBlockIndex {
+    public:
+        /**
+         * @brief State of a single block. Values between 0x00 and 0xFF mean that every byte in the block has that value
+         */
+        using BlockState = u16;
+        constexpr static BlockState Mixed   = 0x100;
+        constexpr static BlockState Unknown = 0x200;
+
+        constexpr static u64 MinBlockSize = 0x1000;
+
+        /**
+         * @brief States of all blocks of the data. Stays valid when the index gets rebuilt for a different data size,
+         * later changes to the data are then only reflected in the new blocks
+         */
+        class Blocks {
+        public:
+            Blocks(u64 dataSize, u64 blockSize);
+
+            [[nodiscard]] u64 getDataSize() const { return m_dataSize; }
+            [[nodiscard]] u64 getBlockSize() const { return m_blockSize; }
+            [[nodiscard]] u64 getBlockCount() const { return m_blockCount; }
+
+            /**
+             * @brief Gets the state of a block
+             * @param index Index of the block, the block starts at offset index * getBlockSize() relative to the base address
+             * @return Uniform value of the block, Mixed or Unknown if the block hasn't been indexed yet
+             */
+            [[nodiscard]] BlockState getState(u64 index) const;
+
+        private:
+            friend class UniformBlockIndex;
+
+            u64 m_dataSize, m_blockSize, m_blockCount;
+            std::unique_ptr<std::atomic<BlockState>[]> m_states;
+        };
+
+        UniformBlockIndex() = default;
+        UniformBlockIndex(const UniformBlockIndex&) = delete;
+        UniformBlockIndex& operator=(const UniformBlockIndex&) = delete;
+        ~UniformBlockIndex();
+
+        /**
+         * @brief Keeps the indices of providers up to date and removes them once their provider gets closed
+         */
+        static void initialize();
+
+        /**
+         * @brief Gets the index of a provider, creating it the first time it's requested
+         * @param provider Provider to get the index of
+         * @return Index of the provider or nullptr if the provider can't be read
+         */
+        [[nodiscard]] static std::shared_ptr<UniformBlockIndex> get(prv::Provider *provider);
+
+        [[nodiscard]] std::shared_ptr<const Blocks> getBlocks() const;
+        [[nodiscard]] bool isIndexing() const;
+
+        /**
+         * @brief Splits a region into the parts that may contain any of the given bytes.
+         * Only runs of blocks that are long enough to be worth skipping are left out
+         * @param baseAddress Base address of the provider
+         * @param region Region to split
+         * @param usedBytes Bytes that the parts need to be searched for
+         * @return Parts of the region, sorted by their address
+         */
+        [[nodiscard]] std::vector<Region> getCandidateRegions(u64 baseAddress, Region region, const std::array<bool, 256> &usedBytes) const;
+
+        /**
+         * @brief Updates the index after data changed
+         * @param provider Provider whose data changed
+         * @param region Region of the change relative to the base address. If the size of the data changed, everything after its start is reindexed
+         */
+        void update(prv::Provider *provider, Region region);
+
+    private:
+        [[nodiscard]] std::shared_ptr<Blocks> getCurrentBlocks() const;
+
+        void rebuild(prv::Provider *provider, u64 fromOffset);
+        void invalidate(prv::Provider *provider, u64 offset, u64 size);
+        void stop();
+
+        void startIndexing(prv::Provider *provider);
+        void indexBlocks(Task &task, prv::Provider *provider, Blocks &blocks);
+
+    private:
+        // Marks a block that's currently being read so changes made in the meantime aren't overwritten
+        constexpr static BlockState Scanning = 0x300;
+
+        mutable std::mutex m_blocksMutex;
+        std::shared_ptr<Blocks> m_blocks;
+
+        mutable std::mutex m_taskMutex;
+        TaskHolder m_task;
+        bool m_taskActive = false;
+        bool m_dirty = false;
+    };
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <bit>
+#include <span>
+#include <vector>
+
+namespace hex { class Task; }
+namespace hex::prv { class Provider; }
+
+namespace hex::plugin::builtin {
+
+    /**
+     * @brief Finds numeric values that lie within a range, the engine behind the value search of the find view
+     * @details Data is processed in blocks of 32 bytes. Every value starting in a block is loaded into a vector lane, byte
+     * swapped if needed and compared against both bounds at once, which results in a bit mask of the matching positions.
+     * If every byte offset needs to be checked, the block is loaded once per byte of the value, each time shifted by one.
+     * Large regions are split into chunks that are processed on multiple threads
+     *
+     * Instantiated for all integer types from 8 to 64 bit as well as float and double
+     */
+    template<typename T>
+    class ValueSearcher {
+    public:
+        /**
+         * @brief Creates a new searcher
+         * @param min Smallest value that's reported
+         * @param max Largest value that's reported
+         * @param endian Endianness of the values in the data
+         */
+        ValueSearcher(T min, T max, std::endian endian);
+
+        /**
+         * @brief Finds all values in a region of a provider
+         * @param task Task to report the progress to
+         * @param provider Provider to search
+         * @param region Region to search. Only values that lie fully inside of it are reported
+         * @param stride Only check values whose distance to the start of the region is a multiple of this
+         * @param chunkSize Size of the chunks that get processed in parallel
+         * @return Addresses of all values, sorted
+         */
+        [[nodiscard]] std::vector<u64> findAll(Task &task, prv::Provider *provider, Region region, u64 stride = 1, size_t chunkSize = 0x40'0000) const;
+
+        /**
+         * @brief Finds all values in a buffer on the calling thread
+         * @param data Data to search
+         * @param address Address of the first byte of the data
+         * @param stride Only check values whose distance to the start of the data is a multiple of this
+         * @return Addresses of all values, sorted
+         */
+        [[nodiscard]] std::vector<u64> findAll(std::span<const u8> data, u64 address, u64 stride = 1) const;
+
+    private:
+        [[nodiscard]] bool matches(const u8 *data) const;
+        void search(std::span<const u8> data, size_t offset, size_t endOffset, u64 stride, u64 address, std::vector<u64> &result) const;
+
+    private:
+        T m_min, m_max;
+        std::endian m_endian;
+    };
+
+}
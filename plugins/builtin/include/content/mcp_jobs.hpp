@@ -0,0 +1,112 @@
+#pragma once
+
+#include <hex.hpp>
+#include <hex/api/task_manager.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex::plugin::builtin::mcp_jobs {
+
+    /**
+     * @brief Analysis started through the MCP server that runs as a task in the background.
+     * Results are collected as rows of a table that the client fetches page by page while
+     * the analysis is still running or after it finished
+     */
+    class Job {
+    public:
+        enum class Status { Running, Finished, Failed, Cancelled };
+
+        Job(u64 id, std::string type, u32 providerId, std::vector<std::string> columns)
+            : m_id(id), m_type(std::move(type)), m_providerId(providerId), m_columns(std::move(columns)) { }
+
+        /**
+         * @brief Appends a row of results. Binary data in a row should be encoded with encodeData()
+         * @param row Array with one value per column
+         */
+        void addRow(nlohmann::json row);
+        void addRows(std::vector<nlohmann::json> rows);
+
+        /**
+         * @brief Returns a page of results starting at the given cursor
+         * @param cursor Index of the first row to return, as returned in next_cursor of the previous page
+         * @param limit Maximum number of rows to return
+         * @return Page containing the status of the job and the requested rows
+         */
+        [[nodiscard]] nlohmann::json getPage(u64 cursor, u64 limit) const;
+        [[nodiscard]] nlohmann::json getSummary() const;
+
+        [[nodiscard]] u64 getId() const { return m_id; }
+        [[nodiscard]] u32 getProviderId() const { return m_providerId; }
+        [[nodiscard]] Status getStatus() const;
+
+    private:
+        friend nlohmann::json startJob(const std::string &, prv::Provider *, ProgressValue, std::vector<std::string>, std::function<void(Task &, Job &)>);
+        friend bool cancelJob(u64);
+
+        void setStatus(Status status, std::string error = "");
+
+    private:
+        u64 m_id;
+        std::string m_type;
+        u32 m_providerId;
+        std::vector<std::string> m_columns;
+
+        mutable std::mutex m_mutex;
+        std::vector<nlohmann::json> m_rows;
+        Status m_status = Status::Running;
+        std::string m_error;
+        TaskHolder m_task;
+    };
+
+    /**
+     * @brief Encodes binary data so it can be safely transferred as part of a result row
+     * @param data Data to encode
+     * @return Base64 encoded data
+     */
+    [[nodiscard]] std::string encodeData(std::span<const u8> data);
+
+    /**
+     * @brief Starts a new job that runs the given function as a task
+     * @param type Name of the analysis, shown in the job list
+     * @param provider Provider the analysis runs on
+     * @param maxValue Maximum progress value of the task
+     * @param columns Names of the columns of the result rows
+     * @param function Function running the analysis and adding its results to the job
+     * @return Tool result containing the id of the started job
+     */
+    nlohmann::json startJob(const std::string &type, prv::Provider *provider, ProgressValue maxValue, std::vector<std::string> columns, std::function<void(Task &, Job &)> function);
+
+    /**
+     * @brief Interrupts a job if it's still running and discards its results
+     * @param id Id of the job
+     * @return True if a job with this id existed
+     */
+    bool cancelJob(u64 id);
+
+    /**
+     * @brief Resolves the data source an analysis tool should run on
+     * @param arguments Arguments of the tool call. Uses the provider with the id given by "handle" or the currently selected one if no handle was passed
+     * @return Provider to use
+     */
+    [[nodiscard]] prv::Provider* getProvider(const nlohmann::json &arguments);
+
+    /**
+     * @brief Resolves the region an analysis tool should run on from the optional "address" and "size" arguments
+     * @param provider Provider the analysis runs on
+     * @param arguments Arguments of the tool call
+     * @return Region to analyze, clamped to the data of the provider
+     */
+    [[nodiscard]] Region getRegion(prv::Provider *provider, const nlohmann::json &arguments);
+
+    void registerJobTools();
+
+}
@@ -2,6 +2,7 @@
 
 #include <content/views/view_hex_editor.hpp>
 #include <hex/api/localization_manager.hpp>
+#include <hex/providers/lazy_overlay.hpp>
 #include <string>
 
 namespace hex::plugin::builtin {
@@ -17,6 +18,7 @@ namespace hex::plugin::builtin {
         u64 m_address;
         u64 m_size;
         std::string m_input;
+        prv::LazyOverlay::Type m_mode = prv::LazyOverlay::Type::Fill;
         bool m_randomBytes = false;
     };
 }
\ No newline at end of file
@@ -56,6 +56,12 @@ namespace hex::plugin::builtin {
         [[nodiscard]] OpenResult open() override;
         void close() override;
 
+        /**
+         * @brief Opens the file read-only and streams all reads straight from disk
+         * @note Never loads the file into memory, locks it or tracks changes to it. Used for headless batch processing
+         */
+        [[nodiscard]] OpenResult openReadOnly();
+
         void loadSettings(const nlohmann::json &settings) override;
         [[nodiscard]] nlohmann::json storeSettings(nlohmann::json settings) const override;
 
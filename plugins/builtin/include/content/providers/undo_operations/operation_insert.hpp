@@ -14,10 +14,12 @@ namespace hex::plugin::builtin::undo {
 
         void undo(prv::Provider *provider) override {
             provider->removeRaw(m_offset, m_size);
+            provider->moveLazyOverlays(m_offset + m_size, -i64(m_size));
         }
 
         void redo(prv::Provider *provider) override {
             provider->insertRaw(m_offset, m_size);
+            provider->moveLazyOverlays(m_offset, i64(m_size));
         }
 
         [[nodiscard]] std::string format() const override {
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <hex/providers/provider.hpp>
+#include <hex/providers/undo_redo/operations/operation.hpp>
+#include <hex/providers/undo_redo/undo_buffer.hpp>
+
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/utils.hpp>
+
+namespace hex::plugin::builtin::undo {
+
+    class OperationLazyOverlay : public prv::undo::Operation {
+    public:
+        explicit OperationLazyOverlay(prv::LazyOverlay overlay) : m_overlay(std::move(overlay)) { }
+
+        void undo(prv::Provider *provider) override {
+            provider->removeLazyOverlay(m_overlay.getId());
+
+            // Parts of the overlay that got written to the data in the meantime need their previous data back
+            for (const auto &[position, data] : m_materializedData) {
+                const auto bytes = data.get();
+                provider->writeRaw(m_overlay.getOrigin() + position, bytes.data(), bytes.size());
+            }
+        }
+
+        void redo(prv::Provider *provider) override {
+            m_materializedData.clear();
+            provider->addLazyOverlay(m_overlay);
+        }
+
+        void materializeLazyOverlays(prv::Provider *provider, const std::function<bool(u64)> &keepResident) override {
+            const auto overlays = provider->getLazyOverlays();
+
+            for (const auto &piece : *overlays) {
+                if (piece.getId() != m_overlay.getId())
+                    continue;
+
+                // Pieces may have moved since the overlay was created, so their data is stored by its position within the overlay.
+                // By the time this operation gets undone, all operations after it have been undone and the overlay is back where it started
+                const auto &region = piece.getRegion();
+                for (u64 offset = 0; offset < region.getSize(); offset += MaterializedChunkSize) {
+                    const auto address = region.getStartAddress() + offset;
+                    std::vector<u8> data(std::min<u64>(MaterializedChunkSize, region.getSize() - offset));
+                    provider->readRaw(address, data.data(), data.size());
+
+                    // The data this overlay replaced already contains the result of all overlays created before it
+                    for (const auto &overlay : *overlays) {
+                        if (overlay.getId() >= m_overlay.getId())
+                            break;
+
+                        overlay.apply(address, data);
+                    }
+
+                    prv::undo::UndoBuffer buffer(data);
+                    if (!keepResident(data.size()))
+                        buffer.offload();
+
+                    m_materializedData.emplace_back(address - piece.getOrigin(), std::move(buffer));
+                }
+            }
+        }
+
+        [[nodiscard]] std::string format() const override {
+            return fmt::format("hex.builtin.undo_operation.lazy_overlay"_lang, hex::toByteString(m_overlay.getRegion().getSize()), m_overlay.getRegion().getStartAddress());
+        }
+
+        std::vector<std::string> formatContent() const override {
+            switch (m_overlay.getType()) {
+                using enum prv::LazyOverlay::Type;
+                case Fill:   return { fmt::format("= {}", hex::crypt::encode16(m_overlay.getKey())) };
+                case Xor:    return { fmt::format("^ {}", hex::crypt::encode16(m_overlay.getKey())) };
+                case Add:    return { fmt::format("+ {}", hex::crypt::encode16(m_overlay.getKey())) };
+                case Random: return { "?" };
+            }
+
+            return { };
+        }
+
+        std::unique_ptr<Operation> clone() const override {
+            return std::make_unique<OperationLazyOverlay>(*this);
+        }
+
+        [[nodiscard]] Region getRegion() const override {
+            return m_overlay.getRegion();
+        }
+
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            size_t result = 0;
+            for (const auto &[position, data] : m_materializedData)
+                result += data.getMemoryUsage();
+
+            return result;
+        }
+
+        void offload() override {
+            for (auto &[position, data] : m_materializedData)
+                data.offload();
+        }
+
+    private:
+        constexpr static u64 MaterializedChunkSize = 1024 * 1024;
+
+        prv::LazyOverlay m_overlay;
+
+        // Data replaced by the parts of the overlay that have been written to the provider, e.g. by saving it. Stored by the position within the overlay
+        std::vector<std::pair<u64, prv::undo::UndoBuffer>> m_materializedData;
+    };
+
+    /**
+     * @brief Wraps an operation that modifies data covered by lazy overlays. Before the operation is done, the overlays
+     * in its region are written to the provider and cut out of the overlays, so the operation works on their result.
+     * Undoing it restores the original data and the removed pieces
+     */
+    class OperationMaterializeLazyOverlays : public prv::undo::Operation {
+    public:
+        OperationMaterializeLazyOverlays(Region region, std::unique_ptr<Operation> &&operation) : m_region(region), m_operation(std::move(operation)) { }
+
+        OperationMaterializeLazyOverlays(const OperationMaterializeLazyOverlays &other)
+            : m_region(other.m_region), m_operation(other.m_operation->clone()), m_originalData(other.m_originalData), m_removedPieces(other.m_removedPieces) { }
+
+        void undo(prv::Provider *provider) override {
+            m_operation->undo(provider);
+
+            const auto originalData = m_originalData.get();
+            provider->writeRaw(m_region.getStartAddress(), originalData.data(), originalData.size());
+            for (const auto &piece : m_removedPieces)
+                provider->addLazyOverlay(piece);
+        }
+
+        void redo(prv::Provider *provider) override {
+            std::vector<u8> originalData(m_region.getSize());
+            provider->readRaw(m_region.getStartAddress(), originalData.data(), originalData.size());
+            m_originalData = prv::undo::UndoBuffer(originalData);
+
+            m_removedPieces = provider->materializeLazyOverlays(m_region);
+            m_operation->redo(provider);
+        }
+
+        [[nodiscard]] std::string format() const override {
+            return m_operation->format();
+        }
+
+        std::vector<std::string> formatContent() const override {
+            return m_operation->formatContent();
+        }
+
+        std::unique_ptr<Operation> clone() const override {
+            return std::make_unique<OperationMaterializeLazyOverlays>(*this);
+        }
+
+        [[nodiscard]] Region getRegion() const override {
+            return m_operation->getRegion();
+        }
+
+        [[nodiscard]] bool shouldHighlight() const override {
+            return m_operation->shouldHighlight();
+        }
+
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return m_operation->getMemoryUsage() + m_originalData.getMemoryUsage();
+        }
+
+        void offload() override {
+            m_operation->offload();
+            m_originalData.offload();
+        }
+
+        void materializeLazyOverlays(prv::Provider *provider, const std::function<bool(u64)> &keepResident) override {
+            m_operation->materializeLazyOverlays(provider, keepResident);
+        }
+
+    private:
+        Region m_region;
+        std::unique_ptr<Operation> m_operation;
+
+        prv::undo::UndoBuffer m_originalData;
+        std::vector<prv::LazyOverlay> m_removedPieces;
+    };
+
+}
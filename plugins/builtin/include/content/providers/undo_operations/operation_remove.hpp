@@ -14,6 +14,7 @@ namespace hex::plugin::builtin::undo {
 
         void undo(prv::Provider *provider) override {
             provider->insertRaw(m_offset, m_size);
+            provider->moveLazyOverlays(m_offset, i64(m_size));
 
             provider->writeRaw(m_offset, m_removedData.data(), m_removedData.size());
         }
@@ -23,6 +24,7 @@ namespace hex::plugin::builtin::undo {
             provider->readRaw(m_offset, m_removedData.data(), m_removedData.size());
 
             provider->removeRaw(m_offset, m_size);
+            provider->moveLazyOverlays(m_offset + m_size, -i64(m_size));
         }
 
         [[nodiscard]] std::string format() const override {
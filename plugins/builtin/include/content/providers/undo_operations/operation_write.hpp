@@ -2,36 +2,49 @@
 
 #include <hex/helpers/crypto.hpp>
 #include <hex/providers/undo_redo/operations/operation.hpp>
+#include <hex/providers/undo_redo/undo_buffer.hpp>
 
 #include <hex/helpers/fmt.hpp>
 #include <hex/helpers/utils.hpp>
 
 #include <fonts/vscode_icons.hpp>
 
+#include <limits>
+#include <span>
+
 namespace hex::plugin::builtin::undo {
 
     class OperationWrite : public prv::undo::Operation {
     public:
         OperationWrite(u64 offset, u64 size, const u8 *oldData, const u8 *newData) :
             m_offset(offset),
-            m_oldData(oldData, oldData + size),
-            m_newData(newData, newData + size) { }
+            m_newData(std::span(newData, size)),
+            m_delta(computeDelta(std::span(oldData, size), std::span(newData, size))) { }
 
         void undo(prv::Provider *provider) override {
-            provider->writeRaw(m_offset, m_oldData.data(), m_oldData.size());
+            const auto oldData = this->getOldData();
+            provider->writeRaw(m_offset, oldData.data(), oldData.size());
         }
 
         void redo(prv::Provider *provider) override {
-            provider->writeRaw(m_offset, m_newData.data(), m_newData.size());
+            const auto newData = m_newData.get();
+            provider->writeRaw(m_offset, newData.data(), newData.size());
         }
 
         [[nodiscard]] std::string format() const override {
-            return fmt::format("hex.builtin.undo_operation.write"_lang, hex::toByteString(m_newData.size()), m_offset);
+            return fmt::format("hex.builtin.undo_operation.write"_lang, hex::toByteString(m_newData.getSize()), m_offset);
         }
 
         std::vector<std::string> formatContent() const override {
+            // Don't try to display huge writes in full, only the displayed bytes need to be decoded
+            constexpr static size_t MaxDisplayedBytes = 64;
+            const bool truncated = m_newData.getSize() > MaxDisplayedBytes;
+
+            const auto oldData = this->getOldData(MaxDisplayedBytes);
+            const auto newData = m_newData.get(MaxDisplayedBytes);
+
             return {
-                fmt::format("{} {} {}", hex::crypt::encode16(m_oldData), ICON_VS_ARROW_RIGHT, hex::crypt::encode16(m_newData)),
+                fmt::format("{}{} {} {}{}", hex::crypt::encode16(oldData), truncated ? " ..." : "", ICON_VS_ARROW_RIGHT, hex::crypt::encode16(newData), truncated ? " ..." : ""),
             };
         }
 
@@ -40,12 +53,42 @@ namespace hex::plugin::builtin::undo {
         }
 
         [[nodiscard]] Region getRegion() const override {
-            return { m_offset, m_oldData.size() };
+            return { m_offset, m_newData.getSize() };
+        }
+
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return m_newData.getMemoryUsage() + m_delta.getMemoryUsage();
+        }
+
+        void offload() override {
+            m_newData.offload();
+            m_delta.offload();
+        }
+
+    private:
+        // The old data is stored as the XOR difference to the new data. Bytes that didn't change turn into
+        // zeros, which lets the undo buffer run-length encode partial modifications down to almost nothing
+        static prv::undo::UndoBuffer computeDelta(std::span<const u8> oldData, std::span<const u8> newData) {
+            std::vector<u8> delta(oldData.size());
+            for (size_t i = 0; i < delta.size(); i += 1)
+                delta[i] = oldData[i] ^ newData[i];
+
+            return prv::undo::UndoBuffer(delta);
+        }
+
+        [[nodiscard]] std::vector<u8> getOldData(size_t maxSize = std::numeric_limits<size_t>::max()) const {
+            auto result = m_newData.get(maxSize);
+            const auto delta = m_delta.get(maxSize);
+
+            for (size_t i = 0; i < result.size(); i += 1)
+                result[i] ^= delta[i];
+
+            return result;
         }
 
     private:
         u64 m_offset;
-        std::vector<u8> m_oldData, m_newData;
+        prv::undo::UndoBuffer m_newData, m_delta;
     };
 
 }
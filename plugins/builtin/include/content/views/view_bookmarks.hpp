@@ -46,6 +46,7 @@ namespace hex::plugin::builtin {
 
         FileBackedProviderData<Bookmarks> m_bookmarks;
         PerProvider<u64> m_currBookmarkId;
+        u32 m_highlightSourceId = 0;
     };
 
 }
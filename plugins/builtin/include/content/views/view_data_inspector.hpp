@@ -8,7 +8,13 @@
 #include <hex/api/content_registry/data_inspector.hpp>
 #include <hex/api/task_manager.hpp>
 
+#include <content/helpers/compiled_pattern.hpp>
+
+#include <wolv/io/file.hpp>
+
+#include <atomic>
 #include <bit>
+#include <map>
 #include <string>
 
 namespace hex::plugin::builtin {
@@ -37,13 +43,26 @@ namespace hex::plugin::builtin {
             std::string filterValue;
         };
 
+        struct InspectorFile {
+            std::string code;
+            std::optional<CompiledPattern> pattern;
+            std::optional<ContentRegistry::DataInspector::impl::DisplayFunction> compileErrorDisplayFunction;
+
+            wolv::io::ChangeTracker tracker;
+            std::atomic<bool> changed = false;
+        };
+
     private:
         void invalidateData();
         void updateInspectorRows();
         void updateInspectorRowsTask();
 
         void executeInspectors();
-        void executeInspector(const std::string& code, const std::fs::path& path, const std::map<std::string, pl::core::Token::Literal>& inVariables);
+        void executeInspector(const InspectorFile& file, const std::fs::path& path, const std::map<std::string, pl::core::Token::Literal>& inVariables);
+        void addInspectorErrorRow(const std::fs::path &path, ContentRegistry::DataInspector::impl::DisplayFunction displayFunction);
+
+        void refreshInspectorFiles();
+        [[nodiscard]] bool haveInspectorFoldersChanged() const;
 
         void inspectorReadFunction(u64 offset, u8 *buffer, size_t size);
 
@@ -72,7 +91,15 @@ namespace hex::plugin::builtin {
         size_t m_validBytes = 0;
         std::atomic<bool> m_dataValid = false;
 
+        std::vector<u8> m_selectionBuffer;
+        u64 m_selectionBufferAddress = 0;
+
         pl::PatternLanguage m_runtime;
+        const prv::Provider *m_runtimeProvider = nullptr;
+
+        std::map<std::fs::path, InspectorFile> m_inspectorFiles;
+        std::map<std::fs::path, std::fs::file_time_type> m_inspectorFolders;
+        bool m_inspectorFilesLoaded = false;
         std::vector<InspectorCacheEntry> m_cachedData, m_workData;
         std::optional<UnlocalizedString> m_selectedEntryName;
 
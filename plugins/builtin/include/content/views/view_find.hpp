@@ -7,19 +7,24 @@
 #include <hex/helpers/binary_pattern.hpp>
 #include <ui/widgets.hpp>
 
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
-#include <wolv/container/interval_tree.hpp>
-
 #include <hex/api/content_registry/views.hpp>
 #include <hex/api/content_registry/data_formatter.hpp>
 
+#include <content/helpers/occurrence_list.hpp>
+
 namespace hex::plugin::builtin {
 
     class ViewFind : public View::Window {
     public:
         ViewFind();
-        ~ViewFind() override = default;
+        ~ViewFind() override;
 
         void drawContent() override;
 
@@ -30,6 +35,7 @@ namespace hex::plugin::builtin {
         void drawHelpText() override;
 
     private:
+        friend struct ViewFindBenchmark;
 
         using Occurrence = hex::ContentRegistry::DataFormatter::impl::FindOccurrence;
 
@@ -80,6 +86,7 @@ namespace hex::plugin::builtin {
 
                 std::string pattern;
                 bool fullMatch = true;
+                bool rawBytes = false;
             } regex;
 
             struct BinaryPattern {
@@ -107,32 +114,48 @@ namespace hex::plugin::builtin {
 
         } m_searchSettings, m_decodeSettings;
 
-        using OccurrenceTree = wolv::container::IntervalTree<Occurrence>;
-
-        PerProvider<std::vector<Occurrence>> m_foundOccurrences, m_sortedOccurrences;
-        PerProvider<Occurrence*> m_lastSelectedOccurrence;
-        PerProvider<OccurrenceTree> m_occurrenceTree;
+        // All found occurrences sorted by address and the indices of the ones that are currently listed, in the order they're listed in
+        PerProvider<OccurrenceList> m_foundOccurrences;
+        PerProvider<std::vector<u32>> m_sortedOccurrences;
+        PerProvider<std::optional<size_t>> m_lastSelectedOccurrence;
+        PerProvider<std::shared_ptr<const OccurrenceFilterIndex>> m_filterIndex;
         PerProvider<std::string> m_currFilter;
         PerProvider<bool> m_settingsCollapsed;
 
         TaskHolder m_searchTask, m_filterTask;
+
+        // The filter index of each provider is built by its own task. Results of tasks started before the last change are discarded
+        PerProvider<TaskHolder> m_indexTask;
+        PerProvider<u64> m_indexGeneration;
+        PerProvider<std::optional<std::chrono::steady_clock::time_point>> m_indexRebuildTime;
         bool m_settingsValid = false;
+        u32 m_highlightSourceId = 0;
         std::string m_replaceBuffer;
 
     private:
-        static std::vector<Occurrence> searchStrings(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Strings &settings);
-        static std::vector<Occurrence> searchSequence(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Sequence &settings);
-        static std::vector<Occurrence> searchRegex(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Regex &settings);
-        static std::vector<Occurrence> searchBinaryPattern(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::BinaryPattern &settings);
-        static std::vector<Occurrence> searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings);
-        static std::vector<Occurrence> searchConstants(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Constants &settings);
-
-        void drawContextMenu(Occurrence &target, const std::string &value);
+        static OccurrenceList searchStrings(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Strings &settings);
+        static OccurrenceList searchSequence(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Sequence &settings);
+        static OccurrenceList searchRegex(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Regex &settings);
+        static OccurrenceList searchBinaryPattern(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::BinaryPattern &settings);
+
+        // Same searches as above, but the occurrences get handed to the callback in batches while the search is still running
+        using OccurrenceCallback = std::function<void(std::span<const Occurrence>)>;
+        static void streamStrings(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Strings &settings, const OccurrenceCallback &callback);
+        static void streamSequence(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Sequence &settings, const OccurrenceCallback &callback);
+        static void streamRegex(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Regex &settings, const OccurrenceCallback &callback);
+        static void streamBinaryPattern(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::BinaryPattern &settings, const OccurrenceCallback &callback);
+        static OccurrenceList searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings);
+        static OccurrenceList searchConstants(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Constants &settings);
+
+        void drawContextMenu(u32 target, const std::string &value);
 
         static std::vector<BinaryPattern> parseBinaryPatternString(std::string string);
         static std::tuple<bool, std::variant<u64, i64, float, double>, size_t> parseNumericValueInput(const std::string &input, SearchSettings::Value::Type type);
 
         void runSearch();
+        void resetOccurrences();
+        void buildFilterIndex(prv::Provider *provider);
+        void invalidateFilterIndex(prv::Provider *provider, Region region);
         std::string decodeValue(prv::Provider *provider, const Occurrence &occurrence, size_t maxBytes = 0xFFFF'FFFF) const;
     };
 
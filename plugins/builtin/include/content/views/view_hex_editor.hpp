@@ -8,6 +8,8 @@
 
 #include <ui/hex_editor.hpp>
 
+#include <content/helpers/highlight_compositor.hpp>
+
 namespace hex::plugin::builtin {
 
     class ViewHexEditor : public View::Window {
@@ -119,6 +121,9 @@ namespace hex::plugin::builtin {
 
         PerProvider<std::map<u64, color_t>> m_foregroundHighlights, m_backgroundHighlights;
         PerProvider<std::set<Region>> m_hoverHighlights;
+
+        HighlightCompositor m_foregroundCompositor = HighlightCompositor(HighlightCompositor::Layer::Foreground);
+        HighlightCompositor m_backgroundCompositor = HighlightCompositor(HighlightCompositor::Layer::Background);
     };
 
 }
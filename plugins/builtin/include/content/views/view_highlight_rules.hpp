@@ -4,7 +4,11 @@
 #include <hex/providers/provider_data.hpp>
 #include <hex/providers/file_backed_provider_data.hpp>
 
+#include <content/helpers/expression_program.hpp>
+
+#include <atomic>
 #include <list>
+#include <map>
 
 #include <wolv/math_eval/math_evaluator.hpp>
 
@@ -49,11 +53,33 @@ namespace hex::plugin::builtin {
                 u32 highlightId = 0;
                 Rule *parentRule = nullptr;
 
+                /**
+                 * @brief Recompiles the expression. Needs to be called whenever mathExpression changes
+                 */
+                void compile();
+
                 static wolv::math_eval::MathEvaluator<i128> s_evaluator;
 
+                /**
+                 * @brief Incremented whenever the data or the rules change, invalidating all cached results
+                 */
+                static std::atomic<u64> s_generation;
+
             private:
                 void addHighlight();
                 void removeHighlight();
+
+                [[nodiscard]] bool matches(u64 address, const u8 *buffer, size_t size);
+                [[nodiscard]] bool matchesSingle(u64 address, const u8 *buffer, size_t size) const;
+                [[nodiscard]] std::vector<u8> evaluateBlock(prv::Provider *provider, u64 blockAddress, size_t cellSize) const;
+
+            private:
+                std::optional<ExpressionProgram> m_program;
+
+                // Results of the compiled program for whole blocks of cells, keyed by the block's start address
+                std::map<u64, std::vector<u8>> m_cachedResults;
+                u64 m_cacheGeneration = 0;
+                size_t m_cacheCellSize = 0;
             };
 
             explicit Rule(std::string name);
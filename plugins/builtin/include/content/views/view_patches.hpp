@@ -3,6 +3,7 @@
 #include <hex.hpp>
 
 #include <hex/ui/view.hpp>
+#include <hex/helpers/interval_set.hpp>
 
 namespace hex::plugin::builtin {
 
@@ -15,11 +16,17 @@ namespace hex::plugin::builtin {
         void drawAlwaysVisibleContent() override;
         void drawHelpText() override;
 
+    private:
+        void rebuildModifiedRegions(prv::Provider *provider);
+
     private:
         u64 m_selectedPatch = 0x00;
         PerProvider<u32> m_numOperations;
         PerProvider<u32> m_savedOperations;
-        PerProvider<std::set<u64>> m_modifiedAddresses;
+        PerProvider<u32> m_trackedOperations;
+        PerProvider<IntervalSet> m_modifiedRegions;
+
+        u32 m_highlightSourceId = 0;
     };
 
 }
\ No newline at end of file
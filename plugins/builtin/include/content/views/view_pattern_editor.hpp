@@ -15,6 +15,8 @@
 #include <hex/helpers/magic.hpp>
 #include <ui/pattern_drawer.hpp>
 
+#include <deque>
+
  namespace pl::ptrn { class Pattern; }
 
 namespace hex::plugin::builtin {
@@ -91,6 +93,26 @@ namespace hex::plugin::builtin {
             u32 color;
         };
 
+        // Console output of the last evaluation. Only the newest maxLines lines are kept so patterns
+        // that log a lot can't grow it without bounds
+        struct ConsoleBuffer {
+            std::deque<std::string> lines;
+            u64 totalLines     = 0;     // Lines ever appended, including the ones that were dropped again
+            u64 displayedLines = 0;     // Value of totalLines the last time the console editor was updated
+
+            void append(std::string line, u64 maxLines) {
+                lines.emplace_back(std::move(line));
+                totalLines += 1;
+
+                while (lines.size() > maxLines)
+                    lines.pop_front();
+            }
+
+            [[nodiscard]] std::vector<std::string> getLines() const {
+                return { lines.begin(), lines.end() };
+            }
+        };
+
         std::unique_ptr<pl::PatternLanguage> m_editorRuntime;
 
         std::mutex m_possiblePatternFilesMutex;
@@ -129,12 +151,13 @@ namespace hex::plugin::builtin {
         ContentRegistry::Settings::SettingsVariable<bool, "hex.builtin.setting.pattern_editor", "hex.builtin.setting.pattern_editor.syntactic_highlighting"> m_colorizeSyntax = true;
         ContentRegistry::Settings::SettingsVariable<bool, "hex.builtin.setting.pattern_editor", "hex.builtin.setting.pattern_editor.semantic_highlighting"> m_colorizeIdentifiers = true;
         ContentRegistry::Settings::SettingsVariable<bool, "hex.builtin.setting.pattern_editor", "hex.builtin.setting.pattern_editor.auto_indent"> m_autoIndent = true;
+        ContentRegistry::Settings::SettingsVariable<int, "hex.builtin.setting.pattern_editor", "hex.builtin.setting.pattern_editor.console_max_lines"> m_consoleMaxLines = 100000;
 
         PerProvider<ui::VisualizerDrawer> m_visualizerDrawer;
         bool m_tooltipJustOpened = false;
 
         PatternSourceCode m_sourceCode;
-        PerProvider<std::vector<std::string>> m_console;
+        PerProvider<ConsoleBuffer> m_console;
         PerProvider<bool> m_executionDone;
 
         std::mutex m_logMutex;
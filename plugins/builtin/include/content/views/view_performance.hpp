@@ -0,0 +1,32 @@
+#pragma once
+
+#include <hex/ui/view.hpp>
+#include <hex/helpers/profiler.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+
+namespace hex::plugin::builtin {
+
+    class ViewPerformance : public View::Floating {
+    public:
+        ViewPerformance();
+        ~ViewPerformance() override = default;
+
+        void drawContent() override;
+        void drawHelpText() override;
+
+        [[nodiscard]] bool shouldDraw() const override { return true; }
+        [[nodiscard]] bool hasViewMenuItemEntry() const override { return false; }
+
+    private:
+        void drawStatisticsTable(prof::Category category, const std::vector<prof::Statistics> &statistics);
+        void drawHistogram(const std::vector<prof::Statistics> &statistics);
+        void exportTrace();
+
+    private:
+        std::optional<std::tuple<prof::Category, std::string, u64>> m_selected;
+    };
+
+}
@@ -29,6 +29,7 @@ namespace hex::plugin::builtin {
     void registerLegacyProjectImporter();
     void registerAchievements();
     void registerReportGenerators();
+    void registerBatchAnalyses();
     void registerTutorials();
     void registerDataInformationSections();
     void loadWorkspaces();
@@ -0,0 +1,206 @@
+#include <hex/api/content_registry/batch_analysis.hpp>
+#include <hex/api/content_registry/pattern_language.hpp>
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/magic.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <hex/providers/provider.hpp>
+
+#include <pl/pattern_language.hpp>
+#include <pl/formatters.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <wolv/literals.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <vector>
+
+namespace hex::plugin::builtin {
+
+    using namespace wolv::literals;
+
+    namespace {
+
+        constexpr static auto ChunkSize = 1_MiB;
+
+        /**
+         * @brief Reads the entire data of a provider in fixed size chunks so memory usage
+         * stays constant no matter how large the analyzed file is
+         */
+        void readChunked(prv::Provider *provider, const std::function<void(u64, std::span<const u8>)> &callback) {
+            std::vector<u8> buffer(std::min<u64>(ChunkSize, provider->getActualSize()));
+
+            const auto baseAddress = provider->getBaseAddress();
+            const auto size        = provider->getActualSize();
+            for (u64 offset = 0; offset < size; offset += buffer.size()) {
+                const auto readSize = std::min<u64>(buffer.size(), size - offset);
+                provider->read(baseAddress + offset, buffer.data(), readSize);
+
+                callback(baseAddress + offset, { buffer.data(), readSize });
+            }
+        }
+
+        nlohmann::json calculateHashes(prv::Provider *provider, const std::string &argument) {
+            constexpr static std::array<std::pair<std::string_view, crypt::Digest>, 7> Algorithms = {{
+                { "md5",    crypt::Digest::MD5    },
+                { "sha1",   crypt::Digest::SHA1   },
+                { "sha224", crypt::Digest::SHA224 },
+                { "sha256", crypt::Digest::SHA256 },
+                { "sha384", crypt::Digest::SHA384 },
+                { "sha512", crypt::Digest::SHA512 },
+                { "crc32",  crypt::Digest::CRC32  },
+            }};
+
+            const auto names = wolv::util::splitString(argument.empty() ? "md5,sha1,sha256" : argument, ",");
+
+            std::vector<crypt::Digest> digests;
+            for (const auto &name : names) {
+                const auto it = std::ranges::find(Algorithms, name, &std::pair<std::string_view, crypt::Digest>::first);
+                if (it == Algorithms.end())
+                    throw std::invalid_argument(fmt::format("Unknown hash algorithm '{}'", name));
+
+                digests.push_back(it->second);
+            }
+
+            // All hashes are calculated in a single pass over the data
+            const auto hashes = crypt::digests(provider, provider->getBaseAddress(), provider->getActualSize(), digests);
+
+            nlohmann::json result = nlohmann::json::object();
+            for (size_t i = 0; i < names.size(); i++)
+                result[names[i]] = wolv::util::toLower(crypt::encode16(hashes[i]));
+
+            return result;
+        }
+
+        nlohmann::json calculateEntropy(prv::Provider *provider, const std::string &) {
+            std::array<u64, 256> frequencies = { };
+            readChunked(provider, [&](u64, std::span<const u8> data) {
+                for (const auto byte : data)
+                    frequencies[byte]++;
+            });
+
+            const auto size = provider->getActualSize();
+
+            double entropy = 0;
+            if (size > 0) {
+                for (const auto frequency : frequencies) {
+                    if (frequency == 0)
+                        continue;
+
+                    const auto probability = double(frequency) / double(size);
+                    entropy -= probability * std::log2(probability);
+                }
+            }
+
+            return entropy / 8.0;
+        }
+
+        nlohmann::json identifyMagic(prv::Provider *provider, const std::string &) {
+            return {
+                { "description", magic::getDescription(provider, provider->getBaseAddress(), 100_KiB, true) },
+                { "mime",        magic::getMIMEType(provider, provider->getBaseAddress(), 100_KiB, true)    },
+                { "extensions",  magic::getExtensions(provider, provider->getBaseAddress(), 100_KiB, true)  }
+            };
+        }
+
+        nlohmann::json extractStrings(prv::Provider *provider, const std::string &argument) {
+            constexpr static size_t MaxReportedStrings = 1000;
+            const size_t minLength = argument.empty() ? 5 : std::stoull(argument, nullptr, 0);
+
+            nlohmann::json strings = nlohmann::json::array();
+            u64 count = 0;
+
+            std::string currString;
+            u64 currStringAddress = 0;
+            const auto finishString = [&] {
+                if (currString.size() >= minLength) {
+                    if (count < MaxReportedStrings)
+                        strings.push_back({ { "address", currStringAddress }, { "value", currString } });
+                    count += 1;
+                }
+
+                currString.clear();
+            };
+
+            // Strings may cross chunk boundaries, so the current string is carried over into the next chunk
+            readChunked(provider, [&](u64 address, std::span<const u8> data) {
+                for (size_t i = 0; i < data.size(); i++) {
+                    const auto c = data[i];
+                    if (std::isprint(c) != 0 || c == '\t') {
+                        if (currString.empty())
+                            currStringAddress = address + i;
+                        currString += char(c);
+                    } else {
+                        finishString();
+                    }
+                }
+            });
+            finishString();
+
+            return {
+                { "count",     count                      },
+                { "truncated", count > MaxReportedStrings },
+                { "strings",   std::move(strings)         }
+            };
+        }
+
+        nlohmann::json executePattern(prv::Provider *provider, const std::string &argument) {
+            std::fs::path patternPath = argument;
+
+            // Without an explicit pattern, use the first one that matches the data
+            if (patternPath.empty()) {
+                const auto foundPatterns = magic::findViablePatterns(provider, false);
+                if (foundPatterns.empty())
+                    return nullptr;
+
+                patternPath = foundPatterns.front().patternFilePath;
+            }
+
+            pl::PatternLanguage runtime;
+            ContentRegistry::PatternLanguage::configureRuntime(runtime, provider);
+            runtime.setDangerousFunctionCallHandler([] { return false; });
+
+            nlohmann::json result = {
+                { "pattern", wolv::util::toUTF8String(patternPath) }
+            };
+
+            if (runtime.executeFile(patternPath) != 0) {
+                std::string errorMessage;
+                for (const auto &error : runtime.getCompileErrors())
+                    errorMessage += fmt::format("{}\n", error.format());
+                if (const auto &evalError = runtime.getEvalError(); evalError.has_value())
+                    errorMessage += fmt::format("{}:{}  {}\n", evalError->line, evalError->column, evalError->message);
+
+                result["error"] = errorMessage;
+                return result;
+            }
+
+            for (const auto &formatter : pl::gen::fmt::createFormatters()) {
+                if (formatter->getName() != "json")
+                    continue;
+
+                const auto formatted = formatter->format(runtime);
+                result["data"] = nlohmann::json::parse(formatted.begin(), formatted.end(), nullptr, false);
+                break;
+            }
+
+            return result;
+        }
+
+    }
+
+    void registerBatchAnalyses() {
+        ContentRegistry::BatchAnalysis::addAnalysis("hashes",  "Comma separated list of md5, sha1, sha224, sha256, sha384, sha512 and crc32 hashes", calculateHashes);
+        ContentRegistry::BatchAnalysis::addAnalysis("entropy", "Normalized Shannon entropy of the entire data",                                       calculateEntropy);
+        ContentRegistry::BatchAnalysis::addAnalysis("magic",   "File type, MIME type and extensions detected by libmagic",                           identifyMagic);
+        ContentRegistry::BatchAnalysis::addAnalysis("strings", "ASCII strings of at least the given length (default 5)",                             extractStrings);
+        ContentRegistry::BatchAnalysis::addAnalysis("pattern", "Runs the given pattern file, or the first matching one, and exports its result",     executePattern);
+    }
+
+}
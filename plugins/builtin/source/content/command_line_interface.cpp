@@ -6,6 +6,7 @@
 #include <hex/api/content_registry/settings.hpp>
 #include <hex/api/content_registry/views.hpp>
 #include <hex/api/content_registry/pattern_language.hpp>
+#include <hex/api/content_registry/batch_analysis.hpp>
 #include <hex/api/events/requests_interaction.hpp>
 #include <hex/api/events/requests_gui.hpp>
 #include <hex/api/events/events_gui.hpp>
@@ -18,6 +19,7 @@
 #include <hex/helpers/literals.hpp>
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/default_paths.hpp>
+#include <hex/helpers/search.hpp>
 #include <hex/helpers/debugging.hpp>
 
 #include <hex/subcommands/subcommands.hpp>
@@ -25,21 +27,118 @@
 #include <hex/mcp/client.hpp>
 
 #include <romfs/romfs.hpp>
+#include <wolv/utils/guards.hpp>
 #include <wolv/utils/string.hpp>
 #include <wolv/math_eval/math_evaluator.hpp>
 
+#include <nlohmann/json.hpp>
+
 #include <pl/cli/cli.hpp>
 
 #include <content/providers/file_provider.hpp>
 #include <content/views/fullscreen/view_fullscreen_save_editor.hpp>
 #include <content/views/fullscreen/view_fullscreen_file_info.hpp>
 
+#include <atomic>
+#include <charconv>
 #include <iostream>
+#include <memory>
+#include <semaphore>
 #include <span>
+#include <thread>
 
 namespace hex::plugin::builtin {
     using namespace hex::literals;
 
+    bool matchesGlob(std::string_view pattern, std::string_view string) {
+        if (pattern.empty())
+            return string.empty();
+
+        if (pattern.starts_with("**")) {
+            // **/ also matches no directory at all
+            if (pattern.starts_with("**/") && matchesGlob(pattern.substr(3), string))
+                return true;
+
+            for (size_t i = 0; i <= string.size(); i++) {
+                if (matchesGlob(pattern.substr(2), string.substr(i)))
+                    return true;
+            }
+
+            return false;
+        }
+
+        if (pattern.front() == '*') {
+            for (size_t i = 0; i <= string.size() && (i == 0 || string[i - 1] != '/'); i++) {
+                if (matchesGlob(pattern.substr(1), string.substr(i)))
+                    return true;
+            }
+
+            return false;
+        }
+
+        if (string.empty())
+            return false;
+
+        if (pattern.front() == '?' ? string.front() != '/' : pattern.front() == string.front())
+            return matchesGlob(pattern.substr(1), string.substr(1));
+
+        return false;
+    }
+
+    namespace {
+
+        void collectAnalysisInputs(const std::string &input, std::vector<std::fs::path> &paths) {
+            // @file reads a list of inputs, one per line
+            if (input.starts_with('@')) {
+                wolv::io::File file(std::fs::path(input.substr(1)), wolv::io::File::Mode::Read);
+                if (!file.isValid()) {
+                    log::error("Failed to open input list '{}'", input.substr(1));
+                    return;
+                }
+
+                for (auto line : wolv::util::splitString(file.readString(), "\n")) {
+                    line = wolv::util::trim(line);
+                    if (!line.empty())
+                        collectAnalysisInputs(line, paths);
+                }
+
+                return;
+            }
+
+            const auto addDirectory = [&paths](const std::fs::path &directory, const auto &filter) {
+                std::error_code error;
+                for (const auto &entry : std::fs::recursive_directory_iterator(directory, std::fs::directory_options::skip_permission_denied, error)) {
+                    if (entry.is_regular_file(error) && filter(entry.path()))
+                        paths.push_back(entry.path());
+                }
+            };
+
+            if (input.find_first_of("*?") == std::string::npos) {
+                const auto path = std::fs::path(reinterpret_cast<const char8_t*>(input.c_str()));
+                if (wolv::io::fs::isDirectory(path))
+                    addDirectory(path, [](const auto &) { return true; });
+                else
+                    paths.push_back(path);
+
+                return;
+            }
+
+            // Only walk the part of the tree below the last directory without wildcards
+            const auto wildcardPosition = input.find_first_of("*?");
+            const auto separatorPosition = input.find_last_of('/', wildcardPosition);
+            const auto root = separatorPosition == std::string::npos ? std::string(".") : input.substr(0, separatorPosition + 1);
+            const auto pattern = separatorPosition == std::string::npos ? input : input.substr(separatorPosition + 1);
+
+            addDirectory(std::fs::path(reinterpret_cast<const char8_t*>(root.c_str())), [&](const std::fs::path &path) {
+                auto relativePath = wolv::util::toUTF8String(std::fs::relative(path, root));
+                std::ranges::replace(relativePath, '\\', '/');
+
+                return matchesGlob(pattern, relativePath);
+            });
+        }
+
+    }
+
     int handleVersionCommand(std::span<const std::string> args) {
         std::ignore = args;
 
@@ -351,6 +450,139 @@ namespace hex::plugin::builtin {
         return EXIT_SUCCESS;
     }
 
+    int handleAnalyzeCommand(std::span<const std::string> args) {
+        const auto &analyses = ContentRegistry::BatchAnalysis::impl::getAnalyses();
+
+        std::vector<std::pair<const ContentRegistry::BatchAnalysis::impl::Analysis*, std::string>> selectedAnalyses;
+        std::vector<std::fs::path> paths;
+        u32 jobCount = std::max(1U, std::thread::hardware_concurrency());
+
+        const auto selectAnalysis = [&](const std::string &selection) {
+            const auto separator = selection.find(':');
+            const auto name      = selection.substr(0, separator);
+            const auto argument  = separator == std::string::npos ? std::string() : selection.substr(separator + 1);
+
+            const auto it = std::ranges::find_if(analyses, [&](const auto &analysis) { return analysis.name == name; });
+            if (it == analyses.end()) {
+                log::println("Unknown analysis: {}", name);
+                return false;
+            }
+
+            selectedAnalyses.emplace_back(&*it, argument);
+            return true;
+        };
+
+        const auto printUsage = [&analyses] {
+            log::println("usage: imhex --analyze [--analysis=<name>[:<argument>]...] [--jobs=<count>] <file|directory|glob|@list>...");
+            log::println("Available analyses:");
+            for (const auto &analysis : analyses)
+                log::println("  {:10} {}", analysis.name, analysis.description);
+        };
+
+        for (const auto &arg : args) {
+            if (arg.starts_with("--analysis=")) {
+                if (!selectAnalysis(arg.substr(11)))
+                    return EXIT_FAILURE;
+            } else if (arg.starts_with("--jobs=")) {
+                const auto value = std::string_view(arg).substr(7);
+
+                u32 count = 0;
+                const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+                if (error != std::errc() || end != value.data() + value.size() || count == 0) {
+                    log::println("Invalid job count: {}", value);
+                    printUsage();
+                    return EXIT_FAILURE;
+                }
+
+                jobCount = count;
+            } else {
+                collectAnalysisInputs(arg, paths);
+            }
+        }
+
+        if (args.empty()) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        if (selectedAnalyses.empty()) {
+            for (const auto &name : { "hashes", "entropy", "magic" })
+                selectAnalysis(name);
+        }
+
+        if (!magic::compile()) {
+            log::println("Failed to compile magic database!");
+            return EXIT_FAILURE;
+        }
+
+        // Analyses that can only run on a limited number of files at once, like the ones backed by libyara, make
+        // the other workers wait for them instead of failing
+        std::vector<std::unique_ptr<std::counting_semaphore<>>> analysisLimits;
+        for (const auto &[analysis, argument] : selectedAnalyses) {
+            if (analysis->maxConcurrentRuns != 0 && analysis->maxConcurrentRuns < jobCount)
+                analysisLimits.push_back(std::make_unique<std::counting_semaphore<>>(analysis->maxConcurrentRuns));
+            else
+                analysisLimits.push_back(nullptr);
+        }
+
+        // Every worker only ever holds a single file open and providers read straight from disk,
+        // so memory usage is bounded by the number of jobs rather than the number or size of files
+        std::atomic<size_t> nextPath = 0;
+        std::atomic<bool> failed = false;
+        {
+            std::vector<std::jthread> workers;
+            for (u32 i = 0; i < std::min<size_t>(jobCount, paths.size()); i++) {
+                workers.emplace_back([&] {
+                    TaskManager::setCurrentThreadName("Batch Analysis");
+
+                    for (size_t index = nextPath++; index < paths.size(); index = nextPath++) {
+                        const auto &path = paths[index];
+
+                        nlohmann::json result = {
+                            { "path", wolv::util::toUTF8String(path) }
+                        };
+
+                        FileProvider provider;
+                        provider.setPickedPath(path);
+                        if (auto openResult = provider.openReadOnly(); openResult.isFailure()) {
+                            result["error"] = openResult.getErrorMessage();
+                            failed = true;
+                        } else {
+                            result["size"] = provider.getActualSize();
+
+                            auto &results = result["results"];
+                            results = nlohmann::json::object();
+                            for (size_t analysisIndex = 0; analysisIndex < selectedAnalyses.size(); analysisIndex += 1) {
+                                const auto &[analysis, argument] = selectedAnalyses[analysisIndex];
+
+                                const auto &limit = analysisLimits[analysisIndex];
+                                if (limit != nullptr)
+                                    limit->acquire();
+                                ON_SCOPE_EXIT {
+                                    if (limit != nullptr)
+                                        limit->release();
+                                };
+
+                                try {
+                                    results[analysis->name] = analysis->callback(&provider, argument);
+                                } catch (const std::exception &e) {
+                                    results[analysis->name] = { { "error", e.what() } };
+                                    failed = true;
+                                }
+                            }
+
+                            provider.close();
+                        }
+
+                        log::println("{}", result.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+                    }
+                });
+            }
+        }
+
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     int handlePatternLanguageCommand(std::span<const std::string> args) {
         std::vector<std::string> processedArgs = { args.begin(), args.end() };
         if (processedArgs.empty()) {
@@ -392,6 +624,41 @@ namespace hex::plugin::builtin {
         return EXIT_SUCCESS;
     }
 
+    int handleFindCommand(std::span<const std::string> args) {
+        const bool ignoreCase = std::ranges::contains(args, "--ignore-case");
+        std::vector<std::string> positionalArgs;
+        std::ranges::copy_if(args, std::back_inserter(positionalArgs), [](const std::string &arg) { return arg != "--ignore-case"; });
+
+        if (positionalArgs.size() != 2) {
+            log::println("usage: imhex --find [--ignore-case] <file> <hex bytes>");
+            return EXIT_FAILURE;
+        }
+
+        const auto sequence = hex::parseHexString(positionalArgs[1]);
+        if (sequence.empty()) {
+            log::println("Invalid byte sequence '{}'", positionalArgs[1]);
+            return EXIT_FAILURE;
+        }
+
+        std::fs::path filePath = reinterpret_cast<const char8_t*>(positionalArgs[0].data());
+
+        FileProvider provider;
+        provider.setPickedPath(filePath);
+        auto result = provider.open();
+        if (result.isFailure()) {
+            log::println("Failed to open file '{}': {}", positionalArgs[0], result.getErrorMessage());
+            return EXIT_FAILURE;
+        }
+
+        const auto region = Region { .address = provider.getBaseAddress(), .size = provider.getActualSize() };
+        Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(region.getSize()), true, false, [](Task &) { });
+
+        for (const auto address : SequenceSearcher(sequence, ignoreCase).findAll(task, &provider, region))
+            log::println("0x{:08X}", address);
+
+        return EXIT_SUCCESS;
+    }
+
     int handleDemangleCommand(std::span<const std::string> args) {
         if (args.size() != 1) {
             log::println("usage: imhex --demangle <identifier>");
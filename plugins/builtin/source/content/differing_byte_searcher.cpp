@@ -1,53 +1,85 @@
 #include <content/differing_byte_searcher.hpp>
+#include <content/helpers/uniform_block_index.hpp>
 #include <hex/api/imhex_api/provider.hpp>
 #include <hex/api/imhex_api/hex_editor.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace hex::plugin::builtin {
 
-    void findNextDifferingByte(
-        const std::function< u64(prv::Provider*) >& lastValidAddressProvider,
-        const std::function< bool(u64, u64) >& addressComparator,
-        const std::function< void(u64*) >& addressStepper,
-        bool *didFindNextValue,
-        bool *didReachEndAddress,
-        u64* foundAddress
-    ) {
+    std::optional<u64> findNextDifferingByte(SearchDirection direction) {
         auto provider = ImHexApi::Provider::get();
         if (provider == nullptr)
-            return;
+            return std::nullopt;
         const auto selection  = ImHexApi::HexEditor::getSelection();
         if (!selection.has_value())
-            return;
+            return std::nullopt;
         if (selection->getSize() != 1)
-            return;
+            return std::nullopt;
 
-        auto currentAddress = selection->getStartAddress();
+        const auto baseAddress = provider->getBaseAddress();
+        const auto size        = provider->getActualSize();
+        const auto startOffset = selection->getStartAddress() - baseAddress;
 
         u8 givenValue = 0;
-        provider->read(currentAddress, &givenValue, 1);
+        provider->read(selection->getStartAddress(), &givenValue, 1);
 
-        u8 currentValue = 0;
+        // Walk through the data one block at a time. Blocks that are known to only contain the given value are skipped
+        // entirely, blocks that only contain a different value don't need to be read either
+        const auto index     = UniformBlockIndex::get(provider);
+        const auto blocks    = index != nullptr ? index->getBlocks() : nullptr;
+        const auto blockSize = blocks != nullptr ? blocks->getBlockSize() : UniformBlockIndex::MinBlockSize;
 
-        *didFindNextValue = false;
-        *didReachEndAddress = false;
+        std::vector<u8> buffer(blockSize);
+        const auto findInBlock = [&](u64 blockIndex, u64 from, u64 to) -> std::optional<u64> {
+            const auto state = blocks != nullptr ? blocks->getState(blockIndex) : UniformBlockIndex::Unknown;
+            if (state == givenValue)
+                return std::nullopt;
+            if (state < UniformBlockIndex::Mixed)
+                return direction == SearchDirection::Forward ? from : to - 1;
 
-        auto endAddress = lastValidAddressProvider(provider);
+            provider->read(baseAddress + from, buffer.data(), to - from);
+            const auto begin = buffer.begin(), end = buffer.begin() + (to - from);
+            const auto isDifferent = [givenValue](u8 value) { return value != givenValue; };
 
-        while (addressComparator(currentAddress, endAddress)) {
-            addressStepper(&currentAddress);
-            if (currentAddress == endAddress) {
-                *didReachEndAddress = true;
+            if (direction == SearchDirection::Forward) {
+                if (auto it = std::find_if(begin, end, isDifferent); it != end)
+                    return from + (it - begin);
+            } else {
+                if (auto it = std::find_if(std::make_reverse_iterator(end), std::make_reverse_iterator(begin), isDifferent); it != std::make_reverse_iterator(begin))
+                    return from + (it.base() - begin) - 1;
             }
-            provider->read(currentAddress, &currentValue, 1);
-            if (currentValue != givenValue) {
-                *didFindNextValue = true;
-                *foundAddress = currentAddress;
-                break;
+
+            return std::nullopt;
+        };
+
+        if (direction == SearchDirection::Forward) {
+            for (u64 offset = startOffset + 1; offset < size;) {
+                const auto blockIndex = offset / blockSize;
+                const auto blockEnd   = std::min((blockIndex + 1) * blockSize, size);
+
+                if (auto result = findInBlock(blockIndex, offset, blockEnd); result.has_value())
+                    return baseAddress + *result;
+
+                offset = blockEnd;
+            }
+        } else {
+            for (u64 offset = startOffset; offset > 0;) {
+                const auto blockIndex = (offset - 1) / blockSize;
+                const auto blockStart = blockIndex * blockSize;
+
+                if (auto result = findInBlock(blockIndex, blockStart, offset); result.has_value())
+                    return baseAddress + *result;
+
+                offset = blockStart;
             }
         }
+
+        return std::nullopt;
     }
 
     bool canSearchForDifferingByte() {
         return ImHexApi::Provider::isValid() && ImHexApi::HexEditor::isSelectionValid() && ImHexApi::HexEditor::getSelection()->getSize() == 1;
     }
-}
\ No newline at end of file
+}
@@ -22,6 +22,7 @@
 
 #include <imgui.h>
 #include <content/global_actions.hpp>
+#include <content/helpers/uniform_block_index.hpp>
 #include <content/legacy_project_importer.hpp>
 
 #include <content/providers/file_provider.hpp>
@@ -298,6 +299,8 @@ namespace hex::plugin::builtin {
             }
         });
 
+        UniformBlockIndex::initialize();
+
         RequestOpenFile::subscribe(openFile);
 
         RequestOpenWindow::subscribe([](const std::string &name) {
@@ -0,0 +1,826 @@
+#include <content/helpers/byte_regex.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/providers/parallel_scanner.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <wolv/utils/guards.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        // Limits the size of the NFA, large repetition counts would otherwise make it grow without bounds
+        constexpr static size_t MaxNodeCount = 50'000;
+        constexpr static u32 MaxRepetitionCount = 1'000;
+
+        // Memory the transition table of a single DFA may use before its cache is flushed
+        constexpr static size_t MaxTransitionTableSize = 0x20'0000;
+
+        std::bitset<256> getByteRange(u8 from, u8 to) {
+            std::bitset<256> result;
+            for (u32 byte = from; byte <= to; byte += 1)
+                result.set(byte);
+
+            return result;
+        }
+
+    }
+
+    /**
+     * @brief Recursive descent parser that compiles an expression into the NFA of a ByteRegex
+     * @details The expression is parsed into a small syntax tree first. Repetitions are expanded by compiling their
+     * child multiple times, which is a lot easier to do on a tree than on already compiled nodes
+     */
+    class ByteRegex::Parser {
+    public:
+        Parser(ByteRegex &regex, std::string_view pattern) : m_regex(regex), m_pattern(pattern) { }
+
+        u32 compile(u32 next) {
+            const auto expression = this->parseAlternation();
+            if (!this->isAtEnd())
+                this->error("Unmatched ')'");
+
+            return this->emit(expression, next);
+        }
+
+    private:
+        constexpr static u32 Unbounded = 0xFFFF'FFFF;
+
+        struct Expression {
+            enum class Type : u8 { Empty, Bytes, Concatenation, Alternation, Repetition } type = Type::Empty;
+            std::bitset<256> bytes = { };
+            std::vector<Expression> children = { };
+            u32 min = 0, max = 0;
+        };
+
+        [[noreturn]] void error(std::string_view message) const {
+            throw std::invalid_argument(fmt::format("{} at position {}", message, m_position));
+        }
+
+        [[nodiscard]] bool isAtEnd() const {
+            return m_position >= m_pattern.size();
+        }
+
+        [[nodiscard]] char peek() const {
+            return this->isAtEnd() ? '\x00' : m_pattern[m_position];
+        }
+
+        char consume() {
+            if (this->isAtEnd())
+                this->error("Unexpected end of pattern");
+
+            return m_pattern[m_position++];
+        }
+
+        bool consumeIf(char character) {
+            if (this->isAtEnd() || m_pattern[m_position] != character)
+                return false;
+
+            m_position += 1;
+            return true;
+        }
+
+        Expression parseAlternation() {
+            Expression expression = { .type = Expression::Type::Alternation };
+            expression.children.push_back(this->parseConcatenation());
+            while (this->consumeIf('|'))
+                expression.children.push_back(this->parseConcatenation());
+
+            if (expression.children.size() == 1)
+                return std::move(expression.children.front());
+
+            return expression;
+        }
+
+        Expression parseConcatenation() {
+            Expression expression = { .type = Expression::Type::Concatenation };
+            while (!this->isAtEnd() && this->peek() != '|' && this->peek() != ')')
+                expression.children.push_back(this->parseRepetition());
+
+            if (expression.children.empty())
+                return { .type = Expression::Type::Empty };
+            if (expression.children.size() == 1)
+                return std::move(expression.children.front());
+
+            return expression;
+        }
+
+        Expression parseRepetition() {
+            auto atom = this->parseAtom();
+
+            u32 min, max;
+            switch (this->peek()) {
+                case '*': min = 0; max = Unbounded; break;
+                case '+': min = 1; max = Unbounded; break;
+                case '?': min = 0; max = 1;         break;
+                case '{': {
+                    m_position += 1;
+                    min = this->parseNumber();
+                    max = min;
+                    if (this->consumeIf(','))
+                        max = this->peek() == '}' ? Unbounded : this->parseNumber();
+                    if (this->peek() != '}')
+                        this->error("Expected '}'");
+                    if (max < min)
+                        this->error("Invalid repetition range");
+                    break;
+                }
+                default:
+                    return atom;
+            }
+            m_position += 1;
+
+            switch (this->peek()) {
+                case '?': case '+':
+                    this->error("Lazy and possessive quantifiers are not supported");
+                case '*': case '{':
+                    this->error("Nothing to repeat");
+                default:
+                    break;
+            }
+
+            Expression expression = { .type = Expression::Type::Repetition, .min = min, .max = max };
+            expression.children.push_back(std::move(atom));
+
+            return expression;
+        }
+
+        u32 parseNumber() {
+            if (!std::isdigit(u8(this->peek())))
+                this->error("Expected a number");
+
+            u32 value = 0;
+            while (std::isdigit(u8(this->peek()))) {
+                value = value * 10 + (this->consume() - '0');
+                if (value > MaxRepetitionCount)
+                    this->error(fmt::format("Repetition counts are limited to {}", MaxRepetitionCount));
+            }
+
+            return value;
+        }
+
+        Expression parseAtom() {
+            switch (const char character = this->consume()) {
+                case '(': {
+                    if (this->consumeIf('?')) {
+                        if (!this->consumeIf(':'))
+                            this->error("Only non-capturing groups are supported");
+                    }
+
+                    auto expression = this->parseAlternation();
+                    if (!this->consumeIf(')'))
+                        this->error("Expected ')'");
+
+                    return expression;
+                }
+                case '[':
+                    return { .type = Expression::Type::Bytes, .bytes = this->parseClass() };
+                case '.':
+                    return { .type = Expression::Type::Bytes, .bytes = std::bitset<256>().set() };
+                case '\\':
+                    return { .type = Expression::Type::Bytes, .bytes = this->parseEscape() };
+                case '^': case '$':
+                    this->error("Anchors are not supported");
+                case '*': case '+': case '?': case '{':
+                    this->error("Nothing to repeat");
+                default:
+                    return { .type = Expression::Type::Bytes, .bytes = getByteRange(u8(character), u8(character)) };
+            }
+        }
+
+        std::bitset<256> parseEscape() {
+            switch (const char character = this->consume()) {
+                case 'x': {
+                    u32 value = 0;
+                    for (u32 i = 0; i < 2; i += 1) {
+                        const auto digit = u8(this->consume());
+                        if (!std::isxdigit(digit))
+                            this->error("Expected two hexadecimal digits");
+
+                        value = (value << 4) | u32(std::isdigit(digit) ? digit - '0' : std::tolower(digit) - 'a' + 10);
+                    }
+
+                    return getByteRange(u8(value), u8(value));
+                }
+                case 'd': return getByteRange('0', '9');
+                case 'D': return ~getByteRange('0', '9');
+                case 'w': return getByteRange('a', 'z') | getByteRange('A', 'Z') | getByteRange('0', '9') | getByteRange('_', '_');
+                case 'W': return ~(getByteRange('a', 'z') | getByteRange('A', 'Z') | getByteRange('0', '9') | getByteRange('_', '_'));
+                case 's': return getByteRange(' ', ' ') | getByteRange('\t', '\r');
+                case 'S': return ~(getByteRange(' ', ' ') | getByteRange('\t', '\r'));
+                case 'n': return getByteRange('\n', '\n');
+                case 'r': return getByteRange('\r', '\r');
+                case 't': return getByteRange('\t', '\t');
+                case 'f': return getByteRange('\f', '\f');
+                case 'v': return getByteRange('\v', '\v');
+                case '0': return getByteRange(0x00, 0x00);
+                default:
+                    if (std::isdigit(u8(character)))
+                        this->error("Backreferences are not supported");
+                    if (std::isalpha(u8(character)))
+                        this->error(fmt::format("Unsupported escape sequence '\\{}'", character));
+
+                    return getByteRange(u8(character), u8(character));
+            }
+        }
+
+        std::bitset<256> parseClass() {
+            const bool negated = this->consumeIf('^');
+
+            std::bitset<256> result;
+            bool first = true;
+            while (first || this->peek() != ']') {
+                first = false;
+
+                // Escapes like \d stand for multiple bytes and can't be the start of a range
+                std::bitset<256> item;
+                if (const char character = this->consume(); character == '\\')
+                    item = this->parseEscape();
+                else
+                    item = getByteRange(u8(character), u8(character));
+
+                if (item.count() == 1 && this->peek() == '-' && m_position + 1 < m_pattern.size() && m_pattern[m_position + 1] != ']') {
+                    m_position += 1;
+
+                    std::bitset<256> end;
+                    if (const char character = this->consume(); character == '\\')
+                        end = this->parseEscape();
+                    else
+                        end = getByteRange(u8(character), u8(character));
+
+                    if (end.count() != 1)
+                        this->error("Invalid range in character class");
+
+                    const auto findByte = [](const std::bitset<256> &bytes) {
+                        u32 byte = 0;
+                        while (!bytes.test(byte))
+                            byte += 1;
+                        return u8(byte);
+                    };
+
+                    const auto from = findByte(item), to = findByte(end);
+                    if (from > to)
+                        this->error("Invalid range in character class");
+
+                    item = getByteRange(from, to);
+                }
+
+                result |= item;
+            }
+            m_position += 1;
+
+            return negated ? ~result : result;
+        }
+
+        u32 emit(const Expression &expression, u32 next) {
+            switch (expression.type) {
+                using enum Expression::Type;
+                case Empty:
+                    return next;
+                case Bytes:
+                    return m_regex.addNode({ .type = Node::Type::Bytes, .bytes = expression.bytes, .next = next });
+                case Concatenation:
+                    for (auto it = expression.children.rbegin(); it != expression.children.rend(); ++it)
+                        next = this->emit(*it, next);
+                    return next;
+                case Alternation: {
+                    auto entry = this->emit(expression.children.back(), next);
+                    for (auto it = expression.children.rbegin() + 1; it != expression.children.rend(); ++it)
+                        entry = m_regex.addNode({ .type = Node::Type::Split, .next = this->emit(*it, next), .alternative = entry });
+                    return entry;
+                }
+                case Repetition: {
+                    const auto &child = expression.children.front();
+
+                    auto entry = next;
+                    if (expression.max == Unbounded) {
+                        const auto loop = m_regex.addNode({ .type = Node::Type::Split });
+                        const auto body = this->emit(child, loop);
+                        m_regex.m_nodes[loop].next = body;
+                        m_regex.m_nodes[loop].alternative = next;
+                        entry = loop;
+                    } else {
+                        // Optional repetitions are nested so there's only a single way to match a given number of them
+                        for (u32 i = expression.min; i < expression.max; i += 1)
+                            entry = m_regex.addNode({ .type = Node::Type::Split, .next = this->emit(child, entry), .alternative = next });
+                    }
+
+                    for (u32 i = 0; i < expression.min; i += 1)
+                        entry = this->emit(child, entry);
+
+                    return entry;
+                }
+            }
+
+            return next;
+        }
+
+    private:
+        ByteRegex &m_regex;
+        std::string_view m_pattern;
+        size_t m_position = 0;
+    };
+
+    /**
+     * @brief DFA that is built from the NFA while it's being used
+     * @details Every DFA state is an ordered list of groups of NFA states. Each group belongs to a different match start
+     * position, earlier groups started earlier. The start positions themselves are tracked by the scanner, every transition
+     * tells it which group of the previous state each new group originates from. Once a group reaches the match node, all
+     * groups that started later are dropped and no new ones are started, while earlier groups keep running since they may
+     * still produce a match that starts further left
+     */
+    class ByteRegex::LazyDfa {
+    public:
+        constexpr static u32 InitialState = 0;
+        constexpr static u32 NewGroup     = 0xFFFF'FFFF;
+        constexpr static u32 Separator    = 0xFFFF'FFFF;
+        constexpr static u32 Unknown      = 0xFFFF'FFFF;
+
+        struct State {
+            // First element is the matched flag, followed by the NFA nodes of every group, each terminated by a separator
+            std::vector<u32> key;
+            u32 groupCount;
+            bool matched, accepting;
+        };
+
+        struct Origins {
+            std::vector<u32> groups;
+            bool isPrefix;
+        };
+
+        struct Transition {
+            u32 next = Unknown;
+            u32 origins = Unknown;
+        };
+
+        explicit LazyDfa(const ByteRegex &regex) : m_regex(regex), m_classCount(regex.m_classRepresentatives.size()) {
+            m_maxStateCount = std::max<size_t>(MaxTransitionTableSize / (m_classCount * sizeof(Transition)), 16);
+            m_visited.resize(m_regex.m_nodes.size(), 0);
+            this->clear();
+        }
+
+        [[nodiscard]] Transition getTransition(u32 state, u8 byte) {
+            const auto &transition = m_transitions[state * m_classCount + m_regex.m_byteClasses[byte]];
+            if (transition.next == Unknown) [[unlikely]]
+                return this->computeTransition(state, byte);
+
+            return transition;
+        }
+
+        [[nodiscard]] const State& getState(u32 state) const { return m_states[state]; }
+        [[nodiscard]] bool isIdleByte(u8 byte) const { return m_idleBytes[byte]; }
+        [[nodiscard]] const Origins& getOrigins(u32 origins) const { return m_origins[origins]; }
+
+        u32 addState(const std::vector<u32> &key) {
+            if (auto it = m_stateIds.find(key); it != m_stateIds.end())
+                return it->second;
+
+            State state = { .key = key, .groupCount = 0, .matched = key.front() != 0, .accepting = false };
+
+            bool groupHasMatch = false;
+            for (size_t i = 1; i < key.size(); i += 1) {
+                if (key[i] == Separator) {
+                    state.groupCount += 1;
+                    state.accepting = groupHasMatch;
+                    groupHasMatch = false;
+                } else if (key[i] == m_regex.m_matchNode) {
+                    groupHasMatch = true;
+                }
+            }
+
+            const auto id = u32(m_states.size());
+            m_states.push_back(std::move(state));
+            m_stateIds.emplace(key, id);
+            m_transitions.resize(m_transitions.size() + m_classCount);
+
+            return id;
+        }
+
+    private:
+        void clear() {
+            m_states.clear();
+            m_stateIds.clear();
+            m_transitions.clear();
+            m_origins.clear();
+            m_originIds.clear();
+
+            std::vector<u32> key = { 0 };
+            m_generation += 1;
+            this->addClosure(m_regex.m_startNode, key);
+            std::sort(key.begin() + 1, key.end());
+            key.push_back(Separator);
+
+            this->addState(key);
+
+            // Bytes that can't start a match keep the initial state as it is. They're skipped without going through the transition table
+            for (u32 byte = 0; byte < 256; byte += 1) {
+                const auto transition = this->getTransition(InitialState, u8(byte));
+                m_idleBytes[byte] = transition.next == InitialState && m_origins[transition.origins].groups == std::vector<u32>({ NewGroup });
+            }
+        }
+
+        void addClosure(u32 node, std::vector<u32> &nodes) {
+            m_stack.push_back(node);
+            while (!m_stack.empty()) {
+                const auto current = m_stack.back();
+                m_stack.pop_back();
+
+                if (m_visited[current] == m_generation)
+                    continue;
+                m_visited[current] = m_generation;
+
+                const auto &nfaNode = m_regex.m_nodes[current];
+                if (nfaNode.type == Node::Type::Split) {
+                    if (nfaNode.alternative != InvalidNode)
+                        m_stack.push_back(nfaNode.alternative);
+                    m_stack.push_back(nfaNode.next);
+                } else {
+                    nodes.push_back(current);
+                }
+            }
+        }
+
+        u32 addOrigins(std::vector<u32> groups) {
+            if (auto it = m_originIds.find(groups); it != m_originIds.end())
+                return it->second;
+
+            bool isPrefix = true;
+            for (u32 i = 0; i < groups.size(); i += 1)
+                isPrefix = isPrefix && groups[i] == i;
+
+            const auto id = u32(m_origins.size());
+            m_originIds.emplace(groups, id);
+            m_origins.push_back({ std::move(groups), isPrefix });
+
+            return id;
+        }
+
+        Transition computeTransition(u32 state, u8 byte) {
+            // Flush the cache if it grew too large. Only the current state needs to survive this
+            auto key = m_states[state].key;
+            if (m_states.size() >= m_maxStateCount) {
+                this->clear();
+                state = this->addState(key);
+            }
+
+            // Nodes already reached by an earlier group are skipped in later ones, the earlier match start always wins
+            m_generation += 1;
+
+            std::vector<u32> nextKey = { 0 };
+            std::vector<u32> origins;
+            bool matched = key.front() != 0;
+
+            u32 groupIndex = 0;
+            for (size_t i = 1; i < key.size(); i += 1) {
+                const auto groupStart = nextKey.size();
+                for (; key[i] != Separator; i += 1) {
+                    const auto &node = m_regex.m_nodes[key[i]];
+                    if (node.type == Node::Type::Bytes && node.bytes.test(byte))
+                        this->addClosure(node.next, nextKey);
+                }
+
+                if (nextKey.size() != groupStart) {
+                    std::sort(nextKey.begin() + i64(groupStart), nextKey.end());
+                    nextKey.push_back(Separator);
+                    origins.push_back(groupIndex);
+
+                    if (std::binary_search(nextKey.begin() + i64(groupStart), nextKey.end() - 1, m_regex.m_matchNode)) {
+                        matched = true;
+                        break;
+                    }
+                }
+
+                groupIndex += 1;
+            }
+
+            if (!matched) {
+                const auto groupStart = nextKey.size();
+                this->addClosure(m_regex.m_startNode, nextKey);
+                if (nextKey.size() != groupStart) {
+                    std::sort(nextKey.begin() + i64(groupStart), nextKey.end());
+                    nextKey.push_back(Separator);
+                    origins.push_back(NewGroup);
+                }
+            }
+            nextKey.front() = matched ? 1 : 0;
+
+            const Transition transition = { .next = this->addState(nextKey), .origins = this->addOrigins(std::move(origins)) };
+            m_transitions[state * m_classCount + m_regex.m_byteClasses[byte]] = transition;
+
+            return transition;
+        }
+
+    private:
+        const ByteRegex &m_regex;
+        size_t m_classCount;
+        size_t m_maxStateCount;
+
+        std::vector<State> m_states;
+        std::map<std::vector<u32>, u32> m_stateIds;
+        std::vector<Transition> m_transitions;
+
+        std::vector<Origins> m_origins;
+        std::map<std::vector<u32>, u32> m_originIds;
+
+        std::vector<u32> m_visited, m_stack;
+        u32 m_generation = 0;
+
+        std::array<bool, 256> m_idleBytes = { };
+    };
+
+    /**
+     * @brief Runs a LazyDfa over data and collects the matches
+     * @details Once a match was found, scanning continues to find a longer one. Bytes following the end of the match
+     * are kept, once the match can't grow anymore or MaxMatchExtension bytes were kept, scanning restarts at its end using these bytes
+     */
+    class ByteRegex::Scanner {
+    public:
+        struct Snapshot {
+            std::vector<u32> key;
+            std::vector<u64> starts;
+            u64 address;
+            Region pending;
+            std::vector<u8> lookahead;
+        };
+
+        Scanner(LazyDfa &dfa, u64 address) : m_dfa(dfa) {
+            this->reset(address);
+        }
+
+        void consume(u8 byte, std::vector<Region> &matches) {
+            if (!this->advance(byte, matches))
+                return;
+
+            auto queue = std::exchange(m_lookahead, { });
+            for (size_t i = 0; i < queue.size();) {
+                if (this->advance(queue[i++], matches)) {
+                    auto remaining = std::exchange(m_lookahead, { });
+                    remaining.insert(remaining.end(), queue.begin() + i64(i), queue.end());
+
+                    queue = std::move(remaining);
+                    i = 0;
+                }
+            }
+        }
+
+        void finish(std::vector<Region> &matches) {
+            while (m_dfa.getState(m_state).matched) {
+                matches.push_back(m_pending);
+
+                const auto queue = std::exchange(m_lookahead, { });
+                this->reset(m_pending.getEndAddress() + 1);
+                for (const auto byte : queue)
+                    this->consume(byte, matches);
+            }
+        }
+
+        /**
+         * @brief Checks if the scanner is in the same state it starts in, with nothing but a new match starting at the next byte
+         */
+        [[nodiscard]] bool isIdle() const {
+            return m_state == LazyDfa::InitialState && m_starts.front() == m_address;
+        }
+
+        /**
+         * @brief Skips over bytes that keep an idle scanner idle
+         * @return Number of bytes skipped. The scanner was idle in front of each of them and still is after them
+         */
+        size_t skipIdle(std::span<const u8> data) {
+            if (!this->isIdle())
+                return 0;
+
+            size_t count = 0;
+            while (count < data.size() && m_dfa.isIdleByte(data[count]))
+                count += 1;
+
+            m_address += count;
+            m_starts.front() = m_address;
+
+            return count;
+        }
+
+        [[nodiscard]] Snapshot save() const {
+            return { m_dfa.getState(m_state).key, m_starts, m_address, m_pending, m_lookahead };
+        }
+
+        void restore(const Snapshot &snapshot) {
+            m_state     = m_dfa.addState(snapshot.key);
+            m_starts    = snapshot.starts;
+            m_address   = snapshot.address;
+            m_pending   = snapshot.pending;
+            m_lookahead = snapshot.lookahead;
+        }
+
+    private:
+        void reset(u64 address) {
+            m_state   = LazyDfa::InitialState;
+            m_starts  = { address };
+            m_address = address;
+        }
+
+        // Returns true if a match was completed and the lookahead bytes need to be scanned again
+        bool advance(u8 byte, std::vector<Region> &matches) {
+            const auto transition = m_dfa.getTransition(m_state, byte);
+            const auto &origins = m_dfa.getOrigins(transition.origins);
+            if (origins.isPrefix) {
+                m_starts.resize(origins.groups.size());
+            } else {
+                m_nextStarts.resize(origins.groups.size());
+                for (size_t i = 0; i < origins.groups.size(); i += 1)
+                    m_nextStarts[i] = origins.groups[i] == LazyDfa::NewGroup ? m_address + 1 : m_starts[origins.groups[i]];
+                std::swap(m_starts, m_nextStarts);
+            }
+
+            m_state = transition.next;
+            m_address += 1;
+
+            const auto &state = m_dfa.getState(m_state);
+            if (state.accepting) {
+                // The group that reached the match node is always the last one
+                m_pending = { m_starts.back(), m_address - m_starts.back() };
+                m_lookahead.clear();
+            } else if (state.matched) {
+                m_lookahead.push_back(byte);
+
+                // Patterns like `a.*b` could otherwise keep the match pending until the end of the data, holding on to all of it
+                // and never getting back in sync with the scanners of the following chunks
+                if (state.groupCount == 0 || m_lookahead.size() >= MaxMatchExtension) {
+                    matches.push_back(m_pending);
+                    this->reset(m_pending.getEndAddress() + 1);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        LazyDfa &m_dfa;
+
+        u32 m_state = LazyDfa::InitialState;
+        std::vector<u64> m_starts, m_nextStarts;
+        u64 m_address = 0;
+
+        Region m_pending = { };
+        std::vector<u8> m_lookahead;
+    };
+
+    ByteRegex::ByteRegex(std::string_view pattern) {
+        m_matchNode = this->addNode({ .type = Node::Type::Match });
+        m_startNode = Parser(*this, pattern).compile(m_matchNode);
+
+        this->computeByteClasses();
+
+        if (LazyDfa(*this).getState(LazyDfa::InitialState).accepting)
+            throw std::invalid_argument("Pattern must not match empty data");
+    }
+
+    u32 ByteRegex::addNode(Node node) {
+        if (m_nodes.size() >= MaxNodeCount)
+            throw std::invalid_argument("Pattern is too complex");
+
+        m_nodes.push_back(node);
+        return u32(m_nodes.size() - 1);
+    }
+
+    void ByteRegex::computeByteClasses() {
+        // A new class starts at every byte where any node treats it differently than the byte before it
+        std::bitset<256> boundaries;
+        boundaries.set(0);
+        for (const auto &node : m_nodes) {
+            if (node.type != Node::Type::Bytes)
+                continue;
+
+            for (u32 byte = 1; byte < 256; byte += 1) {
+                if (node.bytes.test(byte) != node.bytes.test(byte - 1))
+                    boundaries.set(byte);
+            }
+        }
+
+        m_classRepresentatives.clear();
+        for (u32 byte = 0; byte < 256; byte += 1) {
+            if (boundaries.test(byte))
+                m_classRepresentatives.push_back(u8(byte));
+
+            m_byteClasses[byte] = u8(m_classRepresentatives.size() - 1);
+        }
+    }
+
+    std::vector<Region> ByteRegex::search(std::span<const u8> data, u64 address) const {
+        std::vector<Region> matches;
+
+        LazyDfa dfa(*this);
+        Scanner scanner(dfa, address);
+        for (size_t i = 0; i < data.size(); i += 1) {
+            i += scanner.skipIdle(data.subspan(i));
+            if (i < data.size())
+                scanner.consume(data[i], matches);
+        }
+        scanner.finish(matches);
+
+        return matches;
+    }
+
+    std::vector<Region> ByteRegex::search(Task &task, prv::Provider *provider, Region region, size_t chunkSize) const {
+        std::vector<Region> matches;
+        this->search(task, provider, region, [&](std::span<const Region> newMatches) {
+            matches.insert(matches.end(), newMatches.begin(), newMatches.end());
+        }, chunkSize);
+
+        return matches;
+    }
+
+    void ByteRegex::search(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const Region>)> &callback, size_t chunkSize) const {
+        struct ChunkResult {
+            std::vector<Region> matches;
+            // Address ranges in which the chunk's scanner was idle. The scan of the previous chunk can hand over to it at any of these
+            std::vector<Region> idleRanges;
+            Scanner::Snapshot end;
+        };
+
+        std::vector<Region> matches;
+
+        LazyDfa dfa(*this);
+        Scanner scanner(dfa, region.getStartAddress());
+
+        prv::scanParallel(task, provider, region,
+            [this](u64 address, size_t size, std::span<const u8> data) {
+                ChunkResult result;
+
+                // Scan the chunk as if no match started before it
+                LazyDfa chunkDfa(*this);
+                Scanner chunkScanner(chunkDfa, address);
+                for (size_t i = 0; i < size; i += 1) {
+                    if (chunkScanner.isIdle()) {
+                        const auto skipped = chunkScanner.skipIdle(data.subspan(i, size - i));
+                        result.idleRanges.push_back({ address + i, std::min(skipped + 1, size - i) });
+
+                        i += skipped;
+                        if (i == size)
+                            break;
+                    }
+
+                    chunkScanner.consume(data[i], result.matches);
+                }
+
+                result.end = chunkScanner.save();
+
+                return result;
+            },
+            [&](u64 address, std::span<const u8> data, ChunkResult &&result) {
+                // Matches never change once they're found, so they're handed out after every chunk
+                ON_SCOPE_EXIT {
+                    if (!matches.empty()) {
+                        callback(matches);
+                        matches.clear();
+                    }
+                };
+
+                // Continue the previous scan until both scanners are idle at the same address, everything after that
+                // was already found by the chunk's scanner
+                auto idleRange = result.idleRanges.begin();
+                for (size_t i = 0; i < data.size(); i += 1) {
+                    if (scanner.isIdle()) {
+                        const auto skipped = scanner.skipIdle(data.subspan(i));
+                        const auto firstAddress = address + i, lastAddress = address + std::min(i + skipped, data.size() - 1);
+
+                        while (idleRange != result.idleRanges.end() && idleRange->getEndAddress() < firstAddress)
+                            ++idleRange;
+
+                        if (idleRange != result.idleRanges.end() && idleRange->getStartAddress() <= lastAddress) {
+                            const auto syncAddress = std::max(firstAddress, idleRange->getStartAddress());
+                            for (const auto &match : result.matches) {
+                                if (match.getStartAddress() >= syncAddress)
+                                    matches.push_back(match);
+                            }
+
+                            scanner.restore(result.end);
+                            return;
+                        }
+
+                        i += skipped;
+                        if (i == data.size())
+                            break;
+                    }
+
+                    scanner.consume(data[i], matches);
+                }
+            },
+            chunkSize
+        );
+
+        scanner.finish(matches);
+        if (!matches.empty())
+            callback(matches);
+    }
+
+}
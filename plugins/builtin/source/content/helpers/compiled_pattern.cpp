@@ -0,0 +1,34 @@
+#include <content/helpers/compiled_pattern.hpp>
+
+#include <pl/core/evaluator.hpp>
+
+#include <fmt/format.h>
+
+namespace hex::plugin::builtin {
+
+    std::optional<CompiledPattern> CompiledPattern::compile(pl::PatternLanguage &runtime, const std::string &code) {
+        auto ast = runtime.parseString(code, pl::api::Source::DefaultSource);
+        if (!ast.has_value())
+            return std::nullopt;
+
+        CompiledPattern result;
+        result.m_ast = std::move(*ast);
+        for (const auto &[name, value] : runtime.getPragmaValues(code))
+            result.m_pragmas += fmt::format("#pragma {} {}\n", name, value);
+
+        return result;
+    }
+
+    bool CompiledPattern::execute(pl::PatternLanguage &runtime, const std::map<std::string, pl::core::Token::Literal> &inVariables) const {
+        // Executing just the pragmas resets the runtime and the evaluator to their defaults and then runs the pragma handlers,
+        // the same way executing the entire code would. Otherwise settings would carry over from whatever ran or got compiled last
+        if (runtime.executeString(m_pragmas, pl::api::Source::DefaultSource, {}, {}, false) != 0)
+            return false;
+
+        const auto &evaluator = runtime.getInternals().evaluator;
+        evaluator->setInVariables(inVariables);
+
+        return evaluator->evaluate(m_ast);
+    }
+
+}
@@ -0,0 +1,358 @@
+#include <content/helpers/expression_program.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <limits>
+
+namespace hex::plugin::builtin {
+
+    class ExpressionProgram::Compiler {
+    public:
+        explicit Compiler(std::string_view expression) : m_input(expression) { }
+
+        std::optional<std::vector<Instruction>> compile() {
+            if (!this->parseBinary(0))
+                return std::nullopt;
+
+            this->skipWhitespace();
+            if (!m_input.empty())
+                return std::nullopt;
+
+            return std::move(m_instructions);
+        }
+
+    private:
+        struct BinaryOperator {
+            std::string_view token;
+            OpCode opCode;
+            u32 precedence;
+        };
+
+        // Two character operators need to come before their single character prefixes
+        constexpr static std::array BinaryOperators = {
+            BinaryOperator { "||", OpCode::LogicalOr,    1  },
+            BinaryOperator { "&&", OpCode::LogicalAnd,   2  },
+            BinaryOperator { "==", OpCode::Equal,        6  },
+            BinaryOperator { "!=", OpCode::NotEqual,     6  },
+            BinaryOperator { "<<", OpCode::ShiftLeft,    8  },
+            BinaryOperator { ">>", OpCode::ShiftRight,   8  },
+            BinaryOperator { "<=", OpCode::LessEqual,    7  },
+            BinaryOperator { ">=", OpCode::GreaterEqual, 7  },
+            BinaryOperator { "|",  OpCode::BitwiseOr,    3  },
+            BinaryOperator { "^",  OpCode::BitwiseXor,   4  },
+            BinaryOperator { "&",  OpCode::BitwiseAnd,   5  },
+            BinaryOperator { "<",  OpCode::Less,         7  },
+            BinaryOperator { ">",  OpCode::Greater,      7  },
+            BinaryOperator { "+",  OpCode::Add,          9  },
+            BinaryOperator { "-",  OpCode::Subtract,     9  },
+            BinaryOperator { "*",  OpCode::Multiply,     10 },
+            BinaryOperator { "/",  OpCode::Divide,       10 },
+            BinaryOperator { "%",  OpCode::Modulo,       10 },
+        };
+
+        void skipWhitespace() {
+            while (!m_input.empty() && std::isspace(static_cast<unsigned char>(m_input.front())))
+                m_input.remove_prefix(1);
+        }
+
+        bool consume(char c) {
+            this->skipWhitespace();
+            if (m_input.empty() || m_input.front() != c)
+                return false;
+
+            m_input.remove_prefix(1);
+            return true;
+        }
+
+        bool parseBinary(u32 minPrecedence) {
+            if (!this->parseUnary())
+                return false;
+
+            while (true) {
+                this->skipWhitespace();
+
+                const auto op = std::ranges::find_if(BinaryOperators, [this](const BinaryOperator &binaryOperator) {
+                    return m_input.starts_with(binaryOperator.token);
+                });
+
+                if (op == BinaryOperators.end() || op->precedence < minPrecedence)
+                    return true;
+
+                m_input.remove_prefix(op->token.size());
+
+                // All binary operators are left-associative, so the right hand side may only contain operators that bind stronger
+                if (!this->parseBinary(op->precedence + 1))
+                    return false;
+
+                m_instructions.push_back({ op->opCode });
+            }
+        }
+
+        bool parseUnary() {
+            this->skipWhitespace();
+
+            if (m_input.empty())
+                return false;
+
+            std::optional<OpCode> opCode;
+            switch (m_input.front()) {
+                case '-': opCode = OpCode::Negate;      break;
+                case '~': opCode = OpCode::BitwiseNot;  break;
+                case '!': opCode = OpCode::LogicalNot;  break;
+                case '+': m_input.remove_prefix(1); return this->parseUnary();
+                default:  return this->parsePrimary();
+            }
+
+            m_input.remove_prefix(1);
+            if (!this->parseUnary())
+                return false;
+
+            m_instructions.push_back({ *opCode });
+            return true;
+        }
+
+        bool parsePrimary() {
+            this->skipWhitespace();
+
+            if (this->consume('(')) {
+                if (!this->parseBinary(0))
+                    return false;
+
+                return this->consume(')');
+            }
+
+            if (m_input.empty())
+                return false;
+
+            if (std::isdigit(static_cast<unsigned char>(m_input.front())))
+                return this->parseNumber();
+
+            if (std::isalpha(static_cast<unsigned char>(m_input.front())) || m_input.front() == '_')
+                return this->parseIdentifier();
+
+            return false;
+        }
+
+        bool parseNumber() {
+            u32 base = 10;
+            if (m_input.size() > 2 && m_input[0] == '0') {
+                switch (std::tolower(static_cast<unsigned char>(m_input[1]))) {
+                    case 'x': base = 16; break;
+                    case 'b': base = 2;  break;
+                    case 'o': base = 8;  break;
+                    default: break;
+                }
+
+                if (base != 10)
+                    m_input.remove_prefix(2);
+            }
+
+            u128 result = 0;
+            size_t digitCount = 0;
+            while (!m_input.empty()) {
+                const auto c = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(m_input.front())));
+
+                u32 digit;
+                if (c >= '0' && c <= '9')
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'z')
+                    digit = (c - 'a') + 10;
+                else
+                    break;
+
+                if (digit >= base)
+                    return false;
+
+                if (result > (std::numeric_limits<u128>::max() - digit) / base)
+                    return false;
+
+                result = result * base + digit;
+                digitCount += 1;
+                m_input.remove_prefix(1);
+            }
+
+            if (digitCount == 0)
+                return false;
+
+            m_instructions.push_back({ OpCode::PushConstant, i128(result) });
+            return true;
+        }
+
+        bool parseIdentifier() {
+            size_t length = 0;
+            while (length < m_input.size() && (std::isalnum(static_cast<unsigned char>(m_input[length])) || m_input[length] == '_'))
+                length += 1;
+
+            const auto identifier = m_input.substr(0, length);
+            m_input.remove_prefix(length);
+
+            if (identifier == "value")
+                m_instructions.push_back({ OpCode::PushValue });
+            else if (identifier == "offset")
+                m_instructions.push_back({ OpCode::PushOffset });
+            else
+                return false;
+
+            return true;
+        }
+
+    private:
+        std::string_view m_input;
+        std::vector<Instruction> m_instructions;
+    };
+
+    bool ExpressionProgram::applyBinary(OpCode opCode, i128 lhs, i128 rhs, i128 &result) {
+        // Arithmetic is done on unsigned values to get well-defined wrap-around behaviour
+        using enum OpCode;
+
+        switch (opCode) {
+            case Add:          result = i128(u128(lhs) + u128(rhs)); break;
+            case Subtract:     result = i128(u128(lhs) - u128(rhs)); break;
+            case Multiply:     result = i128(u128(lhs) * u128(rhs)); break;
+            case Divide:
+            case Modulo:
+                if (rhs == 0 || (lhs == std::numeric_limits<i128>::min() && rhs == -1))
+                    return false;
+                result = opCode == Divide ? lhs / rhs : lhs % rhs;
+                break;
+            case BitwiseAnd:   result = lhs & rhs; break;
+            case BitwiseOr:    result = lhs | rhs; break;
+            case BitwiseXor:   result = lhs ^ rhs; break;
+            case ShiftLeft:
+            case ShiftRight:
+                if (rhs < 0 || rhs >= 128)
+                    return false;
+                result = opCode == ShiftLeft ? i128(u128(lhs) << u32(rhs)) : lhs >> u32(rhs);
+                break;
+            case Equal:        result = lhs == rhs; break;
+            case NotEqual:     result = lhs != rhs; break;
+            case Less:         result = lhs <  rhs; break;
+            case Greater:      result = lhs >  rhs; break;
+            case LessEqual:    result = lhs <= rhs; break;
+            case GreaterEqual: result = lhs >= rhs; break;
+            case LogicalAnd:   result = lhs != 0 && rhs != 0; break;
+            case LogicalOr:    result = lhs != 0 || rhs != 0; break;
+            default:           return false;
+        }
+
+        return true;
+    }
+
+    std::optional<ExpressionProgram> ExpressionProgram::compile(std::string_view expression) {
+        auto instructions = Compiler(expression).compile();
+        if (!instructions.has_value() || instructions->empty())
+            return std::nullopt;
+
+        ExpressionProgram program;
+
+        // Determine how deep the evaluation stack will get so evaluation never needs to reallocate
+        size_t depth = 0;
+        for (const auto &instruction : *instructions) {
+            switch (instruction.opCode) {
+                case OpCode::PushConstant:
+                case OpCode::PushValue:
+                case OpCode::PushOffset:
+                    depth += 1;
+                    break;
+                case OpCode::Negate:
+                case OpCode::BitwiseNot:
+                case OpCode::LogicalNot:
+                    break;
+                default:
+                    depth -= 1;
+                    break;
+            }
+
+            program.m_maxStackDepth = std::max(program.m_maxStackDepth, depth);
+        }
+
+        program.m_instructions = std::move(*instructions);
+
+        return program;
+    }
+
+    std::optional<i128> ExpressionProgram::evaluate(i128 value, i128 offset) const {
+        std::vector<i128> stack;
+        stack.reserve(m_maxStackDepth);
+
+        for (const auto &[opCode, constant] : m_instructions) {
+            switch (opCode) {
+                case OpCode::PushConstant: stack.push_back(constant); break;
+                case OpCode::PushValue:    stack.push_back(value); break;
+                case OpCode::PushOffset:   stack.push_back(offset); break;
+                case OpCode::Negate:       stack.back() = i128(u128(0) - u128(stack.back())); break;
+                case OpCode::BitwiseNot:   stack.back() = ~stack.back(); break;
+                case OpCode::LogicalNot:   stack.back() = stack.back() == 0; break;
+                default: {
+                    const auto rhs = stack.back();
+                    stack.pop_back();
+
+                    if (!applyBinary(opCode, stack.back(), rhs, stack.back()))
+                        return std::nullopt;
+                    break;
+                }
+            }
+        }
+
+        return stack.back();
+    }
+
+    void ExpressionProgram::evaluate(std::span<const i128> values, std::span<const i128> offsets, std::span<u8> results) const {
+        const auto count = std::min({ values.size(), offsets.size(), results.size() });
+        if (count == 0)
+            return;
+
+        // Evaluate the program instruction by instruction over all inputs at once. Each stack slot holds one value per input
+        std::vector<i128> stack(m_maxStackDepth * count);
+        std::vector<bool> valid(count, true);
+        size_t depth = 0;
+
+        const auto slot = [&](size_t index) { return std::span(stack).subspan(index * count, count); };
+
+        for (const auto &[opCode, constant] : m_instructions) {
+            switch (opCode) {
+                case OpCode::PushConstant:
+                    std::ranges::fill(slot(depth), constant);
+                    depth += 1;
+                    break;
+                case OpCode::PushValue:
+                    std::ranges::copy(values.first(count), slot(depth).begin());
+                    depth += 1;
+                    break;
+                case OpCode::PushOffset:
+                    std::ranges::copy(offsets.first(count), slot(depth).begin());
+                    depth += 1;
+                    break;
+                case OpCode::Negate:
+                    for (auto &value : slot(depth - 1))
+                        value = i128(u128(0) - u128(value));
+                    break;
+                case OpCode::BitwiseNot:
+                    for (auto &value : slot(depth - 1))
+                        value = ~value;
+                    break;
+                case OpCode::LogicalNot:
+                    for (auto &value : slot(depth - 1))
+                        value = value == 0;
+                    break;
+                default: {
+                    auto lhs = slot(depth - 2);
+                    const auto rhs = slot(depth - 1);
+                    for (size_t i = 0; i < count; i += 1) {
+                        if (!applyBinary(opCode, lhs[i], rhs[i], lhs[i]))
+                            valid[i] = false;
+                    }
+
+                    depth -= 1;
+                    break;
+                }
+            }
+        }
+
+        const auto result = slot(0);
+        for (size_t i = 0; i < count; i += 1)
+            results[i] = valid[i] && result[i] != 0 ? 1 : 0;
+    }
+
+}
@@ -0,0 +1,151 @@
+#include <content/helpers/highlight_compositor.hpp>
+
+#include <hex/api/imhex_api/hex_editor.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <algorithm>
+
+#include <imgui_internal.h>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        struct Boundary {
+            u128 address;
+            size_t index;
+            bool opening;
+        };
+
+    }
+
+    std::span<const ui::HexEditor::HighlightRun> HighlightCompositor::resolve(const prv::Provider *provider, const Region &visibleRegion, const std::set<Region> &hoveredRegions) {
+        auto sourceVersions = this->getSourceVersions();
+        const auto highlightsVersion = ImHexApi::HexEditor::impl::getHighlightsVersion();
+
+        if (!m_valid || m_provider != provider || m_region != visibleRegion || m_highlightsVersion != highlightsVersion || m_sourceVersions != sourceVersions) {
+            this->rebuild(provider, visibleRegion, hoveredRegions);
+
+            m_valid             = true;
+            m_provider          = provider;
+            m_region            = visibleRegion;
+            m_highlightsVersion = highlightsVersion;
+            m_sourceVersions    = std::move(sourceVersions);
+        }
+
+        return m_runs;
+    }
+
+    std::vector<std::pair<u32, u64>> HighlightCompositor::getSourceVersions() const {
+        const auto &sources = m_layer == Layer::Foreground ?
+            ImHexApi::HexEditor::impl::getForegroundHighlightSources() :
+            ImHexApi::HexEditor::impl::getBackgroundHighlightSources();
+
+        std::vector<std::pair<u32, u64>> result;
+        result.reserve(sources.size());
+        for (const auto &[id, source] : sources)
+            result.emplace_back(id, source.version);
+
+        return result;
+    }
+
+    void HighlightCompositor::rebuild(const prv::Provider *provider, const Region &visibleRegion, const std::set<Region> &hoveredRegions) {
+        m_runs.clear();
+
+        if (provider == nullptr || visibleRegion == Region::Invalid() || visibleRegion.getSize() == 0)
+            return;
+
+        // Collect all highlights overlapping the visible region in priority order, clipped to the visible region
+        struct Entry {
+            Region region;
+            color_t color;
+            bool hovered;
+        };
+
+        std::vector<Entry> entries;
+        const auto addEntry = [&](const Region &region, color_t color, bool hovered) {
+            if (region.getSize() == 0 || !region.overlaps(visibleRegion))
+                return;
+
+            const auto start = std::max(region.getStartAddress(), visibleRegion.getStartAddress());
+            const auto end   = std::min(region.getEndAddress(), visibleRegion.getEndAddress());
+            entries.push_back({ { .address=start, .size=(end - start) + 1 }, color, hovered });
+        };
+
+        const auto &sources = m_layer == Layer::Foreground ?
+            ImHexApi::HexEditor::impl::getForegroundHighlightSources() :
+            ImHexApi::HexEditor::impl::getBackgroundHighlightSources();
+        for (const auto &[id, source] : sources) {
+            for (const auto &highlighting : source.function(provider, visibleRegion))
+                addEntry(highlighting.getRegion(), highlighting.getColor(), false);
+        }
+
+        const auto &highlights = m_layer == Layer::Foreground ?
+            ImHexApi::HexEditor::impl::getForegroundHighlights() :
+            ImHexApi::HexEditor::impl::getBackgroundHighlights();
+        for (const auto &[id, highlighting] : highlights)
+            addEntry(highlighting.getRegion(), highlighting.getColor(), false);
+
+        if (entries.empty())
+            return;
+
+        if (m_layer == Layer::Background) {
+            for (const auto &region : hoveredRegions)
+                addEntry(region, 0x00, true);
+        }
+
+        // Sweep over all interval boundaries and resolve the color of every elementary segment in between
+        std::vector<Boundary> boundaries;
+        boundaries.reserve(entries.size() * 2);
+        for (size_t i = 0; i < entries.size(); i++) {
+            boundaries.push_back({ entries[i].region.getStartAddress(), i, true });
+            boundaries.push_back({ u128(entries[i].region.getEndAddress()) + 1, i, false });
+        }
+        std::ranges::sort(boundaries, { }, &Boundary::address);
+
+        std::set<size_t> active;
+        for (size_t i = 0; i < boundaries.size();) {
+            const auto segmentStart = boundaries[i].address;
+            for (; i < boundaries.size() && boundaries[i].address == segmentStart; i++) {
+                if (boundaries[i].opening)
+                    active.insert(boundaries[i].index);
+                else
+                    active.erase(boundaries[i].index);
+            }
+
+            if (i == boundaries.size() || active.empty())
+                continue;
+
+            std::optional<ImColor> color;
+            bool hovered = false;
+            for (const auto index : active) {
+                const auto &entry = entries[index];
+                if (entry.hovered) {
+                    hovered = true;
+                } else if (m_layer == Layer::Background) {
+                    color = blendColors(color, ImColor(entry.color));
+                } else if (!color.has_value()) {
+                    // Foreground colors can't be blended, the highlight registered first wins
+                    color = ImColor(entry.color);
+                }
+            }
+
+            if (!color.has_value())
+                continue;
+
+            color_t segmentColor = *color;
+            if (hovered)
+                segmentColor = ImAlphaBlendColors(segmentColor, 0xA0FFFFFF);
+
+            const auto segmentEnd = boundaries[i].address;
+            const Region region = { .address=u64(segmentStart), .size=u64(segmentEnd - segmentStart) };
+
+            // Merge neighbouring segments of the same color into a single run
+            if (!m_runs.empty() && m_runs.back().color == segmentColor && m_runs.back().region.getEndAddress() + 1 == region.getStartAddress())
+                m_runs.back().region.size += region.getSize();
+            else
+                m_runs.push_back({ region, segmentColor });
+        }
+    }
+
+}
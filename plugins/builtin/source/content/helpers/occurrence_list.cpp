@@ -0,0 +1,243 @@
+#include <content/helpers/occurrence_list.hpp>
+
+#include <hex/api/task_manager.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        // Folds characters the same way hex::containsIgnoreCase does
+        u8 foldCase(char character) {
+            return u8(std::toupper(character));
+        }
+
+        void collectTrigrams(std::string_view string, std::vector<u32> &trigrams) {
+            trigrams.clear();
+            for (size_t i = 0; i + 3 <= string.size(); i += 1)
+                trigrams.push_back(u32(foldCase(string[i])) << 16 | u32(foldCase(string[i + 1])) << 8 | u32(foldCase(string[i + 2])));
+
+            std::ranges::sort(trigrams);
+            const auto [first, last] = std::ranges::unique(trigrams);
+            trigrams.erase(first, last);
+        }
+
+    }
+
+    void OccurrenceList::push_back(const Occurrence &occurrence) {
+        const auto size = occurrence.region.getSize();
+        if (m_addresses.empty())
+            m_uniformSize = size;
+
+        if (!m_sizes.empty() || size != m_uniformSize) {
+            if (m_sizes.empty())
+                m_sizes.resize(m_addresses.size(), this->encodeSize(m_uniformSize));
+            m_sizes.push_back(this->encodeSize(size));
+        }
+
+        m_addresses.push_back(occurrence.region.getStartAddress());
+        m_flags.push_back(
+            (u8(occurrence.decodeType) & DecodeTypeMask) |
+            (occurrence.endian != std::endian::native ? NonNativeEndianFlag : 0x00) |
+            (occurrence.selected ? SelectedFlag : 0x00)
+        );
+
+        if (!occurrence.string.empty()) {
+            auto [it, inserted] = m_labelLookup.try_emplace(occurrence.string, u32(m_labels.size()));
+            if (inserted)
+                m_labels.push_back(occurrence.string);
+
+            m_labelIndices.resize(m_addresses.size(), 0);
+            m_labelIndices.back() = it->second;
+        } else if (!m_labelIndices.empty()) {
+            m_labelIndices.resize(m_addresses.size(), 0);
+        }
+    }
+
+    void OccurrenceList::reserve(size_t count) {
+        m_addresses.reserve(count);
+        m_flags.reserve(count);
+    }
+
+    void OccurrenceList::clear() {
+        *this = OccurrenceList();
+    }
+
+    OccurrenceList::Occurrence OccurrenceList::operator[](size_t index) const {
+        const auto flags = m_flags[index];
+
+        return Occurrence {
+            this->getRegion(index),
+            (flags & NonNativeEndianFlag) != 0 ? NonNativeEndian : std::endian::native,
+            Occurrence::DecodeType(flags & DecodeTypeMask),
+            (flags & SelectedFlag) != 0,
+            index < m_labelIndices.size() ? m_labels[m_labelIndices[index]] : std::string()
+        };
+    }
+
+    void OccurrenceList::setSelected(size_t index, bool selected) {
+        if (selected)
+            m_flags[index] |= SelectedFlag;
+        else
+            m_flags[index] &= ~SelectedFlag;
+    }
+
+    void OccurrenceList::clearSelection() {
+        for (auto &flags : m_flags)
+            flags &= ~SelectedFlag;
+    }
+
+    void OccurrenceList::sort() {
+        // Most searches already report their results in order
+        if (!std::ranges::is_sorted(m_addresses)) {
+            std::vector<u32> order(m_addresses.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, {}, [this](u32 index) { return m_addresses[index]; });
+
+            const auto reorder = [&order](auto &column) {
+                if (column.empty())
+                    return;
+
+                std::remove_cvref_t<decltype(column)> sorted;
+                sorted.reserve(column.size());
+                for (const auto index : order)
+                    sorted.push_back(column[index]);
+
+                column = std::move(sorted);
+            };
+
+            reorder(m_addresses);
+            reorder(m_sizes);
+            reorder(m_flags);
+            if (!m_labelIndices.empty()) {
+                m_labelIndices.resize(m_addresses.size(), 0);
+                reorder(m_labelIndices);
+            }
+        }
+
+        m_maxEndAddresses.clear();
+        m_maxEndAddresses.reserve((m_addresses.size() + MaxEndAddressStride - 1) / MaxEndAddressStride);
+        u64 maxEndAddress = 0;
+        for (size_t i = 0; i < m_addresses.size(); i += 1) {
+            maxEndAddress = std::max(maxEndAddress, this->getRegion(i).getEndAddress());
+            if ((i + 1) % MaxEndAddressStride == 0 || i + 1 == m_addresses.size())
+                m_maxEndAddresses.push_back(maxEndAddress);
+        }
+    }
+
+    std::vector<u32> OccurrenceList::findOverlapping(Region region) const {
+        std::vector<u32> result;
+
+        // Occurrences before the first group whose running maximum end address reaches into the region all end before it
+        const auto firstGroup = std::ranges::lower_bound(m_maxEndAddresses, region.getStartAddress()) - m_maxEndAddresses.begin();
+        for (auto i = size_t(firstGroup) * MaxEndAddressStride; i < m_addresses.size() && m_addresses[i] <= region.getEndAddress(); i += 1) {
+            if (this->getRegion(i).getEndAddress() >= region.getStartAddress())
+                result.push_back(u32(i));
+        }
+
+        return result;
+    }
+
+    bool OccurrenceList::hasOverlapping(Region region) const {
+        const auto firstGroup = std::ranges::lower_bound(m_maxEndAddresses, region.getStartAddress()) - m_maxEndAddresses.begin();
+        for (auto i = size_t(firstGroup) * MaxEndAddressStride; i < m_addresses.size() && m_addresses[i] <= region.getEndAddress(); i += 1) {
+            if (this->getRegion(i).getEndAddress() >= region.getStartAddress())
+                return true;
+        }
+
+        return false;
+    }
+
+    u64 OccurrenceList::getSize(size_t index) const {
+        if (m_sizes.empty())
+            return m_uniformSize;
+
+        const auto size = m_sizes[index];
+        if ((size & LargeSizeFlag) != 0)
+            return m_largeSizes[size & ~LargeSizeFlag];
+        else
+            return size;
+    }
+
+    u32 OccurrenceList::encodeSize(u64 size) {
+        if (size < LargeSizeFlag)
+            return u32(size);
+
+        m_largeSizes.push_back(size);
+        return LargeSizeFlag | u32(m_largeSizes.size() - 1);
+    }
+
+    bool OccurrenceFilterIndex::build(Task &task, const OccurrenceList &occurrences, const std::function<std::string(const OccurrenceList::Occurrence&)> &decode) {
+        m_entries.clear();
+        m_unindexed.clear();
+
+        size_t entryCount = 0;
+        std::vector<u32> trigrams;
+        for (u32 i = 0; i < occurrences.size(); i += 1) {
+            task.update(i);
+
+            const auto occurrence = occurrences[i];
+            if (occurrence.region.getSize() > MaxIndexedSize) {
+                m_unindexed.push_back(i);
+                continue;
+            }
+
+            collectTrigrams(decode(occurrence), trigrams);
+
+            // Values are indexed in order so every list of occurrences stays sorted
+            for (const auto trigram : trigrams)
+                m_entries[trigram].push_back(i);
+
+            entryCount += trigrams.size();
+            if (entryCount > MaxEntryCount) {
+                m_entries.clear();
+                m_unindexed.clear();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<std::vector<u32>> OccurrenceFilterIndex::getCandidates(std::string_view filter) const {
+        std::vector<u32> trigrams;
+        collectTrigrams(filter, trigrams);
+        if (trigrams.empty())
+            return std::nullopt;
+
+        // Intersect the occurrence lists of all trigrams, starting with the shortest one
+        std::vector<const std::vector<u32>*> lists;
+        for (const auto trigram : trigrams) {
+            const auto it = m_entries.find(trigram);
+            if (it == m_entries.end()) {
+                lists.clear();
+                break;
+            }
+
+            lists.push_back(&it->second);
+        }
+
+        std::vector<u32> candidates;
+        if (!lists.empty()) {
+            std::ranges::sort(lists, {}, [](const auto *list) { return list->size(); });
+
+            candidates = *lists.front();
+            std::vector<u32> intersection;
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); i += 1) {
+                intersection.clear();
+                std::ranges::set_intersection(candidates, *lists[i], std::back_inserter(intersection));
+                std::swap(candidates, intersection);
+            }
+        }
+
+        std::vector<u32> result;
+        result.reserve(candidates.size() + m_unindexed.size());
+        std::ranges::merge(candidates, m_unindexed, std::back_inserter(result));
+
+        return result;
+    }
+
+}
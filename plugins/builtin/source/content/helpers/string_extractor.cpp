@@ -0,0 +1,330 @@
+#include <content/helpers/string_extractor.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/providers/parallel_scanner.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+
+    #define STRING_CLASSIFY_VECTORIZED
+    #define STRING_CLASSIFY_TARGET __attribute__((target("ssse3")))
+#endif
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        constexpr static size_t BlockSize = 64;
+
+        constexpr u64 getRangeMask(size_t from, size_t to) {
+            const u64 upper = to >= BlockSize ? ~0ULL : (1ULL << to) - 1;
+            return upper & (~0ULL << from);
+        }
+
+        #if defined(STRING_CLASSIFY_VECTORIZED)
+
+            bool isVectorizationSupported() {
+                static const bool supported = __builtin_cpu_supports("ssse3");
+                return supported;
+            }
+
+            /**
+             * @brief Classifies 64 bytes at once by looking up the low nibble of every byte in a table of bit rows
+             * and testing the bit selected by the high nibble. Bytes above 0x7F select no bit and are never valid
+             */
+            STRING_CLASSIFY_TARGET void classifyVectorized(const u8 *data, const u8 *lowNibbleTable, u64 &valid, u64 &zero, u64 &high) {
+                const auto table      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lowNibbleTable));
+                const auto bits       = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+                const auto nibbleMask = _mm_set1_epi8(0x0F);
+                const auto zeros      = _mm_setzero_si128();
+
+                valid = zero = high = 0;
+                for (size_t i = 0; i < BlockSize / 16; i += 1) {
+                    const auto block   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+                    const auto rows    = _mm_shuffle_epi8(table, _mm_and_si128(block, nibbleMask));
+                    const auto columns = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask));
+                    const auto invalid = _mm_cmpeq_epi8(_mm_and_si128(rows, columns), zeros);
+
+                    valid |= u64(u16(~_mm_movemask_epi8(invalid))) << (i * 16);
+                    zero  |= u64(u16(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zeros)))) << (i * 16);
+                    high  |= u64(u16(_mm_movemask_epi8(block))) << (i * 16);
+                }
+            }
+
+        #endif
+
+    }
+
+    StringExtractor::StringExtractor(Encoding encoding, const std::array<bool, 256> &validCharacters, i64 minLength, bool nullTermination)
+        : m_encoding(encoding), m_validCharacters(validCharacters), m_minLength(std::max<i64>(minLength, 1)), m_nullTermination(nullTermination) {
+
+        m_vectorizable = std::none_of(m_validCharacters.begin() + 0x80, m_validCharacters.end(), [](bool valid) { return valid; });
+        for (u32 byte = 0x00; byte < 0x80; byte += 1) {
+            if (m_validCharacters[byte])
+                m_lowNibbleTable[byte & 0x0F] |= u8(1U << (byte >> 4));
+        }
+    }
+
+    StringExtractor::Masks StringExtractor::classify(const u8 *data, size_t size) const {
+        Masks masks = { };
+
+        #if defined(STRING_CLASSIFY_VECTORIZED)
+            if (size == BlockSize && m_vectorizable && isVectorizationSupported()) {
+                classifyVectorized(data, m_lowNibbleTable.data(), masks.valid, masks.zero, masks.high);
+                return masks;
+            }
+        #endif
+
+        for (size_t i = 0; i < size; i += 1) {
+            const auto byte = data[i];
+
+            masks.valid |= u64(m_validCharacters[byte]) << i;
+            masks.zero  |= u64(byte == 0x00) << i;
+            masks.high  |= u64(byte >= 0x80) << i;
+        }
+
+        return masks;
+    }
+
+    bool StringExtractor::isSynchronizationPoint(u8 byte) const {
+        // A synchronization point ends any string no matter in which state the scanner is and always leaves it in the
+        // same state afterwards. Scanning can therefore start right after it without knowing anything that came before
+        switch (m_encoding) {
+            using enum Encoding;
+            case ASCII:
+                return !m_validCharacters[byte];
+            case UTF16LE:
+            case UTF16BE:
+                return !m_validCharacters[byte] && byte != 0x00;
+            case UTF8:
+                return byte < 0x80 && !m_validCharacters[byte];
+        }
+
+        return false;
+    }
+
+    std::optional<size_t> StringExtractor::findSynchronizationPoint(std::span<const u8> data) const {
+        for (size_t offset = 0; offset < data.size(); offset += BlockSize) {
+            const auto size  = std::min(BlockSize, data.size() - offset);
+            const auto masks = this->classify(data.data() + offset, size);
+
+            u64 points = ~masks.valid;
+            switch (m_encoding) {
+                using enum Encoding;
+                case ASCII:                                 break;
+                case UTF16LE: case UTF16BE: points &= ~masks.zero; break;
+                case UTF8:                                  points &= ~masks.high; break;
+            }
+
+            points &= getRangeMask(0, size);
+            if (points != 0)
+                return offset + std::countr_zero(points);
+        }
+
+        return std::nullopt;
+    }
+
+    void StringExtractor::endRun(State &state, u8 terminator, u64 address, std::vector<Run> &runs) const {
+        if (state.count >= m_minLength && (!m_nullTermination || terminator == 0x00))
+            runs.push_back({ state.startAddress, state.count });
+
+        state.startAddress = address + 1;
+        state.count = 0;
+    }
+
+    void StringExtractor::finish(State &state, u8 lastByte, std::vector<Run> &runs) const {
+        // A string running until the end of the data is terminated by the last byte of the data itself
+        if (state.count > 0 && state.count >= m_minLength && (!m_nullTermination || lastByte == 0x00))
+            runs.push_back({ state.startAddress, state.count });
+
+        state.count = 0;
+    }
+
+    void StringExtractor::scanUtf8Byte(State &state, u8 byte, u64 address, std::vector<Run> &runs) const {
+        bool valid;
+        if (state.remainingContinuationBytes > 0) {
+            if ((byte & 0xC0) == 0x80) {
+                valid = true;
+                state.remainingContinuationBytes -= 1;
+            } else {
+                valid = false;
+                state.remainingContinuationBytes = 0;
+            }
+        } else if (byte <= 0x7F) {
+            valid = m_validCharacters[byte];
+        } else if ((byte & 0xE0) == 0xC0) {
+            valid = byte >= 0xC2;
+            state.remainingContinuationBytes = 1;
+        } else if ((byte & 0xF0) == 0xE0) {
+            valid = byte != 0xE0 && byte != 0xED;
+            state.remainingContinuationBytes = 2;
+        } else if ((byte & 0xF8) == 0xF0) {
+            valid = byte <= 0xF4;
+            state.remainingContinuationBytes = 3;
+        } else {
+            valid = false;
+        }
+
+        if (valid)
+            state.count += 1;
+        else
+            this->endRun(state, byte, address, runs);
+    }
+
+    void StringExtractor::scan(State &state, std::span<const u8> data, u64 address, std::vector<Run> &runs) const {
+        for (size_t offset = 0; offset < data.size(); offset += BlockSize) {
+            const auto block        = data.data() + offset;
+            const auto blockSize    = std::min(BlockSize, data.size() - offset);
+            const auto blockAddress = address + offset;
+            const auto masks        = this->classify(block, blockSize);
+
+            // Adds all bytes in [from, to) to the current string and ends it at every byte that isn't set in the valid mask
+            const auto scanRange = [&](u64 valid, size_t from, size_t to) {
+                u64 invalid = ~valid & getRangeMask(from, to);
+                size_t cursor = from;
+                while (invalid != 0) {
+                    const auto index = size_t(std::countr_zero(invalid));
+                    state.count += index - cursor;
+                    this->endRun(state, block[index], blockAddress + index, runs);
+
+                    cursor = index + 1;
+                    invalid &= invalid - 1;
+                }
+
+                state.count += to - cursor;
+            };
+
+            switch (m_encoding) {
+                using enum Encoding;
+                case ASCII:
+                    scanRange(masks.valid, 0, blockSize);
+                    break;
+                case UTF16LE:
+                case UTF16BE: {
+                    // Which bytes need to be characters and which ones need to be zero depends on the alignment of the
+                    // string's start address, so the expected mask changes every time a string ends
+                    const u64 evenBytes  = (blockAddress & 1) == 0 ? 0x5555'5555'5555'5555 : 0xAAAA'AAAA'AAAA'AAAA;
+                    const u64 characters = m_encoding == UTF16LE ? masks.valid : masks.zero;
+                    const u64 zeros      = m_encoding == UTF16LE ? masks.zero  : masks.valid;
+
+                    const u64 evenStart = (characters & evenBytes) | (zeros & ~evenBytes);
+                    const u64 oddStart  = (characters & ~evenBytes) | (zeros & evenBytes);
+
+                    size_t cursor = 0;
+                    while (cursor < blockSize) {
+                        const auto valid   = (state.startAddress & 1) == 0 ? evenStart : oddStart;
+                        const auto invalid = ~valid & getRangeMask(cursor, blockSize);
+                        if (invalid == 0) {
+                            state.count += blockSize - cursor;
+                            break;
+                        }
+
+                        const auto index = size_t(std::countr_zero(invalid));
+                        state.count += index - cursor;
+                        this->endRun(state, block[index], blockAddress + index, runs);
+
+                        cursor = index + 1;
+                    }
+                    break;
+                }
+                case UTF8: {
+                    // Plain ASCII characters are handled through the masks, multi-byte sequences one byte at a time
+                    size_t cursor = 0;
+                    while (cursor < blockSize) {
+                        if (state.remainingContinuationBytes == 0) {
+                            const auto high = masks.high & getRangeMask(cursor, blockSize);
+                            const auto end  = high == 0 ? blockSize : size_t(std::countr_zero(high));
+
+                            scanRange(masks.valid, cursor, end);
+                            cursor = end;
+                            if (cursor == blockSize)
+                                break;
+                        }
+
+                        this->scanUtf8Byte(state, block[cursor], blockAddress + cursor, runs);
+                        cursor += 1;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<StringExtractor::Run> StringExtractor::extract(std::span<const u8> data, u64 address) const {
+        std::vector<Run> runs;
+        if (data.empty())
+            return runs;
+
+        State state = { .startAddress = address };
+        this->scan(state, data, address, runs);
+        this->finish(state, data.back(), runs);
+
+        return runs;
+    }
+
+    std::vector<StringExtractor::Run> StringExtractor::extract(Task &task, prv::Provider *provider, Region region, size_t chunkSize) const {
+        std::vector<Run> runs;
+        this->extract(task, provider, region, [&](std::span<const Run> newRuns) {
+            runs.insert(runs.end(), newRuns.begin(), newRuns.end());
+        }, chunkSize);
+
+        return runs;
+    }
+
+    void StringExtractor::extract(Task &task, prv::Provider *provider, Region region, const std::function<void(std::span<const Run>)> &callback, size_t chunkSize) const {
+        struct ChunkResult {
+            std::optional<size_t> synchronizationPoint;
+            State state;
+            std::vector<Run> runs;
+        };
+
+        std::vector<Run> runs;
+        State state = { .startAddress = region.getStartAddress() };
+        u8 lastByte = 0x00;
+
+        prv::scanParallel(task, provider, region,
+            [this](u64 address, size_t size, std::span<const u8> data) {
+                ChunkResult result;
+
+                // Everything after the first synchronization point can be scanned without knowing the state the previous chunk ended in
+                result.synchronizationPoint = this->findSynchronizationPoint(data.first(size));
+                if (result.synchronizationPoint.has_value()) {
+                    const auto start = *result.synchronizationPoint + 1;
+
+                    result.state = { .startAddress = address + start };
+                    this->scan(result.state, data.subspan(start, size - start), address + start, result.runs);
+                }
+
+                return result;
+            },
+            [&](u64 address, std::span<const u8> data, ChunkResult &&result) {
+                if (result.synchronizationPoint.has_value()) {
+                    this->scan(state, data.first(*result.synchronizationPoint + 1), address, runs);
+                    std::ranges::move(result.runs, std::back_inserter(runs));
+                    state = result.state;
+                } else {
+                    this->scan(state, data, address, runs);
+                }
+
+                lastByte = data.back();
+
+                // Runs never change once they're found, only the one that's still going on is kept in the state
+                if (!runs.empty()) {
+                    callback(runs);
+                    runs.clear();
+                }
+            },
+            chunkSize
+        );
+
+        this->finish(state, lastByte, runs);
+        if (!runs.empty())
+            callback(runs);
+    }
+
+}
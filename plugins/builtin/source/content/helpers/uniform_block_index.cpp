@@ -0,0 +1,318 @@
+#include <content/helpers/uniform_block_index.hpp>
+
+#include <hex/api/events/events_interaction.hpp>
+#include <hex/api/events/events_provider.hpp>
+#include <hex/providers/provider.hpp>
+#include <hex/providers/undo_redo/stack.hpp>
+
+#include <wolv/utils/guards.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        // Limits the memory used by the index of very large providers by using bigger blocks for them
+        constexpr u64 MaxBlockCount = 1024 * 1024;
+
+        // Skipping fewer blocks than this isn't worth splitting up a search for
+        constexpr u64 MinSkippedBlockCount = 16;
+
+        std::mutex s_indicesMutex;
+        std::map<const prv::Provider*, std::shared_ptr<UniformBlockIndex>> s_indices;
+
+        std::shared_ptr<UniformBlockIndex> findIndex(const prv::Provider *provider) {
+            std::scoped_lock lock(s_indicesMutex);
+
+            const auto it = s_indices.find(provider);
+            return it == s_indices.end() ? nullptr : it->second;
+        }
+
+        // Converts an address from a provider event to an offset relative to the base address
+        u64 toOffset(const prv::Provider *provider, u64 address) {
+            return address - std::min(address, provider->getBaseAddress());
+        }
+
+        UniformBlockIndex::BlockState getState(std::span<const u8> data) {
+            if (data.empty())
+                return UniformBlockIndex::Mixed;
+
+            // Comparing the data to itself shifted by one byte lets memcmp do the work with its vectorized implementation
+            if (std::memcmp(data.data(), data.data() + 1, data.size() - 1) == 0)
+                return data.front();
+            else
+                return UniformBlockIndex::Mixed;
+        }
+
+    }
+
+    UniformBlockIndex::Blocks::Blocks(u64 dataSize, u64 blockSize)
+        : m_dataSize(dataSize), m_blockSize(blockSize), m_blockCount((dataSize + blockSize - 1) / blockSize), m_states(std::make_unique<std::atomic<BlockState>[]>(m_blockCount)) {
+        for (u64 i = 0; i < m_blockCount; i += 1)
+            m_states[i].store(Unknown, std::memory_order_relaxed);
+    }
+
+    UniformBlockIndex::BlockState UniformBlockIndex::Blocks::getState(u64 index) const {
+        if (index >= m_blockCount)
+            return Unknown;
+
+        const auto state = m_states[index].load(std::memory_order_relaxed);
+        return state == Scanning ? Unknown : state;
+    }
+
+    UniformBlockIndex::~UniformBlockIndex() {
+        this->stop();
+    }
+
+    void UniformBlockIndex::initialize() {
+        EventProviderDeleted::subscribe([](prv::Provider *provider) {
+            std::shared_ptr<UniformBlockIndex> index;
+            {
+                std::scoped_lock lock(s_indicesMutex);
+
+                const auto it = s_indices.find(provider);
+                if (it == s_indices.end())
+                    return;
+
+                index = std::move(it->second);
+                s_indices.erase(it);
+            }
+
+            index->stop();
+        });
+
+        // Writes, insertions and removals are announced before the data changes. The affected blocks are queued up right away
+        // and once more after the change, when the undo stack announces the operation
+        EventProviderDataModified::subscribe([](prv::Provider *provider, u64 address, u64 size, const u8 *) {
+            if (const auto index = findIndex(provider); index != nullptr)
+                index->invalidate(provider, toOffset(provider, address), size);
+        });
+
+        EventProviderDataInserted::subscribe([](prv::Provider *provider, u64 address, u64) {
+            if (const auto index = findIndex(provider); index != nullptr)
+                index->rebuild(provider, toOffset(provider, address));
+        });
+
+        EventProviderDataRemoved::subscribe([](prv::Provider *provider, u64 address, u64) {
+            if (const auto index = findIndex(provider); index != nullptr)
+                index->rebuild(provider, toOffset(provider, address));
+        });
+
+        EventDataChanged::subscribe([](prv::Provider *provider) {
+            const auto index = findIndex(provider);
+            if (index == nullptr)
+                return;
+
+            // Changes that aren't caused by a single operation, like reloading the provider or reapplying all operations
+            // after the file changed on disk, may have changed any byte
+            if (const auto region = provider->getUndoStack().getChangedRegion(); region.has_value())
+                index->update(provider, *region);
+            else
+                index->update(provider, { 0x00, provider->getActualSize() });
+        });
+    }
+
+    std::shared_ptr<UniformBlockIndex> UniformBlockIndex::get(prv::Provider *provider) {
+        if (provider == nullptr || !provider->isReadable())
+            return nullptr;
+
+        std::shared_ptr<UniformBlockIndex> index;
+        {
+            std::scoped_lock lock(s_indicesMutex);
+
+            auto &entry = s_indices[provider];
+            if (entry != nullptr)
+                return entry;
+
+            entry = std::make_shared<UniformBlockIndex>();
+            index = entry;
+        }
+
+        index->rebuild(provider, 0);
+
+        return index;
+    }
+
+    std::shared_ptr<const UniformBlockIndex::Blocks> UniformBlockIndex::getBlocks() const {
+        return this->getCurrentBlocks();
+    }
+
+    std::shared_ptr<UniformBlockIndex::Blocks> UniformBlockIndex::getCurrentBlocks() const {
+        std::scoped_lock lock(m_blocksMutex);
+
+        return m_blocks;
+    }
+
+    bool UniformBlockIndex::isIndexing() const {
+        std::scoped_lock lock(m_taskMutex);
+
+        return m_taskActive;
+    }
+
+    std::vector<Region> UniformBlockIndex::getCandidateRegions(u64 baseAddress, Region region, const std::array<bool, 256> &usedBytes) const {
+        std::vector<Region> result;
+        if (region.getSize() == 0)
+            return result;
+
+        const auto blocks = this->getBlocks();
+        if (blocks == nullptr) {
+            result.push_back(region);
+            return result;
+        }
+
+        const auto blockSize = blocks->getBlockSize();
+        const auto isSkippable = [&](u64 block) {
+            const auto state = blocks->getState(block);
+            return state < Mixed && !usedBytes[state];
+        };
+
+        // Only blocks fully inside of the region can be skipped
+        const auto start = region.getStartAddress() - baseAddress;
+        const auto end   = start + region.getSize();
+        auto candidateStart = start;
+        for (u64 block = (start + blockSize - 1) / blockSize; (block + 1) * blockSize <= end;) {
+            if (!isSkippable(block)) {
+                block += 1;
+                continue;
+            }
+
+            auto runEnd = block + 1;
+            while ((runEnd + 1) * blockSize <= end && isSkippable(runEnd))
+                runEnd += 1;
+
+            if (runEnd - block >= MinSkippedBlockCount) {
+                if (block * blockSize > candidateStart)
+                    result.push_back({ baseAddress + candidateStart, block * blockSize - candidateStart });
+                candidateStart = runEnd * blockSize;
+            }
+
+            block = runEnd;
+        }
+
+        if (end > candidateStart)
+            result.push_back({ baseAddress + candidateStart, end - candidateStart });
+
+        return result;
+    }
+
+    void UniformBlockIndex::update(prv::Provider *provider, Region region) {
+        const auto blocks = this->getBlocks();
+        if (blocks == nullptr || blocks->getDataSize() != provider->getActualSize())
+            this->rebuild(provider, region.getStartAddress());
+        else
+            this->invalidate(provider, region.getStartAddress(), region.getSize());
+    }
+
+    void UniformBlockIndex::rebuild(prv::Provider *provider, u64 fromOffset) {
+        this->stop();
+
+        const auto size = provider->getActualSize();
+        u64 blockSize = MinBlockSize;
+        while (size / blockSize > MaxBlockCount)
+            blockSize *= 2;
+
+        auto blocks = std::make_shared<Blocks>(size, blockSize);
+
+        // Blocks before the change keep their state as long as the block size stays the same
+        if (const auto previous = this->getBlocks(); previous != nullptr && previous->getBlockSize() == blockSize) {
+            // The last block may have gotten longer or shorter
+            const auto keptBlocks = std::min({ fromOffset, previous->getDataSize(), size }) / blockSize;
+            for (u64 i = 0; i < keptBlocks; i += 1)
+                blocks->m_states[i].store(previous->getState(i), std::memory_order_relaxed);
+        }
+
+        {
+            std::scoped_lock lock(m_blocksMutex);
+            m_blocks = std::move(blocks);
+        }
+
+        this->startIndexing(provider);
+    }
+
+    void UniformBlockIndex::invalidate(prv::Provider *provider, u64 offset, u64 size) {
+        const auto blocks = this->getCurrentBlocks();
+        if (blocks == nullptr || size == 0 || offset >= blocks->getDataSize())
+            return;
+
+        const auto firstBlock = offset / blocks->getBlockSize();
+        const auto lastBlock  = std::min((offset + size - 1) / blocks->getBlockSize(), blocks->getBlockCount() - 1);
+        for (u64 i = firstBlock; i <= lastBlock; i += 1)
+            blocks->m_states[i].store(Unknown, std::memory_order_relaxed);
+
+        this->startIndexing(provider);
+    }
+
+    void UniformBlockIndex::stop() {
+        m_task.interrupt();
+        m_task.wait();
+
+        std::scoped_lock lock(m_taskMutex);
+        m_taskActive = false;
+        m_dirty = false;
+    }
+
+    void UniformBlockIndex::startIndexing(prv::Provider *provider) {
+        std::scoped_lock lock(m_taskMutex);
+
+        // A running task picks up the newly invalidated blocks once it's done with its current pass
+        if (m_taskActive) {
+            m_dirty = true;
+            return;
+        }
+
+        m_taskActive = true;
+        m_dirty = false;
+        m_task = TaskManager::createBackgroundTask("hex.builtin.task.indexing_uniform_blocks", [this, provider](Task &task) {
+            // The task is only marked as done here if it got interrupted, otherwise that happens together with the last check for new work
+            bool done = false;
+            ON_SCOPE_EXIT {
+                if (!done) {
+                    std::scoped_lock lock(m_taskMutex);
+                    m_taskActive = false;
+                }
+            };
+
+            while (true) {
+                // Rebuilding stops the task before replacing the blocks, so they stay the same for the whole pass
+                this->indexBlocks(task, provider, *this->getCurrentBlocks());
+
+                // Blocks invalidated after this point start a new task
+                std::scoped_lock lock(m_taskMutex);
+                if (!m_dirty) {
+                    m_taskActive = false;
+                    done = true;
+                    break;
+                }
+                m_dirty = false;
+            }
+        });
+    }
+
+    void UniformBlockIndex::indexBlocks(Task &task, prv::Provider *provider, Blocks &blocks) {
+        const auto baseAddress = provider->getBaseAddress();
+        const auto size        = blocks.getDataSize();
+
+        std::vector<u8> buffer(blocks.getBlockSize());
+        for (u64 i = 0; i < blocks.getBlockCount(); i += 1) {
+            task.update();
+
+            auto expected = Unknown;
+            if (!blocks.m_states[i].compare_exchange_strong(expected, Scanning, std::memory_order_relaxed))
+                continue;
+
+            // Read the data the same way searches do, so the index describes what they'd see
+            const auto offset    = i * blocks.getBlockSize();
+            const auto blockSize = std::min<u64>(blocks.getBlockSize(), size - std::min(offset, size));
+            provider->read(baseAddress + offset, buffer.data(), blockSize, true);
+
+            // If the block changed while it was being read, it's marked as unknown again and will be read in the next pass
+            expected = Scanning;
+            blocks.m_states[i].compare_exchange_strong(expected, getState({ buffer.data(), blockSize }), std::memory_order_relaxed);
+        }
+    }
+
+}
@@ -0,0 +1,230 @@
+#include <content/helpers/value_searcher.hpp>
+
+#include <hex/api/task_manager.hpp>
+#include <hex/helpers/utils.hpp>
+#include <hex/providers/parallel_scanner.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+
+    #define VALUE_SEARCH_VECTORIZED
+    #define VALUE_SEARCH_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        constexpr static size_t BlockSize = 32;
+
+        // Bit mask with the lowest bit of every value in a block set
+        template<typename T>
+        constexpr u32 getLaneMask() {
+            u32 mask = 0;
+            for (size_t i = 0; i < BlockSize; i += sizeof(T))
+                mask |= 1U << i;
+
+            return mask;
+        }
+
+        #if defined(VALUE_SEARCH_VECTORIZED)
+
+            bool isVectorizationSupported() {
+                static const bool supported = __builtin_cpu_supports("avx2");
+                return supported;
+            }
+
+            /**
+             * @brief Compares every value in a block against the bounds
+             * @return Result of _mm256_movemask_epi8, all bytes of a value that lies within the bounds are set
+             */
+            template<typename T>
+            VALUE_SEARCH_TARGET u32 getMatchMask(__m256i block, __m256i min, __m256i max) {
+                if constexpr (std::same_as<T, float>) {
+                    const auto values  = _mm256_castsi256_ps(block);
+                    const auto matches = _mm256_and_ps(_mm256_cmp_ps(values, _mm256_castsi256_ps(min), _CMP_GE_OQ), _mm256_cmp_ps(values, _mm256_castsi256_ps(max), _CMP_LE_OQ));
+                    return u32(_mm256_movemask_epi8(_mm256_castps_si256(matches)));
+                } else if constexpr (std::same_as<T, double>) {
+                    const auto values  = _mm256_castsi256_pd(block);
+                    const auto matches = _mm256_and_pd(_mm256_cmp_pd(values, _mm256_castsi256_pd(min), _CMP_GE_OQ), _mm256_cmp_pd(values, _mm256_castsi256_pd(max), _CMP_LE_OQ));
+                    return u32(_mm256_movemask_epi8(_mm256_castpd_si256(matches)));
+                } else if constexpr (sizeof(T) == 8) {
+                    // There's no unsigned 64 bit compare, flipping the sign bit maps unsigned values onto signed ones in the same order
+                    if constexpr (std::unsigned_integral<T>)
+                        block = _mm256_xor_si256(block, _mm256_set1_epi64x(std::numeric_limits<i64>::min()));
+
+                    const auto outside = _mm256_or_si256(_mm256_cmpgt_epi64(min, block), _mm256_cmpgt_epi64(block, max));
+                    return ~u32(_mm256_movemask_epi8(outside));
+                } else {
+                    // A value lies within the bounds if clamping it to them doesn't change it
+                    __m256i lower, upper;
+                    if constexpr (sizeof(T) == 1 && std::unsigned_integral<T>) {
+                        lower = _mm256_cmpeq_epi8(_mm256_max_epu8(block, min), block);
+                        upper = _mm256_cmpeq_epi8(_mm256_min_epu8(block, max), block);
+                    } else if constexpr (sizeof(T) == 1) {
+                        lower = _mm256_cmpeq_epi8(_mm256_max_epi8(block, min), block);
+                        upper = _mm256_cmpeq_epi8(_mm256_min_epi8(block, max), block);
+                    } else if constexpr (sizeof(T) == 2 && std::unsigned_integral<T>) {
+                        lower = _mm256_cmpeq_epi16(_mm256_max_epu16(block, min), block);
+                        upper = _mm256_cmpeq_epi16(_mm256_min_epu16(block, max), block);
+                    } else if constexpr (sizeof(T) == 2) {
+                        lower = _mm256_cmpeq_epi16(_mm256_max_epi16(block, min), block);
+                        upper = _mm256_cmpeq_epi16(_mm256_min_epi16(block, max), block);
+                    } else if constexpr (std::unsigned_integral<T>) {
+                        lower = _mm256_cmpeq_epi32(_mm256_max_epu32(block, min), block);
+                        upper = _mm256_cmpeq_epi32(_mm256_min_epu32(block, max), block);
+                    } else {
+                        lower = _mm256_cmpeq_epi32(_mm256_max_epi32(block, min), block);
+                        upper = _mm256_cmpeq_epi32(_mm256_min_epi32(block, max), block);
+                    }
+
+                    return u32(_mm256_movemask_epi8(_mm256_and_si256(lower, upper)));
+                }
+            }
+
+            template<typename T>
+            VALUE_SEARCH_TARGET __m256i broadcast(T value) {
+                if constexpr (std::same_as<T, float>)
+                    return _mm256_castps_si256(_mm256_set1_ps(value));
+                else if constexpr (std::same_as<T, double>)
+                    return _mm256_castpd_si256(_mm256_set1_pd(value));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm256_set1_epi8(std::bit_cast<char>(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm256_set1_epi16(std::bit_cast<i16>(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm256_set1_epi32(std::bit_cast<i32>(value));
+                else if constexpr (std::unsigned_integral<T>)
+                    return _mm256_set1_epi64x(std::bit_cast<i64>(value) ^ std::numeric_limits<i64>::min());
+                else
+                    return _mm256_set1_epi64x(value);
+            }
+
+            /**
+             * @brief Searches blocks of 32 bytes for values within the bounds
+             * @details With a stride of 1, the block is loaded once for every byte of the value, each time shifted by one byte.
+             * The matches of all these loads together cover every position in the block
+             * @return Offset the search stopped at because there were less than 32 bytes left
+             */
+            template<typename T>
+            VALUE_SEARCH_TARGET size_t searchVectorized(const u8 *data, size_t offset, size_t endOffset, u64 stride, T min, T max, bool swapBytes, u64 address, std::vector<u64> &result) {
+                const auto minVector = broadcast<T>(min);
+                const auto maxVector = broadcast<T>(max);
+
+                // Reverses the bytes of every value
+                std::array<u8, BlockSize> swapIndices = { };
+                for (size_t i = 0; i < BlockSize; i += 1)
+                    swapIndices[i] = u8((i % 16) / sizeof(T) * sizeof(T) + (sizeof(T) - 1 - i % sizeof(T)));
+                const auto swapMask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(swapIndices.data()));
+
+                constexpr auto LaneMask = getLaneMask<T>();
+                const auto shift = stride == 1 ? sizeof(T) : 1;
+
+                // The last load of a block ends shift - 1 bytes after it and has to end before the last value that may be checked does
+                for (; offset + BlockSize + shift - 1 <= endOffset + sizeof(T) - 1; offset += BlockSize) {
+                    u32 matches = 0;
+                    for (size_t i = 0; i < shift; i += 1) {
+                        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + i));
+                        if (swapBytes && sizeof(T) > 1)
+                            block = _mm256_shuffle_epi8(block, swapMask);
+
+                        matches |= (getMatchMask<T>(block, minVector, maxVector) & LaneMask) << i;
+                    }
+
+                    while (matches != 0) {
+                        result.push_back(address + offset + std::countr_zero(matches));
+                        matches &= matches - 1;
+                    }
+                }
+
+                return offset;
+            }
+
+        #endif
+
+    }
+
+    template<typename T>
+    ValueSearcher<T>::ValueSearcher(T min, T max, std::endian endian) : m_min(min), m_max(max), m_endian(endian) { }
+
+    template<typename T>
+    bool ValueSearcher<T>::matches(const u8 *data) const {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        value = hex::changeEndianness(value, m_endian);
+
+        return value >= m_min && value <= m_max;
+    }
+
+    template<typename T>
+    void ValueSearcher<T>::search(std::span<const u8> data, size_t offset, size_t endOffset, u64 stride, u64 address, std::vector<u64> &result) const {
+        // endOffset is the first offset at which no value is checked anymore, it needs to leave room for a full value
+        endOffset = std::min<size_t>(endOffset, data.size() >= sizeof(T) ? data.size() - sizeof(T) + 1 : 0);
+
+        #if defined(VALUE_SEARCH_VECTORIZED)
+            if ((stride == 1 || stride == sizeof(T)) && isVectorizationSupported())
+                offset = searchVectorized<T>(data.data(), offset, endOffset, stride, m_min, m_max, m_endian != std::endian::native, address, result);
+        #endif
+
+        for (; offset < endOffset; offset += stride) {
+            if (this->matches(data.data() + offset))
+                result.push_back(address + offset);
+        }
+    }
+
+    template<typename T>
+    std::vector<u64> ValueSearcher<T>::findAll(std::span<const u8> data, u64 address, u64 stride) const {
+        std::vector<u64> result;
+        if (stride == 0)
+            return result;
+
+        this->search(data, 0, data.size(), stride, address, result);
+
+        return result;
+    }
+
+    template<typename T>
+    std::vector<u64> ValueSearcher<T>::findAll(Task &task, prv::Provider *provider, Region region, u64 stride, size_t chunkSize) const {
+        std::vector<u64> result;
+        if (stride == 0 || region.getSize() < sizeof(T))
+            return result;
+
+        prv::scanParallel(task, provider, region,
+            [this, region, stride](u64 address, size_t size, std::span<const u8> data) {
+                // Start at the first position in the chunk that's a multiple of the stride away from the start of the region
+                const auto misalignment = (address - region.getStartAddress()) % stride;
+                const auto offset = misalignment == 0 ? 0 : stride - misalignment;
+
+                std::vector<u64> values;
+                this->search(data, offset, size, stride, address, values);
+
+                return values;
+            },
+            [&](u64, std::span<const u8>, std::vector<u64> &&values) {
+                result.insert(result.end(), values.begin(), values.end());
+            },
+            chunkSize, sizeof(T) - 1
+        );
+
+        return result;
+    }
+
+    template class ValueSearcher<u8>;
+    template class ValueSearcher<u16>;
+    template class ValueSearcher<u32>;
+    template class ValueSearcher<u64>;
+    template class ValueSearcher<i8>;
+    template class ValueSearcher<i16>;
+    template class ValueSearcher<i32>;
+    template class ValueSearcher<i64>;
+    template class ValueSearcher<float>;
+    template class ValueSearcher<double>;
+
+}
@@ -0,0 +1,275 @@
+#include <content/mcp_jobs.hpp>
+
+#include <hex/api/content_registry/communication_interface.hpp>
+#include <hex/api/events/events_provider.hpp>
+#include <hex/api/imhex_api/provider.hpp>
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/logger.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <fmt/format.h>
+#include <romfs/romfs.hpp>
+#include <wolv/literals.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace hex::plugin::builtin::mcp_jobs {
+
+    using namespace wolv::literals;
+
+    namespace {
+
+        constexpr static u64 DefaultPageSize = 1000;
+        constexpr static u64 MaxPageSize     = 10'000;
+
+        // Pages stop early once they grow larger than this, no matter how many rows were requested
+        constexpr static size_t MaxPageBytes = 4_MiB;
+
+        // Results of finished jobs are kept until they're cancelled, or until too many of them piled up
+        constexpr static size_t MaxFinishedJobs = 16;
+
+        std::mutex s_jobsMutex;
+        std::map<u64, std::shared_ptr<Job>> s_jobs;
+        u64 s_nextJobId = 1;
+
+        std::string_view getStatusName(Job::Status status) {
+            switch (status) {
+                using enum Job::Status;
+                case Running:   return "running";
+                case Finished:  return "finished";
+                case Failed:    return "failed";
+                case Cancelled: return "cancelled";
+            }
+
+            return "unknown";
+        }
+
+        void removeOldFinishedJobs() {
+            // Jobs are sorted by their id, so the oldest finished jobs come first
+            std::vector<u64> finishedJobs;
+            for (const auto &[id, job] : s_jobs) {
+                if (job->getStatus() != Job::Status::Running)
+                    finishedJobs.push_back(id);
+            }
+
+            for (size_t i = 0; i + MaxFinishedJobs < finishedJobs.size(); i += 1)
+                s_jobs.erase(finishedJobs[i]);
+        }
+
+        std::shared_ptr<Job> getJob(const nlohmann::json &arguments) {
+            std::scoped_lock lock(s_jobsMutex);
+
+            const auto id = arguments.at("job_id").get<u64>();
+            if (auto it = s_jobs.find(id); it != s_jobs.end())
+                return it->second;
+
+            throw std::invalid_argument(fmt::format("No job with id {} exists", id));
+        }
+
+        nlohmann::json toToolResult(const nlohmann::json &result) {
+            return mcp::StructuredContent {
+                .text = result.dump(),
+                .data = result
+            };
+        }
+
+    }
+
+    void Job::addRow(nlohmann::json row) {
+        std::scoped_lock lock(m_mutex);
+        m_rows.emplace_back(std::move(row));
+    }
+
+    void Job::addRows(std::vector<nlohmann::json> rows) {
+        std::scoped_lock lock(m_mutex);
+        std::ranges::move(rows, std::back_inserter(m_rows));
+    }
+
+    nlohmann::json Job::getPage(u64 cursor, u64 limit) const {
+        std::scoped_lock lock(m_mutex);
+
+        nlohmann::json rows = nlohmann::json::array();
+        size_t pageBytes = 0;
+
+        u64 index = std::min<u64>(cursor, m_rows.size());
+        const u64 end = std::min<u64>(m_rows.size(), index + std::clamp<u64>(limit, 1, MaxPageSize));
+        for (; index < end && pageBytes < MaxPageBytes; index += 1) {
+            pageBytes += m_rows[index].dump().size();
+            rows.push_back(m_rows[index]);
+        }
+
+        // There are more rows to fetch if the page stopped early or the job is still producing results
+        const bool hasMore = index < m_rows.size() || m_status == Status::Running;
+
+        nlohmann::json result = {
+            { "job_id",      m_id },
+            { "status",      getStatusName(m_status) },
+            { "progress",    m_status == Status::Running ? m_task.getProgress() : 100 },
+            { "columns",     m_columns },
+            { "rows",        std::move(rows) },
+            { "total_rows",  m_rows.size() },
+            { "next_cursor", hasMore ? nlohmann::json(index) : nlohmann::json(nullptr) }
+        };
+
+        if (!m_error.empty())
+            result["error"] = m_error;
+
+        return result;
+    }
+
+    nlohmann::json Job::getSummary() const {
+        std::scoped_lock lock(m_mutex);
+
+        return {
+            { "job_id",     m_id },
+            { "type",       m_type },
+            { "handle",     m_providerId },
+            { "status",     getStatusName(m_status) },
+            { "progress",   m_status == Status::Running ? m_task.getProgress() : 100 },
+            { "total_rows", m_rows.size() }
+        };
+    }
+
+    Job::Status Job::getStatus() const {
+        std::scoped_lock lock(m_mutex);
+        return m_status;
+    }
+
+    void Job::setStatus(Status status, std::string error) {
+        std::scoped_lock lock(m_mutex);
+        m_status = status;
+        m_error  = std::move(error);
+    }
+
+    std::string encodeData(std::span<const u8> data) {
+        const auto encoded = crypt::encode64({ data.begin(), data.end() });
+        return { encoded.begin(), encoded.end() };
+    }
+
+    nlohmann::json startJob(const std::string &type, prv::Provider *provider, ProgressValue maxValue, std::vector<std::string> columns, std::function<void(Task &, Job &)> function) {
+        std::shared_ptr<Job> job;
+        {
+            std::scoped_lock lock(s_jobsMutex);
+
+            removeOldFinishedJobs();
+
+            const auto id = s_nextJobId++;
+            job = std::make_shared<Job>(id, type, provider->getID(), std::move(columns));
+            s_jobs.emplace(id, job);
+        }
+
+        // Jobs run concurrently on the task manager's worker threads, the tool call itself returns right away
+        std::scoped_lock lock(job->m_mutex);
+        job->m_task = TaskManager::createTask("hex.builtin.task.mcp_analysis"_unlocalized, maxValue, [job, function = std::move(function)](Task &task) {
+            try {
+                function(task, *job);
+                job->setStatus(Job::Status::Finished);
+            } catch (const std::exception &e) {
+                if (task.shouldInterrupt()) {
+                    job->setStatus(Job::Status::Cancelled);
+                    throw;
+                }
+
+                log::error("MCP analysis job {} failed: {}", job->getId(), e.what());
+                job->setStatus(Job::Status::Failed, e.what());
+            }
+        });
+
+        return toToolResult({
+            { "job_id", job->getId() },
+            { "handle", provider->getID() }
+        });
+    }
+
+    bool cancelJob(u64 id) {
+        std::shared_ptr<Job> job;
+        {
+            std::scoped_lock lock(s_jobsMutex);
+
+            auto it = s_jobs.find(id);
+            if (it == s_jobs.end())
+                return false;
+
+            job = std::move(it->second);
+            s_jobs.erase(it);
+        }
+
+        // The task keeps its own reference to the job, so it's only freed once the task noticed the interruption
+        std::scoped_lock lock(job->m_mutex);
+        job->m_task.interrupt();
+
+        return true;
+    }
+
+    prv::Provider* getProvider(const nlohmann::json &arguments) {
+        if (arguments.contains("handle")) {
+            const auto handle = arguments["handle"].get<u64>();
+            for (const auto &provider : ImHexApi::Provider::getProviders()) {
+                if (provider->getID() == handle)
+                    return provider;
+            }
+
+            throw std::invalid_argument(fmt::format("No data source with handle {} is open", handle));
+        }
+
+        auto provider = ImHexApi::Provider::get();
+        if (provider == nullptr)
+            throw std::invalid_argument("No data source is open");
+
+        return provider;
+    }
+
+    Region getRegion(prv::Provider *provider, const nlohmann::json &arguments) {
+        const auto startAddress = provider->getBaseAddress();
+        const auto endAddress   = startAddress + provider->getActualSize();
+
+        const auto address = std::clamp<u64>(arguments.value("address", startAddress), startAddress, endAddress);
+        const auto size    = std::min<u64>(arguments.value("size", endAddress - address), endAddress - address);
+
+        return { address, size };
+    }
+
+    void registerJobTools() {
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/get_job_results.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            const auto job = getJob(data);
+
+            return toToolResult(job->getPage(data.value<u64>("cursor", 0), data.value<u64>("limit", DefaultPageSize)));
+        });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/list_jobs.json").string(), [](const nlohmann::json &) -> nlohmann::json {
+            std::scoped_lock lock(s_jobsMutex);
+
+            nlohmann::json jobs = nlohmann::json::array();
+            for (const auto &[id, job] : s_jobs)
+                jobs.push_back(job->getSummary());
+
+            return toToolResult({ { "jobs", std::move(jobs) } });
+        });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/cancel_job.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            const auto id = data.at("job_id").get<u64>();
+
+            return toToolResult({
+                { "job_id",    id },
+                { "cancelled", cancelJob(id) }
+            });
+        });
+
+        // Jobs must not outlive the provider they're reading from
+        EventProviderRemoving::subscribe([](const prv::Provider *provider) {
+            std::vector<u64> jobIds;
+            {
+                std::scoped_lock lock(s_jobsMutex);
+                for (const auto &[id, job] : s_jobs) {
+                    if (job->getProviderId() == provider->getID() && job->getStatus() == Job::Status::Running)
+                        jobIds.push_back(id);
+                }
+            }
+
+            for (const auto id : jobIds)
+                cancelJob(id);
+        });
+    }
+
+}
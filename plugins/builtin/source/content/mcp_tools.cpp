@@ -1,15 +1,74 @@
 #include <content/providers/file_provider.hpp>
+#include <content/mcp_jobs.hpp>
+#include <hex/api/content_registry/batch_analysis.hpp>
 #include <hex/api/content_registry/communication_interface.hpp>
+#include <hex/api/content_registry/pattern_language.hpp>
 #include <hex/api/imhex_api/provider.hpp>
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/fmt.hpp>
 #include <romfs/romfs.hpp>
 #include <wolv/literals.hpp>
+#include <wolv/utils/guards.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <pl/pattern_language.hpp>
+#include <pl/patterns/pattern.hpp>
+
+#include <array>
+#include <cmath>
 
 namespace hex::plugin::builtin {
 
     using namespace wolv::literals;
 
+    namespace {
+
+        crypt::Digest getDigest(const std::string &algorithm) {
+            if (algorithm == "md5")
+                return crypt::Digest::MD5;
+            else if (algorithm == "sha1")
+                return crypt::Digest::SHA1;
+            else if (algorithm == "sha224")
+                return crypt::Digest::SHA224;
+            else if (algorithm == "sha256")
+                return crypt::Digest::SHA256;
+            else if (algorithm == "sha384")
+                return crypt::Digest::SHA384;
+            else if (algorithm == "sha512")
+                return crypt::Digest::SHA512;
+            else if (algorithm == "crc32")
+                return crypt::Digest::CRC32;
+
+            throw std::invalid_argument(fmt::format("Unknown hash algorithm '{}'", algorithm));
+        }
+
+        void addPatternRows(const std::shared_ptr<pl::ptrn::Pattern> &pattern, const std::string &parentPath, std::vector<nlohmann::json> &rows) {
+            if (pattern->getVisibility() == pl::ptrn::Visibility::Hidden)
+                return;
+
+            const auto path = parentPath.empty() ? pattern->getVariableName() : fmt::format("{}.{}", parentPath, pattern->getVariableName());
+
+            std::string value;
+            try {
+                value = pattern->getFormattedValue();
+            } catch (const std::exception &e) {
+                value = e.what();
+            }
+
+            rows.push_back({ path, pattern->getTypeName(), pattern->getOffset(), pattern->getSize(), value });
+
+            if (auto iterable = dynamic_cast<pl::ptrn::IIterable*>(pattern.get()); iterable != nullptr) {
+                iterable->forEachEntry(0, iterable->getEntryCount(), [&](u64, const auto &entry) {
+                    addPatternRows(entry, path, rows);
+                });
+            }
+        }
+
+    }
+
     void registerMCPTools() {
+        mcp_jobs::registerJobTools();
+
         ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/open_file.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
             auto filePath = data.at("file_path").get<std::string>();
 
@@ -99,6 +158,137 @@ namespace hex::plugin::builtin {
                 .data = result
             };
         });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/calculate_hashes.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            auto provider = mcp_jobs::getProvider(data);
+            const auto region = mcp_jobs::getRegion(provider, data);
+
+            const auto algorithms = data.value("algorithms", std::vector<std::string>{ "md5", "sha1", "sha256" });
+            const auto blockSize  = data.value<u64>("block_size", 0);
+
+            // Validate the algorithms before starting the job so typos are reported right away
+            std::vector<crypt::Digest> digests;
+            for (const auto &algorithm : algorithms)
+                digests.push_back(getDigest(algorithm));
+
+            return mcp_jobs::startJob("calculate_hashes", provider, ProgressValue::Size(region.getSize()), { "address", "size", "algorithm", "hash" }, [=](Task &task, mcp_jobs::Job &job) {
+                // Without a block size, the entire region is hashed at once
+                const auto step = blockSize == 0 ? region.getSize() : blockSize;
+
+                prv::Provider *hashedProvider = provider;
+                u64 offset = 0;
+                do {
+                    const auto address = region.getStartAddress() + offset;
+                    const auto size    = std::min<u64>(step, region.getSize() - offset);
+
+                    // Updating the task after every chunk lets an interrupted job stop in the middle of a large block
+                    const auto hashes = crypt::digests(hashedProvider, address, size, digests, [&](u64 processed) { task.update(offset + processed); });
+                    for (size_t i = 0; i < algorithms.size(); i += 1)
+                        job.addRow({ address, size, algorithms[i], wolv::util::toLower(crypt::encode16(hashes[i])) });
+
+                    offset += size;
+                    task.update(offset);
+                } while (offset < region.getSize());
+            });
+        });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/calculate_entropy.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            constexpr static size_t RowsPerBatch = 1024;
+
+            auto provider = mcp_jobs::getProvider(data);
+            const auto region = mcp_jobs::getRegion(provider, data);
+            const auto blockSize = std::max<u64>(data.value<u64>("block_size", 4_KiB), 1);
+
+            return mcp_jobs::startJob("calculate_entropy", provider, ProgressValue::Size(region.getSize()), { "address", "size", "entropy" }, [=](Task &task, mcp_jobs::Job &job) {
+                std::vector<u8> buffer(blockSize);
+                std::vector<nlohmann::json> rows;
+
+                for (u64 offset = 0; offset < region.getSize(); offset += blockSize) {
+                    const auto size = std::min<u64>(blockSize, region.getSize() - offset);
+                    provider->read(region.getStartAddress() + offset, buffer.data(), size);
+
+                    std::array<u64, 256> frequencies = { };
+                    for (u64 i = 0; i < size; i += 1)
+                        frequencies[buffer[i]] += 1;
+
+                    double entropy = 0;
+                    for (const auto frequency : frequencies) {
+                        if (frequency == 0)
+                            continue;
+
+                        const auto probability = double(frequency) / double(size);
+                        entropy -= probability * std::log2(probability);
+                    }
+
+                    rows.push_back({ region.getStartAddress() + offset, size, entropy / 8.0 });
+
+                    // Hand out rows in batches so clients can already fetch them while the analysis is still running
+                    if (rows.size() >= RowsPerBatch)
+                        job.addRows(std::exchange(rows, { }));
+
+                    task.update(offset + size);
+                }
+
+                job.addRows(std::move(rows));
+            });
+        });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/evaluate_pattern.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            auto provider = mcp_jobs::getProvider(data);
+            auto sourceCode = data.at("source_code").get<std::string>();
+
+            return mcp_jobs::startJob("evaluate_pattern", provider, ProgressValue::None(), { "path", "type", "address", "size", "value" }, [provider, sourceCode = std::move(sourceCode)](Task &task, mcp_jobs::Job &job) {
+                // Every job uses its own runtime so it neither blocks nor replaces the patterns of the pattern editor
+                pl::PatternLanguage runtime;
+                ContentRegistry::PatternLanguage::configureRuntime(runtime, provider);
+                runtime.setDangerousFunctionCallHandler([] { return false; });
+
+                task.setInterruptCallback([&runtime] {
+                    runtime.abort();
+                });
+                ON_SCOPE_EXIT { task.setInterruptCallback([] { }); };
+
+                if (runtime.executeString(sourceCode) != 0) {
+                    std::string errorMessage;
+                    for (const auto &error : runtime.getCompileErrors())
+                        errorMessage += fmt::format("{}\n", error.format());
+                    if (const auto &evalError = runtime.getEvalError(); evalError.has_value())
+                        errorMessage += fmt::format("{}:{}  {}\n", evalError->line, evalError->column, evalError->message);
+
+                    throw std::runtime_error(errorMessage);
+                }
+
+                std::vector<nlohmann::json> rows;
+                for (const auto &pattern : runtime.getPatterns())
+                    addPatternRows(pattern, "", rows);
+
+                job.addRows(std::move(rows));
+            });
+        });
+
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/run_analysis.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            auto provider = mcp_jobs::getProvider(data);
+
+            const auto name = data.at("analysis").get<std::string>();
+            const auto &analyses = ContentRegistry::BatchAnalysis::impl::getAnalyses();
+            const auto it = std::ranges::find_if(analyses, [&](const auto &analysis) { return analysis.name == name; });
+            if (it == analyses.end())
+                throw std::invalid_argument(fmt::format("Unknown analysis '{}'", name));
+
+            return mcp_jobs::startJob(name, provider, ProgressValue::None(), { "result" }, [provider, callback = it->callback, argument = data.value("argument", "")](Task &, mcp_jobs::Job &job) {
+                auto result = callback(provider, argument);
+
+                // Analyses returning a list of results get one row per entry so they can be fetched page by page
+                if (result.is_array()) {
+                    std::vector<nlohmann::json> rows;
+                    for (auto &entry : result)
+                        rows.push_back(nlohmann::json::array({ std::move(entry) }));
+                    job.addRows(std::move(rows));
+                } else {
+                    job.addRow(nlohmann::json::array({ std::move(result) }));
+                }
+            });
+        });
     }
 
 }
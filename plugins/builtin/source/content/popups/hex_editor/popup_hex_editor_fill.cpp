@@ -7,6 +7,7 @@
 #include <hex/api/achievement_manager.hpp>
 
 #include <content/differing_byte_searcher.hpp>
+#include <content/providers/undo_operations/operation_lazy_overlay.hpp>
 
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/crypto.hpp>
@@ -14,12 +15,10 @@
 #include <fonts/vscode_icons.hpp>
 #include <fonts/tabler_icons.hpp>
 
-#include <wolv/literals.hpp>
-
+#include <algorithm>
+#include <array>
 #include <random>
 
-using namespace wolv::literals;
-
 namespace hex::plugin::builtin {
 
     PopupFill::PopupFill(u64 address, size_t size) : m_address(address), m_size(size) {}
@@ -31,6 +30,31 @@ namespace hex::plugin::builtin {
 
         ImGui::Separator();
 
+        {
+            using enum prv::LazyOverlay::Type;
+            constexpr static std::array ModeNames = {
+                "hex.builtin.view.hex_editor.menu.edit.fill.mode.fill",
+                "hex.builtin.view.hex_editor.menu.edit.fill.mode.xor",
+                "hex.builtin.view.hex_editor.menu.edit.fill.mode.add"
+            };
+            constexpr static std::array Modes = { Fill, Xor, Add };
+
+            const auto selected = std::ranges::find(Modes, m_mode == Random ? Fill : m_mode) - Modes.begin();
+            ImGui::PushItemWidth(width);
+            if (ImGui::BeginCombo("##Mode", Lang(ModeNames[selected]))) {
+                for (size_t i = 0; i < Modes.size(); i += 1) {
+                    if (ImGui::Selectable(Lang(ModeNames[i]), i == size_t(selected)))
+                        m_mode = Modes[i];
+                }
+
+                ImGui::EndCombo();
+            }
+            ImGui::PopItemWidth();
+        }
+
+        if (m_mode != prv::LazyOverlay::Type::Fill)
+            m_randomBytes = false;
+
         const auto padding = ImGui::GetStyle().FramePadding.x;
         ImGui::PushItemWidth(width - (ImGui::GetStyle().ItemSpacing.x * 2 + ImGui::CalcTextSize(ICON_TA_ARROWS_SHUFFLE).x + padding * 3));
         ImGui::BeginDisabled(m_randomBytes);
@@ -38,7 +62,9 @@ namespace hex::plugin::builtin {
         ImGui::EndDisabled();
         ImGui::PopItemWidth();
         ImGui::SameLine(0, padding);
+        ImGui::BeginDisabled(m_mode != prv::LazyOverlay::Type::Fill);
         ImGuiExt::DimmedIconToggle(ICON_TA_ARROWS_SHUFFLE, &m_randomBytes);
+        ImGui::EndDisabled();
         ImGui::SetItemTooltip("%s", "hex.builtin.view.hex_editor.menu.edit.fill.random"_lang.get());
         ImGui::SameLine(0, padding);
         ImGui::TextUnformatted("hex.ui.common.bytes"_lang);
@@ -67,55 +93,36 @@ namespace hex::plugin::builtin {
             return;
 
         auto provider = ImHexApi::Provider::get();
-        u32 patchCount = 0;
-
-        constexpr static auto BatchFillSize = 1_MiB;
-        if (!m_randomBytes) {
-            std::erase(input, ' ');
+        if (address >= provider->getActualSize())
+            return;
 
-            auto bytes = crypt::decode16(input);
-            if (bytes.empty())
-                return;
+        size = std::min<u64>(size, provider->getActualSize() - address);
+        if (size == 0)
+            return;
 
-            // Group the fill pattern into a larger chunk
-            std::vector<u8> batchData;
-            if (bytes.size() < BatchFillSize) {
-                batchData.resize(std::min<u64>(alignTo<u64>(BatchFillSize, bytes.size()), size));
-                for (u64 i = 0; i < batchData.size(); i += bytes.size()) {
-                    auto remainingSize = std::min<size_t>(batchData.size() - i, bytes.size());
-                    std::copy_n(bytes.begin(), remainingSize, batchData.begin() + i);
-                }
-            } else {
-                batchData = std::move(bytes);
-            }
+        // The region is only marked as modified here, the data itself gets computed when it's read and written to the provider once it's saved
+        auto type = m_mode;
+        std::vector<u8> key;
+        if (type == prv::LazyOverlay::Type::Fill && m_randomBytes) {
+            type = prv::LazyOverlay::Type::Random;
 
-            const auto startAddress = provider->getBaseAddress() + address;
-            for (u64 i = 0; i < size; i += batchData.size()) {
-                const auto remainingSize = std::min<size_t>(size - i, batchData.size());
-                provider->write(startAddress + i, batchData.data(), remainingSize);
-                patchCount += 1;
+            std::random_device randomDevice;
+            for (u32 i = 0; i < 2; i += 1) {
+                const auto value = randomDevice();
+                key.insert(key.end(), reinterpret_cast<const u8*>(&value), reinterpret_cast<const u8*>(&value) + sizeof(value));
             }
         } else {
-            std::random_device r;
-            std::default_random_engine randomEngine(r());
-            std::uniform_int_distribution<u16> uniformDist(std::numeric_limits<u8>::min(), std::numeric_limits<u8>::max());
-
-            std::vector<u8> batchData(BatchFillSize);
-            const auto startAddress = provider->getBaseAddress() + address;
-            for (u64 i = 0; i < size; i += batchData.size()) {
-                const auto remainingSize = std::min<size_t>(size - i, batchData.size());
-
-                std::generate_n(batchData.begin(), remainingSize, [&uniformDist, &randomEngine] () -> u8 {
-                    return uniformDist(randomEngine);
-                });
+            std::erase(input, ' ');
 
-                provider->write(startAddress + i, batchData.data(), remainingSize);
-                patchCount += 1;
-            }
+            key = crypt::decode16(input);
+            if (key.empty())
+                return;
         }
-        provider->getUndoStack().groupOperations(patchCount, "hex.builtin.undo_operation.fill"_unlocalized);
+
+        provider->getUndoStack().add<undo::OperationLazyOverlay>(prv::LazyOverlay(type, Region { address, size }, std::move(key)));
+        provider->markDataDirty();
 
         AchievementManager::unlockAchievement("hex.builtin.achievement.hex_editor"_unlocalized, "hex.builtin.achievement.hex_editor.fill.name"_unlocalized);
     }
 
-}
\ No newline at end of file
+}
@@ -13,8 +13,6 @@
 #include <hex/helpers/crypto.hpp>
 #include <hex/helpers/search.hpp>
 
-#include <hex/providers/buffered_reader.hpp>
-
 #include <fonts/vscode_icons.hpp>
 
 #include <popups/popup_file_chooser.hpp>
@@ -230,34 +228,31 @@ namespace hex::plugin::builtin {
         if (providerSize == 0x00)
             return std::nullopt;
 
-        prv::ProviderReader reader(provider);
+        const SequenceSearcher searcher(sequence);
 
         auto startAbsolutePosition = provider->getBaseAddress();
         auto endAbsolutePosition = provider->getBaseAddress() + providerSize - 1;
 
         if (!m_searchBackwards) {
-            if (m_reachedEnd || !m_foundRegion.has_value()) {
-                reader.seek(startAbsolutePosition);
-            } else {
-                reader.seek(m_foundRegion->getStartAddress() + 1);
-            }
-            reader.setEndAddress(endAbsolutePosition);
-
-            auto occurrence = searchInterruptable(reader.begin(), reader.end(), sequence.begin(), sequence.end(), task);
-            if (occurrence != reader.end()) {
-                return Region{.address=occurrence.getAddress(), .size=sequence.size()};
+            if (!m_reachedEnd && m_foundRegion.has_value())
+                startAbsolutePosition = m_foundRegion->getStartAddress() + 1;
+            if (startAbsolutePosition > endAbsolutePosition)
+                return std::nullopt;
+
+            auto occurrence = searcher.findNext(task, provider, Region { .address=startAbsolutePosition, .size=endAbsolutePosition - startAbsolutePosition + 1 });
+            if (occurrence.has_value()) {
+                return Region{.address=*occurrence, .size=sequence.size()};
             }
         } else {
-            if (m_reachedEnd || !m_foundRegion.has_value()) {
-                reader.setEndAddress(endAbsolutePosition);
-            } else {
-                reader.setEndAddress(m_foundRegion->getEndAddress() - 1);
+            if (!m_reachedEnd && m_foundRegion.has_value()) {
+                if (m_foundRegion->getEndAddress() <= startAbsolutePosition)
+                    return std::nullopt;
+                endAbsolutePosition = m_foundRegion->getEndAddress() - 1;
             }
-            reader.seek(startAbsolutePosition);
 
-            auto occurrence = searchInterruptable(reader.rbegin(), reader.rend(), sequence.rbegin(), sequence.rend(), task);
-            if (occurrence != reader.rend()) {
-                return Region{.address=occurrence.getAddress() - (sequence.size() - 1), .size=sequence.size()};
+            auto occurrence = searcher.findPrevious(task, provider, Region { .address=startAbsolutePosition, .size=endAbsolutePosition - startAbsolutePosition + 1 });
+            if (occurrence.has_value()) {
+                return Region{.address=*occurrence, .size=sequence.size()};
             }
         }
 
@@ -75,6 +75,8 @@ namespace hex::plugin::builtin {
     }
 
     void FileProvider::save() {
+        this->materializeLazyOverlays();
+
         if (m_loadedIntoMemory) {
             m_ignoreNextChangeEvent = true;
             this->createBackupIfNeeded(m_file.getPath());
@@ -353,6 +355,27 @@ namespace hex::plugin::builtin {
         return {};
     }
 
+    prv::Provider::OpenResult FileProvider::openReadOnly() {
+        m_readable = true;
+        m_writable = false;
+
+        const auto &path = getPickedPath();
+        if (wolv::io::fs::isDirectory(path))
+            return OpenResult::failure(fmt::format("hex.builtin.provider.file.error.is_directory"_lang, path.string()));
+
+        m_file = wolv::io::File(path, wolv::io::File::Mode::Read);
+        if (!m_file.isValid()) {
+            m_readable = false;
+            return OpenResult::failure(fmt::format("hex.builtin.provider.file.error.open"_lang, path.string(), formatSystemError(m_file.getOpenError().value_or(0))));
+        }
+
+        m_fileStats = m_file.getFileInfo();
+        m_fileSize  = m_file.getSize();
+        m_loadedIntoMemory = false;
+
+        return {};
+    }
+
 
     void FileProvider::close() {
         m_file.close();
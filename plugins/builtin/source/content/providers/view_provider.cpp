@@ -45,6 +45,7 @@ namespace hex::plugin::builtin {
     }
 
     void ViewProvider::save() {
+        this->materializeLazyOverlays();
         m_provider->save();
     }
 
@@ -89,6 +90,7 @@ namespace hex::plugin::builtin {
             return;
 
         m_provider->read(offset, buffer, size, overlays);
+        this->applyLazyOverlays(offset - this->getBaseAddress(), buffer, size);
     }
 
     void ViewProvider::write(u64 offset, const void *buffer, size_t size) {
@@ -13,6 +13,7 @@
 #include <hex/api/plugin_manager.hpp>
 
 #include <hex/ui/view.hpp>
+#include <hex/providers/undo_redo/stack.hpp>
 
 #include <hex/helpers/debugging.hpp>
 #include <hex/helpers/http_requests.hpp>
@@ -761,6 +762,11 @@ for (const auto &path : m_paths) {
             ContentRegistry::Settings::add<Widgets::SliderDataSize>("hex.builtin.setting.general"_unlocalized, {}, "hex.builtin.setting.general.max_mem_file_size"_unlocalized, 512_MiB, 0_bytes, 32_GiB, 1_MiB)
                 .setTooltip("hex.builtin.setting.general.max_mem_file_size.desc"_unlocalized);
             ContentRegistry::Settings::add<Widgets::SliderInteger>("hex.builtin.setting.general"_unlocalized, "hex.builtin.setting.general.patterns"_unlocalized, "hex.builtin.setting.general.pattern_data_max_filter_items"_unlocalized, 128, 32, 1024);
+            ContentRegistry::Settings::add<Widgets::SliderDataSize>("hex.builtin.setting.general"_unlocalized, {}, "hex.builtin.setting.general.undo_memory_budget"_unlocalized, 512_MiB, 16_MiB, 32_GiB, 1_MiB)
+                .setTooltip("hex.builtin.setting.general.undo_memory_budget.desc"_unlocalized)
+                .setChangedCallback([](Widgets::Widget &widget) {
+                    prv::undo::Stack::setMemoryBudget(static_cast<Widgets::SliderDataSize&>(widget).getValue());
+                });
 
             ContentRegistry::Settings::add<Widgets::Checkbox>("hex.builtin.setting.general"_unlocalized, {}, "hex.builtin.setting.general.data_inspector_exact_size_only"_unlocalized, false);
 
@@ -943,6 +949,8 @@ for (const auto &path : m_paths) {
             ContentRegistry::Settings::add<Widgets::Checkbox>("hex.builtin.setting.pattern_editor"_unlocalized, {}, "hex.builtin.setting.pattern_editor.auto_indent"_unlocalized, true);
             ContentRegistry::Settings::add<Widgets::Checkbox>("hex.builtin.setting.pattern_editor"_unlocalized, {}, "hex.builtin.setting.pattern_editor.disable_folds"_unlocalized, false);
             ContentRegistry::Settings::add<Widgets::Checkbox>("hex.builtin.setting.pattern_editor"_unlocalized, {}, "hex.builtin.setting.pattern_editor.show_white_spaces"_unlocalized, false);
+            ContentRegistry::Settings::add<Widgets::SliderInteger>("hex.builtin.setting.pattern_editor"_unlocalized, {}, "hex.builtin.setting.pattern_editor.console_max_lines"_unlocalized, 100000, 1000, 1000000)
+                .setTooltip("hex.builtin.setting.pattern_editor.console_max_lines.desc"_unlocalized);
         }
 
         /* Folders */
@@ -15,6 +15,7 @@
 #include "content/views/view_find.hpp"
 #include "content/views/view_theme_manager.hpp"
 #include "content/views/view_logs.hpp"
+#include "content/views/view_performance.hpp"
 #include "content/views/view_achievements.hpp"
 #include "content/views/view_highlight_rules.hpp"
 #include "content/views/view_tutorials.hpp"
@@ -41,6 +42,7 @@ namespace hex::plugin::builtin {
         ContentRegistry::Views::add<ViewFind>();
         ContentRegistry::Views::add<ViewThemeManager>();
         ContentRegistry::Views::add<ViewLogs>();
+        ContentRegistry::Views::add<ViewPerformance>();
         ContentRegistry::Views::add<ViewAchievements>();
         ContentRegistry::Views::add<ViewHighlightRules>();
         ContentRegistry::Views::add<ViewTutorials>();
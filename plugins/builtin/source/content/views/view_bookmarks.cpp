@@ -76,22 +76,19 @@ namespace hex::plugin::builtin {
                 m_bookmarks.markChanged();
         });
 
-        // Draw hex editor background highlights for bookmarks
-        ImHexApi::HexEditor::addBackgroundHighlightingProvider([this](u64 address, const u8* data, size_t size, bool) -> std::optional<color_t> {
-            std::ignore = data;
-
-            // Check all bookmarks for potential overlaps with the current address
-            std::optional<ImColor> color;
-            for (const auto &bookmark : *m_bookmarks) {
+        // Publish bookmark regions as hex editor background highlights. Overlapping bookmarks get blended by the compositor
+        m_highlightSourceId = ImHexApi::HexEditor::addBackgroundHighlightSource([this](const prv::Provider *provider, const Region &region) {
+            std::vector<ImHexApi::HexEditor::Highlighting> result;
+            for (const auto &bookmark : m_bookmarks.get(provider)) {
                 if (!bookmark.highlightVisible)
                     continue;
 
-                if (Region { .address=address, .size=size }.isWithin(bookmark.entry.region)) {
-                    color = blendColors(color, bookmark.entry.color);
-                }
+                // Bookmarks color every cell they cover at least partially, the same way all other highlights do
+                if (bookmark.entry.region.overlaps(region))
+                    result.emplace_back(bookmark.entry.region, bookmark.entry.color);
             }
 
-            return color;
+            return result;
         });
 
         // Draw hex editor tooltips for bookmarks
@@ -630,6 +627,7 @@ namespace hex::plugin::builtin {
         }
 
         m_currBookmarkId.get(provider) = currentBookmarkId;
+        ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
         EventHighlightingChanged::post();
     }
 
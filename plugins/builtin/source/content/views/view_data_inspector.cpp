@@ -52,6 +52,7 @@ namespace hex::plugin::builtin {
 
         EventProviderClosed::subscribe(this, [this](const auto*) {
             m_selectedRegion = { Region::Invalid(), nullptr };
+            m_runtimeProvider = nullptr;
         });
 
         ContentRegistry::Settings::onChange("hex.builtin.setting.data_inspector"_unlocalized, "hex.builtin.setting.data_inspector.hidden_rows"_untranslated, [this](const ContentRegistry::Settings::SettingsValue &value) {
@@ -69,6 +70,9 @@ namespace hex::plugin::builtin {
     ViewDataInspector::~ViewDataInspector() {
         EventRegionSelected::unsubscribe(this);
         EventProviderClosed::unsubscribe(this);
+
+        for (auto &[path, file] : m_inspectorFiles)
+            file.tracker.stopTracking();
     }
 
     void ViewDataInspector::updateInspectorRows() {
@@ -101,11 +105,28 @@ namespace hex::plugin::builtin {
     void ViewDataInspector::updateInspectorRowsTask() {
         m_workData.clear();
 
-        if (m_selectedRegion.getProvider() == nullptr)
+        const auto provider = m_selectedRegion.getProvider();
+        if (provider == nullptr)
             return;
 
+        const auto &entries = ContentRegistry::DataInspector::impl::getEntries();
+
+        // Read the selected bytes once and share them between all inspectors instead of
+        // hitting the provider again for every single entry
+        {
+            size_t bufferSize = 0;
+            for (const auto &entry : entries)
+                bufferSize = std::max(bufferSize, entry.maxSize);
+
+            m_selectionBufferAddress = m_selectedRegion.getStartAddress();
+            m_selectionBuffer.resize(std::min<u64>(bufferSize, m_validBytes));
+            provider->read(m_selectionBufferAddress, m_selectionBuffer.data(), m_selectionBuffer.size());
+
+            preprocessBytes(m_selectionBuffer);
+        }
+
         // Decode bytes using registered inspectors
-        for (const auto &entry : ContentRegistry::DataInspector::impl::getEntries()) {
+        for (const auto &entry : entries) {
             if (m_validBytes < entry.requiredSize)
                 continue;
 
@@ -122,11 +143,9 @@ namespace hex::plugin::builtin {
                 }
             }
 
-            // Try to read as many bytes as requested and possible
-            std::vector<u8> buffer(m_validBytes > entry.maxSize ? entry.maxSize : m_validBytes);
-            m_selectedRegion.getProvider()->read(m_selectedRegion.getStartAddress(), buffer.data(), buffer.size());
-
-            preprocessBytes(buffer);
+            // Pass as many bytes as requested and possible
+            const auto bufferSize = std::min<size_t>(entry.maxSize, m_selectionBuffer.size());
+            std::vector<u8> buffer(m_selectionBuffer.begin(), m_selectionBuffer.begin() + bufferSize);
 
             // Insert processed data into the inspector list
             m_workData.emplace_back(
@@ -146,6 +165,12 @@ namespace hex::plugin::builtin {
     }
 
     void ViewDataInspector::inspectorReadFunction(u64 offset, u8 *buffer, size_t size) {
+        // Most custom inspectors only read data close to the selection which is already available in the selection buffer
+        if (offset >= m_selectionBufferAddress && size <= m_selectionBuffer.size() && offset - m_selectionBufferAddress <= m_selectionBuffer.size() - size) {
+            std::copy_n(m_selectionBuffer.begin() + (offset - m_selectionBufferAddress), size, buffer);
+            return;
+        }
+
         m_selectedRegion.getProvider()->read(offset, buffer, size);
 
         preprocessBytes({ buffer, size });
@@ -159,8 +184,11 @@ namespace hex::plugin::builtin {
 
         const auto provider = m_selectedRegion.getProvider();
 
-        // Setup a new pattern language runtime
-        ContentRegistry::PatternLanguage::configureRuntime(m_runtime, provider);
+        // Setting up a pattern language runtime is expensive, only do it again when the provider changed
+        if (m_runtimeProvider != provider) {
+            ContentRegistry::PatternLanguage::configureRuntime(m_runtime, provider);
+            m_runtimeProvider = provider;
+        }
 
         // Setup the runtime to read from the selected provider
         m_runtime.setDataSource(provider->getBaseAddress(), provider->getActualSize(), [this](u64 offset, u8 *buffer, size_t size) {
@@ -176,47 +204,130 @@ namespace hex::plugin::builtin {
         // Set start address to the selected address
         m_runtime.setStartAddress(m_selectedRegion.getStartAddress());
 
-        // Loop over all files in the inspectors folder and execute them
-        for (const auto &folderPath : paths::Inspectors.read()) {
-            for (const auto &entry: std::fs::recursive_directory_iterator(folderPath)) {
-                const auto &filePath = entry.path();
-                // Skip non-files and files that don't end with .hexpat
-                if (!entry.exists() || !entry.is_regular_file() || filePath.extension() != ".hexpat")
-                    continue;
-
-                // Read the inspector file
-                wolv::io::File file(filePath, wolv::io::File::Mode::Read);
+        // Pick up inspector files that were added, removed or modified since the last run
+        this->refreshInspectorFiles();
 
-                if (!file.isValid()) continue;
-                auto inspectorCode = file.readString();
+        // Execute all inspector files. Files that failed to compile aren't run again until they get modified
+        for (const auto &[path, file] : m_inspectorFiles) {
+            if (file.code.empty())
+                continue;
 
-                // Execute the inspector file
-                if (inspectorCode.empty()) continue;
-                this->executeInspector(inspectorCode, filePath, inVariables);
+            if (file.compileErrorDisplayFunction.has_value()) {
+                this->addInspectorErrorRow(path, *file.compileErrorDisplayFunction);
+                continue;
             }
+
+            this->executeInspector(file, path, inVariables);
         }
     }
 
-    void ViewDataInspector::executeInspector(const std::string& code, const std::fs::path& path, const std::map<std::string, pl::core::Token::Literal>& inVariables) {
-        if (m_runtime.executeString(code, pl::api::Source::DefaultSource, {}, inVariables, true) != 0) {
+    bool ViewDataInspector::haveInspectorFoldersChanged() const {
+        const auto folders = paths::Inspectors.read();
+        if (std::ranges::any_of(folders, [this](const auto &folder) { return !m_inspectorFolders.contains(folder); }))
+            return true;
 
-            auto displayFunction = createPatternErrorDisplayFunction(path);
+        // Adding, removing or renaming a file updates the modification time of the folder it's in
+        for (const auto &[folder, lastWriteTime] : m_inspectorFolders) {
+            std::error_code error;
+            if (std::fs::last_write_time(folder, error) != lastWriteTime || error)
+                return true;
+        }
 
-            // Insert the inspector containing the error message into the list
-            m_workData.emplace_back(
-                UntranslatedString(wolv::util::toUTF8String(path.filename())),
-                std::move(displayFunction),
-                std::nullopt,
-                false,
-                0,
-                wolv::util::toUTF8String(path)
-            );
+        return false;
+    }
+
+    void ViewDataInspector::refreshInspectorFiles() {
+        if (!m_inspectorFilesLoaded || this->haveInspectorFoldersChanged()) {
+            m_inspectorFilesLoaded = true;
+            m_inspectorFolders.clear();
+
+            // Collect all inspector files and remember the state of every folder they're in
+            std::set<std::fs::path> foundFiles;
+            for (const auto &folderPath : paths::Inspectors.read()) {
+                std::error_code error;
+                m_inspectorFolders[folderPath] = std::fs::last_write_time(folderPath, error);
+
+                for (const auto &entry : std::fs::recursive_directory_iterator(folderPath, error)) {
+                    const auto &filePath = entry.path();
+                    if (entry.is_directory()) {
+                        m_inspectorFolders[filePath] = std::fs::last_write_time(filePath, error);
+                        continue;
+                    }
+
+                    // Skip non-files and files that don't end with .hexpat
+                    if (!entry.exists() || !entry.is_regular_file() || filePath.extension() != ".hexpat")
+                        continue;
 
+                    foundFiles.insert(filePath);
+                }
+            }
+
+            // Drop files that don't exist anymore
+            for (auto it = m_inspectorFiles.begin(); it != m_inspectorFiles.end();) {
+                if (foundFiles.contains(it->first)) {
+                    ++it;
+                } else {
+                    it->second.tracker.stopTracking();
+                    it = m_inspectorFiles.erase(it);
+                }
+            }
+
+            // Start watching newly added files
+            for (const auto &filePath : foundFiles) {
+                auto [it, inserted] = m_inspectorFiles.try_emplace(filePath);
+                if (!inserted)
+                    continue;
+
+                auto &file = it->second;
+                file.changed = true;
+                file.tracker = wolv::io::ChangeTracker(filePath);
+                file.tracker.startTracking([changed = &file.changed] {
+                    changed->store(true, std::memory_order_release);
+                });
+            }
+        }
+
+        // Reload and validate all files whose content changed
+        for (auto &[path, file] : m_inspectorFiles) {
+            if (!file.changed.exchange(false, std::memory_order_acq_rel))
+                continue;
+
+            wolv::io::File inspectorFile(path, wolv::io::File::Mode::Read);
+            file.code = inspectorFile.isValid() ? inspectorFile.readString() : "";
+            file.pattern.reset();
+            file.compileErrorDisplayFunction.reset();
+
+            if (file.code.empty())
+                continue;
+
+            // Compilation doesn't depend on the selected data, so the file is only compiled once and then evaluated on every selection change
+            file.pattern = CompiledPattern::compile(m_runtime, file.code);
+            if (!file.pattern.has_value())
+                file.compileErrorDisplayFunction = createPatternErrorDisplayFunction(path);
+        }
+    }
+
+    void ViewDataInspector::addInspectorErrorRow(const std::fs::path &path, ContentRegistry::DataInspector::impl::DisplayFunction displayFunction) {
+        // Insert the inspector containing the error message into the list
+        m_workData.emplace_back(
+            UntranslatedString(wolv::util::toUTF8String(path.filename())),
+            std::move(displayFunction),
+            std::nullopt,
+            false,
+            0,
+            wolv::util::toUTF8String(path)
+        );
+    }
+
+    void ViewDataInspector::executeInspector(const InspectorFile& file, const std::fs::path& path, const std::map<std::string, pl::core::Token::Literal>& inVariables) {
+        // Evaluate the compiled file instead of going through executeString() which would compile it again
+        if (!file.pattern->execute(m_runtime, inVariables)) {
+            this->addInspectorErrorRow(path, createPatternErrorDisplayFunction(path));
             return;
         }
 
-        // Loop over patterns produced by the runtime
-        const auto &patterns = m_runtime.getPatterns();
+        // Loop over patterns produced by the evaluator
+        const auto &patterns = m_runtime.getInternals().evaluator->getPatterns();
         for (const auto &pattern: patterns) {
             // Skip hidden patterns
             if (pattern->getVisibility() == pl::ptrn::Visibility::Hidden)
@@ -270,17 +381,7 @@ namespace hex::plugin::builtin {
                 AchievementManager::unlockAchievement("hex.builtin.achievement.patterns"_unlocalized,
                                                       "hex.builtin.achievement.patterns.data_inspector.name"_unlocalized);
             } catch (const pl::core::err::EvaluatorError::Exception &) {
-                auto displayFunction = createPatternErrorDisplayFunction(path);
-
-                // Insert the inspector containing the error message into the list
-                m_workData.emplace_back(
-                    UntranslatedString(wolv::util::toUTF8String(path.filename())),
-                    std::move(displayFunction),
-                    std::nullopt,
-                    false,
-                    0,
-                    wolv::util::toUTF8String(path)
-                );
+                this->addInspectorErrorRow(path, createPatternErrorDisplayFunction(path));
             }
         }
     }
@@ -633,7 +734,7 @@ namespace hex::plugin::builtin {
             for (const auto &error : compileErrors) {
                 errorMessage += fmt::format("{}\n", error.format());
             }
-        } else if (const auto &evalError = m_runtime.getEvalError(); evalError.has_value()) {
+        } else if (const auto &evalError = m_runtime.getInternals().evaluator->getConsole().getLastHardError(); evalError.has_value()) {
             errorMessage += fmt::format("{}:{}  {}\n", evalError->line, evalError->column, evalError->message);
         }
 
@@ -4,6 +4,8 @@
 #include <hex/api/achievement_manager.hpp>
 #include <hex/api/imhex_api/hex_editor.hpp>
 #include <hex/api/events/events_interaction.hpp>
+#include <hex/api/events/events_provider.hpp>
+#include <hex/api/content_registry/communication_interface.hpp>
 #include <hex/api/content_registry/user_interface.hpp>
 #include <hex/trace/stacktrace.hpp>
 
@@ -16,31 +18,52 @@
 #include <imgui_internal.h>
 
 #include <array>
+#include <cctype>
+#include <chrono>
+#include <limits>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <barrier>
 
 #include <boost/regex.hpp>
 
+#include <content/helpers/byte_regex.hpp>
 #include <content/helpers/constants.hpp>
+#include <content/helpers/string_extractor.hpp>
+#include <content/helpers/uniform_block_index.hpp>
+#include <content/helpers/value_searcher.hpp>
+#include <content/mcp_jobs.hpp>
 #include <toasts/toast_notification.hpp>
 
+#include <romfs/romfs.hpp>
+#include <wolv/literals.hpp>
+
 namespace hex::plugin::builtin {
 
+    using namespace wolv::literals;
+
+    namespace {
+
+        // Time the data needs to stay unchanged before the filter index of changed results gets rebuilt
+        constexpr auto FilterIndexRebuildDelay = std::chrono::milliseconds(500);
+
+    }
+
     ViewFind::ViewFind() : View::Window("hex.builtin.view.find.name"_unlocalized, ICON_VS_SEARCH) {
         const static auto HighlightColor = [] { return (ImGuiExt::GetCustomColorU32(ImGuiCustomCol_FindHighlight) & 0x00FFFFFF) | 0x70000000; };
 
-        ImHexApi::HexEditor::addBackgroundHighlightingProvider([this](u64 address, const u8* data, size_t size, bool) -> std::optional<color_t> {
-            std::ignore = data;
-            std::ignore = size;
-
+        m_highlightSourceId = ImHexApi::HexEditor::addBackgroundHighlightSource([this](const prv::Provider *provider, const Region &region) {
+            std::vector<ImHexApi::HexEditor::Highlighting> result;
             if (m_searchTask.isRunning())
-                return { };
+                return result;
 
-            if (!m_occurrenceTree->overlapping({ .start=address, .end=address }).empty())
-                return HighlightColor();
-            else
-                return std::nullopt;
+            const auto color = HighlightColor();
+            const auto &occurrences = m_foundOccurrences.get(provider);
+            for (const auto index : occurrences.findOverlapping(region))
+                result.emplace_back(occurrences.getRegion(index), color);
+
+            return result;
         });
 
         ImHexApi::HexEditor::addTooltipProvider([this](u64 address, const u8* data, size_t size) {
@@ -50,21 +73,23 @@ namespace hex::plugin::builtin {
             if (m_searchTask.isRunning())
                 return;
 
-            auto occurrences = m_occurrenceTree->overlapping({ .start=address, .end=address + size });
-            if (occurrences.empty())
+            auto indices = m_foundOccurrences->findOverlapping({ .address=address, .size=size });
+            if (indices.empty())
                 return;
 
             ImGui::BeginTooltip();
 
-            for (const auto &occurrence : occurrences) {
-                ImGui::PushID(&occurrence);
+            for (const auto index : indices) {
+                const auto occurrence = (*m_foundOccurrences)[index];
+
+                ImGui::PushID(int(index));
                 if (ImGui::BeginTable("##tooltips", 1, ImGuiTableFlags_RowBg | ImGuiTableFlags_NoClip)) {
                     ImGui::TableNextRow();
                     ImGui::TableNextColumn();
 
                     {
-                        auto region = occurrence.value->region;
-                        const auto value = this->decodeValue(ImHexApi::Provider::get(), *occurrence.value, 256);
+                        auto region = occurrence.region;
+                        const auto value = this->decodeValue(ImHexApi::Provider::get(), occurrence, 256);
 
                         ImGui::ColorButton("##color", ImColor(HighlightColor()), ImGuiColorEditFlags_AlphaOpaque);
                         ImGui::SameLine(0, 10);
@@ -108,14 +133,29 @@ namespace hex::plugin::builtin {
             ImGui::EndTooltip();
         });
 
+        // The filter index was built from the values the occurrences had before the data changed. Inserting or removing
+        // data moves everything after it, so all occurrences from there on are affected
+        const auto onDataChanged = [this](prv::Provider *provider, Region region) {
+            TaskManager::doLater([this, provider, region] { this->invalidateFilterIndex(provider, region); });
+        };
+        EventProviderDataModified::subscribe(this, [onDataChanged](prv::Provider *provider, u64 address, u64 size, const u8 *) {
+            onDataChanged(provider, { address, size });
+        });
+        EventProviderDataInserted::subscribe(this, [onDataChanged](prv::Provider *provider, u64 address, u64) {
+            onDataChanged(provider, { address, std::numeric_limits<u64>::max() - address });
+        });
+        EventProviderDataRemoved::subscribe(this, [onDataChanged](prv::Provider *provider, u64 address, u64) {
+            onDataChanged(provider, { address, std::numeric_limits<u64>::max() - address });
+        });
+
         ShortcutManager::addShortcut(this, CTRLCMD + Keys::A, "hex.builtin.view.find.shortcut.select_all"_unlocalized, [this] {
             if (m_filterTask.isRunning())
                 return;
             if (m_searchTask.isRunning())
                 return;
 
-            for (auto &occurrence : *m_sortedOccurrences)
-                occurrence.selected = true;
+            for (const auto index : *m_sortedOccurrences)
+                m_foundOccurrences->setSelected(index, true);
         });
 
         /* Find Selection */
@@ -143,6 +183,89 @@ namespace hex::plugin::builtin {
             this->bringToFront();
         }, []{ return ImHexApi::Provider::isValid() && ImHexApi::HexEditor::isSelectionValid(); },
         ContentRegistry::Views::getViewByName("hex.builtin.view.hex_editor.name"_unlocalized));
+
+        /* MCP search tool */
+        ContentRegistry::MCP::registerTool(romfs::get("mcp/tools/search_data.json").string(), [](const nlohmann::json &data) -> nlohmann::json {
+            constexpr static size_t MaxReturnedBytes = 4_KiB;
+
+            auto provider = mcp_jobs::getProvider(data);
+            const auto region = mcp_jobs::getRegion(provider, data);
+
+            const auto mode  = data.at("mode").get<std::string>();
+            const auto query = data.value("query", "");
+
+            static const std::map<std::string, SearchSettings::StringType> StringTypes = {
+                { "ascii",   SearchSettings::StringType::ASCII   },
+                { "utf8",    SearchSettings::StringType::UTF8    },
+                { "utf16le", SearchSettings::StringType::UTF16LE },
+                { "utf16be", SearchSettings::StringType::UTF16BE }
+            };
+            const auto stringTypeName = data.value("string_type", "ascii");
+            const auto stringTypeIt = StringTypes.find(stringTypeName);
+            if (stringTypeIt == StringTypes.end())
+                throw std::invalid_argument(fmt::format("Unknown string type '{}'", stringTypeName));
+            const auto stringType = stringTypeIt->second;
+
+            std::function<void(Task &, const OccurrenceCallback &)> search;
+            if (mode == "strings") {
+                SearchSettings::Strings settings;
+                settings.minLength = data.value("min_length", settings.minLength);
+                settings.type = stringType;
+                search = [=](Task &task, const OccurrenceCallback &callback) { streamStrings(task, provider, region, settings, callback); };
+            } else if (mode == "sequence") {
+                SearchSettings::Sequence settings;
+                settings.sequence = query;
+                settings.type = stringType;
+                settings.ignoreCase = data.value("ignore_case", false);
+                search = [=](Task &task, const OccurrenceCallback &callback) { streamSequence(task, provider, region, settings, callback); };
+            } else if (mode == "regex") {
+                SearchSettings::Regex settings;
+                settings.pattern = query;
+                settings.minLength = data.value("min_length", settings.minLength);
+                settings.type = stringType;
+                settings.fullMatch = false;
+                settings.rawBytes = data.value("raw_bytes", false);
+                if (settings.rawBytes) {
+                    // Report invalid patterns right away instead of through a failed job
+                    ByteRegex regex(settings.pattern);
+                }
+                search = [=](Task &task, const OccurrenceCallback &callback) { streamRegex(task, provider, region, settings, callback); };
+            } else if (mode == "binary_pattern") {
+                SearchSettings::BinaryPattern settings;
+                settings.input = query;
+                settings.pattern = hex::BinaryPattern(query);
+                settings.alignment = data.value("alignment", 1U);
+                if (!settings.pattern.isValid())
+                    throw std::invalid_argument("Invalid binary pattern");
+                search = [=](Task &task, const OccurrenceCallback &callback) { streamBinaryPattern(task, provider, region, settings, callback); };
+            } else {
+                throw std::invalid_argument(fmt::format("Unknown search mode '{}'", mode));
+            }
+
+            return mcp_jobs::startJob(fmt::format("search_data:{}", mode), provider, ProgressValue::Size(region.getSize()), { "address", "size", "data" }, [provider, search](Task &task, mcp_jobs::Job &job) {
+                // Rows get added as soon as their part of the data has been searched so clients can start reading them right away
+                std::vector<u8> buffer;
+                search(task, [&](std::span<const Occurrence> occurrences) {
+                    std::vector<nlohmann::json> rows;
+                    rows.reserve(occurrences.size());
+
+                    for (const auto &occurrence : occurrences) {
+                        buffer.resize(std::min<u64>(occurrence.region.getSize(), MaxReturnedBytes));
+                        provider->read(occurrence.region.getStartAddress(), buffer.data(), buffer.size());
+
+                        rows.push_back({ occurrence.region.getStartAddress(), occurrence.region.getSize(), mcp_jobs::encodeData(buffer) });
+                    }
+
+                    job.addRows(std::move(rows));
+                });
+            });
+        });
+    }
+
+    ViewFind::~ViewFind() {
+        EventProviderDataModified::unsubscribe(this);
+        EventProviderDataInserted::unsubscribe(this);
+        EventProviderDataRemoved::unsubscribe(this);
     }
 
     template<typename Type, typename StorageType>
@@ -206,34 +329,52 @@ namespace hex::plugin::builtin {
         return fmt::format("{}", value);
     }
 
-    std::vector<hex::ContentRegistry::DataFormatter::impl::FindOccurrence> ViewFind::searchStrings(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Strings &settings) {
-        using enum SearchSettings::StringType;
+    namespace {
+
+        // Adapts the streaming searches to the ones that return all occurrences at once
+        template<typename Settings>
+        OccurrenceList collectOccurrences(Task &task, prv::Provider *provider, Region searchRegion, const Settings &settings, auto streamFunction) {
+            OccurrenceList results;
+            streamFunction(task, provider, searchRegion, settings, [&](std::span<const OccurrenceList::Occurrence> occurrences) {
+                for (const auto &occurrence : occurrences)
+                    results.push_back(occurrence);
+            });
+
+            return results;
+        }
+
+    }
+
+    OccurrenceList ViewFind::searchStrings(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Strings &settings) {
+        return collectOccurrences(task, provider, searchRegion, settings, &ViewFind::streamStrings);
+    }
+
+    OccurrenceList ViewFind::searchSequence(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Sequence &settings) {
+        return collectOccurrences(task, provider, searchRegion, settings, &ViewFind::streamSequence);
+    }
+
+    OccurrenceList ViewFind::searchRegex(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Regex &settings) {
+        return collectOccurrences(task, provider, searchRegion, settings, &ViewFind::streamRegex);
+    }
 
-        std::vector<Occurrence> results;
+    OccurrenceList ViewFind::searchBinaryPattern(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::BinaryPattern &settings) {
+        return collectOccurrences(task, provider, searchRegion, settings, &ViewFind::streamBinaryPattern);
+    }
+
+    void ViewFind::streamStrings(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Strings &settings, const OccurrenceCallback &callback) {
+        using enum SearchSettings::StringType;
 
         if (settings.type == ASCII_UTF16BE || settings.type == ASCII_UTF16LE) {
             auto newSettings = settings;
 
             newSettings.type = ASCII;
-            auto asciiResults = searchStrings(task, provider, searchRegion, newSettings);
-            std::ranges::copy(asciiResults, std::back_inserter(results));
-
-            if (settings.type == ASCII_UTF16BE) {
-                newSettings.type = UTF16BE;
-                auto utf16Results = searchStrings(task, provider, searchRegion, newSettings);
-                std::ranges::copy(utf16Results, std::back_inserter(results));
-            } else if (settings.type == ASCII_UTF16LE) {
-                newSettings.type = UTF16LE;
-                auto utf16Results = searchStrings(task, provider, searchRegion, newSettings);
-                std::ranges::copy(utf16Results, std::back_inserter(results));
-            }
+            streamStrings(task, provider, searchRegion, newSettings, callback);
 
-            return results;
-        }
+            newSettings.type = settings.type == ASCII_UTF16BE ? UTF16BE : UTF16LE;
+            streamStrings(task, provider, searchRegion, newSettings, callback);
 
-        auto reader = prv::ProviderReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
+            return;
+        }
 
         const auto [decodeType, endian] = [&]() -> std::pair<Occurrence::DecodeType, std::endian> {
             if (settings.type == ASCII)
@@ -259,96 +400,35 @@ namespace hex::plugin::builtin {
                 (settings.lineFeeds           && (byte == '\r' || byte == '\n'));
         };
 
-        i64 countedCharacters = 0;
-        u64 startAddress = reader.begin().getAddress();
-        u64 endAddress = reader.end().getAddress();
+        std::array<bool, 256> validCharacters = { };
+        for (u32 byte = 0x00; byte <= 0xFF; byte += 1)
+            validCharacters[byte] = validAscii(u8(byte));
 
-        u64 progress = 0;
-        i8 remainingCharacters = 0;
-        for (const u8 byte : reader) {
-            bool validChar = false;
-
-            if (settings.type == ASCII) {
-                validChar = validAscii(byte);
-            } else if (settings.type == UTF16LE) {
-                // Check if second byte of UTF-16 encoded string is 0x00
-                if (countedCharacters % 2 == 1)
-                    validChar = byte == 0x00;
-                else
-                    validChar = validAscii(byte);
-            } else if (settings.type == UTF16BE) {
-                // Check if first byte of UTF-16 encoded string is 0x00
-                if (countedCharacters % 2 == 0)
-                    validChar = byte == 0x00;
-                else
-                    validChar = validAscii(byte);
-            } else if (settings.type == UTF8) {
-                if (remainingCharacters > 0) {
-                    // Expect continuation byte
-                    if ((byte & 0b1100'0000) == 0b1000'0000) {
-                        validChar = true;
-                        remainingCharacters -= 1;
-                    } else {
-                        validChar = false; // broken sequence
-                        remainingCharacters = 0;
-                    }
-                } else {
-                    // New character
-                    if (byte <= 0x7F) {
-                        // ASCII
-                        validChar = validAscii(byte);
-                        remainingCharacters = 0;
-                    } else if ((byte & 0b1110'0000) == 0b1100'0000) {
-                        // 2-byte start (U+80..U+7FF)
-                        validChar = (byte >= 0xC2); // exclude overlongs (0xC0, 0xC1)
-                        remainingCharacters = 1;
-                    } else if ((byte & 0b1111'0000) == 0b1110'0000) {
-                        // 3-byte start (U+800..U+FFFF)
-                        validChar = byte != 0xE0 && byte != 0xED;
-                        // E0 must be followed by >= 0xA0, ED must be <= 0x9F (avoid surrogates)
-                        remainingCharacters = 2;
-                    } else if ((byte & 0b1111'1000) == 0b1111'0000) {
-                        // 4-byte start (U+10000..U+10FFFF)
-                        validChar = (byte <= 0xF4); // reject > U+10FFFF
-                        remainingCharacters = 3;
-                    } else {
-                        validChar = false;
-                        remainingCharacters = 0;
-                    }
-                }
+        const auto encoding = [&] {
+            switch (settings.type) {
+                case UTF8:    return StringExtractor::Encoding::UTF8;
+                case UTF16LE: return StringExtractor::Encoding::UTF16LE;
+                case UTF16BE: return StringExtractor::Encoding::UTF16BE;
+                default:      return StringExtractor::Encoding::ASCII;
             }
+        }();
 
-            task.update(progress);
-
-            if (validChar)
-                countedCharacters++;
-            if (!validChar || startAddress + countedCharacters == endAddress) {
-                if (countedCharacters >= settings.minLength) {
-                    if (!settings.nullTermination || byte == 0x00) {
-                        results.push_back(Occurrence { Region { .address=startAddress, .size=size_t(countedCharacters) }, endian, decodeType, false, {} });
-                    }
-                }
-
-                startAddress += countedCharacters + 1;
-                countedCharacters = 0;
-                progress = startAddress - searchRegion.getStartAddress();
+        const StringExtractor extractor(encoding, validCharacters, settings.minLength, settings.nullTermination);
 
-            }
-        }
+        std::vector<Occurrence> occurrences;
+        extractor.extract(task, provider, searchRegion, [&](std::span<const StringExtractor::Run> runs) {
+            occurrences.clear();
+            for (const auto &run : runs)
+                occurrences.push_back(Occurrence { Region { .address = run.address, .size = run.size }, endian, decodeType, false, {} });
 
-        return results;
+            callback(occurrences);
+        });
     }
 
-    std::vector<hex::ContentRegistry::DataFormatter::impl::FindOccurrence> ViewFind::searchSequence(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Sequence &settings) {
-        std::vector<Occurrence> results;
-
-        auto reader = prv::ProviderReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
-
+    void ViewFind::streamSequence(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Sequence &settings, const OccurrenceCallback &callback) {
         auto input = hex::decodeByteString(settings.sequence);
         if (input.empty())
-            return { };
+            return;
 
         std::vector<u8> bytes;
         auto decodeType = Occurrence::DecodeType::Binary;
@@ -384,44 +464,55 @@ namespace hex::plugin::builtin {
             }
         }
 
-        auto occurrence = reader.begin();
-        u64 progress = 0;
+        // Blocks that only consist of a byte that's not part of the sequence can't contain any part of an occurrence,
+        // so only the regions between them need to be searched
+        std::array<bool, 256> usedBytes = { };
+        for (const auto byte : bytes) {
+            usedBytes[byte] = true;
+            if (settings.ignoreCase) {
+                usedBytes[u8(std::tolower(byte))] = true;
+                usedBytes[u8(std::toupper(byte))] = true;
+            }
+        }
 
-        auto searchPredicate = [&]() -> bool(*)(u8, u8) {
-            if (!settings.ignoreCase)
-                return [](u8 left, u8 right) -> bool {
-                    return left == right;
-                };
-            else
-                return [](u8 left, u8 right) -> bool {
-                    if (std::isupper(left))
-                        left = std::tolower(left);
-                    if (std::isupper(right))
-                        right = std::tolower(right);
+        std::vector<Region> regions = { searchRegion };
+        if (const auto index = UniformBlockIndex::get(provider); index != nullptr)
+            regions = index->getCandidateRegions(provider->getBaseAddress(), searchRegion, usedBytes);
 
-                    return left == right;
-                };
-        }();
+        const SequenceSearcher searcher(bytes, settings.ignoreCase);
 
+        std::vector<Occurrence> occurrences;
+        for (const auto &region : regions) {
+            searcher.findAll(task, provider, region, [&](std::span<const u64> addresses) {
+                occurrences.clear();
+                for (const auto address : addresses)
+                    occurrences.push_back(Occurrence{ Region { .address=address, .size=bytes.size() }, endian, decodeType, false, {} });
 
-        while (true) {
-            task.update(progress);
+                callback(occurrences);
+            });
+        }
+    }
 
-            occurrence = hex::searchInterruptable(reader.begin(), reader.end(), bytes.begin(), bytes.end(), searchPredicate, task);
-            if (occurrence == reader.end())
-                break;
+    void ViewFind::streamRegex(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Regex &settings, const OccurrenceCallback &callback) {
+        std::vector<Occurrence> occurrences;
+
+        if (settings.rawBytes) {
+            const ByteRegex regex(settings.pattern);
+            regex.search(task, provider, searchRegion, [&](std::span<const Region> regions) {
+                occurrences.clear();
+                for (const auto &region : regions)
+                    occurrences.push_back(Occurrence { region, std::endian::native, Occurrence::DecodeType::Binary, false, {} });
+
+                callback(occurrences);
+            });
 
-            auto address = occurrence.getAddress();
-            reader.seek(address + 1);
-            results.push_back(Occurrence{ Region { .address=address, .size=bytes.size() }, endian, decodeType, false, {} });
-            progress = address - searchRegion.getStartAddress();
+            return;
         }
 
-        return results;
-    }
+        boost::regex regex(settings.pattern);
 
-    std::vector<hex::ContentRegistry::DataFormatter::impl::FindOccurrence> ViewFind::searchRegex(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::Regex &settings) {
-        auto stringOccurrences = searchStrings(task, provider, searchRegion, SearchSettings::Strings {
+        // Each batch of strings gets filtered as soon as it has been found
+        const auto strings = SearchSettings::Strings {
             .minLength          = settings.minLength,
             .nullTermination    = settings.nullTermination,
             .type               = settings.type,
@@ -432,98 +523,46 @@ namespace hex::plugin::builtin {
             .symbols            = true,
             .spaces             = true,
             .lineFeeds          = true
-        });
-
-        std::vector<Occurrence> result;
-        boost::regex regex(settings.pattern);
-        for (const auto &occurrence : stringOccurrences) {
-            std::string string(occurrence.region.getSize(), '\x00');
-            provider->read(occurrence.region.getStartAddress(), string.data(), occurrence.region.getSize());
-
-            task.update();
-
-            if (settings.fullMatch) {
-                if (boost::regex_match(string, regex))
-                    result.push_back(occurrence);
-            } else {
-                if (boost::regex_search(string, regex))
-                    result.push_back(occurrence);
-            }
-        }
-
-        return result;
-    }
-
-    std::vector<hex::ContentRegistry::DataFormatter::impl::FindOccurrence> ViewFind::searchBinaryPattern(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::BinaryPattern &settings) {
-        std::vector<Occurrence> results;
-
-        auto reader = prv::ProviderReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
-
-        const size_t patternSize = settings.pattern.getSize();
-
-        if (settings.alignment == 1) {
-            u32 matchedBytes = 0;
-            for (auto it = reader.begin(); it < reader.end(); it += 1) {
-                auto byte = *it;
+        };
+        streamStrings(task, provider, searchRegion, strings, [&](std::span<const Occurrence> stringOccurrences) {
+            occurrences.clear();
+            for (const auto &occurrence : stringOccurrences) {
+                std::string string(occurrence.region.getSize(), '\x00');
+                provider->read(occurrence.region.getStartAddress(), string.data(), occurrence.region.getSize());
 
-                task.update(it.getAddress());
-                if (settings.pattern.matchesByte(byte, matchedBytes)) {
-                    matchedBytes++;
-                    if (matchedBytes == settings.pattern.getSize()) {
-                        auto occurrenceAddress = it.getAddress() - (patternSize - 1);
+                task.update();
 
-                        results.push_back(Occurrence { Region { .address=occurrenceAddress, .size=patternSize }, std::endian::native, Occurrence::DecodeType::Binary, false, {} });
-                        it.setAddress(occurrenceAddress);
-                        matchedBytes = 0;
-                    }
+                if (settings.fullMatch) {
+                    if (boost::regex_match(string, regex))
+                        occurrences.push_back(occurrence);
                 } else {
-                    if (matchedBytes > 0)
-                        it -= matchedBytes;
-                    matchedBytes = 0;
+                    if (boost::regex_search(string, regex))
+                        occurrences.push_back(occurrence);
                 }
             }
-        } else {
-            std::vector<u8> data(patternSize);
-            for (u64 address = searchRegion.getStartAddress(); address < searchRegion.getEndAddress(); address += settings.alignment) {
-                reader.read(address, data.data(), data.size());
 
-                task.update(address);
-
-                bool match = true;
-                for (u32 i = 0; i < patternSize; i++) {
-                    if (!settings.pattern.matchesByte(data[i], i)) {
-                        match = false;
-                        break;
-                    }
-                }
+            if (!occurrences.empty())
+                callback(occurrences);
+        });
+    }
 
-                if (match)
-                    results.push_back(Occurrence { Region { .address=address, .size=patternSize }, std::endian::native, Occurrence::DecodeType::Binary, false, {} });
-            }
-        }
+    void ViewFind::streamBinaryPattern(Task &task, prv::Provider *provider, hex::Region searchRegion, const SearchSettings::BinaryPattern &settings, const OccurrenceCallback &callback) {
+        const size_t patternSize = settings.pattern.getSize();
 
-        return results;
-    }
+        const BinaryPatternSearcher searcher(settings.pattern);
 
-    template<typename T> T convert_signed_integer( T value, size_t size ) {
+        std::vector<Occurrence> occurrences;
+        searcher.findAll(task, provider, searchRegion, std::max<u32>(settings.alignment, 1), [&](std::span<const u64> addresses) {
+            occurrences.clear();
+            for (const auto address : addresses)
+                occurrences.push_back(Occurrence { Region { .address=address, .size=patternSize }, std::endian::native, Occurrence::DecodeType::Binary, false, {} });
 
-        switch (size) {
-            case 1: return static_cast<T>(static_cast<i8>(value));
-            case 2: return static_cast<T>(static_cast<i16>(value));
-            case 4: return static_cast<T>(static_cast<i32>(value));
-            case 8: return static_cast<T>(static_cast<i64>(value));
-            default: return value;
-        }
+            callback(occurrences);
+        });
     }
 
-    std::vector<hex::ContentRegistry::DataFormatter::impl::FindOccurrence> ViewFind::searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings) {
-        std::vector<Occurrence> results;
-
-        auto reader = prv::ProviderReader(provider);
-        reader.seek(searchRegion.getStartAddress());
-        reader.setEndAddress(searchRegion.getEndAddress());
+    OccurrenceList ViewFind::searchValue(Task &task, prv::Provider *provider, Region searchRegion, const SearchSettings::Value &settings) {
+        OccurrenceList results;
 
         auto inputMin = settings.inputMin;
         auto inputMax = settings.inputMax;
@@ -539,60 +578,41 @@ namespace hex::plugin::builtin {
 
         const auto size = sizeMin;
 
-        const auto advance = settings.aligned ? size : 1;
-
-        for (u64 address = searchRegion.getStartAddress(); address < searchRegion.getEndAddress(); address += advance) {
-            task.update(address);
-
-            auto result = std::visit([&]<typename T>(T) {
-                using DecayedType = std::remove_cvref_t<std::decay_t<T>>;
-
-                auto minValue = std::get<DecayedType>(min);
-                auto maxValue = std::get<DecayedType>(max);
-
-                DecayedType value = 0;
-                reader.read(address, reinterpret_cast<u8*>(&value), size);
-                value = hex::changeEndianness(value, size, settings.endian);
-                if constexpr (std::signed_integral<DecayedType>)
-                    value = convert_signed_integer<DecayedType>(value, size);
-
-                return value >= minValue && value <= maxValue;
-            }, min);
-
-            if (result) {
-                Occurrence::DecodeType decodeType = [&]{
-                    switch (settings.type) {
-                        using enum SearchSettings::Value::Type;
-                        using enum Occurrence::DecodeType;
-
-                        case U8:
-                        case U16:
-                        case U32:
-                        case U64:
-                            return Unsigned;
-                        case I8:
-                        case I16:
-                        case I32:
-                        case I64:
-                            return Signed;
-                        case F32:
-                            return Float;
-                        case F64:
-                            return Double;
-                        default:
-                            return Binary;
-                    }
-                }();
+        const auto search = [&]<typename T>() {
+            const auto toValue = [](auto value) { return static_cast<T>(value); };
+            const ValueSearcher<T> searcher(std::visit(toValue, min), std::visit(toValue, max), settings.endian);
 
-                results.push_back(Occurrence { Region { .address=address, .size=size }, settings.endian, decodeType, false, {} });
-            }
+            return searcher.findAll(task, provider, searchRegion, settings.aligned ? size : 1);
+        };
+
+        std::vector<u64> addresses;
+        Occurrence::DecodeType decodeType;
+        switch (settings.type) {
+            using enum SearchSettings::Value::Type;
+            using enum Occurrence::DecodeType;
+
+            case U8:  addresses = search.operator()<u8>();     decodeType = Unsigned; break;
+            case U16: addresses = search.operator()<u16>();    decodeType = Unsigned; break;
+            case U32: addresses = search.operator()<u32>();    decodeType = Unsigned; break;
+            case U64: addresses = search.operator()<u64>();    decodeType = Unsigned; break;
+            case I8:  addresses = search.operator()<i8>();     decodeType = Signed;   break;
+            case I16: addresses = search.operator()<i16>();    decodeType = Signed;   break;
+            case I32: addresses = search.operator()<i32>();    decodeType = Signed;   break;
+            case I64: addresses = search.operator()<i64>();    decodeType = Signed;   break;
+            case F32: addresses = search.operator()<float>();  decodeType = Float;    break;
+            case F64: addresses = search.operator()<double>(); decodeType = Double;   break;
+            default:  return { };
         }
 
+        results.reserve(addresses.size());
+        for (const auto address : addresses)
+            results.push_back(Occurrence { Region { .address=address, .size=size }, settings.endian, decodeType, false, {} });
+
         return results;
     }
 
-    std::vector<ViewFind::Occurrence> ViewFind::searchConstants(Task &task, prv::Provider* provider, Region searchRegion, const SearchSettings::Constants &settings) {
-        std::vector<Occurrence> results;
+    OccurrenceList ViewFind::searchConstants(Task &task, prv::Provider* provider, Region searchRegion, const SearchSettings::Constants &settings) {
+        OccurrenceList results;
 
         std::vector<ConstantGroup> constantGroups;
         for (const auto &path : paths::Constants.read()) {
@@ -692,55 +712,108 @@ namespace hex::plugin::builtin {
                 AchievementManager::unlockAchievement("hex.builtin.achievement.find"_unlocalized, "hex.builtin.achievement.find.find_numeric.name"_unlocalized);
         }
 
-        m_occurrenceTree->clear();
-        EventHighlightingChanged::post();
+        m_decodeSettings = m_searchSettings;
+        this->resetOccurrences();
 
         m_searchTask = TaskManager::createTask("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(searchRegion.getSize()), [this, settings = m_searchSettings, searchRegion](auto &task) {
             auto provider = ImHexApi::Provider::get();
 
+            OccurrenceList occurrences;
             switch (settings.mode) {
                 using enum SearchSettings::Mode;
                 case Strings:
-                    m_foundOccurrences.get(provider) = searchStrings(task, provider, searchRegion, settings.strings);
+                    occurrences = searchStrings(task, provider, searchRegion, settings.strings);
                     break;
                 case Sequence:
-                    m_foundOccurrences.get(provider) = searchSequence(task, provider, searchRegion, settings.bytes);
+                    occurrences = searchSequence(task, provider, searchRegion, settings.bytes);
                     break;
                 case Regex:
-                    m_foundOccurrences.get(provider) = searchRegex(task, provider, searchRegion, settings.regex);
+                    occurrences = searchRegex(task, provider, searchRegion, settings.regex);
                     break;
                 case BinaryPattern:
-                    m_foundOccurrences.get(provider) = searchBinaryPattern(task, provider, searchRegion, settings.binaryPattern);
+                    occurrences = searchBinaryPattern(task, provider, searchRegion, settings.binaryPattern);
                     break;
                 case Value:
-                    m_foundOccurrences.get(provider) = searchValue(task, provider, searchRegion, settings.value);
+                    occurrences = searchValue(task, provider, searchRegion, settings.value);
                     break;
                 case Constants:
-                    m_foundOccurrences.get(provider) = searchConstants(task, provider, searchRegion, settings.constants);
+                    occurrences = searchConstants(task, provider, searchRegion, settings.constants);
                     break;
             }
 
-            m_sortedOccurrences.get(provider).clear();
-            m_lastSelectedOccurrence = nullptr;
-
-            for (const auto &occurrence : m_foundOccurrences.get(provider))
-                m_occurrenceTree->insert({ .start=occurrence.region.getStartAddress(), .end=occurrence.region.getEndAddress() }, occurrence);
+            occurrences.sort();
+            m_foundOccurrences.get(provider) = std::move(occurrences);
 
             TaskManager::doLater([this, provider] {
+                ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
                 EventHighlightingChanged::post();
-                m_settingsCollapsed.get(provider) = !m_foundOccurrences->empty();
+                m_settingsCollapsed.get(provider) = !m_foundOccurrences.get(provider).empty();
             });
         });
+    }
+
+    void ViewFind::resetOccurrences() {
+        // The index task reads the occurrences, it needs to be done before they can be cleared
+        m_indexTask->interrupt();
+        m_indexTask->wait();
+        *m_indexGeneration += 1;
+        m_indexRebuildTime->reset();
 
-        m_decodeSettings = m_searchSettings;
         m_foundOccurrences->clear();
         m_sortedOccurrences->clear();
-        m_occurrenceTree->clear();
-        m_lastSelectedOccurrence = nullptr;
+        m_lastSelectedOccurrence->reset();
+        m_filterIndex->reset();
 
+        ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
         EventHighlightingChanged::post();
     }
 
+    void ViewFind::buildFilterIndex(prv::Provider *provider) {
+        m_indexRebuildTime.get(provider).reset();
+        if (m_foundOccurrences.get(provider).size() < OccurrenceFilterIndex::MinOccurrenceCount)
+            return;
+
+        // A previous task has already been interrupted at this point if there is one, so this doesn't take long
+        auto &indexTask = m_indexTask.get(provider);
+        indexTask.interrupt();
+        indexTask.wait();
+
+        indexTask = TaskManager::createBackgroundTask("hex.builtin.task.indexing_results", [this, provider, generation = m_indexGeneration.get(provider)](Task &task) {
+            OccurrenceFilterIndex index;
+            const bool built = index.build(task, m_foundOccurrences.get(provider), [this, provider](const Occurrence &occurrence) {
+                return this->decodeValue(provider, occurrence);
+            });
+
+            if (!built)
+                return;
+
+            TaskManager::doLater([this, provider, generation, index = std::make_shared<const OccurrenceFilterIndex>(std::move(index))] {
+                // Results may have been cleared or replaced while the index was being built
+                if (generation == m_indexGeneration.get(provider))
+                    m_filterIndex.get(provider) = index;
+            });
+        });
+    }
+
+    void ViewFind::invalidateFilterIndex(prv::Provider *provider, Region region) {
+        // Changes that don't touch any of the occurrences don't change their values either
+        if (region.getSize() == 0 || m_searchTask.isRunning() || !m_foundOccurrences.get(provider).hasOverlapping(region))
+            return;
+
+        // Only rebuild indices that were already in use, all others get built once their results get filtered
+        auto &indexTask = m_indexTask.get(provider);
+        const bool rebuild = m_filterIndex.get(provider) != nullptr || indexTask.isRunning() || m_indexRebuildTime.get(provider).has_value();
+
+        // The interrupted task may keep running for a moment, its result gets discarded because of the new generation
+        indexTask.interrupt();
+        m_indexGeneration.get(provider) += 1;
+        m_filterIndex.get(provider).reset();
+
+        // Every further change delays the rebuild, so editing the data doesn't restart it on every keystroke
+        if (rebuild)
+            m_indexRebuildTime.get(provider) = std::chrono::steady_clock::now() + FilterIndexRebuildDelay;
+    }
+
     std::string ViewFind::decodeValue(prv::Provider *provider, const Occurrence &occurrence, size_t maxBytes) const {
         std::vector<u8> bytes(std::min<size_t>(occurrence.region.getSize(), maxBytes));
         provider->read(occurrence.region.getStartAddress(), bytes.data(), bytes.size());
@@ -798,10 +871,10 @@ namespace hex::plugin::builtin {
         return result;
     }
 
-    void ViewFind::drawContextMenu(Occurrence &target, const std::string &value) {
+    void ViewFind::drawContextMenu(u32 target, const std::string &value) {
         if (ImGui::IsMouseClicked(ImGuiMouseButton_Right) && ImGui::IsItemHovered()) {
             ImGui::OpenPopup("FindContextMenu");
-            target.selected = true;
+            m_foundOccurrences->setSelected(target, true);
             m_replaceBuffer.clear();
         }
 
@@ -820,10 +893,11 @@ namespace hex::plugin::builtin {
                             auto provider = ImHexApi::Provider::get();
                             auto bytes = parseHexString(m_replaceBuffer);
 
-                            for (const auto &occurrence : *m_sortedOccurrences) {
-                                if (occurrence.selected) {
-                                    size_t size = std::min<size_t>(occurrence.region.size, bytes.size());
-                                    provider->write(occurrence.region.getStartAddress(), bytes.data(), size);
+                            for (const auto index : *m_sortedOccurrences) {
+                                if (m_foundOccurrences->isSelected(index)) {
+                                    const auto region = m_foundOccurrences->getRegion(index);
+                                    size_t size = std::min<size_t>(region.size, bytes.size());
+                                    provider->write(region.getStartAddress(), bytes.data(), size);
                                 }
                             }
                         }
@@ -840,10 +914,11 @@ namespace hex::plugin::builtin {
                             auto provider = ImHexApi::Provider::get();
                             auto bytes = decodeByteString(m_replaceBuffer);
 
-                            for (const auto &occurrence : *m_sortedOccurrences) {
-                                if (occurrence.selected) {
-                                    size_t size = std::min<size_t>(occurrence.region.size, bytes.size());
-                                    provider->write(occurrence.region.getStartAddress(), bytes.data(), size);
+                            for (const auto index : *m_sortedOccurrences) {
+                                if (m_foundOccurrences->isSelected(index)) {
+                                    const auto region = m_foundOccurrences->getRegion(index);
+                                    size_t size = std::min<size_t>(region.size, bytes.size());
+                                    provider->write(region.getStartAddress(), bytes.data(), size);
                                 }
                             }
                         }
@@ -865,6 +940,9 @@ namespace hex::plugin::builtin {
     void ViewFind::drawContent() {
         auto provider = ImHexApi::Provider::get();
 
+        if (const auto &rebuildTime = m_indexRebuildTime.get(provider); rebuildTime.has_value() && std::chrono::steady_clock::now() >= *rebuildTime)
+            this->buildFilterIndex(provider);
+
         ImGui::BeginDisabled(m_searchTask.isRunning());
         {
             auto &collapsed = m_settingsCollapsed.get(provider);
@@ -961,37 +1039,52 @@ namespace hex::plugin::builtin {
 
                         mode = SearchSettings::Mode::Regex;
 
-                        ImGui::InputInt("hex.builtin.view.find.strings.min_length"_lang, &settings.minLength, 1, 1);
-                        if (settings.minLength < 1)
-                            settings.minLength = 1;
+                        ImGui::Checkbox("hex.builtin.view.find.regex.raw_bytes"_lang, &settings.rawBytes);
+                        ImGui::SetItemTooltip("%s", "hex.builtin.view.find.regex.raw_bytes.tooltip"_lang.get());
 
-                        if (ImGui::BeginCombo("hex.ui.common.type"_lang, StringTypes[std::to_underlying(settings.type)].c_str())) {
-                            for (size_t i = 0; i < StringTypes.size(); i++) {
-                                auto type = static_cast<SearchSettings::StringType>(i);
+                        ImGui::BeginDisabled(settings.rawBytes);
+                        {
+                            ImGui::InputInt("hex.builtin.view.find.strings.min_length"_lang, &settings.minLength, 1, 1);
+                            if (settings.minLength < 1)
+                                settings.minLength = 1;
 
-                                if (ImGui::Selectable(StringTypes[i].c_str(), type == settings.type))
-                                    settings.type = type;
+                            if (ImGui::BeginCombo("hex.ui.common.type"_lang, StringTypes[std::to_underlying(settings.type)].c_str())) {
+                                for (size_t i = 0; i < StringTypes.size(); i++) {
+                                    auto type = static_cast<SearchSettings::StringType>(i);
+
+                                    if (ImGui::Selectable(StringTypes[i].c_str(), type == settings.type))
+                                        settings.type = type;
+                                }
+                                ImGui::EndCombo();
                             }
-                            ImGui::EndCombo();
-                        }
 
-                        ImGui::Checkbox("hex.builtin.view.find.strings.null_term"_lang, &settings.nullTermination);
+                            ImGui::Checkbox("hex.builtin.view.find.strings.null_term"_lang, &settings.nullTermination);
+                        }
+                        ImGui::EndDisabled();
 
                         ImGui::NewLine();
 
                         ImGuiExt::InputTextIconHint("hex.builtin.view.find.regex.pattern"_lang, ICON_VS_REGEX, "[A-Za-z]{2}\\d{3}", settings.pattern);
 
                         try {
-                            boost::regex regex(settings.pattern);
+                            if (settings.rawBytes) {
+                                ByteRegex regex(settings.pattern);
+                            } else {
+                                boost::regex regex(settings.pattern);
+                            }
                             m_settingsValid = true;
                         } catch (const boost::regex_error &) {
                             m_settingsValid = false;
+                        } catch (const std::invalid_argument &) {
+                            m_settingsValid = false;
                         }
 
                         if (settings.pattern.empty())
                             m_settingsValid = false;
 
+                        ImGui::BeginDisabled(settings.rawBytes);
                         ImGui::Checkbox("hex.builtin.view.find.regex.full_match"_lang, &settings.fullMatch);
+                        ImGui::EndDisabled();
 
                         ImGui::EndTabItem();
                     }
@@ -1127,12 +1220,7 @@ namespace hex::plugin::builtin {
             ImGui::BeginDisabled(m_foundOccurrences->empty());
             {
                 if (ImGuiExt::DimmedIconButton(ICON_VS_SEARCH_STOP, ImGui::GetStyleColorVec4(ImGuiCol_Text))) {
-                    m_foundOccurrences->clear();
-                    m_sortedOccurrences->clear();
-                    m_occurrenceTree->clear();
-                    m_lastSelectedOccurrence = nullptr;
-
-                    EventHighlightingChanged::post();
+                    this->resetOccurrences();
                 }
                 ImGui::SetItemTooltip("%s", "hex.builtin.view.find.search.reset"_lang.get());
             }
@@ -1149,12 +1237,16 @@ namespace hex::plugin::builtin {
         ImGui::NewLine();
 
         auto &currOccurrences = *m_sortedOccurrences;
+        const auto listAllOccurrences = [&] {
+            currOccurrences.resize(m_foundOccurrences->size());
+            std::iota(currOccurrences.begin(), currOccurrences.end(), 0);
+        };
 
         ImGui::PushItemWidth(-30_scaled);
         auto prevFilterLength = m_currFilter->length();
         if (ImGuiExt::InputTextIcon("##filter", ICON_VS_FILTER, *m_currFilter)) {
             if (prevFilterLength > m_currFilter->length())
-                *m_sortedOccurrences = *m_foundOccurrences;
+                listAllOccurrences();
 
             if (m_filterTask.isRunning())
                 m_filterTask.interrupt();
@@ -1163,15 +1255,34 @@ namespace hex::plugin::builtin {
             std::scoped_lock lock(mutex);
 
             if (!m_currFilter->empty()) {
-                m_filterTask = TaskManager::createTask("hex.builtin.task.filtering_data"_unlocalized, ProgressValue::Count(currOccurrences.size()), [this, provider, &currOccurrences, filter = m_currFilter.get(provider)](Task &task) {
+                // The index is built the first time the results get filtered, the filter tasks until then check every occurrence
+                if (m_filterIndex.get(provider) == nullptr && !m_indexTask.get(provider).isRunning())
+                    this->buildFilterIndex(provider);
+
+                m_filterTask = TaskManager::createTask("hex.builtin.task.filtering_data"_unlocalized, ProgressValue::Count(currOccurrences.size()), [this, provider, &currOccurrences, filter = m_currFilter.get(provider), filterIndex = m_filterIndex.get(provider)](Task &task) {
                     std::scoped_lock lock(mutex);
 
+                    const auto &occurrences = m_foundOccurrences.get(provider);
+
+                    // If the index is ready, only the occurrences it considers possible matches need to be decoded
+                    std::vector<bool> candidates;
+                    if (filterIndex != nullptr) {
+                        if (const auto indices = filterIndex->getCandidates(filter); indices.has_value()) {
+                            candidates.resize(occurrences.size());
+                            for (const auto index : *indices)
+                                candidates[index] = true;
+                        }
+                    }
+
                     u64 progress = 0;
-                    std::erase_if(currOccurrences, [this, provider, &task, &progress, &filter](const auto &region) {
+                    std::erase_if(currOccurrences, [this, provider, &task, &progress, &filter, &occurrences, &candidates](u32 index) {
                         task.update(progress);
                         progress += 1;
 
-                        return !hex::containsIgnoreCase(this->decodeValue(provider, region), filter);
+                        if (!candidates.empty() && !candidates[index])
+                            return true;
+
+                        return !hex::containsIgnoreCase(this->decodeValue(provider, occurrences[index]), filter);
                     });
                 });
             }
@@ -1201,8 +1312,13 @@ namespace hex::plugin::builtin {
                         if (!file.isValid())
                             return;
 
+                        std::vector<Occurrence> occurrences;
+                        occurrences.reserve(m_sortedOccurrences->size());
+                        for (const auto index : *m_sortedOccurrences)
+                            occurrences.push_back((*m_foundOccurrences)[index]);
+
                         auto result = formatter.callback(
-                                m_sortedOccurrences.get(provider),
+                                occurrences,
                                 [&](Occurrence o){ return this->decodeValue(provider, o); });
 
                         file.writeVector(result);
@@ -1222,31 +1338,35 @@ namespace hex::plugin::builtin {
             auto sortSpecs = ImGui::TableGetSortSpecs();
 
             if (m_sortedOccurrences->empty() && !m_foundOccurrences->empty()) {
-                currOccurrences = *m_foundOccurrences;
+                listAllOccurrences();
                 sortSpecs->SpecsDirty = true;
             }
 
             if (sortSpecs->SpecsDirty) {
-                std::ranges::stable_sort(currOccurrences, [this, &sortSpecs, provider](const Occurrence &left, const Occurrence &right) -> bool {
-                    if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("offset")) {
-                        if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
-                            return left.region.getStartAddress() < right.region.getStartAddress();
-                        else
-                            return left.region.getStartAddress() > right.region.getStartAddress();
-                    } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("size")) {
-                        if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
-                            return left.region.getSize() < right.region.getSize();
-                        else
-                            return left.region.getSize() > right.region.getSize();
-                    } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("value")) {
-                        if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
-                            return this->decodeValue(provider, left) < this->decodeValue(provider, right);
-                        else
-                            return this->decodeValue(provider, left) > this->decodeValue(provider, right);
-                    }
+                const auto &occurrences = *m_foundOccurrences;
+                const bool ascending = sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending;
+                const auto compare = [ascending](const auto &left, const auto &right) -> bool {
+                    if (ascending)
+                        return left < right;
+                    else
+                        return left > right;
+                };
 
-                    return false;
-                });
+                if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("offset")) {
+                    std::ranges::stable_sort(currOccurrences, compare, [&occurrences](u32 index) { return occurrences.getRegion(index).getStartAddress(); });
+                } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("size")) {
+                    std::ranges::stable_sort(currOccurrences, compare, [&occurrences](u32 index) { return occurrences.getRegion(index).getSize(); });
+                } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("value")) {
+                    // Decode every value once up front instead of twice for every comparison
+                    std::vector<std::pair<std::string, u32>> values;
+                    values.reserve(currOccurrences.size());
+                    for (const auto index : currOccurrences)
+                        values.emplace_back(this->decodeValue(provider, occurrences[index]), index);
+
+                    std::ranges::stable_sort(values, compare, [](const auto &entry) -> const std::string& { return entry.first; });
+                    for (size_t i = 0; i < values.size(); i += 1)
+                        currOccurrences[i] = values[i].second;
+                }
 
                 sortSpecs->SpecsDirty = false;
             }
@@ -1258,7 +1378,8 @@ namespace hex::plugin::builtin {
 
             while (clipper.Step()) {
                 for (size_t i = clipper.DisplayStart; i < std::min<size_t>(clipper.DisplayEnd, currOccurrences.size()); i++) {
-                    auto &foundItem = currOccurrences[i];
+                    const auto index = currOccurrences[i];
+                    const auto foundItem = (*m_foundOccurrences)[index];
 
                     ImGui::TableNextRow();
                     ImGui::TableNextColumn();
@@ -1274,22 +1395,22 @@ namespace hex::plugin::builtin {
                     ImGuiExt::TextFormatted("{}", value);
                     ImGui::SameLine();
                     if (ImGui::Selectable("##line", foundItem.selected, ImGuiSelectableFlags_SpanAllColumns)) {
-                        if (ImGui::GetIO().KeyShift && m_lastSelectedOccurrence != nullptr) {
-                            for (auto start = std::min(&foundItem, m_lastSelectedOccurrence.get(provider)); start <= std::max(&foundItem, m_lastSelectedOccurrence.get(provider)); start += 1)
-                                start->selected = true;
+                        if (ImGui::GetIO().KeyShift && m_lastSelectedOccurrence->has_value()) {
+                            const auto lastSelected = std::min(**m_lastSelectedOccurrence, currOccurrences.size() - 1);
+                            for (auto row = std::min(i, lastSelected); row <= std::max(i, lastSelected); row += 1)
+                                m_foundOccurrences->setSelected(currOccurrences[row], true);
 
                         } else if (ImGui::GetIO().KeyCtrl) {
-                            foundItem.selected = !foundItem.selected;
+                            m_foundOccurrences->setSelected(index, !foundItem.selected);
                         } else {
-                            for (auto &occurrence : *m_sortedOccurrences)
-                                occurrence.selected = false;
-                            foundItem.selected = true;
+                            m_foundOccurrences->clearSelection();
+                            m_foundOccurrences->setSelected(index, true);
                             ImHexApi::HexEditor::setSelection(foundItem.region.getStartAddress(), foundItem.region.getSize());
                         }
 
-                        m_lastSelectedOccurrence = &foundItem;
+                        *m_lastSelectedOccurrence = i;
                     }
-                    drawContextMenu(foundItem, value);
+                    drawContextMenu(index, value);
 
                     ImGui::PopID();
                 }
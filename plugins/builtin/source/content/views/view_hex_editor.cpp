@@ -16,6 +16,7 @@
 #include <hex/helpers/utils.hpp>
 #include <hex/helpers/crypto.hpp>
 #include <hex/helpers/default_paths.hpp>
+#include <hex/helpers/profiler.hpp>
 
 #include <hex/providers/buffered_reader.hpp>
 #include <toasts/toast_notification.hpp>
@@ -92,19 +93,13 @@ namespace hex::plugin::builtin {
 
             std::optional<color_t> result;
             for (const auto &[id, callback] : ImHexApi::HexEditor::impl::getForegroundHighlightingFunctions()) {
+                prof::ScopedTimer timer(prof::Category::Highlighting, "Foreground highlighting", id, size);
                 if (auto color = callback(address, data, size, result.has_value()); color.has_value()) {
                     result = color;
                     break;
                 }
             }
 
-            if (!result.has_value()) {
-                for (const auto &[id, highlighting] : ImHexApi::HexEditor::impl::getForegroundHighlights()) {
-                    if (highlighting.getRegion().overlaps({ .address=address, .size=size }))
-                        return highlighting.getColor();
-                }
-            }
-
             if (result.has_value())
                 m_foregroundHighlights->insert({ address, result.value() });
 
@@ -160,35 +155,44 @@ namespace hex::plugin::builtin {
 
             std::optional<color_t> result;
             for (const auto &[id, callback] : ImHexApi::HexEditor::impl::getBackgroundHighlightingFunctions()) {
+                prof::ScopedTimer timer(prof::Category::Highlighting, "Background highlighting", id, size);
                 if (auto color = callback(address, data, size, result.has_value()); color.has_value()) {
                     result = blendColors(result, color);
                 }
             }
 
-            if (!result.has_value()) {
-                for (const auto &[id, highlighting] : ImHexApi::HexEditor::impl::getBackgroundHighlights()) {
-                    if (highlighting.getRegion().overlaps({ .address=address, .size=size })) {
-                        result = blendColors(result, highlighting.getColor());
-                    }
-                }
-            }
-
             if (result.has_value())
                 m_backgroundHighlights->insert({ address, result.value() });
 
             return result;
         });
 
+        // Interval based highlights and static highlights are resolved once per frame for the entire visible region
+        m_hexEditor.setForegroundHighlightRunCallback([this](const Region &visibleRegion) {
+            prof::ScopedTimer timer(prof::Category::Highlighting, "Foreground highlight runs", 0, visibleRegion.getSize());
+            return m_foregroundCompositor.resolve(m_hexEditor.getProvider(), visibleRegion);
+        });
+
+        m_hexEditor.setBackgroundHighlightRunCallback([this](const Region &visibleRegion) -> std::span<const ui::HexEditor::HighlightRun> {
+            if (!showHighlights)
+                return { };
+
+            prof::ScopedTimer timer(prof::Category::Highlighting, "Background highlight runs", 0, visibleRegion.getSize());
+            return m_backgroundCompositor.resolve(m_hexEditor.getProvider(), visibleRegion, *m_hoverHighlights);
+        });
+
         m_hexEditor.setHoverChangedCallback([this](u64 address, size_t size) {
             if (!showHighlights)
                 return;
 
             m_hoverHighlights->clear();
+            m_backgroundCompositor.invalidate();
 
             if (Region(address, size) == Region::Invalid())
                 return;
 
             for (const auto &[id, hoverFunction] : ImHexApi::HexEditor::impl::getHoveringFunctions()) {
+                prof::ScopedTimer timer(prof::Category::Highlighting, "Hover highlighting", id, size);
                 auto highlightedAddresses = hoverFunction(m_hexEditor.getProvider(), address, size);
                 m_hoverHighlights->merge(highlightedAddresses);
             }
@@ -199,6 +203,7 @@ namespace hex::plugin::builtin {
                 return;
 
             for (const auto &[id, callback] : ImHexApi::HexEditor::impl::getTooltipFunctions()) {
+                prof::ScopedTimer timer(prof::Category::Tooltip, "Tooltip", id, size);
                 callback(address, data, size);
             }
 
@@ -708,6 +713,9 @@ namespace hex::plugin::builtin {
 
             m_foregroundHighlights.get(provider).clear();
             m_backgroundHighlights.get(provider).clear();
+
+            m_foregroundCompositor.invalidate();
+            m_backgroundCompositor.invalidate();
         });
 
         ContentRegistry::Settings::onChange("hex.builtin.setting.hex_editor"_unlocalized, "hex.builtin.setting.hex_editor.bytes_per_row"_unlocalized, [this](const ContentRegistry::Settings::SettingsValue &value) {
@@ -863,32 +871,10 @@ namespace hex::plugin::builtin {
             1620,
             CTRLCMD + Keys::LeftBracket,
             [] {
-                bool didFindNextValue = false;
-                bool didReachBeginning = false;
-                u64 foundAddress;
-
-                findNextDifferingByte(
-                    [] (prv::Provider* provider) -> u64 {
-                        return provider->getBaseAddress();
-                    },
-                    [] (u64 currentAddress, u64 endAddress) -> bool {
-                        return currentAddress > endAddress;
-                    },
-                    [] (u64* currentAddress) {
-                        (*currentAddress)--;
-                    },
-                    &didFindNextValue,
-                    &didReachBeginning,
-                    &foundAddress
-                );
-
-                if (didFindNextValue) {
-                    ImHexApi::HexEditor::setSelection(foundAddress, 1);
-                }
-
-                if (!didFindNextValue && didReachBeginning) {
+                if (auto address = findNextDifferingByte(SearchDirection::Backward); address.has_value())
+                    ImHexApi::HexEditor::setSelection(*address, 1);
+                else
                     ui::ToastInfo::open("hex.builtin.view.hex_editor.menu.file.skip_until.beginning_reached"_lang);
-                }
             },
             canSearchForDifferingByte,
             this
@@ -904,32 +890,10 @@ namespace hex::plugin::builtin {
             1630,
             CTRLCMD + Keys::RightBracket,
             [] {
-                bool didFindNextValue = false;
-                bool didReachEnd = false;
-                u64 foundAddress;
-
-                findNextDifferingByte(
-                    [] (prv::Provider* provider) -> u64 {
-                        return provider->getBaseAddress() + provider->getActualSize() - 1;
-                    },
-                    [] (u64 currentAddress, u64 endAddress) -> bool {
-                        return currentAddress < endAddress;
-                    },
-                    [] (u64* currentAddress) {
-                        (*currentAddress)++;
-                    },
-                    &didFindNextValue,
-                    &didReachEnd,
-                    &foundAddress
-                );
-
-                if (didFindNextValue) {
-                    ImHexApi::HexEditor::setSelection(foundAddress, 1);
-                }
-
-                if (!didFindNextValue && didReachEnd) {
+                if (auto address = findNextDifferingByte(SearchDirection::Forward); address.has_value())
+                    ImHexApi::HexEditor::setSelection(*address, 1);
+                else
                     ui::ToastInfo::open("hex.builtin.view.hex_editor.menu.file.skip_until.end_reached"_lang);
-                }
             },
             canSearchForDifferingByte,
             this
@@ -14,6 +14,17 @@
 namespace hex::plugin::builtin {
 
     wolv::math_eval::MathEvaluator<i128> ViewHighlightRules::Rule::Expression::s_evaluator;
+    std::atomic<u64> ViewHighlightRules::Rule::Expression::s_generation = 1;
+
+    namespace {
+
+        // Number of cells that are evaluated together and cached as one block
+        constexpr static size_t CellsPerBlock = 256;
+
+        // Upper limit of cached blocks per expression before the cache gets dropped again
+        constexpr static size_t MaxCachedBlocks = 1024;
+
+    }
 
     ViewHighlightRules::Rule::Rule(std::string name) : name(std::move(name)) { }
 
@@ -46,6 +57,8 @@ namespace hex::plugin::builtin {
     }
 
     ViewHighlightRules::Rule::Expression::Expression(std::string mathExpression, std::array<float, 3> color) : mathExpression(std::move(mathExpression)), color(color) {
+        this->compile();
+
         // Create a new highlight provider function for this expression
         this->addHighlight();
     }
@@ -56,7 +69,7 @@ namespace hex::plugin::builtin {
             ImHexApi::HexEditor::removeForegroundHighlightingProvider(this->highlightId);
     }
 
-    ViewHighlightRules::Rule::Expression::Expression(Expression &&other) noexcept : mathExpression(std::move(other.mathExpression)), color(other.color), parentRule(other.parentRule) {
+    ViewHighlightRules::Rule::Expression::Expression(Expression &&other) noexcept : mathExpression(std::move(other.mathExpression)), color(other.color), parentRule(other.parentRule), m_program(std::move(other.m_program)) {
         // Remove the highlight from the other expression and add a new one for this one
         // This is necessary as the highlight provider function holds a reference to the expression
         // so to avoid dangling references, we need to destroy the old one before the expression itself
@@ -69,6 +82,8 @@ namespace hex::plugin::builtin {
         this->mathExpression = std::move(other.mathExpression);
         this->color = other.color;
         this->parentRule = other.parentRule;
+        m_program = std::move(other.m_program);
+        m_cachedResults.clear();
 
         // Remove the highlight from the other expression and add a new one for this one
         other.removeHighlight();
@@ -77,6 +92,11 @@ namespace hex::plugin::builtin {
         return *this;
     }
 
+    void ViewHighlightRules::Rule::Expression::compile() {
+        m_program = ExpressionProgram::compile(this->mathExpression);
+        m_cachedResults.clear();
+    }
+
     void ViewHighlightRules::Rule::Expression::addHighlight() {
         this->highlightId = ImHexApi::HexEditor::addForegroundHighlightingProvider([this](u64 offset, const u8 *buffer, size_t size, bool) -> std::optional<color_t>{
             // If the rule containing this expression is disabled, don't highlight anything
@@ -87,25 +107,98 @@ namespace hex::plugin::builtin {
             if (this->mathExpression.empty())
                 return std::nullopt;
 
-            // Load the bytes that are being highlighted into a variable
-            u64 value = 0;
-            std::memcpy(&value, buffer, std::min(sizeof(value), size));
-
-            // Add the value and offset variables to the evaluator
-            s_evaluator.setVariable("value", value);
-            s_evaluator.setVariable("offset", offset);
-
-            // Evaluate the expression
-            auto result = s_evaluator.evaluate(this->mathExpression);
-
-            // If the evaluator has returned a value and it's not 0, return the selected color
-            if (result.has_value() && result.value() != 0)
+            // If the expression evaluated to a value other than 0, return the selected color
+            if (this->matches(offset, buffer, size))
                 return ImGui::ColorConvertFloat4ToU32(ImVec4(this->color[0], this->color[1], this->color[2], 1.0F));
             else
                 return std::nullopt;
         });
     }
 
+    bool ViewHighlightRules::Rule::Expression::matches(u64 address, const u8 *buffer, size_t size) {
+        auto provider = ImHexApi::Provider::get();
+        if (!m_program.has_value() || provider == nullptr || size == 0 || size > sizeof(u64))
+            return this->matchesSingle(address, buffer, size);
+
+        // Drop all cached results if the data, the rules or the cell size changed since they were computed
+        if (m_cacheGeneration != s_generation || m_cacheCellSize != size) {
+            m_cachedResults.clear();
+            m_cacheGeneration = s_generation;
+            m_cacheCellSize = size;
+        }
+
+        const u64 blockSize = size * CellsPerBlock;
+        const u64 baseAddress = provider->getBaseAddress();
+        if (address < baseAddress)
+            return this->matchesSingle(address, buffer, size);
+
+        const u64 blockAddress = baseAddress + ((address - baseAddress) / blockSize) * blockSize;
+
+        // Cells that aren't aligned to the block grid, e.g. due to an odd page address, are evaluated on their own
+        if ((address - blockAddress) % size != 0)
+            return this->matchesSingle(address, buffer, size);
+
+        auto it = m_cachedResults.find(blockAddress);
+        if (it == m_cachedResults.end()) {
+            if (m_cachedResults.size() >= MaxCachedBlocks)
+                m_cachedResults.clear();
+
+            it = m_cachedResults.emplace(blockAddress, this->evaluateBlock(provider, blockAddress, size)).first;
+        }
+
+        const auto cellIndex = (address - blockAddress) / size;
+        if (cellIndex >= it->second.size())
+            return this->matchesSingle(address, buffer, size);
+
+        return it->second[cellIndex] != 0;
+    }
+
+    bool ViewHighlightRules::Rule::Expression::matchesSingle(u64 address, const u8 *buffer, size_t size) const {
+        // Load the bytes that are being highlighted into a variable
+        u64 value = 0;
+        std::memcpy(&value, buffer, std::min(sizeof(value), size));
+
+        std::optional<i128> result;
+        if (m_program.has_value()) {
+            result = m_program->evaluate(value, address);
+        } else {
+            // Fall back to the generic evaluator for expressions using features the program compiler doesn't support
+            s_evaluator.setVariable("value", value);
+            s_evaluator.setVariable("offset", address);
+
+            result = s_evaluator.evaluate(this->mathExpression);
+        }
+
+        return result.has_value() && result.value() != 0;
+    }
+
+    std::vector<u8> ViewHighlightRules::Rule::Expression::evaluateBlock(prv::Provider *provider, u64 blockAddress, size_t cellSize) const {
+        const u64 endAddress = provider->getBaseAddress() + provider->getActualSize();
+        if (blockAddress >= endAddress)
+            return { };
+
+        // Read the data of the entire block at once and only evaluate full cells
+        const auto readSize = std::min<u64>(cellSize * CellsPerBlock, endAddress - blockAddress);
+        const auto cellCount = readSize / cellSize;
+
+        std::vector<u8> bytes(readSize);
+        provider->read(blockAddress, bytes.data(), bytes.size());
+
+        std::vector<i128> values(cellCount), offsets(cellCount);
+        for (size_t i = 0; i < cellCount; i += 1) {
+            u64 value = 0;
+            std::memcpy(&value, bytes.data() + i * cellSize, cellSize);
+
+            values[i]  = value;
+            offsets[i] = blockAddress + i * cellSize;
+        }
+
+        std::vector<u8> results(cellCount);
+        m_program->evaluate(values, offsets, results);
+
+        return results;
+    }
+
     void ViewHighlightRules::Rule::Expression::removeHighlight() {
         ImHexApi::HexEditor::removeForegroundHighlightingProvider(this->highlightId);
         this->highlightId = 0;
@@ -139,10 +232,24 @@ namespace hex::plugin::builtin {
         EventProviderOpened::subscribe(this, [this](prv::Provider *provider) {
             m_selectedRule.get(provider).reset();
         });
+
+        // Invalidate all cached expression results whenever the data or the highlighting changes
+        EventHighlightingChanged::subscribe(this, [] {
+            Rule::Expression::s_generation += 1;
+        });
+        EventDataChanged::subscribe(this, [](prv::Provider *) {
+            Rule::Expression::s_generation += 1;
+        });
+        EventProviderChanged::subscribe(this, [](prv::Provider *, prv::Provider *) {
+            Rule::Expression::s_generation += 1;
+        });
     }
 
     ViewHighlightRules::~ViewHighlightRules() {
         EventProviderOpened::unsubscribe(this);
+        EventHighlightingChanged::unsubscribe(this);
+        EventDataChanged::unsubscribe(this);
+        EventProviderChanged::unsubscribe(this);
     }
 
     FileBackedProviderData<ViewHighlightRules::Rules>::SerializedData ViewHighlightRules::encodeRules(const Rules &rules) {
@@ -310,6 +417,7 @@ namespace hex::plugin::builtin {
 
                         // If any of the inputs have changed, update the highlight
                         if (updateHighlight) {
+                            expression.compile();
                             m_rules.markChanged();
                             EventHighlightingChanged::post();
                         }
@@ -3,12 +3,15 @@
 #include <hex/providers/provider.hpp>
 
 #include <hex/api/events/events_interaction.hpp>
+#include <hex/api/imhex_api/hex_editor.hpp>
 #include <nlohmann/json.hpp>
 
 #include <content/providers/undo_operations/operation_write.hpp>
 #include <content/providers/undo_operations/operation_insert.hpp>
 #include <content/providers/undo_operations/operation_remove.hpp>
+#include <content/providers/undo_operations/operation_lazy_overlay.hpp>
 
+#include <algorithm>
 #include <ranges>
 #include <string>
 
@@ -21,32 +24,39 @@ namespace hex::plugin::builtin {
         MovePerProviderData::subscribe(this, [this](prv::Provider *from, prv::Provider *to) {
              m_savedOperations.get(from) = 0;
              m_savedOperations.get(to)   = 0;
+             m_trackedOperations.get(from) = 0;
+             m_trackedOperations.get(to)   = 0;
+             m_modifiedRegions.get(from).clear();
+             m_modifiedRegions.get(to).clear();
+             ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
         });
 
-        ImHexApi::HexEditor::addForegroundHighlightingProvider([this](u64 offset, const u8* buffer, size_t, bool) -> std::optional<color_t> {
-            std::lock_guard lock(prv::undo::Stack::getMutex());
-
-            std::ignore = buffer;
-
-            if (!ImHexApi::Provider::isValid())
-                return std::nullopt;
+        // Publish the regions modified since the last save as hex editor foreground highlights
+        m_highlightSourceId = ImHexApi::HexEditor::addForegroundHighlightSource([this](const prv::Provider *provider, const Region &region) {
+            std::vector<ImHexApi::HexEditor::Highlighting> result;
+            if (!provider->isSavable() || region.getSize() == 0)
+                return result;
 
-            auto provider = ImHexApi::Provider::get();
-            if (!provider->isSavable())
-                return std::nullopt;
+            std::lock_guard lock(prv::undo::Stack::getMutex());
 
-            offset -= provider->getBaseAddress();
+            // Modified regions are stored relative to the start of the provider's data
+            const auto baseAddress = provider->getBaseAddress();
+            if (region.getEndAddress() < baseAddress)
+                return result;
 
-            if (m_modifiedAddresses->contains(offset))
-                return ImGuiExt::GetCustomColorU32(ImGuiCustomCol_Patches);
+            const auto startAddress = std::max(region.getStartAddress(), baseAddress);
+            const auto color = ImGuiExt::GetCustomColorU32(ImGuiCustomCol_Patches);
+            for (const auto &modifiedRegion : m_modifiedRegions.get(provider).getOverlapping({ startAddress - baseAddress, region.getEndAddress() - startAddress + 1 }))
+                result.emplace_back(Region { modifiedRegion.getStartAddress() + baseAddress, modifiedRegion.getSize() }, color);
 
-            return std::nullopt;
+            return result;
         });
 
         EventProviderSaved::subscribe([this](prv::Provider *provider) {
             m_savedOperations.get(provider) = provider->getUndoStack().getAppliedOperations().size();
-            m_modifiedAddresses.get(provider).clear();
-            EventHighlightingChanged::post();
+            m_trackedOperations.get(provider) = m_savedOperations.get(provider);
+            m_modifiedRegions.get(provider).clear();
+            ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
         });
 
         EventProviderDataModified::subscribe(this, [](prv::Provider *provider, u64 offset, u64 size, const u8 *data) {
@@ -57,7 +67,13 @@ namespace hex::plugin::builtin {
 
             std::vector<u8> oldData(size, 0x00);
             provider->read(offset, oldData.data(), size);
-            provider->getUndoStack().add<undo::OperationWrite>(offset, size, oldData.data(), data);
+
+            // Data written over lazy overlays replaces their result, so the overlays have to be cut out of the region first
+            std::unique_ptr<prv::undo::Operation> operation = std::make_unique<undo::OperationWrite>(offset, size, oldData.data(), data);
+            if (const Region region = { offset, size }; provider->hasLazyOverlays(region))
+                operation = std::make_unique<undo::OperationMaterializeLazyOverlays>(region, std::move(operation));
+
+            provider->getUndoStack().add(std::move(operation));
         });
 
         EventProviderDataInserted::subscribe(this, [](prv::Provider *provider, u64 offset, u64 size) {
@@ -67,49 +83,71 @@ namespace hex::plugin::builtin {
         EventProviderDataRemoved::subscribe(this, [](prv::Provider *provider, u64 offset, u64 size) {
             offset -= provider->getBaseAddress();
 
-            provider->getUndoStack().add<undo::OperationRemove>(offset, size);
+            std::unique_ptr<prv::undo::Operation> operation = std::make_unique<undo::OperationRemove>(offset, size);
+            if (const Region region = { offset, size }; provider->hasLazyOverlays(region))
+                operation = std::make_unique<undo::OperationMaterializeLazyOverlays>(region, std::move(operation));
+
+            provider->getUndoStack().add(std::move(operation));
         });
 
         EventDataChanged::subscribe(this, [this](prv::Provider *provider) {
             std::lock_guard lock(prv::undo::Stack::getMutex());
 
-            const auto &undoStack = provider->getUndoStack();
-            const auto stackSize = undoStack.getAppliedOperations().size();
+            const auto &appliedOperations = provider->getUndoStack().getAppliedOperations();
+            const auto stackSize = appliedOperations.size();
             const auto savedStackSize = m_savedOperations.get(provider);
-
-            m_modifiedAddresses.get(provider).clear();
-            if (stackSize == savedStackSize) {
-                // Do nothing
-            } else if (stackSize > savedStackSize) {
-                for (const auto &operation : undoStack.getAppliedOperations() | std::views::drop(savedStackSize)) {
-                    if (!operation->shouldHighlight())
-                        continue;
-
-                    auto region = operation->getRegion();
-                    for (u64 addr = region.getStartAddress(); addr <= region.getEndAddress(); addr++) {
-                        m_modifiedAddresses.get(provider).insert(addr);
-                    }
-                }
-            } else {
-                for (const auto &operation : undoStack.getUndoneOperations() | std::views::reverse | std::views::take(savedStackSize - stackSize)) {
-                    if (!operation->shouldHighlight())
-                        continue;
-
-                    auto region = operation->getRegion();
-                    for (u64 addr = region.getStartAddress(); addr <= region.getEndAddress(); addr++) {
-                        m_modifiedAddresses.get(provider).insert(addr);
-                    }
-                }
+            auto &trackedStackSize = m_trackedOperations.get(provider);
+
+            // In the common case of a single new operation being added or redone on top of the
+            // already tracked ones, merge its region into the set instead of rebuilding everything
+            if (stackSize == trackedStackSize + 1 && trackedStackSize >= savedStackSize) {
+                const auto &operation = appliedOperations.back();
+                if (operation->shouldHighlight())
+                    m_modifiedRegions.get(provider).insert(operation->getRegion());
+
+                trackedStackSize = stackSize;
+            } else if (stackSize != trackedStackSize) {
+                this->rebuildModifiedRegions(provider);
             }
+
+            ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
         });
     }
 
+    void ViewPatches::rebuildModifiedRegions(prv::Provider *provider) {
+        std::lock_guard lock(prv::undo::Stack::getMutex());
+
+        const auto &undoStack = provider->getUndoStack();
+        const auto stackSize = undoStack.getAppliedOperations().size();
+        const auto savedStackSize = m_savedOperations.get(provider);
+
+        auto &modifiedRegions = m_modifiedRegions.get(provider);
+        modifiedRegions.clear();
+
+        const auto addOperation = [&modifiedRegions](const auto &operation) {
+            if (operation->shouldHighlight())
+                modifiedRegions.insert(operation->getRegion());
+        };
+
+        if (stackSize > savedStackSize) {
+            for (const auto &operation : undoStack.getAppliedOperations() | std::views::drop(savedStackSize))
+                addOperation(operation);
+        } else if (stackSize < savedStackSize) {
+            for (const auto &operation : undoStack.getUndoneOperations() | std::views::reverse | std::views::take(savedStackSize - stackSize))
+                addOperation(operation);
+        }
+
+        m_trackedOperations.get(provider) = stackSize;
+    }
+
     ViewPatches::~ViewPatches() {
         MovePerProviderData::unsubscribe(this);
         EventProviderSaved::unsubscribe(this);
         EventProviderDataModified::unsubscribe(this);
         EventProviderDataInserted::unsubscribe(this);
         EventProviderDataRemoved::unsubscribe(this);
+
+        ImHexApi::HexEditor::removeForegroundHighlightSource(m_highlightSourceId);
     }
 
 
@@ -213,7 +251,7 @@ namespace hex::plugin::builtin {
             const auto &operations = provider->getUndoStack().getAppliedOperations();
             if (m_numOperations.get(provider) != operations.size()) {
                 m_numOperations.get(provider) = operations.size();
-                EventHighlightingChanged::post();
+                ImHexApi::HexEditor::invalidateHighlightSource(m_highlightSourceId);
             }
         }
     }
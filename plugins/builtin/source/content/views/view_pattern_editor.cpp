@@ -1149,19 +1149,38 @@ namespace hex::plugin::builtin {
 
 
         if (m_consoleNeedsUpdate) {
-            std::scoped_lock lock(m_logMutex);
-            auto lineCount = m_consoleEditor.get(provider).getTextLines().size();
-            if (m_console->size() < lineCount || (lineCount == 1 && m_consoleEditor.get(provider).getLineText(0).empty())) {
-                m_consoleEditor.get(provider).setText("");
-                lineCount = 0;
+            std::vector<std::string> newLines;
+            bool replaceText = false;
+            u64 bufferedLines = 0;
+
+            // Only take the lines that arrived since the last frame while holding the lock so the evaluator isn't held up
+            {
+                std::scoped_lock lock(m_logMutex);
+                auto &console = m_console.get(provider);
+
+                const auto unseenLines = console.totalLines - console.displayedLines;
+                replaceText   = unseenLines >= console.lines.size();
+                bufferedLines = console.lines.size();
+                newLines.assign(console.lines.end() - i64(std::min<u64>(unseenLines, bufferedLines)), console.lines.end());
+
+                console.displayedLines = console.totalLines;
+                m_consoleNeedsUpdate = false;
             }
 
-            const auto linesToAdd = m_console->size() - lineCount;
+            auto &consoleEditor = m_consoleEditor.get(provider);
+            if (replaceText)
+                consoleEditor.setText("");
 
-            for (size_t i = 0; i < linesToAdd; i += 1) {
-                m_consoleEditor.get(provider).appendLine(m_console->at(lineCount + i));
+            for (const auto &line : newLines) {
+                if (consoleEditor.getLongestLineLength() < line.size())
+                    consoleEditor.setLongestLineLength(line.size());
             }
-            m_consoleNeedsUpdate = false;
+            consoleEditor.appendLines(newLines);
+
+            // Lines that were dropped from the console buffer are removed from the editor as well
+            const auto excessLines = i64(consoleEditor.getLines().size()) - i64(bufferedLines);
+            if (excessLines > 0 && bufferedLines > 0)
+                consoleEditor.getLines().removeLines(0, excessLines - 1);
         }
 
         fonts::CodeEditor().push();
@@ -1809,7 +1828,10 @@ namespace hex::plugin::builtin {
         m_textEditor.get(provider).clearActionables();
 
         m_consoleEditor.get(provider).clearActionables();
-        m_console.get(provider).clear();
+        {
+            std::scoped_lock logLock(m_logMutex);
+            m_console.get(provider) = {};
+        }
         m_consoleEditor.get(provider).setLongestLineLength(0);
         m_consoleNeedsUpdate = true;
 
@@ -1833,7 +1855,8 @@ namespace hex::plugin::builtin {
             return true;
         });
 
-        TaskManager::createTask("hex.builtin.view.pattern_editor.evaluating"_unlocalized, ProgressValue::None(), [this, code, provider](auto &task) {
+        const u64 maxConsoleLines = std::max(m_consoleMaxLines.get(), 1);
+        TaskManager::createTask("hex.builtin.view.pattern_editor.evaluating"_unlocalized, ProgressValue::None(), [this, code, provider, maxConsoleLines](auto &task) {
             // Disable exception tracing to speed up evaluation
             trace::disableExceptionCaptureForCurrentThread();
 
@@ -1880,9 +1903,8 @@ namespace hex::plugin::builtin {
                 return m_dangerousFunctionsAllowed == DangerousFunctionPerms::Allow;
             });
 
-            runtime.setLogCallback([this, provider](auto level, const auto& message) {
-                std::scoped_lock lock(m_logMutex);
-
+            // Lines are only queued up here, the console editor picks up everything that arrived since the last frame at once
+            runtime.setLogCallback([this, provider, maxConsoleLines](auto level, const auto& message) {
                 auto lines = wolv::util::splitString(message, "\n");
                 for (auto &line : lines) {
                     if (!wolv::util::trim(line).empty()) {
@@ -1896,12 +1918,13 @@ namespace hex::plugin::builtin {
                             default: break;
                         }
                     }
-                    if (m_consoleEditor.get(provider).getLongestLineLength() < line.size()) {
-                        m_consoleEditor.get(provider).setLongestLineLength(line.size());
-                    }
-                    m_console.get(provider).emplace_back(line);
-                    m_consoleNeedsUpdate = true;
                 }
+
+                std::scoped_lock lock(m_logMutex);
+                auto &console = m_console.get(provider);
+                for (auto &line : lines)
+                    console.append(std::move(line), maxConsoleLines);
+                m_consoleNeedsUpdate = true;
             });
 
             ON_SCOPE_EXIT {
@@ -1913,8 +1936,9 @@ namespace hex::plugin::builtin {
                 m_lastEvaluationProcessed = false;
 
                 std::scoped_lock lock(m_logMutex);
-                m_console.get(provider).emplace_back(
-                   fmt::format("I: Evaluation took {}", std::chrono::duration<double>(runtime.getLastRunningTime()))
+                m_console.get(provider).append(
+                   fmt::format("I: Evaluation took {}", std::chrono::duration<double>(runtime.getLastRunningTime())),
+                   maxConsoleLines
                 );
                 m_consoleNeedsUpdate = true;
                 m_debuggerActive.get(provider) = false;
@@ -2042,7 +2066,12 @@ namespace hex::plugin::builtin {
                 m_textEditor.get(newProvider).setDisableCodeFolds(m_codeFoldsDisabled);
                 m_textEditor.get(newProvider).setAutoIndent(m_autoIndent);
                 m_hasUnparsedChanges.get(newProvider) = true;
-                m_consoleEditor.get(newProvider).setText(wolv::util::combineStrings(m_console.get(newProvider), "\n"));
+                {
+                    std::scoped_lock lock(m_logMutex);
+                    auto &console = m_console.get(newProvider);
+                    m_consoleEditor.get(newProvider).setText(wolv::util::combineStrings(console.getLines(), "\n"));
+                    console.displayedLines = console.totalLines;
+                }
                 m_consoleEditor.get(newProvider).getLines().setScroll(m_consoleScroll.get(newProvider));
             }
         });
@@ -2762,7 +2791,7 @@ namespace hex::plugin::builtin {
 
             auto lock = std::scoped_lock(ContentRegistry::PatternLanguage::getRuntimeLock());
 
-            auto consoleOutput = m_console.get(provider);
+            auto consoleOutput = m_console.get(provider).getLines();
 
             nlohmann::json result = {
                 { "handle", provider->getID() },
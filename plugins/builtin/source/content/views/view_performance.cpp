@@ -0,0 +1,186 @@
+#include "content/views/view_performance.hpp"
+
+#include <hex/api/content_registry/user_interface.hpp>
+#include <hex/api/imhex_api/provider.hpp>
+#include <hex/api/localization_manager.hpp>
+#include <hex/helpers/fs.hpp>
+#include <hex/helpers/utils.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <toasts/toast_notification.hpp>
+#include <fonts/vscode_icons.hpp>
+
+#include <implot.h>
+#include <wolv/io/file.hpp>
+#include <wolv/utils/guards.hpp>
+
+#include <algorithm>
+
+namespace hex::plugin::builtin {
+
+    namespace {
+
+        std::string formatDuration(double nanoseconds) {
+            if (nanoseconds < 1'000.0)
+                return fmt::format("{:.0f} ns", nanoseconds);
+            else if (nanoseconds < 1'000'000.0)
+                return fmt::format("{:.2f} µs", nanoseconds / 1'000.0);
+            else if (nanoseconds < 1'000'000'000.0)
+                return fmt::format("{:.2f} ms", nanoseconds / 1'000'000.0);
+            else
+                return fmt::format("{:.2f} s", nanoseconds / 1'000'000'000.0);
+        }
+
+        std::string getDisplayName(const prof::Statistics &statistics) {
+            switch (statistics.category) {
+                using enum prof::Category;
+                case View:
+                case MiniMap:
+                case TaskWait:
+                case TaskRun:
+                    return Lang(UnlocalizedString(statistics.name));
+                case ProviderRead:
+                case ProviderReadRaw:
+                    for (const auto &provider : ImHexApi::Provider::getProviders()) {
+                        if (provider->getID() == statistics.id)
+                            return provider->getName();
+                    }
+
+                    return fmt::format("{} #{}", statistics.name, statistics.id);
+                default:
+                    if (statistics.id != 0)
+                        return fmt::format("{} #{}", statistics.name, statistics.id);
+                    else
+                        return statistics.name;
+            }
+        }
+
+    }
+
+    ViewPerformance::ViewPerformance() : View::Floating("hex.builtin.view.performance.name"_unlocalized, ICON_VS_PULSE) {
+        ContentRegistry::UserInterface::addMenuItem({ "hex.builtin.menu.extras"_unlocalized, "hex.builtin.view.performance.name"_unlocalized }, ICON_VS_PULSE, 2550, Shortcut::None, [&, this] {
+            this->getWindowOpenState() = true;
+        });
+    }
+
+    void ViewPerformance::drawContent() {
+        bool enabled = prof::isEnabled();
+        if (ImGui::Checkbox("hex.builtin.view.performance.enabled"_lang, &enabled))
+            prof::setEnabled(enabled);
+
+        ImGui::SameLine();
+        if (ImGuiExt::DimmedButton("hex.builtin.view.performance.reset"_lang)) {
+            prof::reset();
+            m_selected.reset();
+        }
+
+        ImGui::SameLine();
+        if (ImGuiExt::DimmedButton("hex.builtin.view.performance.export_trace"_lang))
+            this->exportTrace();
+
+        ImGui::Separator();
+
+        const auto statistics = prof::getStatistics();
+
+        if (ImGui::BeginChild("##statistics", ImVec2(0, m_selected.has_value() ? -200_scaled : 0))) {
+            for (size_t i = 0; i < prof::CategoryCount; i += 1) {
+                const auto category = prof::Category(i);
+
+                const auto name = fmt::format("hex.builtin.view.performance.category.{}", prof::getCategoryName(category));
+                if (ImGui::CollapsingHeader(Lang(UnlocalizedString(name)), ImGuiTreeNodeFlags_DefaultOpen))
+                    this->drawStatisticsTable(category, statistics);
+            }
+        }
+        ImGui::EndChild();
+
+        if (m_selected.has_value())
+            this->drawHistogram(statistics);
+    }
+
+    void ViewPerformance::drawStatisticsTable(prof::Category category, const std::vector<prof::Statistics> &statistics) {
+        ImGui::PushID(int(category));
+        ON_SCOPE_EXIT { ImGui::PopID(); };
+
+        if (ImGui::BeginTable("##statistics", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.name"_lang, ImGuiTableColumnFlags_WidthStretch, 3.0F);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.count"_lang);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.total"_lang);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.mean"_lang);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.max"_lang);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.bytes"_lang);
+            ImGui::TableSetupColumn("hex.builtin.view.performance.column.throughput"_lang);
+
+            ImGui::TableHeadersRow();
+
+            for (const auto &entry : statistics) {
+                if (entry.category != category)
+                    continue;
+
+                ImGui::PushID(&entry);
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                const auto key = std::tuple(entry.category, entry.name, entry.id);
+                if (ImGui::Selectable(getDisplayName(entry).c_str(), m_selected == key, ImGuiSelectableFlags_SpanAllColumns))
+                    m_selected = key;
+
+                ImGui::TableNextColumn();
+                ImGuiExt::TextFormatted("{}", entry.count);
+                ImGui::TableNextColumn();
+                ImGuiExt::TextFormatted("{}", formatDuration(double(entry.totalNanoseconds)));
+                ImGui::TableNextColumn();
+                ImGuiExt::TextFormatted("{}", formatDuration(double(entry.totalNanoseconds) / double(entry.count)));
+                ImGui::TableNextColumn();
+                ImGuiExt::TextFormatted("{}", formatDuration(double(entry.maxNanoseconds)));
+
+                ImGui::TableNextColumn();
+                if (entry.bytes != 0)
+                    ImGuiExt::TextFormatted("{}", hex::toByteString(entry.bytes));
+                ImGui::TableNextColumn();
+                if (entry.bytes != 0 && entry.totalNanoseconds != 0)
+                    ImGuiExt::TextFormatted("{}/s", hex::toByteString(u64(double(entry.bytes) / (double(entry.totalNanoseconds) / 1'000'000'000.0))));
+
+                ImGui::PopID();
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    void ViewPerformance::drawHistogram(const std::vector<prof::Statistics> &statistics) {
+        const auto it = std::ranges::find_if(statistics, [this](const prof::Statistics &entry) {
+            return std::tie(entry.category, entry.name, entry.id) == *m_selected;
+        });
+
+        // The selected entry disappears when the statistics get reset
+        if (it == statistics.end()) {
+            m_selected.reset();
+            return;
+        }
+
+        const auto sampleCount = std::min(it->sampleCount, prof::Statistics::SampleCount);
+        if (ImPlot::BeginPlot("##histogram", ImVec2(-1, -1), ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect)) {
+            ImPlot::SetupAxes("hex.builtin.view.performance.histogram.duration"_lang, "hex.builtin.view.performance.histogram.calls"_lang, ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::PlotHistogram(getDisplayName(*it).c_str(), it->samples.data(), int(sampleCount), 32);
+
+            ImPlot::EndPlot();
+        }
+    }
+
+    void ViewPerformance::exportTrace() {
+        fs::openFileBrowser(fs::DialogMode::Save, { { "Chrome Trace", "json" } }, [](const std::fs::path &path) {
+            wolv::io::File file(path, wolv::io::File::Mode::Create);
+            if (!file.isValid()) {
+                ui::ToastError::open("hex.builtin.view.performance.export_trace.error"_lang);
+                return;
+            }
+
+            file.writeString(prof::exportChromeTrace());
+        });
+    }
+
+    void ViewPerformance::drawHelpText() {
+        ImGuiExt::TextUnformattedCentered("This view shows how much time ImHex spends drawing views, running highlighting, tooltip and minimap callbacks, reading from providers and running tasks. Profiling has to be enabled first and only slows down ImHex while it's turned on.");
+    }
+
+}
@@ -33,8 +33,10 @@ IMHEX_PLUGIN_SUBCOMMANDS() {
     { "encode",          "",  "Encode a string",                              hex::plugin::builtin::handleEncodeCommand           },
     { "decode",          "",  "Decode a string",                              hex::plugin::builtin::handleDecodeCommand           },
     { "magic",           "",  "Identify file types",                          hex::plugin::builtin::handleMagicCommand            },
+    { "analyze",         "",  "Analyze many files in parallel as JSON Lines", hex::plugin::builtin::handleAnalyzeCommand,         SubCommand::Flags::SubCommand | SubCommand::Flags::InitPlugins },
     { "pl",              "",  "Interact with the pattern language",           hex::plugin::builtin::handlePatternLanguageCommand, SubCommand::Flags::SubCommand | SubCommand::Flags::InitPlugins },
     { "hexdump",         "",  "Generate a hex dump of the provided file",     hex::plugin::builtin::handleHexdumpCommand          },
+    { "find",            "",  "Find all occurrences of a byte sequence",      hex::plugin::builtin::handleFindCommand             },
     { "demangle",        "",  "Demangle a mangled symbol",                    hex::plugin::builtin::handleDemangleCommand         },
     { "reset-settings",  "",  "Resets all settings back to default",          hex::plugin::builtin::handleSettingsResetCommand    },
     { "debug-mode",      "",  "Enables debugging features",                   hex::plugin::builtin::handleDebugModeCommand,       },
@@ -101,6 +103,7 @@ IMHEX_PLUGIN_SETUP_BUILTIN("Built-in", "WerWolv", "Default ImHex functionality")
     registerCommandForwarders();
     registerAchievements();
     registerReportGenerators();
+    registerBatchAnalyses();
     registerTutorials();
     registerDataInformationSections();
     loadWorkspaces();
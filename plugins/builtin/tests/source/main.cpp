@@ -3,13 +3,45 @@
 #include <hex/api/plugin_manager.hpp>
 #include <content/views/view_patches.hpp>
 #include <hex/api/task_manager.hpp>
+#include <hex/api/content_registry/batch_analysis.hpp>
+#include <hex/api/events/events_interaction.hpp>
+#include <hex/api/imhex_api/hex_editor.hpp>
 #include <hex/api/imhex_api/provider.hpp>
 #include <hex/api/project_manager.hpp>
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/patches.hpp>
+#include <hex/providers/undo_redo/stack.hpp>
 #include <hex/helpers/tar.hpp>
+#include <content/command_line_interface.hpp>
 #include <content/legacy_project_importer.hpp>
+#include <content/helpers/byte_regex.hpp>
+#include <content/helpers/compiled_pattern.hpp>
+#include <content/helpers/expression_program.hpp>
+#include <content/helpers/highlight_compositor.hpp>
+#include <content/helpers/occurrence_list.hpp>
+#include <content/helpers/string_extractor.hpp>
+#include <content/helpers/uniform_block_index.hpp>
+#include <content/helpers/value_searcher.hpp>
+#include <content/providers/undo_operations/operation_insert.hpp>
+#include <content/providers/undo_operations/operation_lazy_overlay.hpp>
+#include <content/providers/undo_operations/operation_remove.hpp>
+#include <content/providers/undo_operations/operation_write.hpp>
+#include <hex/test/test_provider.hpp>
 
+#include <imgui_internal.h>
 #include <nlohmann/json.hpp>
+#include <pl/core/evaluator.hpp>
+#include <pl/patterns/pattern.hpp>
 #include <wolv/io/file.hpp>
+#include <wolv/math_eval/math_evaluator.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <tuple>
 
 using namespace hex;
 using namespace hex::plugin::builtin;
@@ -50,6 +82,177 @@ TEST_SEQUENCE("Providers/InvalidResize") {
     TEST_SUCCESS();
 };
 
+TEST_SEQUENCE("Providers/UndoWrite") {
+    INIT_PLUGIN("Built-in");
+
+    auto &provider = *ImHexApi::Provider::createProvider("hex.builtin.provider.mem_file"_unlocalized, true);
+    provider.resize(0x1000);
+
+    std::mt19937 random(1234);
+    const auto makeData = [&] {
+        std::vector<u8> data(0x1000);
+        for (auto &byte : data)
+            byte = u8(random());
+
+        return data;
+    };
+    const auto readData = [&] {
+        std::vector<u8> data(provider.getActualSize());
+        provider.read(0, data.data(), data.size());
+
+        return data;
+    };
+
+    const auto oldData = makeData();
+    provider.writeRaw(0, oldData.data(), oldData.size());
+
+    // Only a small part of the data changes, the old data is stored as a delta that mostly consists of zeros
+    auto newData = oldData;
+    for (size_t i = 0x100; i < 0x120; i += 1)
+        newData[i] = ~newData[i];
+
+    prv::undo::Stack stack(&provider);
+    stack.add<undo::OperationWrite>(0, newData.size(), oldData.data(), newData.data());
+    TEST_ASSERT(readData() == newData);
+    TEST_ASSERT(stack.getMemoryUsage() < newData.size() + newData.size() / 8, "{}", stack.getMemoryUsage());
+
+    stack.undo();
+    TEST_ASSERT(readData() == oldData);
+    stack.redo();
+    TEST_ASSERT(readData() == newData);
+
+    const auto content = stack.getAppliedOperations().back()->formatContent();
+    TEST_ASSERT(content.size() == 1);
+    TEST_ASSERT(content.front().starts_with(crypt::encode16(std::vector(oldData.begin(), oldData.begin() + 64)) + " ..."));
+
+    // Going over the budget offloads the oldest operation first, which then gets read back from disk
+    const auto previousBudget = prv::undo::Stack::getMemoryBudget();
+    prv::undo::Stack::setMemoryBudget(0x2100);
+
+    const auto finalData = makeData();
+    stack.add<undo::OperationWrite>(0, finalData.size(), newData.data(), finalData.data());
+    prv::undo::Stack::setMemoryBudget(previousBudget);
+
+    const auto &operations = stack.getAppliedOperations();
+    TEST_ASSERT(operations.size() == 2);
+    TEST_ASSERT(operations[0]->getMemoryUsage() == 0);
+    TEST_ASSERT(operations[1]->getMemoryUsage() > 0);
+    TEST_ASSERT(stack.getMemoryUsage() == operations[1]->getMemoryUsage());
+
+    stack.undo(2);
+    TEST_ASSERT(readData() == oldData);
+    stack.redo(2);
+    TEST_ASSERT(readData() == finalData);
+
+    // Undone operations stop counting once a new operation replaces them
+    stack.undo();
+    stack.add<undo::OperationWrite>(0, 1, newData.data(), finalData.data());
+    TEST_ASSERT(stack.getMemoryUsage() == operations[0]->getMemoryUsage() + operations[1]->getMemoryUsage());
+
+    // Operations that replace undone ones get offloaded as well
+    prv::undo::Stack::setMemoryBudget(0);
+    for (u32 i = 0; i < 4; i += 1)
+        stack.add<undo::OperationWrite>(0, newData.size(), finalData.data(), newData.data());
+    TEST_ASSERT(stack.getMemoryUsage() == 0, "{}", stack.getMemoryUsage());
+
+    stack.undo(3);
+    stack.add<undo::OperationWrite>(0, newData.size(), finalData.data(), newData.data());
+    prv::undo::Stack::setMemoryBudget(previousBudget);
+    TEST_ASSERT(stack.getMemoryUsage() == 0, "{}", stack.getMemoryUsage());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Providers/LazyOverlay") {
+    INIT_PLUGIN("Built-in");
+
+    auto &provider = *ImHexApi::Provider::createProvider("hex.builtin.provider.mem_file"_unlocalized, true);
+    provider.resize(0x100);
+
+    std::vector<u8> originalData(0x100);
+    for (size_t i = 0; i < originalData.size(); i += 1)
+        originalData[i] = u8(i);
+    provider.writeRaw(0, originalData.data(), originalData.size());
+
+    const auto readData = [&] {
+        std::vector<u8> data(provider.getActualSize());
+        provider.read(0, data.data(), data.size());
+
+        return data;
+    };
+
+    auto xorData = originalData;
+    for (size_t i = 0x08; i < 0x28; i += 1)
+        xorData[i] ^= 0xFF;
+
+    auto fillData = xorData;
+    for (size_t i = 0x10; i < 0x30; i += 1)
+        fillData[i] = i % 2 == 0 ? 0x12 : 0x34;
+
+    auto &stack = provider.getUndoStack();
+    stack.add<undo::OperationLazyOverlay>(prv::LazyOverlay(prv::LazyOverlay::Type::Xor, { 0x08, 0x20 }, { 0xFF }));
+    stack.add<undo::OperationLazyOverlay>(prv::LazyOverlay(prv::LazyOverlay::Type::Fill, { 0x10, 0x20 }, { 0x12, 0x34 }));
+    TEST_ASSERT(readData() == fillData);
+
+    // Exported patches contain the bytes of the overlays
+    auto patches = Patches::fromProvider(&provider);
+    TEST_ASSERT(patches.has_value());
+    const auto ipsPatch = patches->toIPSPatch();
+    TEST_ASSERT(ipsPatch.has_value());
+    const auto importedPatches = Patches::fromIPSPatch(*ipsPatch);
+    TEST_ASSERT(importedPatches.has_value());
+
+    for (u64 address = 0x08; address < 0x30; address += 1) {
+        const auto &bytes = importedPatches->get();
+        TEST_ASSERT(bytes.contains(address) && bytes.at(address) == fillData[address], "address: 0x{:X}", address);
+    }
+
+    // Saving writes the overlays to the data. Undoing them afterwards restores the data they replaced
+    provider.materializeLazyOverlays();
+    TEST_ASSERT(provider.getLazyOverlays()->empty());
+    TEST_ASSERT(readData() == fillData);
+
+    stack.undo();
+    TEST_ASSERT(readData() == xorData);
+    stack.redo();
+    TEST_ASSERT(readData() == fillData);
+    TEST_ASSERT(provider.getLazyOverlays()->size() == 1);
+
+    stack.undo(2);
+    TEST_ASSERT(readData() == originalData);
+    stack.redo(2);
+    TEST_ASSERT(readData() == fillData);
+
+    // Overlays that got split up and moved before saving are restored where they were created
+    stack.add<undo::OperationInsert>(0x18, 4);
+    auto insertedData = fillData;
+    insertedData.insert(insertedData.begin() + 0x18, 4, 0x00);
+    TEST_ASSERT(readData() == insertedData);
+
+    provider.materializeLazyOverlays();
+    TEST_ASSERT(readData() == insertedData);
+
+    stack.undo();
+    TEST_ASSERT(readData() == fillData);
+    stack.undo();
+    TEST_ASSERT(readData() == xorData);
+    stack.undo();
+    TEST_ASSERT(readData() == originalData);
+
+    // Replaced data that doesn't fit into the memory budget gets offloaded while the overlays are being written
+    const auto previousBudget = prv::undo::Stack::getMemoryBudget();
+    prv::undo::Stack::setMemoryBudget(0);
+    stack.add<undo::OperationLazyOverlay>(prv::LazyOverlay(prv::LazyOverlay::Type::Xor, { 0x00, 0x100 }, { 0x55 }));
+    provider.materializeLazyOverlays();
+    prv::undo::Stack::setMemoryBudget(previousBudget);
+    TEST_ASSERT(stack.getMemoryUsage() == 0, "{}", stack.getMemoryUsage());
+
+    stack.undo();
+    TEST_ASSERT(readData() == originalData);
+
+    TEST_SUCCESS();
+};
+
 TEST_SEQUENCE("Project/ParseLegacy") {
     const auto projectPath = std::filesystem::current_path() / "legacy_project_test.hexproj";
     std::filesystem::remove(projectPath);
@@ -304,3 +507,667 @@ TEST_SEQUENCE("Project/ProviderOpenState") {
 
     TEST_SUCCESS();
 };
+
+namespace {
+
+    // Straightforward byte by byte implementation the extractor has to produce the exact same results as
+    std::vector<StringExtractor::Run> extractStringsReference(std::span<const u8> data, u64 address, StringExtractor::Encoding encoding, const std::array<bool, 256> &validCharacters, i64 minLength, bool nullTermination) {
+        using enum StringExtractor::Encoding;
+
+        std::vector<StringExtractor::Run> runs;
+        u64 startAddress = address;
+        i64 count = 0;
+        u8 remaining = 0;
+        for (size_t i = 0; i < data.size(); i += 1) {
+            const u8 byte = data[i];
+
+            bool valid = false;
+            if (encoding == ASCII) {
+                valid = validCharacters[byte];
+            } else if (encoding == UTF16LE) {
+                valid = count % 2 == 0 ? validCharacters[byte] : byte == 0x00;
+            } else if (encoding == UTF16BE) {
+                valid = count % 2 == 1 ? validCharacters[byte] : byte == 0x00;
+            } else if (remaining > 0) {
+                valid = (byte & 0xC0) == 0x80;
+                remaining = valid ? remaining - 1 : 0;
+            } else if (byte <= 0x7F) {
+                valid = validCharacters[byte];
+            } else if ((byte & 0xE0) == 0xC0) {
+                valid = byte >= 0xC2;
+                remaining = 1;
+            } else if ((byte & 0xF0) == 0xE0) {
+                valid = byte != 0xE0 && byte != 0xED;
+                remaining = 2;
+            } else if ((byte & 0xF8) == 0xF0) {
+                valid = byte <= 0xF4;
+                remaining = 3;
+            }
+
+            if (valid)
+                count += 1;
+            if (!valid || i == data.size() - 1) {
+                if (count >= minLength && (!nullTermination || byte == 0x00))
+                    runs.push_back({ startAddress, u64(count) });
+
+                startAddress += count + 1;
+                count = 0;
+            }
+        }
+
+        return runs;
+    }
+
+}
+
+TEST_SEQUENCE("Find/StringExtractor") {
+    INIT_PLUGIN("Built-in");
+
+    std::mt19937 random(1234);
+
+    std::array<std::array<bool, 256>, 2> characterSets = { };
+    for (u32 byte = 0x00; byte <= 0xFF; byte += 1) {
+        characterSets[0][byte] = std::isalnum(byte) || byte == ' ';
+        // Non-ASCII characters being valid disables the vectorized classification
+        characterSets[1][byte] = std::isalpha(byte) || byte >= 0xE0;
+    }
+
+    for (u32 iteration = 0; iteration < 200; iteration += 1) {
+        // Mostly text, mixed with null bytes, UTF-8 sequences and noise
+        std::vector<u8> data(random() % 5000);
+        for (auto &byte : data) {
+            switch (random() % 10) {
+                case 0: case 1:         byte = 0x00; break;
+                case 2:                 byte = u8(0x80 + random() % 0x80); break;
+                case 3:                 byte = u8(random()); break;
+                default:                byte = u8('a' + random() % 26); break;
+            }
+        }
+
+        const auto encoding        = StringExtractor::Encoding(random() % 4);
+        const auto &characters     = characterSets[random() % characterSets.size()];
+        const auto minLength       = i64(1 + random() % 8);
+        const auto nullTermination = random() % 2 == 0;
+        const auto baseAddress     = u64(random() % 3);
+
+        const StringExtractor extractor(encoding, characters, minLength, nullTermination);
+        const auto expected = extractStringsReference(data, baseAddress, encoding, characters, minLength, nullTermination);
+
+        TEST_ASSERT(extractor.extract(data, baseAddress) == expected, "iteration: {}", iteration);
+
+        // Small chunks to make sure strings crossing chunk boundaries are merged correctly
+        std::vector<u8> providerData(baseAddress, 0x00);
+        providerData.insert(providerData.end(), data.begin(), data.end());
+        test::TestProvider provider(&providerData);
+
+        Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+        const auto chunkSize = 1 + random() % 300;
+        TEST_ASSERT(extractor.extract(task, &provider, Region { baseAddress, data.size() }, chunkSize) == expected, "iteration: {}, chunk size: {}", iteration, chunkSize);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Find/ByteRegex") {
+    INIT_PLUGIN("Built-in");
+
+    const auto search = [](std::string_view pattern, std::string_view text) {
+        const std::vector<u8> data(text.begin(), text.end());
+        return ByteRegex(pattern).search(data, 0x00);
+    };
+
+    // Matches are leftmost-longest and never overlap
+    TEST_ASSERT(search("ab|abcd|c", "xabcdc") == std::vector<Region>({ { 1, 4 }, { 5, 1 } }));
+    TEST_ASSERT(search("a+", "aaxaaa") == std::vector<Region>({ { 0, 2 }, { 3, 3 } }));
+    TEST_ASSERT(search("a{2}", "aaaaa") == std::vector<Region>({ { 0, 2 }, { 2, 2 } }));
+    TEST_ASSERT(search("(?:ab)+c?|b", "ababxbabc") == std::vector<Region>({ { 0, 4 }, { 5, 1 }, { 6, 3 } }));
+    TEST_ASSERT(search("\\x4D\\x5A..\\x00", std::string_view("MZ\x90\xFF\x00MZ\x00", 8)) == std::vector<Region>({ { 0, 5 } }));
+    TEST_ASSERT(search("[^\\x00]+\\0", std::string_view("\x00ab\x00\x00c", 6)) == std::vector<Region>({ { 1, 3 } }));
+    TEST_ASSERT(search("[a-c\\d]{3,}", "xab1x2cab") == std::vector<Region>({ { 1, 3 }, { 5, 4 } }));
+
+    // Matches only get replaced by longer ones ending close enough to them
+    const auto extended = "ab" + std::string(ByteRegex::MaxMatchExtension - 1, 'x') + "b";
+    TEST_ASSERT(search("a.*b", extended) == std::vector<Region>({ { 0, extended.size() } }));
+    TEST_ASSERT(search("a.*b", "ab" + std::string(ByteRegex::MaxMatchExtension, 'x') + "b") == std::vector<Region>({ { 0, 2 } }));
+
+    for (const auto pattern : { "", "a*", "a|", "(a", "a)", "[a", "a{2,1}", "a*?", "^a", "(a)\\1", "\\q", "(?=a)" }) {
+        bool failed = false;
+        try {
+            ByteRegex regex(pattern);
+        } catch (const std::invalid_argument &) {
+            failed = true;
+        }
+
+        TEST_ASSERT(failed, "pattern: {}", pattern);
+    }
+
+    // Matches that keep growing are cut off the same way when scanning in chunks
+    {
+        std::mt19937 random(1234);
+        std::vector<u8> data(ByteRegex::MaxMatchExtension * 4);
+        for (size_t i = 0; i < data.size(); i += 1) {
+            const bool gap = i >= ByteRegex::MaxMatchExtension && i < ByteRegex::MaxMatchExtension * 5 / 2;
+            data[i] = gap ? 'x' : "xxxxxxxxab"[random() % 10];
+        }
+
+        const ByteRegex regex("a.*b");
+        const auto expected = regex.search(data, 0x00);
+
+        test::TestProvider provider(&data);
+        for (const size_t chunkSize : { 7, 1000, 0x4000 }) {
+            Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+            TEST_ASSERT(regex.search(task, &provider, Region { 0x00, data.size() }, chunkSize) == expected, "chunk size: {}", chunkSize);
+        }
+    }
+
+    // Scanning in small chunks has to find the same matches as scanning everything at once
+    std::mt19937 random(1234);
+    for (const auto pattern : { "[a-c]{3,}x?", "(ab|a)(c|bcd)", "a.{0,20}b", "[^x]+x\\0" }) {
+        const ByteRegex regex(pattern);
+
+        std::vector<u8> data(10'000);
+        for (auto &byte : data)
+            byte = "abcdx\x00"[random() % 6];
+
+        const auto expected = regex.search(data, 0x00);
+
+        test::TestProvider provider(&data);
+        for (const size_t chunkSize : { 1, 7, 64, 1000 }) {
+            Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+            TEST_ASSERT(regex.search(task, &provider, Region { 0x00, data.size() }, chunkSize) == expected, "pattern: {}, chunk size: {}", pattern, chunkSize);
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Find/ValueSearcher") {
+    std::mt19937 random(1234);
+    std::vector<u8> data(10'000);
+    for (auto &byte : data)
+        byte = random() % 4 == 0 ? 0x00 : u8(random());
+
+    test::TestProvider provider(&data);
+    const auto region = Region { .address = 0x11, .size = data.size() - 0x33 };
+
+    // Compares the searcher against decoding every value on its own
+    const auto check = [&]<typename T>(T min, T max) {
+        for (const auto endian : { std::endian::little, std::endian::big }) {
+            for (const u64 stride : { u64(1), u64(sizeof(T)), u64(3) }) {
+                std::vector<u64> expected;
+                for (u64 address = region.getStartAddress(); address + sizeof(T) - 1 <= region.getEndAddress(); address += stride) {
+                    T value;
+                    std::memcpy(&value, data.data() + address, sizeof(T));
+                    value = hex::changeEndianness(value, endian);
+
+                    if (value >= min && value <= max)
+                        expected.push_back(address);
+                }
+
+                Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+                TEST_ASSERT(ValueSearcher<T>(min, max, endian).findAll(task, &provider, region, stride, 0x100) == expected, "size: {}, stride: {}", sizeof(T), stride);
+            }
+        }
+
+        return EXIT_SUCCESS;
+    };
+
+    TEST_ASSERT(check(u8(0x10), u8(0x80)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(i8(-20), i8(20)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(u16(0x100), u16(0xF000)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(i16(-1000), i16(0)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(u32(0), u32(0x00FF'FFFF)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(i32(-0x10000), i32(0x7FFF'0000)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(u64(0x8000'0000'0000'0000), u64(0xF000'0000'0000'0000)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(i64(-0x1000'0000'0000'0000), i64(0x10)) == EXIT_SUCCESS);
+    TEST_ASSERT(check(-100.0F, 100.0F) == EXIT_SUCCESS);
+    TEST_ASSERT(check(0.0, 1.0E100) == EXIT_SUCCESS);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Find/OccurrenceList") {
+    using Occurrence = OccurrenceList::Occurrence;
+
+    std::mt19937 random(1234);
+    std::vector<Occurrence> occurrences;
+    for (u32 i = 0; i < 2000; i += 1) {
+        occurrences.push_back(Occurrence {
+            Region { .address = random() % 0x10000, .size = 1 + random() % 0x200 },
+            random() % 2 == 0 ? std::endian::little : std::endian::big,
+            Occurrence::DecodeType(random() % 8),
+            random() % 2 == 0,
+            random() % 4 == 0 ? fmt::format("label{}", random() % 10) : ""
+        });
+    }
+
+    OccurrenceList list;
+    for (const auto &occurrence : occurrences)
+        list.push_back(occurrence);
+
+    TEST_ASSERT(list.size() == occurrences.size());
+    for (size_t i = 0; i < occurrences.size(); i += 1) {
+        const auto &expected = occurrences[i];
+        const auto occurrence = list[i];
+
+        TEST_ASSERT(occurrence.region == expected.region, "index: {}", i);
+        TEST_ASSERT(occurrence.endian == expected.endian, "index: {}", i);
+        TEST_ASSERT(occurrence.decodeType == expected.decodeType, "index: {}", i);
+        TEST_ASSERT(occurrence.selected == expected.selected, "index: {}", i);
+        TEST_ASSERT(occurrence.string == expected.string, "index: {}", i);
+    }
+
+    list.sort();
+    std::ranges::stable_sort(occurrences, {}, [](const Occurrence &occurrence) { return occurrence.region.getStartAddress(); });
+    for (size_t i = 0; i < occurrences.size(); i += 1)
+        TEST_ASSERT(list[i].region == occurrences[i].region && list[i].string == occurrences[i].string, "index: {}", i);
+
+    // Overlap lookups have to find exactly the occurrences a linear scan finds
+    for (u32 i = 0; i < 500; i += 1) {
+        const auto region = Region { .address = random() % 0x10400, .size = 1 + random() % 0x100 };
+
+        std::vector<u32> expected;
+        for (u32 j = 0; j < occurrences.size(); j += 1) {
+            if (occurrences[j].region.overlaps(region))
+                expected.push_back(j);
+        }
+
+        TEST_ASSERT(list.findOverlapping(region) == expected, "region: 0x{:X}, 0x{:X}", region.getStartAddress(), region.getSize());
+        TEST_ASSERT(list.hasOverlapping(region) == !expected.empty(), "region: 0x{:X}, 0x{:X}", region.getStartAddress(), region.getSize());
+    }
+
+    // Sizes are only stored per occurrence once they differ, sizes that don't fit into the column are stored separately
+    const std::vector<std::pair<u64, u64>> sizedRegions = { { 0x40, 4 }, { 0x10, 4 }, { 0x30, 0x1'0000'0000 }, { 0x20, 4 } };
+
+    OccurrenceList sizedList;
+    for (const auto &[address, size] : sizedRegions)
+        sizedList.push_back(Occurrence { Region { .address = address, .size = size }, std::endian::native, Occurrence::DecodeType::Binary, false, "" });
+    sizedList.sort();
+
+    TEST_ASSERT(sizedList[0].region.getStartAddress() == 0x10 && sizedList[0].region.getSize() == 4);
+    TEST_ASSERT(sizedList[2].region.getStartAddress() == 0x30 && sizedList[2].region.getSize() == 0x1'0000'0000);
+    TEST_ASSERT(sizedList[3].region.getStartAddress() == 0x40 && sizedList[3].region.getSize() == 4);
+    TEST_ASSERT(sizedList[3].endian == std::endian::native);
+    TEST_ASSERT((sizedList.findOverlapping({ .address = 0x1000, .size = 1 }) == std::vector<u32> { 2 }));
+
+    // The filter index may report too many candidates but never miss a match
+    const auto decode = [](const Occurrence &occurrence) { return fmt::format("{:X}_{}", occurrence.region.getStartAddress(), occurrence.string); };
+
+    Task task("hex.builtin.task.indexing_results"_unlocalized, ProgressValue::Count(list.size()), true, false, [](Task &) { });
+    OccurrenceFilterIndex index;
+    TEST_ASSERT(index.build(task, list, decode));
+    TEST_ASSERT(!index.getCandidates("ab").has_value());
+
+    for (const std::string filter : { "abc", "LABEL3", "_label", "1234", "ffff_" }) {
+        const auto candidates = index.getCandidates(filter);
+        TEST_ASSERT(candidates.has_value(), "filter: {}", filter);
+
+        for (u32 i = 0; i < list.size(); i += 1) {
+            const auto occurrence = list[i];
+            if (hex::containsIgnoreCase(decode(occurrence), filter))
+                TEST_ASSERT(std::ranges::binary_search(*candidates, i), "filter: {}, index: {}", filter, i);
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Find/UniformBlockIndex") {
+    INIT_PLUGIN("Built-in");
+    TaskManager::init();
+
+    constexpr static u64 BlockSize = UniformBlockIndex::MinBlockSize;
+
+    auto &provider = *ImHexApi::Provider::createProvider("hex.builtin.provider.mem_file"_unlocalized, true);
+    provider.resize(BlockSize * 64);
+
+    // Zero filled blocks, followed by a single mixed block and erased blocks
+    std::mt19937 random(1234);
+    std::vector<u8> data(BlockSize * 64, 0x00);
+    std::fill(data.begin() + BlockSize * 33, data.end(), 0xFF);
+    for (u64 i = BlockSize * 32; i < BlockSize * 33; i += 1)
+        data[i] = u8(random());
+    provider.writeRaw(0, data.data(), data.size());
+
+    const auto index = UniformBlockIndex::get(&provider);
+    TEST_ASSERT(index != nullptr);
+
+    // Waits for the index to catch up and then compares it with the states a linear scan finds
+    const auto matchesData = [&] {
+        while (index->isIndexing())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const auto blocks = index->getBlocks();
+        if (blocks->getDataSize() != data.size() || blocks->getBlockSize() != BlockSize)
+            return false;
+
+        for (u64 i = 0; i < blocks->getBlockCount(); i += 1) {
+            const auto begin = data.begin() + i * BlockSize;
+            const auto end   = data.begin() + std::min<u64>((i + 1) * BlockSize, data.size());
+            const auto state = std::all_of(begin, end, [&](u8 byte) { return byte == *begin; }) ? UniformBlockIndex::BlockState(*begin) : UniformBlockIndex::Mixed;
+
+            if (blocks->getState(i) != state)
+                return false;
+        }
+
+        return true;
+    };
+    TEST_ASSERT(matchesData());
+
+    // Only runs of blocks that don't contain any of the searched bytes get skipped
+    std::array<bool, 256> usedBytes = { };
+    usedBytes['A'] = true;
+    TEST_ASSERT(index->getCandidateRegions(0x1000, { 0x1000 + 100, data.size() - 100 }, usedBytes) == std::vector<Region>({ { 0x1000 + 100, BlockSize - 100 }, { 0x1000 + BlockSize * 32, BlockSize } }));
+    usedBytes[0x00] = true;
+    TEST_ASSERT(index->getCandidateRegions(0x1000, { 0x1000, data.size() }, usedBytes) == std::vector<Region>({ { 0x1000, BlockSize * 33 } }));
+    TEST_ASSERT(index->getCandidateRegions(0x1000, { 0x1000 + BlockSize * 34, BlockSize * 10 }, usedBytes) == std::vector<Region>({ { 0x1000 + BlockSize * 34, BlockSize * 10 } }));
+
+    auto &stack = provider.getUndoStack();
+
+    // Writes only invalidate the blocks they touch
+    auto newData = data;
+    std::fill_n(newData.begin() + BlockSize * 5 + 10, 20, 0xAA);
+    std::fill_n(newData.begin() + BlockSize * 40, BlockSize, 0x00);
+    stack.add<undo::OperationWrite>(0, data.size(), data.data(), newData.data());
+    std::swap(data, newData);
+    TEST_ASSERT(matchesData());
+
+    stack.undo();
+    std::swap(data, newData);
+    TEST_ASSERT(matchesData());
+
+    // Inserting and removing data rebuilds the index for the new size
+    stack.add<undo::OperationInsert>(BlockSize * 10 + 5, BlockSize * 3);
+    data.insert(data.begin() + BlockSize * 10 + 5, BlockSize * 3, 0x00);
+    TEST_ASSERT(matchesData());
+
+    stack.add<undo::OperationRemove>(BlockSize * 30, BlockSize * 5 + 7);
+    const std::vector<u8> removedData(data.begin() + BlockSize * 30, data.begin() + BlockSize * 35 + 7);
+    data.erase(data.begin() + BlockSize * 30, data.begin() + BlockSize * 35 + 7);
+    TEST_ASSERT(matchesData());
+
+    stack.undo();
+    data.insert(data.begin() + BlockSize * 30, removedData.begin(), removedData.end());
+    TEST_ASSERT(matchesData());
+
+    stack.undo();
+    data.erase(data.begin() + BlockSize * 10 + 5, data.begin() + BlockSize * 13 + 5);
+    TEST_ASSERT(matchesData());
+
+    // Changes that don't come from a single operation, like reloading the provider, reindex all blocks
+    std::fill_n(data.begin() + BlockSize * 50, BlockSize * 2, 0x42);
+    provider.writeRaw(BlockSize * 50, data.data() + BlockSize * 50, BlockSize * 2);
+    EventDataChanged::post(&provider);
+    TEST_ASSERT(matchesData());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("HighlightRules/ExpressionProgram") {
+    // The compiled program has to produce the same results as the tree-walking evaluator it replaces
+    const auto check = [](const std::string &expression, i64 value, i64 offset) {
+        wolv::math_eval::MathEvaluator<i128> evaluator;
+        evaluator.setVariable("value", value);
+        evaluator.setVariable("offset", offset);
+        const auto expected = evaluator.evaluate(expression);
+
+        const auto program = ExpressionProgram::compile(expression);
+        TEST_ASSERT(program.has_value(), "expression: {}", expression);
+        TEST_ASSERT(program->evaluate(value, offset) == expected, "expression: {}, value: {}, offset: {}", expression, value, offset);
+
+        return EXIT_SUCCESS;
+    };
+
+    constexpr static std::array Expressions = {
+        // Arithmetic and precedence
+        "1 + 2 * 3", "(1 + 2) * 3", "10 - 3 - 2", "100 / 10 / 5", "17 % 5 + 1", "-17 / 5", "-17 % 5",
+        "2 * 3 + 4 * 5", "1 << 4 + 1", "256 >> 2 >> 1", "6 & 3 | 8 ^ 12", "1 | 2 & 3", "1 + 2 == 3", "3 > 2 == 1",
+        "1 < 2 && 2 < 3 || 0", "0 || 1 && 0", "!0 + ~5 + -3", "-(4 - 10) * 2",
+
+        // Variables
+        "value + offset", "value * 2 + offset % 7", "(value >> 4) == offset", "value != 0 && offset >= 16",
+        "value <= offset || value > 100", "value & offset", "-value / 3",
+
+        // Errors
+        "value / offset", "value % offset", "1 / 0", "1 % (offset - offset)",
+    };
+
+    constexpr static std::array<std::pair<i64, i64>, 6> Inputs = {{
+        { 0, 0 }, { 1, 16 }, { 255, 3 }, { -7, 100 }, { 12345, -9 }, { 0x7FFF'FFFF, 0 }
+    }};
+
+    for (const auto expression : Expressions) {
+        for (const auto &[value, offset] : Inputs)
+            TEST_ASSERT(check(expression, value, offset) == EXIT_SUCCESS);
+    }
+
+    // Anything the program can't handle has to be rejected so the tree-walking evaluator gets used instead
+    for (const auto expression : { "", "1 +", "(1 + 2", "1 + 2)", "foo + 1", "value ** 2", "1 2", "0x", "0b102", "value = 1" })
+        TEST_ASSERT(!ExpressionProgram::compile(expression).has_value(), "expression: {}", expression);
+
+    TEST_ASSERT(ExpressionProgram::compile("0x10 + 0b11 + 0o7")->evaluate(0, 0) == 26);
+
+    // Evaluating many inputs at once has to match evaluating them one by one, including inputs that fail
+    std::mt19937 random(1234);
+    std::vector<i128> values(1000), offsets(1000);
+    for (size_t i = 0; i < values.size(); i += 1) {
+        values[i]  = i128(random() % 1000) - 500;
+        offsets[i] = i128(random() % 10);
+    }
+
+    for (const auto expression : { "value / offset + value % 3 > 2", "value * offset", "!(value & 1) || offset == 4" }) {
+        const auto program = ExpressionProgram::compile(expression);
+        TEST_ASSERT(program.has_value(), "expression: {}", expression);
+
+        std::vector<u8> results(values.size());
+        program->evaluate(values, offsets, results);
+
+        for (size_t i = 0; i < values.size(); i += 1) {
+            const auto result = program->evaluate(values[i], offsets[i]);
+            TEST_ASSERT(results[i] == (result.has_value() && *result != 0), "expression: {}, index: {}", expression, i);
+        }
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("HexEditor/HighlightCompositor") {
+    using Highlighting = ImHexApi::HexEditor::Highlighting;
+    using Run = ui::HexEditor::HighlightRun;
+
+    std::vector<u8> data(0x1000);
+    test::TestProvider provider(&data);
+
+    constexpr static color_t Red = 0xFF0000FF, Green = 0xFF00FF00, Blue = 0xFFFF0000;
+
+    const auto runsEqual = [](std::span<const Run> runs, const std::vector<Run> &expected) {
+        return std::ranges::equal(runs, expected, [](const Run &left, const Run &right) {
+            return left.region == right.region && left.color == right.color;
+        });
+    };
+
+    u32 queryCount = 0;
+    std::vector<Highlighting> sourceHighlights = {
+        { { .address = 0x0F8, .size = 0x10 }, Red },
+        { { .address = 0x104, .size = 0x10 }, Green },
+        { { .address = 0x200, .size = 0x10 }, Blue },
+    };
+    const auto sourceId = ImHexApi::HexEditor::addBackgroundHighlightSource([&](const prv::Provider *, const Region &) {
+        queryCount += 1;
+        return sourceHighlights;
+    });
+
+    // Overlapping background highlights get blended and everything is clipped to the visible region
+    HighlightCompositor background(HighlightCompositor::Layer::Background);
+    const Region visibleRegion = { .address = 0x100, .size = 0x40 };
+    const color_t blended = *blendColors(blendColors(std::nullopt, ImColor(Red)), ImColor(Green));
+
+    TEST_ASSERT(runsEqual(background.resolve(&provider, visibleRegion), {
+        { { .address = 0x100, .size = 0x04 }, Red },
+        { { .address = 0x104, .size = 0x04 }, blended },
+        { { .address = 0x108, .size = 0x0C }, Green },
+    }));
+
+    // Runs are only rebuilt if something changed
+    std::ignore = background.resolve(&provider, visibleRegion);
+    TEST_ASSERT(queryCount == 1);
+
+    sourceHighlights.push_back({ { .address = 0x114, .size = 0x04 }, Green });
+    ImHexApi::HexEditor::invalidateHighlightSource(sourceId);
+    TEST_ASSERT(runsEqual(background.resolve(&provider, visibleRegion), {
+        { { .address = 0x100, .size = 0x04 }, Red },
+        { { .address = 0x104, .size = 0x04 }, blended },
+        { { .address = 0x108, .size = 0x10 }, Green },
+    }));
+    TEST_ASSERT(queryCount == 2);
+
+    // Runs are byte-granular. The hex editor colors a cell as soon as any of its bytes is covered by a run, which applies to
+    // all sources including bookmarks. Before, bookmarks only highlighted cells that lay entirely within them
+    sourceHighlights = { { { .address = 0x111, .size = 0x02 }, Blue } };
+    ImHexApi::HexEditor::invalidateHighlightSource(sourceId);
+    TEST_ASSERT(runsEqual(background.resolve(&provider, visibleRegion), {
+        { { .address = 0x111, .size = 0x02 }, Blue },
+    }));
+
+    // Static highlights are included and hovered regions get emphasized
+    const auto highlightId = ImHexApi::HexEditor::addBackgroundHighlight({ .address = 0x120, .size = 0x08 }, Red);
+    background.invalidate();
+    TEST_ASSERT(runsEqual(background.resolve(&provider, visibleRegion, { { .address = 0x124, .size = 0x10 } }), {
+        { { .address = 0x111, .size = 0x02 }, Blue },
+        { { .address = 0x120, .size = 0x04 }, Red },
+        { { .address = 0x124, .size = 0x04 }, ImAlphaBlendColors(Red, 0xA0FFFFFF) },
+    }));
+
+    ImHexApi::HexEditor::removeBackgroundHighlight(highlightId);
+    ImHexApi::HexEditor::removeBackgroundHighlightSource(sourceId);
+    background.invalidate();
+    TEST_ASSERT(background.resolve(&provider, visibleRegion).empty());
+
+    // Foreground colors can't be blended, the source that was registered first wins
+    const auto firstId = ImHexApi::HexEditor::addForegroundHighlightSource([](const prv::Provider *, const Region &) {
+        return std::vector<Highlighting> { { { .address = 0x10, .size = 0x10 }, Red } };
+    });
+    const auto secondId = ImHexApi::HexEditor::addForegroundHighlightSource([](const prv::Provider *, const Region &) {
+        return std::vector<Highlighting> { { { .address = 0x08, .size = 0x20 }, Green } };
+    });
+
+    HighlightCompositor foreground(HighlightCompositor::Layer::Foreground);
+    TEST_ASSERT(runsEqual(foreground.resolve(&provider, { .address = 0x00, .size = 0x100 }), {
+        { { .address = 0x08, .size = 0x08 }, Green },
+        { { .address = 0x10, .size = 0x10 }, Red },
+        { { .address = 0x20, .size = 0x08 }, Green },
+    }));
+
+    ImHexApi::HexEditor::removeForegroundHighlightSource(firstId);
+    ImHexApi::HexEditor::removeForegroundHighlightSource(secondId);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatternLanguage/CompiledPattern") {
+    const std::array<u8, 2> data = { 0x12, 0x34 };
+
+    pl::PatternLanguage runtime;
+    runtime.setDataSource(0x00, data.size(), [&](u64 offset, u8 *buffer, size_t size) {
+        std::memcpy(buffer, data.data() + offset, size);
+    });
+    runtime.setDefaultEndian(std::endian::little);
+
+    const auto bigEndian     = CompiledPattern::compile(runtime, "#pragma endian big\nu16 value @ 0x00;");
+    const auto defaultEndian = CompiledPattern::compile(runtime, "u16 value @ 0x00;");
+    TEST_ASSERT(bigEndian.has_value() && defaultEndian.has_value());
+
+    const auto execute = [&](const CompiledPattern &pattern) -> std::optional<u128> {
+        if (!pattern.execute(runtime, {}))
+            return std::nullopt;
+
+        const auto &patterns = runtime.getInternals().evaluator->getPatterns();
+        if (patterns.size() != 1)
+            return std::nullopt;
+
+        return patterns.front()->getValue().toUnsigned();
+    };
+
+    // Pragmas have to be applied again on every run and must not leak into code that doesn't use them
+    for (u32 i = 0; i < 2; i += 1) {
+        TEST_ASSERT(execute(*bigEndian) == 0x1234, "run: {}", i);
+        TEST_ASSERT(execute(*defaultEndian) == 0x3412, "run: {}", i);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("CommandLine/MatchesGlob") {
+    constexpr static std::array<std::tuple<std::string_view, std::string_view, bool>, 20> Cases = {{
+        { "*.bin",          "file.bin",             true  },
+        { "*.bin",          "file.bin.bak",         false },
+        { "*.bin",          "dir/file.bin",         false },
+        { "file.???",       "file.bin",             true  },
+        { "file.???",       "file.bi",              false },
+        { "?",              "/",                    false },
+        { "dir/*",          "dir/file",             true  },
+        { "dir/*",          "dir/sub/file",         false },
+        { "**",             "dir/sub/file",         true  },
+        { "**",             "",                     true  },
+        { "**/*.bin",       "file.bin",             true  },
+        { "**/*.bin",       "dir/sub/file.bin",     true  },
+        { "**/*.bin",       "dir/sub/file.txt",     false },
+        { "dir/**/file",    "dir/file",             true  },
+        { "dir/**/file",    "dir/a/b/file",         true  },
+        { "dir/**/file",    "other/a/file",         false },
+        { "*",              "",                     true  },
+        { "",               "",                     true  },
+        { "",               "file",                 false },
+        { "*a*b*",          "xxaxxbxx",             true  },
+    }};
+
+    for (const auto &[pattern, string, expected] : Cases)
+        TEST_ASSERT(matchesGlob(pattern, string) == expected, "pattern: {}, string: {}", pattern, string);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("CommandLine/Analyze") {
+    INIT_PLUGIN("Built-in");
+
+    // Invalid job counts are rejected instead of throwing
+    for (const auto &jobs : { "--jobs=", "--jobs=abc", "--jobs=0", "--jobs=4x", "--jobs=-1", "--jobs=99999999999" }) {
+        const std::array<std::string, 2> args = { jobs, "file.bin" };
+        TEST_ASSERT(handleAnalyzeCommand(args) == EXIT_FAILURE, "{}", jobs);
+    }
+
+    const auto &analyses = ContentRegistry::BatchAnalysis::impl::getAnalyses();
+    const auto hashes = std::ranges::find(analyses, "hashes", &ContentRegistry::BatchAnalysis::impl::Analysis::name);
+    TEST_ASSERT(hashes != analyses.end());
+
+    // Data spanning multiple chunks so every hash has to be fed more than once
+    std::vector<u8> data(3 * 1024 * 1024 + 123);
+    std::mt19937 random(0x1337);
+    for (auto &byte : data)
+        byte = u8(random());
+
+    test::TestProvider testProvider(&data);
+    prv::Provider *provider = &testProvider;
+
+    // All hashes are calculated in a single pass and have to match the ones calculated on their own
+    const auto result = hashes->callback(provider, "md5,sha1,sha224,sha256,sha384,sha512,crc32");
+    const auto encode = [](const auto &hash) { return wolv::util::toLower(crypt::encode16({ hash.begin(), hash.end() })); };
+
+    TEST_ASSERT(result["md5"]    == encode(crypt::md5(provider, 0, data.size())));
+    TEST_ASSERT(result["sha1"]   == encode(crypt::sha1(provider, 0, data.size())));
+    TEST_ASSERT(result["sha224"] == encode(crypt::sha224(provider, 0, data.size())));
+    TEST_ASSERT(result["sha256"] == encode(crypt::sha256(provider, 0, data.size())));
+    TEST_ASSERT(result["sha384"] == encode(crypt::sha384(provider, 0, data.size())));
+    TEST_ASSERT(result["sha512"] == encode(crypt::sha512(provider, 0, data.size())));
+    TEST_ASSERT(result["crc32"]  == fmt::format("{:08x}", crypt::crc32(provider, 0, data.size(), 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true)));
+
+    bool threw = false;
+    try {
+        std::ignore = hashes->callback(provider, "md5,md4");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    TEST_ASSERT(threw);
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <fonts/vscode_icons.hpp>
+#include <hex/api/task_manager.hpp>
+#include <hex/providers/cached_provider.hpp>
+
+#include <wolv/io/file.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hex::plugin::decompress {
+
+    /**
+     * @brief Read-only provider that exposes the decompressed contents of a gzip, zlib, xz or zstd file.
+     * A single pass over the file records checkpoints from which decompression can be resumed, so reading
+     * any offset only needs to decompress the data between the closest checkpoint before it and the offset itself.
+     * The checkpoints are stored next to the file so opening it again doesn't need another pass.
+     * That pass runs as a task after opening the file, the provider stays empty until it's done
+     */
+    class CompressedStreamProvider : public prv::CachedProvider,
+                                     public prv::IProviderDataDescription,
+                                     public prv::IProviderFilePicker {
+    public:
+        enum class Format : u8 {
+            Unknown = 0,
+            Deflate = 1,
+            XZ      = 2,
+            Zstd    = 3
+        };
+
+        struct Checkpoint {
+            u64 uncompressedOffset = 0;
+            u64 compressedOffset = 0;
+
+            // Whether decoding starts at the beginning of a gzip member, xz block or zstd frame here
+            bool streamStart = false;
+
+            // Format specific value. Number of bits of the previous byte belonging to the next deflate block or the xz check type
+            u8 parameter = 0;
+
+            // Last 32KiB of decompressed data before a deflate checkpoint that's inside of a stream
+            std::vector<u8> window;
+        };
+
+        class Decoder;
+
+        CompressedStreamProvider();
+        ~CompressedStreamProvider() override;
+
+        [[nodiscard]] bool isAvailable() const override { return m_file.isValid(); }
+        [[nodiscard]] bool isReadable() const override { return true; }
+        [[nodiscard]] bool isWritable() const override { return false; }
+        [[nodiscard]] bool isResizable() const override { return false; }
+        [[nodiscard]] bool isSavable() const override { return false; }
+
+        [[nodiscard]] OpenResult open() override;
+        void close() override;
+
+        [[nodiscard]] bool isIndexing() const { return m_indexTask.isRunning(); }
+
+        [[nodiscard]] std::string getName() const override;
+        [[nodiscard]] std::vector<Description> getDataDescription() const override;
+
+        [[nodiscard]] std::vector<fs::ItemFilter> getValidExtensions() const override;
+        [[nodiscard]] bool canOpenFile(const std::fs::path &path) const override;
+
+        void loadSettings(const nlohmann::json &settings) override;
+        [[nodiscard]] nlohmann::json storeSettings(nlohmann::json settings) const override;
+
+        [[nodiscard]] UnlocalizedString getTypeName() const override {
+            return "hex.decompress.provider.compressed_stream"_unlocalized;
+        }
+
+        [[nodiscard]] const char* getIcon() const override {
+            return ICON_VS_FILE_ZIP;
+        }
+
+    protected:
+        void readFromSource(u64 offset, void *buffer, size_t size) override;
+        void writeToSource(u64 offset, const void *buffer, size_t size) override;
+        [[nodiscard]] u64 getSourceSize() const override;
+
+    private:
+        [[nodiscard]] std::fs::path getIndexPath() const;
+        [[nodiscard]] bool loadIndex();
+        void storeIndex() const;
+        void buildIndex(Task &task);
+
+        size_t decode(u8 *buffer, size_t size);
+
+    private:
+        wolv::io::File m_file;
+        Format m_format = Format::Unknown;
+
+        std::vector<Checkpoint> m_checkpoints;
+        std::atomic<u64> m_uncompressedSize = 0;
+        TaskHolder m_indexTask;
+
+        mutable std::mutex m_decoderMutex;
+        std::unique_ptr<Decoder> m_decoder;
+        bool m_decoderValid = false;
+        size_t m_checkpointIndex = 0;
+        u64 m_position = 0;
+    };
+
+}
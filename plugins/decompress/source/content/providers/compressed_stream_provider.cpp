@@ -0,0 +1,855 @@
+#include <content/providers/compressed_stream_provider.hpp>
+
+#include <hex/api/localization_manager.hpp>
+#include <hex/api/events/events_interaction.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/logger.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <nlohmann/json.hpp>
+#include <toasts/toast_notification.hpp>
+
+#include <wolv/literals.hpp>
+#include <wolv/utils/guards.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#if IMHEX_FEATURE_ENABLED(ZLIB)
+    #include <zlib.h>
+#endif
+#if IMHEX_FEATURE_ENABLED(LIBLZMA)
+    #include <lzma.h>
+#endif
+#if IMHEX_FEATURE_ENABLED(ZSTD)
+    #define ZSTD_STATIC_LINKING_ONLY
+    #include <zstd.h>
+#endif
+
+namespace hex::plugin::decompress {
+
+    using namespace wolv::literals;
+
+    /**
+     * @brief Format specific part of the provider. Builds the checkpoint index and decodes data starting at a checkpoint
+     */
+    class CompressedStreamProvider::Decoder {
+    public:
+        explicit Decoder(wolv::io::File &file) : m_file(file), m_fileSize(file.getSize()), m_input(InputChunkSize) { }
+        virtual ~Decoder() = default;
+
+        /**
+         * @brief Decodes the entire file once and records all checkpoints
+         * @param task Task the index is built on, updated with the number of compressed bytes processed so far
+         * @param uncompressedSize Set to the total size of the decompressed data
+         * @return Checkpoints sorted by their offsets. The first one is always at the start of the data
+         * @throws std::runtime_error if the data is invalid
+         */
+        virtual std::vector<Checkpoint> buildIndex(Task &task, u64 &uncompressedSize) = 0;
+
+        /**
+         * @brief Continues decoding from a checkpoint
+         * @param checkpoint Checkpoint to continue at
+         * @return Whether decoding can continue there
+         */
+        virtual bool seek(const Checkpoint &checkpoint) = 0;
+
+        /**
+         * @brief Decodes the next bytes after the current position
+         * @param buffer Buffer to decode into
+         * @param size Size of the buffer
+         * @return Number of bytes decoded. Zero once the current gzip member, xz block or zstd frame ended or the data is invalid
+         */
+        virtual size_t decode(u8 *buffer, size_t size) = 0;
+
+    protected:
+        constexpr static auto InputChunkSize = 64_KiB;
+
+        std::span<u8> readInput() {
+            const auto size = std::min<u64>(m_input.size(), m_fileSize - std::min(m_inputOffset, m_fileSize));
+            if (size > 0)
+                m_file.readBufferAtomic(m_inputOffset, m_input.data(), size);
+
+            m_inputOffset += size;
+            return { m_input.data(), size };
+        }
+
+        wolv::io::File &m_file;
+        u64 m_fileSize;
+
+        std::vector<u8> m_input;
+        u64 m_inputOffset = 0;
+    };
+
+    namespace {
+
+        using Checkpoint = CompressedStreamProvider::Checkpoint;
+        using Format = CompressedStreamProvider::Format;
+
+        #if IMHEX_FEATURE_ENABLED(ZLIB)
+
+            /**
+             * @brief Deflate checkpoints are placed at block boundaries and store the last 32KiB of decompressed data
+             * since following blocks can refer back to it. Concatenated gzip members each get an additional checkpoint
+             */
+            class DeflateDecoder : public CompressedStreamProvider::Decoder {
+            public:
+                explicit DeflateDecoder(wolv::io::File &file) : Decoder(file) { }
+                ~DeflateDecoder() override { this->end(); }
+
+                std::vector<Checkpoint> buildIndex(Task &task, u64 &uncompressedSize) override {
+                    std::vector<Checkpoint> checkpoints = { { .uncompressedOffset = 0, .compressedOffset = 0, .streamStart = true, .parameter = 0, .window = {} } };
+
+                    this->end();
+                    if (inflateInit2(&m_stream, AutoDetectHeader) != Z_OK)
+                        throw std::runtime_error("Failed to initialize zlib");
+                    m_initialized = true;
+                    m_inputOffset = 0;
+
+                    // Decompressed data is only needed for the window, so it's decompressed into a ring buffer of that size
+                    std::vector<u8> window(WindowSize);
+                    u64 totalIn = 0, totalOut = 0, lastCheckpoint = 0;
+                    while (true) {
+                        if (m_stream.avail_in == 0) {
+                            task.update(m_inputOffset);
+
+                            const auto input = this->readInput();
+                            if (input.empty())
+                                throw std::runtime_error("Unexpected end of compressed data");
+
+                            m_stream.next_in  = input.data();
+                            m_stream.avail_in = input.size();
+                        }
+
+                        if (m_stream.avail_out == 0) {
+                            m_stream.next_out  = window.data();
+                            m_stream.avail_out = window.size();
+                        }
+
+                        totalIn  += m_stream.avail_in;
+                        totalOut += m_stream.avail_out;
+                        const auto result = inflate(&m_stream, Z_BLOCK);
+                        totalIn  -= m_stream.avail_in;
+                        totalOut -= m_stream.avail_out;
+
+                        if (result == Z_STREAM_END) {
+                            if (!this->isGzipMemberAt(totalIn))
+                                break;
+
+                            inflateReset(&m_stream);
+                            checkpoints.push_back({ .uncompressedOffset = totalOut, .compressedOffset = totalIn, .streamStart = true, .parameter = 0, .window = {} });
+                            lastCheckpoint = totalOut;
+                            continue;
+                        }
+
+                        if (result != Z_OK && result != Z_BUF_ERROR)
+                            throw std::runtime_error(m_stream.msg != nullptr ? m_stream.msg : "Invalid deflate data");
+
+                        // Inflate stops after every block header when using Z_BLOCK. Bit 7 is set at the start of a block, bit 6 if it's the last one
+                        const bool atBlockStart = (m_stream.data_type & 0x80) != 0 && (m_stream.data_type & 0x40) == 0;
+                        if (atBlockStart && totalOut - lastCheckpoint >= CheckpointInterval) {
+                            Checkpoint checkpoint = { .uncompressedOffset = totalOut, .compressedOffset = totalIn, .streamStart = false, .parameter = u8(m_stream.data_type & 0x07), .window = std::vector<u8>(WindowSize) };
+
+                            // Unroll the ring buffer so the window starts with its oldest byte
+                            const auto left = m_stream.avail_out;
+                            std::copy(window.end() - left, window.end(), checkpoint.window.begin());
+                            std::copy(window.begin(), window.end() - left, checkpoint.window.begin() + left);
+
+                            checkpoints.push_back(std::move(checkpoint));
+                            lastCheckpoint = totalOut;
+                        }
+                    }
+
+                    uncompressedSize = totalOut;
+                    return checkpoints;
+                }
+
+                bool seek(const Checkpoint &checkpoint) override {
+                    this->end();
+
+                    if (checkpoint.streamStart) {
+                        if (inflateInit2(&m_stream, AutoDetectHeader) != Z_OK)
+                            return false;
+                        m_initialized = true;
+
+                        m_inputOffset = checkpoint.compressedOffset;
+                    } else {
+                        if (inflateInit2(&m_stream, -MaxWindowBits) != Z_OK)
+                            return false;
+                        m_initialized = true;
+
+                        // The block might start in the middle of a byte, feed its remaining bits to inflate first
+                        const auto bitCount = checkpoint.parameter;
+                        m_inputOffset = checkpoint.compressedOffset - (bitCount != 0 ? 1 : 0);
+                        if (bitCount != 0) {
+                            u8 byte = 0;
+                            m_file.readBufferAtomic(m_inputOffset, &byte, 1);
+                            m_inputOffset += 1;
+
+                            if (inflatePrime(&m_stream, bitCount, byte >> (8 - bitCount)) != Z_OK)
+                                return false;
+                        }
+
+                        if (inflateSetDictionary(&m_stream, checkpoint.window.data(), checkpoint.window.size()) != Z_OK)
+                            return false;
+                    }
+
+                    return true;
+                }
+
+                size_t decode(u8 *buffer, size_t size) override {
+                    m_stream.next_out  = buffer;
+                    m_stream.avail_out = size;
+
+                    while (m_stream.avail_out > 0) {
+                        if (m_stream.avail_in == 0) {
+                            const auto input = this->readInput();
+                            if (input.empty())
+                                break;
+
+                            m_stream.next_in  = input.data();
+                            m_stream.avail_in = input.size();
+                        }
+
+                        if (inflate(&m_stream, Z_NO_FLUSH) != Z_OK)
+                            break;
+                    }
+
+                    return size - m_stream.avail_out;
+                }
+
+            private:
+                constexpr static int MaxWindowBits = 15;
+                constexpr static int AutoDetectHeader = MaxWindowBits + 32;
+                constexpr static size_t WindowSize = 1 << MaxWindowBits;
+                constexpr static u64 CheckpointInterval = 4_MiB;
+
+                bool isGzipMemberAt(u64 offset) const {
+                    if (offset + 2 > m_fileSize)
+                        return false;
+
+                    std::array<u8, 2> magic = { };
+                    m_file.readBufferAtomic(offset, magic.data(), magic.size());
+
+                    return magic[0] == 0x1F && magic[1] == 0x8B;
+                }
+
+                void end() {
+                    if (m_initialized)
+                        inflateEnd(&m_stream);
+
+                    m_stream = { };
+                    m_initialized = false;
+                }
+
+                z_stream m_stream = { };
+                bool m_initialized = false;
+            };
+
+        #endif
+
+        #if IMHEX_FEATURE_ENABLED(LIBLZMA)
+
+            /**
+             * @brief xz files already contain an index of all their blocks, each of which can be decoded on its own
+             */
+            class XZDecoder : public CompressedStreamProvider::Decoder {
+            public:
+                explicit XZDecoder(wolv::io::File &file) : Decoder(file) { }
+                ~XZDecoder() override { lzma_end(&m_stream); }
+
+                std::vector<Checkpoint> buildIndex(Task &task, u64 &uncompressedSize) override {
+                    lzma_index *index = nullptr;
+                    {
+                        lzma_stream stream = LZMA_STREAM_INIT;
+                        ON_SCOPE_EXIT { lzma_end(&stream); };
+
+                        if (lzma_file_info_decoder(&stream, &index, UINT64_MAX, m_fileSize) != LZMA_OK)
+                            throw std::runtime_error("Failed to initialize liblzma");
+
+                        // The decoder only reads the headers and indices and tells us where to continue reading
+                        m_inputOffset = 0;
+                        while (true) {
+                            if (stream.avail_in == 0) {
+                                task.update(m_inputOffset);
+
+                                const auto input = this->readInput();
+                                stream.next_in  = input.data();
+                                stream.avail_in = input.size();
+                            }
+
+                            const auto result = lzma_code(&stream, LZMA_RUN);
+                            if (result == LZMA_STREAM_END)
+                                break;
+                            if (result == LZMA_SEEK_NEEDED) {
+                                m_inputOffset = stream.seek_pos;
+                                stream.avail_in = 0;
+                                continue;
+                            }
+                            if (result != LZMA_OK)
+                                throw std::runtime_error("Invalid xz data");
+                        }
+                    }
+                    ON_SCOPE_EXIT { lzma_index_end(index, nullptr); };
+
+                    std::vector<Checkpoint> checkpoints;
+                    lzma_index_iter iterator;
+                    lzma_index_iter_init(&iterator, index);
+                    while (!lzma_index_iter_next(&iterator, LZMA_INDEX_ITER_NONEMPTY_BLOCK)) {
+                        checkpoints.push_back({
+                            .uncompressedOffset = iterator.block.uncompressed_file_offset,
+                            .compressedOffset   = iterator.block.compressed_file_offset,
+                            .streamStart        = true,
+                            .parameter          = u8(iterator.stream.flags->check),
+                            .window             = {}
+                        });
+                    }
+
+                    if (checkpoints.empty())
+                        checkpoints.push_back({ .uncompressedOffset = 0, .compressedOffset = 0, .streamStart = true, .parameter = 0, .window = {} });
+
+                    uncompressedSize = lzma_index_uncompressed_size(index);
+                    return checkpoints;
+                }
+
+                bool seek(const Checkpoint &checkpoint) override {
+                    lzma_end(&m_stream);
+                    m_stream = LZMA_STREAM_INIT;
+                    m_ended = false;
+
+                    std::array<u8, LZMA_BLOCK_HEADER_SIZE_MAX> header = { };
+                    if (checkpoint.compressedOffset >= m_fileSize)
+                        return false;
+                    m_file.readBufferAtomic(checkpoint.compressedOffset, header.data(), 1);
+
+                    lzma_block block = { };
+                    block.version     = 1;
+                    block.check       = lzma_check(checkpoint.parameter);
+                    block.filters     = m_filters.data();
+                    block.header_size = lzma_block_header_size_decode(header[0]);
+                    if (header[0] == 0x00 || checkpoint.compressedOffset + block.header_size > m_fileSize)
+                        return false;
+
+                    m_file.readBufferAtomic(checkpoint.compressedOffset, header.data(), block.header_size);
+                    if (lzma_block_header_decode(&block, nullptr, header.data()) != LZMA_OK)
+                        return false;
+
+                    // The block decoder keeps a pointer to the block options while decoding
+                    m_block = block;
+                    const auto result = lzma_block_decoder(&m_stream, &m_block);
+                    lzma_filters_free(m_filters.data(), nullptr);
+                    if (result != LZMA_OK)
+                        return false;
+
+                    m_inputOffset = checkpoint.compressedOffset + block.header_size;
+                    return true;
+                }
+
+                size_t decode(u8 *buffer, size_t size) override {
+                    if (m_ended)
+                        return 0;
+
+                    m_stream.next_out  = buffer;
+                    m_stream.avail_out = size;
+
+                    while (m_stream.avail_out > 0) {
+                        if (m_stream.avail_in == 0) {
+                            const auto input = this->readInput();
+                            if (input.empty())
+                                break;
+
+                            m_stream.next_in  = input.data();
+                            m_stream.avail_in = input.size();
+                        }
+
+                        if (lzma_code(&m_stream, LZMA_RUN) != LZMA_OK) {
+                            m_ended = true;
+                            break;
+                        }
+                    }
+
+                    return size - m_stream.avail_out;
+                }
+
+            private:
+                lzma_stream m_stream = LZMA_STREAM_INIT;
+                lzma_block m_block = { };
+                std::array<lzma_filter, LZMA_FILTERS_MAX + 1> m_filters = { };
+                bool m_ended = false;
+            };
+
+        #endif
+
+        #if IMHEX_FEATURE_ENABLED(ZSTD)
+
+            /**
+             * @brief zstd frames are independent of each other. Their boundaries are found by walking the block headers
+             * so only frames without a stored content size need to be decompressed while indexing
+             */
+            class ZstdDecoder : public CompressedStreamProvider::Decoder {
+            public:
+                explicit ZstdDecoder(wolv::io::File &file) : Decoder(file), m_context(ZSTD_createDCtx()) { }
+                ~ZstdDecoder() override { ZSTD_freeDCtx(m_context); }
+
+                std::vector<Checkpoint> buildIndex(Task &task, u64 &uncompressedSize) override {
+                    std::vector<Checkpoint> checkpoints;
+
+                    u64 offset = 0, totalOut = 0;
+                    while (offset < m_fileSize) {
+                        task.update(offset);
+
+                        std::array<u8, ZSTD_FRAMEHEADERSIZE_MAX> header = { };
+                        const auto headerSize = std::min<u64>(header.size(), m_fileSize - offset);
+                        m_file.readBufferAtomic(offset, header.data(), headerSize);
+
+                        ZSTD_frameHeader frameHeader;
+                        if (ZSTD_getFrameHeader(&frameHeader, header.data(), headerSize) != 0)
+                            throw std::runtime_error(fmt::format("Invalid zstd frame at offset 0x{:X}", offset));
+
+                        if (frameHeader.frameType == ZSTD_skippableFrame) {
+                            offset += frameHeader.headerSize + frameHeader.frameContentSize;
+                            continue;
+                        }
+
+                        const Checkpoint checkpoint = { .uncompressedOffset = totalOut, .compressedOffset = offset, .streamStart = true, .parameter = 0, .window = {} };
+
+                        // Every block starts with a three byte header containing its type, size and whether it's the last one
+                        offset += frameHeader.headerSize;
+                        while (true) {
+                            std::array<u8, 3> blockHeader = { };
+                            if (offset + blockHeader.size() > m_fileSize)
+                                throw std::runtime_error("Unexpected end of compressed data");
+                            m_file.readBufferAtomic(offset, blockHeader.data(), blockHeader.size());
+
+                            const u32 value     = blockHeader[0] | (blockHeader[1] << 8) | (blockHeader[2] << 16);
+                            const auto lastBlock = (value & 0b1) != 0;
+                            const auto blockType = (value >> 1) & 0b11;
+                            const auto blockSize = value >> 3;
+                            if (blockType == 3)
+                                throw std::runtime_error(fmt::format("Invalid zstd block at offset 0x{:X}", offset));
+
+                            // RLE blocks only store the byte that's repeated
+                            offset += blockHeader.size() + (blockType == 1 ? 1 : blockSize);
+                            if (lastBlock)
+                                break;
+                        }
+
+                        if (frameHeader.checksumFlag)
+                            offset += 4;
+
+                        u64 contentSize = frameHeader.frameContentSize;
+                        if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN) {
+                            if (!this->seek(checkpoint))
+                                throw std::runtime_error("Failed to initialize zstd");
+
+                            contentSize = 0;
+                            std::vector<u8> buffer(ZSTD_DStreamOutSize());
+                            while (const auto decoded = this->decode(buffer.data(), buffer.size()))
+                                contentSize += decoded;
+                        }
+
+                        checkpoints.push_back(checkpoint);
+                        totalOut += contentSize;
+                    }
+
+                    if (checkpoints.empty())
+                        checkpoints.push_back({ .uncompressedOffset = 0, .compressedOffset = 0, .streamStart = true, .parameter = 0, .window = {} });
+
+                    uncompressedSize = totalOut;
+                    return checkpoints;
+                }
+
+                bool seek(const Checkpoint &checkpoint) override {
+                    if (m_context == nullptr || ZSTD_isError(ZSTD_DCtx_reset(m_context, ZSTD_reset_session_only)))
+                        return false;
+
+                    m_inputOffset = checkpoint.compressedOffset;
+                    m_inputBuffer = { nullptr, 0, 0 };
+                    m_ended = false;
+
+                    return true;
+                }
+
+                size_t decode(u8 *buffer, size_t size) override {
+                    if (m_ended)
+                        return 0;
+
+                    ZSTD_outBuffer output = { buffer, size, 0 };
+                    while (output.pos < output.size) {
+                        if (m_inputBuffer.pos == m_inputBuffer.size) {
+                            const auto input = this->readInput();
+                            if (input.empty())
+                                break;
+
+                            m_inputBuffer = { input.data(), input.size(), 0 };
+                        }
+
+                        // Decoding stops at the end of the frame since the next one has a checkpoint of its own
+                        const auto result = ZSTD_decompressStream(m_context, &output, &m_inputBuffer);
+                        if (ZSTD_isError(result) || result == 0) {
+                            m_ended = true;
+                            break;
+                        }
+                    }
+
+                    return output.pos;
+                }
+
+            private:
+                ZSTD_DCtx *m_context;
+                ZSTD_inBuffer m_inputBuffer = { nullptr, 0, 0 };
+                bool m_ended = false;
+            };
+
+        #endif
+
+        Format detectFormat(wolv::io::File &file) {
+            std::array<u8, 6> magic = { };
+            if (file.getSize() < magic.size())
+                return Format::Unknown;
+            file.readBufferAtomic(0, magic.data(), magic.size());
+
+            if (magic[0] == 0x1F && magic[1] == 0x8B)
+                return Format::Deflate;
+            if ((magic[0] & 0x0F) == 0x08 && ((magic[0] << 8) | magic[1]) % 31 == 0)
+                return Format::Deflate;
+            if (magic == std::array<u8, 6>{ 0xFD, '7', 'z', 'X', 'Z', 0x00 })
+                return Format::XZ;
+            if (magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+                return Format::Zstd;
+            if ((magic[0] & 0xF0) == 0x50 && magic[1] == 0x2A && magic[2] == 0x4D && magic[3] == 0x18)
+                return Format::Zstd;
+
+            return Format::Unknown;
+        }
+
+        std::unique_ptr<CompressedStreamProvider::Decoder> createDecoder(Format format, wolv::io::File &file) {
+            switch (format) {
+                #if IMHEX_FEATURE_ENABLED(ZLIB)
+                    case Format::Deflate: return std::make_unique<DeflateDecoder>(file);
+                #endif
+                #if IMHEX_FEATURE_ENABLED(LIBLZMA)
+                    case Format::XZ:      return std::make_unique<XZDecoder>(file);
+                #endif
+                #if IMHEX_FEATURE_ENABLED(ZSTD)
+                    case Format::Zstd:    return std::make_unique<ZstdDecoder>(file);
+                #endif
+                default:                  return nullptr;
+            }
+        }
+
+        const char* getFormatName(Format format) {
+            switch (format) {
+                case Format::Deflate: return "gzip / zlib";
+                case Format::XZ:      return "xz";
+                case Format::Zstd:    return "zstd";
+                default:              return "???";
+            }
+        }
+
+        constexpr static std::array<char, 8> IndexMagic = { 'I', 'M', 'H', 'X', 'C', 'I', 'D', 'X' };
+        constexpr static u32 IndexVersion = 1;
+
+        template<typename T>
+        void appendValue(std::vector<u8> &data, const T &value) {
+            const auto bytes = reinterpret_cast<const u8*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        template<typename T>
+        T readValue(std::span<const u8> &data) {
+            if (data.size() < sizeof(T))
+                throw std::out_of_range("Index file truncated");
+
+            T value;
+            std::memcpy(&value, data.data(), sizeof(T));
+            data = data.subspan(sizeof(T));
+
+            return value;
+        }
+
+        i64 getModificationTime(const std::fs::path &path) {
+            std::error_code error;
+            return std::fs::last_write_time(path, error).time_since_epoch().count();
+        }
+
+    }
+
+    CompressedStreamProvider::CompressedStreamProvider() : CachedProvider(64_KiB, 256) { }
+    CompressedStreamProvider::~CompressedStreamProvider() = default;
+
+    prv::Provider::OpenResult CompressedStreamProvider::open() {
+        std::ignore = CachedProvider::open();
+
+        const auto path = this->getPickedPath();
+        m_file = wolv::io::File(path, wolv::io::File::Mode::Read);
+        if (!m_file.isValid())
+            return OpenResult::failure(fmt::format("hex.builtin.provider.file.error.open"_lang, wolv::util::toUTF8String(path), formatSystemError(errno)));
+
+        m_format  = detectFormat(m_file);
+        m_decoder = createDecoder(m_format, m_file);
+        if (m_decoder == nullptr) {
+            m_file.close();
+            return OpenResult::failure("hex.decompress.provider.compressed_stream.error.unsupported"_lang);
+        }
+
+        // Indexing needs a full pass over the data so it runs in the background where it can be cancelled
+        if (!this->loadIndex()) {
+            m_indexTask = TaskManager::createTask("hex.decompress.provider.compressed_stream.indexing"_unlocalized, ProgressValue::Size(m_file.getSize()), [this](Task &task) {
+                try {
+                    this->buildIndex(task);
+                } catch (const std::runtime_error &e) {
+                    ui::ToastError::open(fmt::format("hex.decompress.provider.compressed_stream.error.index"_lang, e.what()));
+                }
+            });
+        }
+
+        m_decoderValid = false;
+
+        return {};
+    }
+
+    void CompressedStreamProvider::buildIndex(Task &task) {
+        // The index is built using a separate file handle and decoder so it doesn't get in the way of reads
+        wolv::io::File file(this->getPickedPath(), wolv::io::File::Mode::Read);
+        if (!file.isValid())
+            throw std::runtime_error("Failed to open file");
+
+        u64 uncompressedSize = 0;
+        auto checkpoints = createDecoder(m_format, file)->buildIndex(task, uncompressedSize);
+
+        {
+            std::scoped_lock lock(m_decoderMutex);
+
+            m_checkpoints      = std::move(checkpoints);
+            m_uncompressedSize = uncompressedSize;
+            m_decoderValid     = false;
+        }
+
+        this->clearCache();
+        this->storeIndex();
+        EventDataChanged::post(this);
+    }
+
+    void CompressedStreamProvider::close() {
+        m_indexTask.interrupt();
+        m_indexTask.wait();
+
+        {
+            std::scoped_lock lock(m_decoderMutex);
+
+            m_decoder.reset();
+            m_decoderValid = false;
+            m_checkpoints.clear();
+            m_uncompressedSize = 0;
+            m_file.close();
+        }
+
+        CachedProvider::close();
+    }
+
+    void CompressedStreamProvider::readFromSource(u64 offset, void *buffer, size_t size) {
+        std::memset(buffer, 0x00, size);
+
+        std::scoped_lock lock(m_decoderMutex);
+        if (m_decoder == nullptr || offset >= m_uncompressedSize || m_checkpoints.empty())
+            return;
+        size = std::min<u64>(size, m_uncompressedSize - offset);
+
+        // Only restart decoding from a checkpoint if the current position is past the requested offset
+        // or if there's a closer checkpoint, otherwise sequential reads just continue where the last one stopped
+        const auto checkpoint = std::prev(std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), offset, [](u64 value, const Checkpoint &checkpoint) {
+            return value < checkpoint.uncompressedOffset;
+        }));
+        if (!m_decoderValid || m_position > offset || checkpoint->uncompressedOffset > m_position) {
+            if (!m_decoder->seek(*checkpoint))
+                return;
+
+            m_decoderValid    = true;
+            m_checkpointIndex = checkpoint - m_checkpoints.begin();
+            m_position        = checkpoint->uncompressedOffset;
+        }
+
+        std::array<u8, 16_KiB> skipBuffer = { };
+        while (m_position < offset) {
+            if (this->decode(skipBuffer.data(), std::min<u64>(skipBuffer.size(), offset - m_position)) == 0)
+                return;
+        }
+
+        auto output = static_cast<u8*>(buffer);
+        while (size > 0) {
+            const auto decoded = this->decode(output, size);
+            if (decoded == 0)
+                break;
+
+            output += decoded;
+            size   -= decoded;
+        }
+    }
+
+    size_t CompressedStreamProvider::decode(u8 *buffer, size_t size) {
+        while (true) {
+            if (const auto decoded = m_decoder->decode(buffer, size); decoded > 0) {
+                m_position += decoded;
+                return decoded;
+            }
+
+            // The current gzip member, xz block or zstd frame ended, continue with the next one
+            const auto next = std::find_if(m_checkpoints.begin() + m_checkpointIndex + 1, m_checkpoints.end(), [](const Checkpoint &checkpoint) {
+                return checkpoint.streamStart;
+            });
+            if (next == m_checkpoints.end() || next->uncompressedOffset != m_position || !m_decoder->seek(*next)) {
+                m_decoderValid = false;
+                return 0;
+            }
+
+            m_checkpointIndex = next - m_checkpoints.begin();
+        }
+    }
+
+    void CompressedStreamProvider::writeToSource(u64 offset, const void *buffer, size_t size) {
+        std::ignore = offset;
+        std::ignore = buffer;
+        std::ignore = size;
+    }
+
+    u64 CompressedStreamProvider::getSourceSize() const {
+        return m_uncompressedSize;
+    }
+
+    std::fs::path CompressedStreamProvider::getIndexPath() const {
+        auto path = this->getPickedPath();
+        path += ".imhexidx";
+
+        return path;
+    }
+
+    bool CompressedStreamProvider::loadIndex() {
+        wolv::io::File file(this->getIndexPath(), wolv::io::File::Mode::Read);
+        if (!file.isValid())
+            return false;
+
+        const auto content = file.readVector();
+        std::span<const u8> data = content;
+
+        try {
+            // Only use the index if it was created for exactly this version of the file
+            if (readValue<std::array<char, 8>>(data) != IndexMagic || readValue<u32>(data) != IndexVersion)
+                return false;
+            if (readValue<Format>(data) != m_format || readValue<u64>(data) != m_file.getSize() || readValue<i64>(data) != getModificationTime(this->getPickedPath()))
+                return false;
+
+            const auto uncompressedSize = readValue<u64>(data);
+
+            // Every checkpoint takes up at least its fixed size fields, a larger count means the file is corrupted
+            constexpr static u64 MinCheckpointSize = sizeof(u64) + sizeof(u64) + sizeof(u8) + sizeof(u8) + sizeof(u32);
+            const auto checkpointCount = readValue<u64>(data);
+            if (checkpointCount > data.size() / MinCheckpointSize)
+                return false;
+
+            std::vector<Checkpoint> checkpoints(checkpointCount);
+            for (auto &checkpoint : checkpoints) {
+                checkpoint.uncompressedOffset = readValue<u64>(data);
+                checkpoint.compressedOffset   = readValue<u64>(data);
+                checkpoint.streamStart        = readValue<u8>(data) != 0;
+                checkpoint.parameter          = readValue<u8>(data);
+
+                const auto windowSize = readValue<u32>(data);
+                if (data.size() < windowSize)
+                    return false;
+                checkpoint.window.assign(data.begin(), data.begin() + windowSize);
+                data = data.subspan(windowSize);
+            }
+
+            if (checkpoints.empty() || checkpoints.front().uncompressedOffset != 0)
+                return false;
+
+            m_checkpoints      = std::move(checkpoints);
+            m_uncompressedSize = uncompressedSize;
+        } catch (const std::exception &) {
+            return false;
+        }
+
+        return true;
+    }
+
+    void CompressedStreamProvider::storeIndex() const {
+        std::vector<u8> data;
+        appendValue(data, IndexMagic);
+        appendValue(data, IndexVersion);
+        appendValue(data, m_format);
+        appendValue(data, u64(m_file.getSize()));
+        appendValue(data, getModificationTime(this->getPickedPath()));
+        appendValue(data, u64(m_uncompressedSize));
+        appendValue(data, u64(m_checkpoints.size()));
+
+        for (const auto &checkpoint : m_checkpoints) {
+            appendValue(data, checkpoint.uncompressedOffset);
+            appendValue(data, checkpoint.compressedOffset);
+            appendValue(data, u8(checkpoint.streamStart ? 1 : 0));
+            appendValue(data, checkpoint.parameter);
+            appendValue(data, u32(checkpoint.window.size()));
+            data.insert(data.end(), checkpoint.window.begin(), checkpoint.window.end());
+        }
+
+        wolv::io::File file(this->getIndexPath(), wolv::io::File::Mode::Create);
+        if (!file.isValid()) {
+            log::warn("Failed to store index of compressed stream next to '{}'", wolv::util::toUTF8String(this->getPickedPath()));
+            return;
+        }
+
+        file.writeVector(data);
+    }
+
+    std::string CompressedStreamProvider::getName() const {
+        return fmt::format("hex.decompress.provider.compressed_stream.name"_lang, wolv::util::toUTF8String(this->getPickedPath().filename()));
+    }
+
+    std::vector<CompressedStreamProvider::Description> CompressedStreamProvider::getDataDescription() const {
+        std::vector<Description> result;
+
+        result.emplace_back("hex.builtin.provider.file.path"_lang, wolv::util::toUTF8String(this->getPickedPath()));
+        result.emplace_back("hex.decompress.provider.compressed_stream.format"_lang, getFormatName(m_format));
+        result.emplace_back("hex.decompress.provider.compressed_stream.compressed_size"_lang, hex::toByteString(m_file.getSize()));
+        result.emplace_back("hex.decompress.provider.compressed_stream.uncompressed_size"_lang, hex::toByteString(m_uncompressedSize));
+
+        std::scoped_lock lock(m_decoderMutex);
+        result.emplace_back("hex.decompress.provider.compressed_stream.checkpoints"_lang, this->isIndexing() ? std::string("hex.decompress.provider.compressed_stream.indexing"_lang) : fmt::format("{}", m_checkpoints.size()));
+
+        return result;
+    }
+
+    std::vector<fs::ItemFilter> CompressedStreamProvider::getValidExtensions() const {
+        return {
+            { "gzip Compressed File", "gz"   },
+            { "gzip Compressed File", "tgz"  },
+            { "zlib Compressed File", "zz"   },
+            { "xz Compressed File",   "xz"   },
+            { "xz Compressed File",   "txz"  },
+            { "zstd Compressed File", "zst"  },
+            { "zstd Compressed File", "tzst" },
+        };
+    }
+
+    bool CompressedStreamProvider::canOpenFile(const std::fs::path &path) const {
+        return wolv::io::fs::isRegularFile(path);
+    }
+
+    void CompressedStreamProvider::loadSettings(const nlohmann::json &settings) {
+        Provider::loadSettings(settings);
+
+        auto path = settings.at("path").get<std::string>();
+        this->setPickedPath(std::u8string(path.begin(), path.end()));
+    }
+
+    nlohmann::json CompressedStreamProvider::storeSettings(nlohmann::json settings) const {
+        settings["path"] = wolv::io::fs::toNormalizedPathString(this->getPickedPath());
+
+        return Provider::storeSettings(settings);
+    }
+
+}
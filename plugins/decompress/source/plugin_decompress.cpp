@@ -1,9 +1,13 @@
 #include <hex/plugin.hpp>
 
+#include <hex/api/content_registry/provider.hpp>
+#include <hex/api/localization_manager.hpp>
 #include <hex/helpers/logger.hpp>
 
 #include <romfs/romfs.hpp>
 
+#include <content/providers/compressed_stream_provider.hpp>
+
 namespace hex::plugin::decompress {
 
     void registerPatternLanguageFunctions();
@@ -15,6 +19,11 @@ using namespace hex::plugin::decompress;
 
 IMHEX_PLUGIN_SETUP("Decompressing", "WerWolv", "Support for decompressing data") {
     hex::log::debug("Using romfs: '{}'", romfs::name());
+    hex::LocalizationManager::addLanguages(romfs::get("lang/languages.json").string(), [](const std::filesystem::path &path) {
+        return romfs::get(path).string();
+    });
 
     registerPatternLanguageFunctions();
+
+    ContentRegistry::Provider::add<CompressedStreamProvider>();
 }
\ No newline at end of file
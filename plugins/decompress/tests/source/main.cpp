@@ -0,0 +1,204 @@
+#include <hex/test/tests.hpp>
+#include <hex/api/task_manager.hpp>
+
+#include <content/providers/compressed_stream_provider.hpp>
+
+#include <wolv/io/file.hpp>
+#include <wolv/io/fs.hpp>
+#include <wolv/literals.hpp>
+#include <wolv/utils/guards.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(TEST_FORMAT_ZLIB)
+    #include <zlib.h>
+#endif
+#if defined(TEST_FORMAT_LIBLZMA)
+    #include <lzma.h>
+#endif
+#if defined(TEST_FORMAT_ZSTD)
+    #include <zstd.h>
+#endif
+
+using namespace hex;
+using namespace hex::plugin::decompress;
+using namespace wolv::literals;
+
+namespace {
+
+    // Reads bypass the cache so every one of them has to go through the decoder
+    class UncachedCompressedStreamProvider : public CompressedStreamProvider {
+    public:
+        void readUncached(u64 offset, void *buffer, size_t size) {
+            this->readFromSource(offset, buffer, size);
+        }
+    };
+
+    constexpr static u64 DataSize  = 10_MiB;
+    constexpr static u64 FrameSize = 1_MiB;
+
+    // Compressible, but not so much that the compressed data only consists of a few deflate blocks
+    std::vector<u8> generateData() {
+        std::mt19937 random(0x1337);
+
+        std::vector<u8> result(DataSize);
+        for (u64 i = 0; i < result.size(); i += 1)
+            result[i] = u8((i / 64) % 251 + random() % 4);
+
+        return result;
+    }
+
+    int testRandomAccess(const std::string &extension, const std::vector<u8> &compressed, const std::vector<u8> &data) {
+        TaskManager::init();
+
+        const auto path = std::fs::temp_directory_path() / ("imhex_compressed_stream_test." + extension);
+        auto indexPath = path;
+        indexPath += ".imhexidx";
+
+        wolv::io::fs::remove(indexPath);
+        wolv::io::File(path, wolv::io::File::Mode::Create).writeVector(compressed);
+        ON_SCOPE_EXIT {
+            wolv::io::fs::remove(path);
+            wolv::io::fs::remove(indexPath);
+        };
+
+        // Reads at the end, start and across frame boundaries, followed by random ones that mostly seek backwards or across checkpoints
+        std::vector<std::pair<u64, u64>> reads = {
+            { DataSize - 100, 100 }, { 0, 4_KiB }, { FrameSize - 100, 200 }, { 3 * FrameSize - 1, 2 }, { 2_MiB, 6_MiB }, { 5 * FrameSize - 64_KiB, 128_KiB }, { 1, 1 }
+        };
+        std::mt19937 random(0x4242);
+        for (u32 i = 0; i < 100; i += 1) {
+            const auto offset = random() % DataSize;
+            reads.emplace_back(offset, std::min<u64>(random() % 256_KiB + 1, DataSize - offset));
+        }
+
+        // The first time the index gets built, the second time it's loaded from the file stored next to the data
+        for (const auto storedIndex : { false, true }) {
+            UncachedCompressedStreamProvider provider;
+            provider.setPickedPath(path);
+            TEST_ASSERT(!provider.open().isFailure(), "{}", extension);
+            TEST_ASSERT(!storedIndex || !provider.isIndexing(), "{} index wasn't reused", extension);
+
+            while (provider.isIndexing())
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            TEST_ASSERT(provider.getActualSize() == DataSize, "{} size is {}", extension, provider.getActualSize());
+            TEST_ASSERT(wolv::io::fs::exists(indexPath), "{}", extension);
+
+            std::vector<u8> buffer;
+            for (const auto &[offset, size] : reads) {
+                buffer.assign(size, 0x00);
+                provider.readUncached(offset, buffer.data(), buffer.size());
+
+                TEST_ASSERT(std::ranges::equal(buffer, std::span(data).subspan(offset, size)), "{} read of 0x{:X} bytes at 0x{:X}", extension, size, offset);
+            }
+
+            // Reads past the end are filled with zeros
+            buffer.assign(16, 0xFF);
+            provider.readUncached(DataSize - 8, buffer.data(), buffer.size());
+            TEST_ASSERT(std::ranges::equal(std::span(buffer).first(8), std::span(data).last(8)));
+            TEST_ASSERT(std::ranges::all_of(std::span(buffer).last(8), [](u8 byte) { return byte == 0x00; }));
+
+            provider.close();
+        }
+
+        // An index claiming more checkpoints than it could possibly contain is rejected and gets rebuilt
+        {
+            constexpr static size_t CheckpointCountOffset = 8 + sizeof(u32) + sizeof(CompressedStreamProvider::Format) + 3 * sizeof(u64);
+            constexpr static u64 CorruptedCheckpointCount = std::numeric_limits<u64>::max() / 2;
+
+            auto index = wolv::io::File(indexPath, wolv::io::File::Mode::Read).readVector();
+            TEST_ASSERT(index.size() >= CheckpointCountOffset + sizeof(u64), "{}", extension);
+            std::memcpy(index.data() + CheckpointCountOffset, &CorruptedCheckpointCount, sizeof(u64));
+            wolv::io::File(indexPath, wolv::io::File::Mode::Create).writeVector(index);
+
+            UncachedCompressedStreamProvider provider;
+            provider.setPickedPath(path);
+            TEST_ASSERT(!provider.open().isFailure(), "{}", extension);
+
+            while (provider.isIndexing())
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            TEST_ASSERT(provider.getActualSize() == DataSize, "{} size is {}", extension, provider.getActualSize());
+            provider.close();
+
+            index = wolv::io::File(indexPath, wolv::io::File::Mode::Read).readVector();
+            u64 checkpointCount = 0;
+            std::memcpy(&checkpointCount, index.data() + CheckpointCountOffset, sizeof(u64));
+            TEST_ASSERT(checkpointCount != CorruptedCheckpointCount, "{} corrupted index wasn't replaced", extension);
+        }
+
+        TEST_SUCCESS();
+    }
+
+}
+
+#if defined(TEST_FORMAT_ZLIB)
+
+    TEST_SEQUENCE("CompressedStream/Gzip") {
+        const auto data = generateData();
+
+        z_stream stream = { };
+        TEST_ASSERT(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+        std::vector<u8> compressed(deflateBound(&stream, data.size()));
+        stream.next_in   = const_cast<u8*>(data.data());
+        stream.avail_in  = data.size();
+        stream.next_out  = compressed.data();
+        stream.avail_out = compressed.size();
+        const auto result = deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        TEST_ASSERT(result == Z_STREAM_END);
+
+        return testRandomAccess("gz", compressed, data);
+    };
+
+#endif
+
+#if defined(TEST_FORMAT_LIBLZMA)
+
+    TEST_SEQUENCE("CompressedStream/XZ") {
+        const auto data = generateData();
+
+        // Every frame is compressed as its own stream so there's a checkpoint at the start of each of them
+        std::vector<u8> compressed;
+        for (u64 offset = 0; offset < data.size(); offset += FrameSize) {
+            std::vector<u8> stream(lzma_stream_buffer_bound(FrameSize));
+            size_t streamSize = 0;
+            TEST_ASSERT(lzma_easy_buffer_encode(1, LZMA_CHECK_CRC64, nullptr, data.data() + offset, FrameSize, stream.data(), &streamSize, stream.size()) == LZMA_OK);
+
+            compressed.insert(compressed.end(), stream.begin(), stream.begin() + streamSize);
+        }
+
+        return testRandomAccess("xz", compressed, data);
+    };
+
+#endif
+
+#if defined(TEST_FORMAT_ZSTD)
+
+    TEST_SEQUENCE("CompressedStream/Zstd") {
+        const auto data = generateData();
+
+        // Every frame gets a checkpoint at its start
+        std::vector<u8> compressed;
+        for (u64 offset = 0; offset < data.size(); offset += FrameSize) {
+            std::vector<u8> frame(ZSTD_compressBound(FrameSize));
+            const auto frameSize = ZSTD_compress(frame.data(), frame.size(), data.data() + offset, FrameSize, 3);
+            TEST_ASSERT(!ZSTD_isError(frameSize));
+
+            compressed.insert(compressed.end(), frame.begin(), frame.begin() + frameSize);
+        }
+
+        return testRandomAccess("zst", compressed, data);
+    };
+
+#endif
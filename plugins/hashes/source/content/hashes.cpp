@@ -90,12 +90,12 @@ namespace hex::plugin::hashes {
 
         Function create(std::string name) const override {
             return Hash::create(name, [hash = *this](const Region& region, prv::Provider *provider) -> std::vector<u8> {
-                auto crc = HashFactory::Checksum::CreateCRC(hash.m_width, hash.m_polynomial, hash.m_initialValue, hash.m_reflectIn, hash.m_reflectOut, hash.m_xorOut, 0, { "CRC" });
+                // HashLib is only used for the presets, the calculation itself uses the much faster built-in CRC engine
+                const auto crc = crypt::crc(provider, region.getStartAddress(), region.getSize(), hash.m_width, hash.m_polynomial, hash.m_initialValue, hash.m_xorOut, hash.m_reflectIn, hash.m_reflectOut);
 
-                crc->Initialize();
-
-                auto bytes = hashProviderRegionWithHashLib(region, provider, crc);
-                bytes.resize((hash.m_width + 7) / 8);
+                std::vector<u8> bytes((std::clamp<u32>(hash.m_width, 1, 64) + 7) / 8);
+                for (size_t i = 0; i < bytes.size(); i++)
+                    bytes[i] = u8(crc >> ((bytes.size() - i - 1) * 8));
 
                 return bytes;
             });
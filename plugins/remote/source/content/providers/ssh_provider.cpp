@@ -54,6 +54,8 @@ namespace hex::plugin::remote {
     }
 
     void SSHProvider::save() {
+        this->materializeLazyOverlays();
+
         if (m_sftpClient.isConnected() && m_remoteFile->isOpen()) {
             m_remoteFile->flush();
         }
@@ -0,0 +1,59 @@
+#include <hex/test/benchmarks.hpp>
+
+#include <hex/helpers/fmt.hpp>
+
+#include <ui/text_editor.hpp>
+
+using namespace hex;
+using namespace hex::ui;
+
+namespace {
+
+    std::string generateSource(u32 repetitions) {
+        std::string result;
+        for (u32 i = 0; i < repetitions; i++) {
+            result += fmt::format(
+                "#define FEATURE_{0}\n"
+                "#ifdef FEATURE_{0}\n"
+                "/// Header number {0}\n"
+                "struct Header{0} {{\n"
+                "    u32 magic; // \"magic\" value\n"
+                "    /* multi line\n"
+                "       comment */ u8 data[magic];\n"
+                "    char name[] = \"escaped \\\" quote\";\n"
+                "}};\n"
+                "#endif\n"
+                "#ifndef FEATURE_{0}\n"
+                "Header{0} header{0} @ 0x{0:X};\n"
+                "#endif\n"
+                "\n",
+                i);
+        }
+
+        return result;
+    }
+
+}
+
+BENCHMARK("TextEditor/Colorize") {
+    const auto source = generateSource(2000);
+
+    TextEditor editor;
+    editor.setText(source);
+    auto &lines = editor.getLines();
+
+    state.measure("Full colorize", source.size(), [&] {
+        lines.colorizeInternal(true);
+    });
+    state.setCounter("lines", double(lines.size()));
+
+    // Typing a character into the middle of the file only has to re-scan that one line
+    state.measure("Colorize after edit", 0, [&] {
+        lines.insertTextAt({ lines.size() / 2, 0 }, "x");
+        lines.colorizeInternal(false);
+    });
+
+    state.measure("Colorize when idle", 0, [&] {
+        lines.colorizeInternal(false);
+    });
+}
@@ -8,6 +8,7 @@
 #include <hex/api/events/events_interaction.hpp>
 
 #include <imgui.h>
+#include <span>
 #include <hex/ui/view.hpp>
 
 namespace hex::ui {
@@ -76,6 +77,16 @@ namespace hex::ui {
 
     class HexEditor {
     public:
+        /**
+         * @brief A contiguous range of addresses that all share the same highlight color
+         */
+        struct HighlightRun {
+            Region region;
+            color_t color;
+        };
+
+        using HighlightRunCallback = std::function<std::span<const HighlightRun>(const Region &)>;
+
         explicit HexEditor(prv::Provider *provider = nullptr);
         void draw(float height = ImGui::GetContentRegionAvail().y);
 
@@ -349,6 +360,22 @@ namespace hex::ui {
             m_backgroundColorCallback = callback;
         }
 
+        /**
+         * @brief Sets the callback that is queried once per frame with the visible region and returns a sorted list of
+         * non-overlapping foreground color runs. Colors returned by the per-cell foreground callback take precedence
+         */
+        void setForegroundHighlightRunCallback(const HighlightRunCallback &callback) {
+            m_foregroundRunCallback = callback;
+        }
+
+        /**
+         * @brief Sets the callback that is queried once per frame with the visible region and returns a sorted list of
+         * non-overlapping background color runs. They get blended with the colors returned by the per-cell background callback
+         */
+        void setBackgroundHighlightRunCallback(const HighlightRunCallback &callback) {
+            m_backgroundRunCallback = callback;
+        }
+
         void setHoverChangedCallback(const std::function<void(u64, size_t)> &callback) {
             m_hoverChangedCallback = callback;
         }
@@ -473,7 +500,9 @@ namespace hex::ui {
 
         static std::optional<color_t> defaultColorCallback(u64, const u8 *, size_t) { return std::nullopt; }
         static void defaultTooltipCallback(u64, const u8 *, size_t) {  }
+        static std::span<const HighlightRun> defaultRunCallback(const Region &) { return { }; }
         std::function<std::optional<color_t>(u64, const u8 *, size_t)> m_foregroundColorCallback = defaultColorCallback, m_backgroundColorCallback = defaultColorCallback;
+        HighlightRunCallback m_foregroundRunCallback = defaultRunCallback, m_backgroundRunCallback = defaultRunCallback;
         std::function<void(u64, size_t)> m_hoverChangedCallback = [](auto, auto){ };
         std::function<void(u64, const u8 *, size_t)> m_tooltipCallback = defaultTooltipCallback;
 
@@ -10,7 +10,6 @@
 #include <unordered_map>
 #include <map>
 #include <atomic>
-#include <regex>
 #include <chrono>
 #include <iostream>
 #include <set>
@@ -212,7 +211,6 @@ namespace hex::ui {
         using Tokens            = std::vector<Token>;
         using SafeTokenIterator = pl::hlp::SafeIterator<Tokens::const_iterator>;
         using Location          = pl::core::Location;
-        using RegexList         = std::vector<std::pair<std::regex, PaletteIndex>>;
         using Keywords          = std::unordered_set<std::string>;
         using ErrorMarkers      = std::map<Coordinates, std::pair<i32, std::string>>;
         using Breakpoints       = std::unordered_set<u32>;
@@ -346,6 +344,54 @@ namespace hex::ui {
             strConstIter m_flagsIter;
         };
 
+        // State of the comment / string / preprocessor scanner at a line boundary. Lines cache the state they
+        // were scanned with so unchanged lines can be skipped as soon as the state converges again after an edit
+        struct LexerState {
+            struct Preprocessor {
+                std::vector<bool> m_ifDefs;
+                std::vector<std::string> m_defines;
+
+                bool operator==(const Preprocessor &other) const = default;
+            };
+
+            bool m_withinString = false;
+            bool m_withinBlockComment = false;
+            bool m_withinGlobalDocComment = false;
+            bool m_withinBlockDocComment = false;
+            bool m_withinNotDef = false;
+            bool m_commentOpen = false;
+            // Shared between all lines with the same preprocessor state and only copied when a directive changes it
+            std::shared_ptr<const Preprocessor> m_preprocessor;
+
+            bool operator==(const LexerState &other) const;
+        };
+
+        // Whether the flags of a line are up to date. Lines get marked as not colorized from many places, so instead of
+        // tracking them all, every mark increments a shared counter. Lines::colorizeInternal() only has to look for lines
+        // that need to be scanned again if the counter changed since its last run
+        class ColorizedFlag {
+        public:
+            ColorizedFlag(bool value = false) : m_value(value) { countChange(value); }
+            ColorizedFlag(const ColorizedFlag &other) : ColorizedFlag(other.m_value) {}
+
+            ColorizedFlag &operator=(bool value) { m_value = value; countChange(value); return *this; }
+            ColorizedFlag &operator=(const ColorizedFlag &other) { return *this = other.m_value; }
+
+            operator bool() const { return m_value; }
+            bool operator==(const ColorizedFlag &other) const { return m_value == other.m_value; }
+
+            static u64 getChangeCount() { return s_changeCount.load(std::memory_order_relaxed); }
+
+        private:
+            static void countChange(bool value) {
+                if (!value)
+                    s_changeCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            bool m_value;
+            inline static std::atomic<u64> s_changeCount = 0;
+        };
+
         class Line {
         public:
             friend class TextEditor;
@@ -381,8 +427,8 @@ namespace hex::ui {
             Line() : m_lineMaxColumn(-1) {}
             explicit Line(const char *line) : Line(std::string(line)) {}
             explicit Line(const std::string &line) : m_chars(line), m_colors(std::string(line.size(), 0x00)), m_flags(std::string(line.size(), 0x00)), m_lineMaxColumn(maxColumn()) {}
-            Line(const Line &line) : m_chars(std::string(line.m_chars)), m_colors(std::string(line.m_colors)), m_flags(std::string(line.m_flags)), m_colorized(line.m_colorized), m_lineMaxColumn(line.m_lineMaxColumn) {}
-            Line(Line &&line) noexcept : m_chars(std::move(line.m_chars)), m_colors(std::move(line.m_colors)), m_flags(std::move(line.m_flags)), m_colorized(line.m_colorized), m_lineMaxColumn(line.m_lineMaxColumn) {}
+            Line(const Line &line) : m_chars(std::string(line.m_chars)), m_colors(std::string(line.m_colors)), m_flags(std::string(line.m_flags)), m_colorized(line.m_colorized), m_lineMaxColumn(line.m_lineMaxColumn), m_lexerStart(line.m_lexerStart), m_lexerEnd(line.m_lexerEnd) {}
+            Line(Line &&line) noexcept : m_chars(std::move(line.m_chars)), m_colors(std::move(line.m_colors)), m_flags(std::move(line.m_flags)), m_colorized(line.m_colorized), m_lineMaxColumn(line.m_lineMaxColumn), m_lexerStart(std::move(line.m_lexerStart)), m_lexerEnd(std::move(line.m_lexerEnd)) {}
             Line(std::string chars, std::string colors, std::string flags) : m_chars(std::move(chars)), m_colors(std::move(colors)), m_flags(std::move(flags)), m_lineMaxColumn(maxColumn()) {}
 
             bool operator==(const Line &o) const;
@@ -442,8 +488,10 @@ namespace hex::ui {
            std::string m_chars;
            std::string m_colors;
            std::string m_flags;
-           bool m_colorized = false;
+           ColorizedFlag m_colorized = false;
            i32 m_lineMaxColumn;
+           LexerState m_lexerStart;
+           LexerState m_lexerEnd;
         };
 
         class FoldedLine {
@@ -523,8 +571,6 @@ namespace hex::ui {
         };
 
         struct LanguageDefinition {
-            using TokenRegexString = std::pair<std::string, PaletteIndex>;
-            using TokenRegexStrings = std::vector<TokenRegexString>;
             using TokenizeCallback = bool (*)(strConstIter, strConstIter, strConstIter &, strConstIter &, PaletteIndex &);
 
             std::string m_name;
@@ -535,10 +581,9 @@ namespace hex::ui {
             char m_preprocChar = '#';
             bool m_autoIndentation = true;
             TokenizeCallback m_tokenize = {};
-            TokenRegexStrings m_tokenRegexStrings;
             bool m_caseSensitive = true;
 
-            LanguageDefinition() : m_keywords({}), m_identifiers({}), m_preprocIdentifiers({}), m_tokenRegexStrings({}) {}
+            LanguageDefinition() : m_keywords({}), m_identifiers({}), m_preprocIdentifiers({}) {}
 
             void setAutoIndentation(bool autoIndentation) { m_autoIndentation = autoIndentation; }
             static const LanguageDefinition &CPlusPlus();
@@ -610,6 +655,10 @@ namespace hex::ui {
         using StringVector          = std::vector<std::string>;
         using RangeFromCoordinates  = std::pair<Coordinates, Coordinates>;
 
+        // Characters that can start one of the scanner's multi-character checks. Everything else is skipped with a single table lookup
+        enum class CharClass : u8 { Separator = 0b0001, Operator = 0b0010, CommentStart = 0b0100, CommentEnd = 0b1000 };
+        using CharClasses           = std::array<u8, 256>;
+
         bool areEqual(const std::pair<Range,CodeFold> &a, const std::pair<Range,CodeFold> &b);
 
         class Lines {
@@ -669,6 +718,7 @@ namespace hex::ui {
             friend bool Range::Coordinates::isValid(Lines &lines);
             friend TextEditor::Coordinates Range::Coordinates::sanitize(Lines &lines);
             void appendLine(const std::string &value);
+            void appendLines(const StringVector &values);
             void removeHiddenLinesFromPattern();
             void addHiddenLinesToPattern();
             void setSelection(const Range &selection);
@@ -805,6 +855,7 @@ namespace hex::ui {
             Indices m_leadingLineSpaces;
             i32 m_undoIndex = 0;
             bool m_updateFlags = true;
+            u64 m_colorizedChangeCount = 0;
             Breakpoints m_breakpoints;
             ErrorMarkers m_errorMarkers;
             ErrorHoverBoxes m_errorHoverBoxes;
@@ -838,7 +889,8 @@ namespace hex::ui {
             float m_lineNumberFieldWidth = 0.0F;
             bool m_textChanged = false;
             LanguageDefinition m_languageDefinition;
-            RegexList m_regexList;
+            CharClasses m_charClasses = {};
+            std::pair<i32, i32> m_lexedDelimiterLines = { -1, -1 };
             float m_numberOfLinesDisplayed = 0;
             bool m_withinRender = false;
             bool m_initializedCodeFolds = false;
@@ -963,6 +1015,7 @@ namespace hex::ui {
         void deleteChar();
         void setReadOnly(bool value) { m_lines.setReadOnly(value); };
         void appendLine(const std::string &value);
+        void appendLines(const StringVector &values);
         void setOverwrite(bool value) { m_overwrite = value; }
         bool isOverwrite() const { return m_overwrite; }
         void setText(const std::string &text, bool undo = false);
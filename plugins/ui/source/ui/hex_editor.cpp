@@ -4,6 +4,7 @@
 #include <hex/api/localization_manager.hpp>
 
 #include <hex/helpers/encoding_file.hpp>
+#include <hex/helpers/profiler.hpp>
 #include <hex/helpers/utils.hpp>
 
 #include <wolv/utils/guards.hpp>
@@ -18,6 +19,24 @@
 
 namespace hex::ui {
 
+    namespace {
+
+        /**
+         * @brief Looks up the color run covering the given cell. Cells are visited in ascending address order,
+         * so the cursor only ever moves forward and the whole frame is resolved in a single pass over the runs
+         */
+        std::optional<color_t> findRunColor(std::span<const HexEditor::HighlightRun> runs, size_t &cursor, const Region &cell) {
+            while (cursor < runs.size() && runs[cursor].region.getEndAddress() < cell.getStartAddress())
+                cursor++;
+
+            if (cursor < runs.size() && runs[cursor].region.getStartAddress() <= cell.getEndAddress())
+                return runs[cursor].color;
+
+            return std::nullopt;
+        }
+
+    }
+
     /* Data Visualizer */
 
     class DataVisualizerAscii : public hex::ContentRegistry::HexEditor::DataVisualizer {
@@ -352,6 +371,8 @@ namespace hex::ui {
         }
         drawList->ChannelsSetCurrent(0);
 
+        prof::ScopedTimer timer(prof::Category::MiniMap, m_miniMapVisualizer->unlocalizedName.get(), 0, rowCount * bytesPerRow);
+
         std::vector<u8> rowData(bytesPerRow);
         std::vector<ImColor> rowColors;
         const auto drawStart = std::max<ImS64>(0, scrollPos - grabPos);
@@ -761,6 +782,24 @@ namespace hex::ui {
                     m_visibleRowCount = size.y / CharacterSize.y;
                     m_visibleRowCount = std::max<i64>(m_visibleRowCount, 1);
 
+                    // Resolve the highlight runs of all visible rows at once
+                    std::span<const HighlightRun> foregroundRuns, backgroundRuns;
+                    size_t foregroundRunCursor = 0, backgroundRunCursor = 0;
+                    {
+                        const u64 firstRow = m_scrollPosition;
+                        const u64 lastRow  = std::min<u64>(m_scrollPosition + m_visibleRowCount + 5, numRows);
+                        if (lastRow > firstRow) {
+                            const u64 startOffset = firstRow * bytesPerRow;
+                            const u64 endOffset   = std::min<u64>(lastRow * bytesPerRow, m_provider->getSize());
+
+                            if (endOffset > startOffset) {
+                                const Region visibleRegion = { .address=startOffset + m_provider->getBaseAddress() + m_provider->getCurrentPageAddress(), .size=endOffset - startOffset };
+                                foregroundRuns = m_foregroundRunCallback(visibleRegion);
+                                backgroundRuns = m_backgroundRunCallback(visibleRegion);
+                            }
+                        }
+                    }
+
                     // Loop over rows
                     std::vector<u8> bytes(bytesPerRow, 0x00);
                     std::vector<std::tuple<std::optional<color_t>, std::optional<color_t>>> cellColors(bytesPerRow / bytesPerCell);
@@ -796,6 +835,12 @@ namespace hex::ui {
                                     auto foregroundColor = m_foregroundColorCallback(byteAddress, &bytes[x * cellBytes], cellBytes);
                                     auto backgroundColor = m_backgroundColorCallback(byteAddress, &bytes[x * cellBytes], cellBytes);
 
+                                    const Region cellRegion = { .address=byteAddress, .size=cellBytes };
+                                    if (!foregroundColor.has_value())
+                                        foregroundColor = findRunColor(foregroundRuns, foregroundRunCursor, cellRegion);
+                                    if (auto runColor = findRunColor(backgroundRuns, backgroundRunCursor, cellRegion); runColor.has_value())
+                                        backgroundColor = ImU32(*blendColors(backgroundColor, ImColor(*runColor)));
+
                                     if (m_grayOutZero && !foregroundColor.has_value()) {
                                         bool allZero = true;
                                         for (u64 i = 0; i < cellBytes && (x * cellBytes + i) < bytes.size(); i++) {
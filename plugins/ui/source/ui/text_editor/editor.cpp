@@ -111,6 +111,33 @@ namespace hex::ui {
         m_lines.m_textChanged = true;
     }
 
+    // Unlike appendLine, empty lines are kept so the line count always matches the number of values appended
+    void Lines::appendLines(const StringVector &values) {
+        bool replaceFirstLine = isEmpty();
+        for (const auto &value : values) {
+            auto text = wolv::util::replaceStrings(wolv::util::preprocessText(value), "\000", ".");
+            auto maxColumn = stringCharacterCount(text);
+            if (replaceFirstLine) {
+                m_unfoldedLines[0].setLine(text);
+                replaceFirstLine = false;
+            } else {
+                m_unfoldedLines.emplace_back(text);
+            }
+            m_unfoldedLines.back().m_lineMaxColumn = maxColumn;
+            m_unfoldedLines.back().m_colorized = false;
+        }
+    }
+
+    void TextEditor::appendLines(const StringVector &values) {
+        if (values.empty())
+            return;
+
+        m_lines.appendLines(values);
+        m_lines.setCursorPosition(m_lines.lineCoordinates(m_lines.size() - 1, 0), false);
+        m_lines.ensureCursorVisible();
+        m_lines.m_textChanged = true;
+    }
+
     i32 Lines::insertTextAtCursor(const std::string &value) {
         if (value.empty())
             return 0;
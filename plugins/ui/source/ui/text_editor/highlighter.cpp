@@ -8,6 +8,7 @@ namespace hex::ui {
     using Keys = TextEditor::Keys;
     using Lines = TextEditor::Lines;
     using LanguageDefinition = TextEditor::LanguageDefinition;
+    using LexerState = TextEditor::LexerState;
 
     extern Palette s_paletteBase;
 
@@ -225,11 +226,34 @@ namespace hex::ui {
         }
     }
 
+    bool LexerState::operator==(const LexerState &other) const {
+        if (m_withinString != other.m_withinString || m_withinBlockComment != other.m_withinBlockComment ||
+            m_withinGlobalDocComment != other.m_withinGlobalDocComment || m_withinBlockDocComment != other.m_withinBlockDocComment ||
+            m_withinNotDef != other.m_withinNotDef || m_commentOpen != other.m_commentOpen)
+            return false;
+        if (m_preprocessor == other.m_preprocessor)
+            return true;
+        return m_preprocessor != nullptr && other.m_preprocessor != nullptr && *m_preprocessor == *other.m_preprocessor;
+    }
+
+    // Scans the lines for comments, strings and preprocessor blocks and stores the result in the line flags.
+    // Every line remembers the scanner state it started and ended with. A line whose contents didn't change
+    // and that starts in the same state as last time can't produce different flags, so the scan jumps
+    // straight to its cached end state. After an edit this re-scans the edited lines plus however many
+    // following lines are affected, e.g. up to the end of a newly opened block comment.
     void Lines::colorizeInternal(bool force) {
         if (isEmpty())
             return;
 
-        if (m_updateFlags) {
+        // Edits don't always request a new scan, but they always mark the lines they touched. That's only worth
+        // looking for if any line was marked since the last run
+        const auto colorizedChangeCount = ColorizedFlag::getChangeCount();
+        if (!m_updateFlags && colorizedChangeCount != m_colorizedChangeCount)
+            m_updateFlags = std::ranges::any_of(m_unfoldedLines, [](const Line &line) { return !line.m_colorized && !line.empty(); });
+        m_colorizedChangeCount = colorizedChangeCount;
+
+        if (m_updateFlags || force) {
+            m_updateFlags = false;
             auto endLine = size();
             auto commentStartLine = endLine;
             auto commentStartIndex = 0;
@@ -245,6 +269,54 @@ namespace hex::ui {
             std::vector<bool> ifDefs;
             ifDefs.push_back(true);
             m_defines.emplace_back("__IMHEX__");
+
+            // Snapshot of ifDefs and m_defines shared by the cached line states, rebuilt only after a directive
+            std::shared_ptr<const LexerState::Preprocessor> preprocessor;
+            bool preprocessorChanged = true;
+
+            auto saveState = [&] {
+                if (preprocessorChanged) {
+                    preprocessor = std::make_shared<const LexerState::Preprocessor>(LexerState::Preprocessor { ifDefs, m_defines });
+                    preprocessorChanged = false;
+                }
+
+                LexerState state;
+                state.m_withinString = withinString;
+                state.m_withinBlockComment = withinBlockComment;
+                state.m_withinGlobalDocComment = withinGlobalDocComment;
+                state.m_withinBlockDocComment = withinBlockDocComment;
+                state.m_withinNotDef = withinNotDef;
+                state.m_commentOpen = commentStartLine != endLine;
+                state.m_preprocessor = preprocessor;
+                return state;
+            };
+
+            // Only called at the end of a line, so an open block comment always started on this or an earlier line
+            auto restoreState = [&](const LexerState &state) {
+                withinString = state.m_withinString;
+                withinBlockComment = state.m_withinBlockComment;
+                withinGlobalDocComment = state.m_withinGlobalDocComment;
+                withinBlockDocComment = state.m_withinBlockDocComment;
+                withinNotDef = state.m_withinNotDef;
+                commentStartLine = state.m_commentOpen ? currentLine : endLine;
+                commentStartIndex = 0;
+                commentLength = 0;
+                if (state.m_preprocessor != preprocessor) {
+                    preprocessor = state.m_preprocessor;
+                    ifDefs = preprocessor->m_ifDefs;
+                    m_defines = preprocessor->m_defines;
+                }
+            };
+
+            // Lines holding the matched delimiters get their flags from the cursor position and not only from their contents
+            std::pair<i32, i32> delimiterLines = { -1, -1 };
+            if (m_matchedDelimiter.isActive())
+                delimiterLines = { m_matchedDelimiter.m_nearCursor.m_line, m_matchedDelimiter.m_matched.m_line };
+            auto isDelimiterLine = [&](i32 lineIndex) {
+                return lineIndex == delimiterLines.first || lineIndex == delimiterLines.second ||
+                       lineIndex == m_lexedDelimiterLines.first || lineIndex == m_lexedDelimiterLines.second;
+            };
+
             for (currentLine = 0; currentLine < endLine; currentLine++) {
                 auto &line = m_unfoldedLines[currentLine];
                 auto lineLength = line.size();
@@ -254,6 +326,17 @@ namespace hex::ui {
                     line.m_colorized = false;
                 }
 
+                auto startState = saveState();
+                if (!force && line.m_colorized && !isDelimiterLine(currentLine) && line.m_lexerStart == startState) {
+                    // Lines without directives adopt the current snapshot so later passes can compare pointers only
+                    if (line.m_lexerEnd.m_preprocessor == line.m_lexerStart.m_preprocessor)
+                        line.m_lexerEnd.m_preprocessor = preprocessor;
+                    line.m_lexerStart = std::move(startState);
+                    restoreState(line.m_lexerEnd);
+                    continue;
+                }
+                line.m_lexerStart = std::move(startState);
+
 
                 auto withinComment = false;
                 auto withinDocComment = false;
@@ -281,17 +364,20 @@ namespace hex::ui {
                 };
 
                 u64 currentIndex = 0;
-                if (line.empty())
+                if (line.empty()) {
+                    line.m_lexerEnd = line.m_lexerStart;
                     continue;
+                }
                 while (currentIndex < lineLength) {
 
                     char c = line[currentIndex];
+                    const u8 charClass = m_charClasses[static_cast<u8>(c)];
 
                     matchedBracket = false;
-                    if (s_separators.contains(c) && m_matchedDelimiter.isActive()) {
+                    if ((charClass & u8(CharClass::Separator)) != 0 && m_matchedDelimiter.isActive()) {
                         if (m_matchedDelimiter.m_nearCursor == lineIndexCoords(currentLine + 1, currentIndex) || m_matchedDelimiter.m_matched == lineIndexCoords(currentLine + 1, currentIndex))
                             matchedBracket = true;
-                    } else if (s_operators.contains(c) && m_matchedDelimiter.isActive()) {
+                    } else if ((charClass & u8(CharClass::Operator)) != 0 && m_matchedDelimiter.isActive()) {
                         Coordinates current = lineCoordinates(currentLine, currentIndex);
                         auto udt = static_cast<char>(PaletteIndex::UserDefinedType);
                         Coordinates cursor = Invalid;
@@ -377,6 +463,7 @@ namespace hex::ui {
                                         ifDefs.push_back(false);
                                 }
                             }
+                            preprocessorChanged = true;
                         }
 
                         if (c == '\"' && !withinPreproc && !isComment && !withinComment && !withinDocComment) {
@@ -393,7 +480,7 @@ namespace hex::ui {
                                 return !a.empty() && currentIndex + 1 >= a.size() && equals(a.begin(), a.end(), b.begin() + (currentIndex + 1 - a.size()), b.begin() + (currentIndex + 1), pred);
                             };
 
-                            if (!isComment && !withinComment && !withinDocComment && !withinPreproc && !withinString) {
+                            if ((charClass & u8(CharClass::CommentStart)) != 0 && !isComment && !withinComment && !withinDocComment && !withinPreproc && !withinString) {
                                 if (compareForth(m_languageDefinition.m_docComment, line.m_chars)) {
                                     withinDocComment = !isComment;
                                     commentLength = 3;
@@ -428,7 +515,7 @@ namespace hex::ui {
                             }
                             setGlyphFlags(currentIndex);
 
-                            if (compareBack(m_languageDefinition.m_commentEnd, line.m_chars) && ((commentStartLine != currentLine) || (commentStartIndex + commentLength < (i64) currentIndex))) {
+                            if ((charClass & u8(CharClass::CommentEnd)) != 0 && compareBack(m_languageDefinition.m_commentEnd, line.m_chars) && ((commentStartLine != currentLine) || (commentStartIndex + commentLength < (i64) currentIndex))) {
                                 withinBlockComment = false;
                                 withinBlockDocComment = false;
                                 withinGlobalDocComment = false;
@@ -456,19 +543,35 @@ namespace hex::ui {
                     currentIndex++;
                 }
                 withinNotDef = !ifDefs.back();
+                line.m_lexerEnd = saveState();
             }
             m_defines.clear();
+            m_lexedDelimiterLines = delimiterLines;
         }
         colorizeRange(force);
     }
 
     void Lines::setLanguageDefinition(const LanguageDefinition &languageDef) {
         m_languageDefinition = languageDef;
-        m_regexList.clear();
 
-        for (auto &r: m_languageDefinition.m_tokenRegexStrings)
-            m_regexList.emplace_back(std::regex(r.first, std::regex_constants::optimize), r.second);
+        m_charClasses = {};
+        auto addCharClass = [this](char c, CharClass charClass) {
+            m_charClasses[static_cast<u8>(c)] |= u8(charClass);
+        };
+
+        for (char c : s_separators)
+            addCharClass(c, CharClass::Separator);
+        for (char c : s_operators)
+            addCharClass(c, CharClass::Operator);
+        for (const auto &commentStart : { m_languageDefinition.m_docComment, m_languageDefinition.m_singleLineComment, m_languageDefinition.m_globalDocComment, m_languageDefinition.m_blockDocComment, m_languageDefinition.m_commentStart }) {
+            if (!commentStart.empty())
+                addCharClass(commentStart.front(), CharClass::CommentStart);
+        }
+        if (!m_languageDefinition.m_commentEnd.empty())
+            addCharClass(m_languageDefinition.m_commentEnd.back(), CharClass::CommentEnd);
 
+        for (auto &line : m_unfoldedLines)
+            line.m_colorized = false;
         colorize();
     }
 
@@ -709,16 +812,6 @@ namespace hex::ui {
                 langDef.m_identifiers.insert(std::make_pair(std::string(k), id));
             }
 
-            langDef.m_tokenRegexStrings.emplace_back("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Directive);
-            langDef.m_tokenRegexStrings.emplace_back(R"(L?\"(\\.|[^\"])*\")", PaletteIndex::StringLiteral);
-            langDef.m_tokenRegexStrings.emplace_back(R"(\'\\?[^\']\')", PaletteIndex::CharLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[0-7]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[a-zA-Z_][a-zA-Z0-9_]*", PaletteIndex::Identifier);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\!\%\^\&\*\-\+\=\~\|\<\>\?\/])", PaletteIndex::Operator);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\[\]\{\}\(\)\;\,\.])", PaletteIndex::Separator);
             langDef.m_commentStart = "/*";
             langDef.m_commentEnd = "*/";
             langDef.m_singleLineComment = "//";
@@ -760,16 +853,6 @@ namespace hex::ui {
                 langDef.m_identifiers.insert(std::make_pair(std::string(k), id));
             }
 
-            langDef.m_tokenRegexStrings.emplace_back("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Directive);
-            langDef.m_tokenRegexStrings.emplace_back(R"(L?\"(\\.|[^\"])*\")", PaletteIndex::StringLiteral);
-            langDef.m_tokenRegexStrings.emplace_back(R"(\'\\?[^\']\')", PaletteIndex::CharLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?",PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[0-7]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[a-zA-Z_][a-zA-Z0-9_]*", PaletteIndex::Identifier);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\!\%\^\&\*\-\+\=\~\|\<\>\?\/])", PaletteIndex::Operator);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\[\]\{\}\(\)\;\,\.])", PaletteIndex::Separator);
             langDef.m_commentStart = "/*";
             langDef.m_commentEnd = "*/";
             langDef.m_singleLineComment = "//";
@@ -904,16 +987,6 @@ namespace hex::ui {
                 langDef.m_identifiers.insert(std::make_pair(std::string(k), id));
             }
 
-            langDef.m_tokenRegexStrings.emplace_back("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Directive);
-            langDef.m_tokenRegexStrings.emplace_back(R"(L?\"(\\.|[^\"])*\")", PaletteIndex::StringLiteral);
-            langDef.m_tokenRegexStrings.emplace_back(R"(\'\\?[^\']\')", PaletteIndex::CharLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?",PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[0-7]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[a-zA-Z_][a-zA-Z0-9_]*", PaletteIndex::Identifier);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\!\%\^\&\*\-\+\=\~\|\<\>\?\/])", PaletteIndex::Operator);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\[\]\{\}\(\)\;\,\.])", PaletteIndex::Separator);
 
             langDef.m_commentStart = "/*";
             langDef.m_commentEnd = "*/";
@@ -957,16 +1030,6 @@ namespace hex::ui {
                 langDef.m_identifiers.insert(std::make_pair(std::string(k), id));
             }
 
-            langDef.m_tokenRegexStrings.emplace_back("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Directive);
-            langDef.m_tokenRegexStrings.emplace_back(R"(L?\"(\\.|[^\"])*\")", PaletteIndex::StringLiteral);
-            langDef.m_tokenRegexStrings.emplace_back(R"(\'\\?[^\']\')", PaletteIndex::CharLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?",PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[0-7]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[a-zA-Z_][a-zA-Z0-9_]*", PaletteIndex::Identifier);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\!\%\^\&\*\-\+\=\~\|\<\>\?\/])", PaletteIndex::Operator);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\[\]\{\}\(\)\;\,\.])", PaletteIndex::Separator);
 
             langDef.m_commentStart = "/*";
             langDef.m_commentEnd = "*/";
@@ -1021,16 +1084,6 @@ namespace hex::ui {
                 langDef.m_identifiers.insert(std::make_pair(std::string(k), id));
             }
 
-            langDef.m_tokenRegexStrings.emplace_back(R"([ \t]*#[ \t]*[a-zA-Z_]+)", PaletteIndex::Directive);
-            langDef.m_tokenRegexStrings.emplace_back(R"(L?\"(\\.|[^\"])*\")", PaletteIndex::StringLiteral);
-            langDef.m_tokenRegexStrings.emplace_back(R"(\'\\?[^\']\')", PaletteIndex::CharLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[+-]?[0-9]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[0-7]+[Uu]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?", PaletteIndex::NumericLiteral);
-            langDef.m_tokenRegexStrings.emplace_back("[a-zA-Z_][a-zA-Z0-9_]*", PaletteIndex::Identifier);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\!\%\^\&\*\-\+\=\~\|\<\>\?\/])", PaletteIndex::Operator);
-            langDef.m_tokenRegexStrings.emplace_back(R"([\[\]\{\}\(\)\;\,\.])", PaletteIndex::Separator);
 
             langDef.m_commentStart = "--[[";
             langDef.m_commentEnd = "]]";
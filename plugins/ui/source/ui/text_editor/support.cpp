@@ -5,6 +5,7 @@
 #include <pl/core/preprocessor.hpp>
 
 #include <algorithm>
+#include <regex>
 
 namespace hex::ui {
     using Interval           = TextEditor::Interval;
@@ -236,6 +237,8 @@ namespace hex::ui {
         m_flags = std::move(line.m_flags);
         m_colorized = line.m_colorized;
         m_lineMaxColumn = line.m_lineMaxColumn;
+        m_lexerStart = std::move(line.m_lexerStart);
+        m_lexerEnd = std::move(line.m_lexerEnd);
         return *this;
     }
 
@@ -516,6 +519,8 @@ namespace hex::ui {
         m_flags = text.m_flags;
         m_colorized = text.m_colorized;
         m_lineMaxColumn = text.m_lineMaxColumn;
+        m_lexerStart = text.m_lexerStart;
+        m_lexerEnd = text.m_lexerEnd;
     }
 
     bool Line::needsUpdate() const {
@@ -1108,34 +1113,66 @@ namespace hex::ui {
         if (m_optionsChanged)
             m_optionsChanged = false;
 
-        u64 byteIndex = 0;
         m_matches.clear();
         m_findWord = findWord;
-        auto startingPos = lines->m_state.m_cursorPosition;
-        auto saveState = lines->m_state;
-        Coordinates begin = lines->lineCoordinates(0, 0);
-        lines->m_state.m_cursorPosition = begin;
 
-        if (!findNext(lines, byteIndex)) {
-            lines->m_state = saveState;
-            lines->ensureCursorVisible();
-            return;
-        }
-        EditorState state = m_matches.back();
+        // Search through the text once instead of restarting the search for every match. This keeps
+        // searching the console usable even when it holds a large amount of output
+        std::string wordLower = m_findWord;
+        if (!getMatchCase())
+            std::transform(wordLower.begin(), wordLower.end(), wordLower.begin(), ::tolower);
+
+        std::string textSrc = lines->getText();
+        if (!getMatchCase())
+            std::transform(textSrc.begin(), textSrc.end(), textSrc.begin(), ::tolower);
 
-        while (state.m_cursorPosition < startingPos) {
-            if (!findNext(lines, byteIndex)) {
-                lines->m_state = saveState;
-                lines->ensureCursorVisible();
+        std::vector<u64> matchOffsets;
+        if (getWholeWord() || getFindRegEx()) {
+            std::regex regularExpression;
+            try {
+                regularExpression.assign(getFindRegEx() ? wordLower : make_wholeWord(wordLower));
+            } catch (const std::regex_error &e) {
+                hex::log::error("Error in regular expression: {}", e.what());
                 return;
             }
-            state = m_matches.back();
-        }
 
-        while (findNext(lines, byteIndex));
+            for (auto iter = std::sregex_iterator(textSrc.begin(), textSrc.end(), regularExpression); iter != std::sregex_iterator(); ++iter)
+                matchOffsets.push_back(iter->position());
+        } else {
+            for (auto textLoc = textSrc.find(wordLower); textLoc != std::string::npos; textLoc = textSrc.find(wordLower, textLoc + 1))
+                matchOffsets.push_back(textLoc);
+        }
 
+        // Match offsets are ascending, so both the start and the end coordinates can be found by walking forward through the text
+        struct OffsetWalker {
+            const std::string &text;
+            u64 offset = 0;
+            i32 line = 0;
+            u64 lineStart = 0;
+
+            std::pair<i32, i32> advance(u64 target) {
+                for (; offset < target; offset++) {
+                    if (text[offset] == '\n') {
+                        line++;
+                        lineStart = offset + 1;
+                    }
+                }
+                return { line, TextEditor::stringCharacterCount(text.substr(lineStart, target - lineStart)) };
+            }
+        };
+
+        OffsetWalker startWalker { textSrc }, endWalker { textSrc };
+        const u64 matchBytes = m_findWord.size();
+        for (const auto textLoc : matchOffsets) {
+            const auto [startLine, startColumn] = startWalker.advance(textLoc);
+            const auto [endLine, endColumn]     = endWalker.advance(std::min<u64>(textLoc + matchBytes, textSrc.size()));
+
+            EditorState state;
+            state.m_selection = Range(lines->lineCoordinates(startLine, startColumn), lines->lineCoordinates(endLine, endColumn));
+            state.m_cursorPosition = state.m_selection.m_end;
+            m_matches.push_back(state);
+        }
 
-        lines->m_state = saveState;
         lines->ensureCursorVisible();
    }
 
@@ -0,0 +1,81 @@
+#include <hex/test/tests.hpp>
+#include <hex/helpers/fmt.hpp>
+
+#include <ui/text_editor.hpp>
+
+using namespace hex;
+using namespace hex::ui;
+
+namespace {
+
+    std::string generateSource(u32 repetitions) {
+        std::string result;
+        for (u32 i = 0; i < repetitions; i++) {
+            result += fmt::format(
+                "#define FEATURE_{0}\n"
+                "#ifdef FEATURE_{0}\n"
+                "/// Header number {0}\n"
+                "struct Header{0} {{\n"
+                "    u32 magic; // \"magic\" value\n"
+                "    /* multi line\n"
+                "       comment */ u8 data[magic];\n"
+                "    char name[] = \"escaped \\\" quote\";\n"
+                "}};\n"
+                "#endif\n"
+                "#ifndef FEATURE_{0}\n"
+                "Header{0} header{0} @ 0x{0:X};\n"
+                "#endif\n"
+                "\n",
+                i);
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> getFlags(TextEditor &editor) {
+        auto &lines = editor.getLines();
+
+        std::vector<std::string> result;
+        for (i32 i = 0; i < lines.size(); i++)
+            result.push_back(lines[i].substr(0, (u64) -1, TextEditor::Line::LinePart::Flags));
+
+        return result;
+    }
+
+}
+
+TEST_SEQUENCE("TextEditor/IncrementalColorize") {
+    TextEditor editor;
+    editor.setText(generateSource(20));
+    editor.getLines().colorizeInternal();
+
+    // Edits that change how the following lines have to be scanned, and later edits that close them again
+    const std::vector<std::pair<TextEditor::Coordinates, std::string>> edits = {
+        { { 3, 0 },   "/* "                  },
+        { { 40, 0 },  " */"                  },
+        { { 10, 0 },  "\""                   },
+        { { 12, 0 },  "\""                   },
+        { { 30, 0 },  "#undef FEATURE_2\n"   },
+        { { 60, 0 },  "#ifdef UNKNOWN\n"     },
+        { { 90, 0 },  "#endif\n"             },
+        { { 100, 4 }, "// /* not a block\n"  },
+        { { 0, 0 },   "\n\n"                 },
+    };
+
+    for (auto [where, text] : edits) {
+        editor.getLines().insertTextAt(where, text);
+        editor.getLines().colorizeInternal();
+
+        TextEditor reference;
+        reference.setText(editor.getText());
+        reference.getLines().colorizeInternal(true);
+
+        const auto incrementalFlags = getFlags(editor);
+        const auto referenceFlags   = getFlags(reference);
+        TEST_ASSERT(incrementalFlags.size() == referenceFlags.size());
+        for (size_t line = 0; line < incrementalFlags.size(); line++)
+            TEST_ASSERT(incrementalFlags[line] == referenceFlags[line], "after inserting '{}', line {}", text, line);
+    }
+
+    TEST_SUCCESS();
+};
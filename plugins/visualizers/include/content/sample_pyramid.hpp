@@ -0,0 +1,85 @@
+#pragma once
+
+#include <hex.hpp>
+#include <hex/api/task_manager.hpp>
+
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace hex::plugin::visualizers {
+
+    /**
+     * @brief Multi-resolution summary of a long series of samples.
+     * Every level stores the minimum, maximum and mean of blocks of samples that are larger than the ones of the
+     * level below it, so any range of the series can be drawn with a bounded number of points without losing peaks
+     */
+    class SamplePyramid {
+    public:
+        struct Bucket {
+            u64 first, count;
+            float min, max, mean;
+        };
+
+        using SampleReader = std::function<void(u64 first, std::span<float> samples)>;
+
+        /**
+         * @brief Sets the function used to read the individual samples of ranges small enough to be drawn sample by sample
+         * @note The samples themselves aren't kept in memory. Without a reader, the finest level of blocks is used instead
+         * @param reader Function filling the given span with the samples starting at the given index
+         */
+        void setSampleReader(SampleReader reader) { m_sampleReader = std::move(reader); }
+
+        /**
+         * @brief Adds samples to the end of the series. They're summarized into the first level right away and not stored
+         * @param samples Samples to add
+         */
+        void append(std::span<const float> samples);
+
+        /**
+         * @brief Builds the remaining summary levels once all samples have been added
+         * @param task Task the pyramid is built on, checked for interruption
+         */
+        void finalize(Task &task);
+
+        [[nodiscard]] u64 getSampleCount() const { return m_sampleCount; }
+
+        /**
+         * @brief Summarizes a range of the series using the finest level that needs at most the given number of buckets
+         * @param first Index of the first sample in the range
+         * @param last Index one past the last sample in the range
+         * @param maxBuckets Maximum number of buckets that should be returned
+         * @return Buckets covering the range, one per sample if the range is small enough and a sample reader is set
+         */
+        [[nodiscard]] std::vector<Bucket> query(u64 first, u64 last, u64 maxBuckets) const;
+
+    private:
+        constexpr static u64 FirstBlockSize = 8;
+        constexpr static u64 BlockSizeFactor = 4;
+
+        struct Level {
+            u64 blockSize;
+            std::vector<float> min, max, mean;
+        };
+
+        void flushPendingBlock();
+
+        u64 m_sampleCount = 0;
+        std::vector<Level> m_levels;
+        SampleReader m_sampleReader;
+
+        // Summary of the block of the first level that's currently being filled
+        u64 m_pendingCount = 0;
+        float m_pendingMin = 0, m_pendingMax = 0;
+        double m_pendingSum = 0;
+    };
+
+    /**
+     * @brief Plots the part of a sample pyramid that's visible in the current plot.
+     * Zoomed out, the range between the minimum and maximum of every bucket is shaded and its mean is drawn as a line
+     * @param label Label of the plotted item
+     * @param pyramid Samples to plot, with the sample index as the X coordinate
+     */
+    void plotSamples(const char *label, const SamplePyramid &pyramid);
+
+}
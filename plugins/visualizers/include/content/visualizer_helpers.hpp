@@ -1,8 +1,16 @@
 #pragma once
 
+#include <hex/api/task_manager.hpp>
+
 #include <pl/pattern_language.hpp>
 #include <pl/patterns/pattern.hpp>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+
 namespace hex::plugin::visualizers {
 
     template<typename T>
@@ -17,4 +25,86 @@ namespace hex::plugin::visualizers {
         return result;
     }
 
-}
\ No newline at end of file
+    /**
+     * @brief Reads the data of a pattern as an array of values in fixed size chunks instead of copying all of it at once
+     * @param task Task the data is read from, checked for interruption after every chunk
+     * @param pattern Pattern to read
+     * @param callback Function called with every chunk of values
+     */
+    template<typename T>
+    void readPatternChunked(Task &task, pl::ptrn::Pattern *pattern, const std::function<void(std::span<const T>)> &callback) {
+        constexpr static u64 ChunkValueCount = 0x10000;
+
+        const auto valueCount = pattern->getSize() / sizeof(T);
+        std::vector<T> buffer(std::min<u64>(valueCount, ChunkValueCount));
+
+        auto *evaluator = pattern->getEvaluator();
+        for (u64 index = 0; index < valueCount; index += buffer.size()) {
+            task.update();
+
+            const auto count = std::min<u64>(buffer.size(), valueCount - index);
+            evaluator->readData(pattern->getOffset() + index * sizeof(T), buffer.data(), count * sizeof(T), pattern->getSection());
+            callback({ buffer.data(), count });
+        }
+    }
+
+    /**
+     * @brief Computes a value on a background task and hands it over to the UI thread once it's done.
+     * Starting a new computation interrupts the previous one and discards whatever it would have produced
+     */
+    template<typename T>
+    class BackgroundResult {
+    public:
+        void start(std::function<T(Task &)> function) {
+            this->reset();
+
+            auto slot = std::make_shared<Slot>();
+            m_slot = slot;
+            m_task = TaskManager::createTask("hex.visualizers.pl_visualizer.task.visualizing"_unlocalized, ProgressValue::None(), [slot, function = std::move(function)](Task &task) {
+                auto value = function(task);
+
+                std::scoped_lock lock(slot->mutex);
+                slot->value = std::move(value);
+            });
+        }
+
+        /**
+         * @brief Returns the computed value once it's available
+         * @return Pointer to the value or nullptr while it's still being computed
+         */
+        [[nodiscard]] T* get() {
+            if (m_slot != nullptr) {
+                std::unique_lock lock(m_slot->mutex, std::try_to_lock);
+                if (lock.owns_lock() && m_slot->value.has_value()) {
+                    m_value = std::move(m_slot->value);
+                    lock.unlock();
+                    m_slot.reset();
+                }
+            }
+
+            return m_value.has_value() ? &*m_value : nullptr;
+        }
+
+        [[nodiscard]] bool isRunning() const {
+            return m_task.isRunning();
+        }
+
+        void reset() {
+            m_task.interrupt();
+            m_task = {};
+            m_slot.reset();
+            m_value.reset();
+        }
+
+    private:
+        struct Slot {
+            std::mutex mutex;
+            std::optional<T> value;
+        };
+
+        TaskHolder m_task;
+        std::shared_ptr<Slot> m_slot;
+        std::optional<T> m_value;
+    };
+
+}
@@ -1,5 +1,7 @@
 #include <content/visualizer_helpers.hpp>
+#include <content/sample_pyramid.hpp>
 
+#include <hex/helpers/auto_reset.hpp>
 #include <hex/helpers/scaling.hpp>
 
 #include <implot.h>
@@ -8,13 +10,11 @@
 
 #include <pl/patterns/pattern_bitfield.hpp>
 
-namespace hex::plugin::visualizers {
+#include <algorithm>
 
-    void drawDigitalSignalVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
-        auto *bitfield = dynamic_cast<pl::ptrn::PatternBitfield*>(arguments[0].toPattern().get());
-        if (bitfield == nullptr)
-            throw std::logic_error("Digital signal visualizer only works with bitfields.");
+namespace hex::plugin::visualizers {
 
+    namespace {
 
         struct DataPoint {
             std::array<ImVec2, 2> points;
@@ -22,76 +22,138 @@ namespace hex::plugin::visualizers {
             std::string value;
             ImColor color;
         };
-        static std::vector<DataPoint> dataPoints;
-        static ImVec2 lastPoint;
+
+        struct SignalData {
+            std::vector<DataPoint> dataPoints;
+            SamplePyramid levels;
+            float length = 0;
+        };
+
+    }
+
+    void drawDigitalSignalVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
+        auto pattern = arguments[0].toPattern();
+        if (dynamic_cast<pl::ptrn::PatternBitfield*>(pattern.get()) == nullptr)
+            throw std::logic_error("Digital signal visualizer only works with bitfields.");
+
+        static AutoReset<BackgroundResult<SignalData>> signal;
+        static bool fitAxes = false;
 
         if (shouldReset) {
-            dataPoints.clear();
-            lastPoint = { 0, 0 };
-
-            bitfield->forEachEntry(0, bitfield->getEntryCount(), [&](u64, const auto &entry) {
-                size_t bitSize;
-                if (const auto *bitfieldField = dynamic_cast<pl::ptrn::PatternBitfieldField*>(entry.get()); bitfieldField != nullptr)
-                    bitSize = bitfieldField->getBitSize();
-                else
-                    bitSize = entry->getSize() * 8;
-
-                auto value = entry->getValue();
-                bool high = value.toUnsigned() > 0;
-                dataPoints.emplace_back(
-                     std::array<ImVec2, 2> { lastPoint, { lastPoint.x, high ? 1.0F : 0.0F } },
-                    entry->getDisplayName(),
-                    entry->getFormattedValue(),
-                    entry->getColor()
-                );
-
-                lastPoint = dataPoints.back().points[1];
-                lastPoint.x += float(bitSize);
+            signal->start([pattern](Task &task) {
+                auto *bitfield = static_cast<pl::ptrn::PatternBitfield*>(pattern.get());
+
+                SignalData result;
+                ImVec2 lastPoint = { 0, 0 };
+                bitfield->forEachEntry(0, bitfield->getEntryCount(), [&](u64, const auto &entry) {
+                    task.update();
+
+                    size_t bitSize;
+                    if (const auto *bitfieldField = dynamic_cast<pl::ptrn::PatternBitfieldField*>(entry.get()); bitfieldField != nullptr)
+                        bitSize = bitfieldField->getBitSize();
+                    else
+                        bitSize = entry->getSize() * 8;
+
+                    auto value = entry->getValue();
+                    bool high = value.toUnsigned() > 0;
+                    result.dataPoints.emplace_back(
+                         std::array<ImVec2, 2> { lastPoint, { lastPoint.x, high ? 1.0F : 0.0F } },
+                        entry->getDisplayName(),
+                        entry->getFormattedValue(),
+                        entry->getColor()
+                    );
+
+                    const float level = high ? 1.0F : 0.0F;
+                    result.levels.append({ &level, 1 });
+
+                    lastPoint = result.dataPoints.back().points[1];
+                    lastPoint.x += float(bitSize);
+                });
+
+                result.dataPoints.push_back({
+                    .points = { lastPoint, { lastPoint.x, 0 } },
+                    .label = "",
+                    .value = "",
+                    .color = ImColor(0x00)
+                });
+                result.length = lastPoint.x;
+                result.levels.finalize(task);
+
+                return result;
             });
+            fitAxes = true;
+        }
 
-            dataPoints.push_back({
-                .points = { lastPoint, { lastPoint.x, 0 } },
-                .label = "",
-                .value = "",
-                .color = ImColor(0x00)
-            });
+        const auto signalData = signal->get();
+        if (signalData == nullptr) {
+            if (signal->isRunning())
+                ImGuiExt::TextSpinner("hex.visualizers.pl_visualizer.task.visualizing"_lang);
+            return;
         }
 
+        const auto &dataPoints = signalData->dataPoints;
         if (ImPlot::BeginPlot("##Signal", ImVec2(600_scaled, 200_scaled), ImPlotFlags_NoLegend | ImPlotFlags_NoFrame | ImPlotFlags_NoMenus | ImPlotFlags_NoMouseText)) {
-            ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, 0, lastPoint.x);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0, signalData->length, fitAxes ? ImPlotCond_Always : ImPlotCond_Once);
+            ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, 0, signalData->length);
+            fitAxes = false;
 
             ImPlot::SetupAxis(ImAxis_Y1, "", ImPlotAxisFlags_LockMin | ImPlotAxisFlags_LockMax);
             ImPlot::SetupAxisFormat(ImAxis_Y1, "");
             ImPlot::SetupAxisLimits(ImAxis_Y1, -0.1F, 1.1F);
 
-            for (size_t i = 0; i < dataPoints.size() - 1; i += 1) {
-                const auto &left = dataPoints[i];
-                const auto &right = dataPoints[i + 1];
-
-                {
-                    auto x = left.points[1].x + ((right.points[0].x - left.points[1].x) / 2);
-                    ImPlot::Annotation(x, 0.55F, left.color, {}, false, "%s", left.label.c_str());
-                    ImPlot::Annotation(x, 0.40F, left.color, {}, false, "%s", left.value.c_str());
+            // Find the entries that are currently visible. The last data point only marks the end of the signal
+            const auto limits = ImPlot::GetPlotLimits();
+            const auto startsAfter = [](double x, const DataPoint &dataPoint) { return x < dataPoint.points[0].x; };
+            const auto firstVisible = u64(std::max<i64>(std::upper_bound(dataPoints.begin(), dataPoints.end() - 1, limits.X.Min, startsAfter) - dataPoints.begin() - 1, 0));
+            const auto lastVisible  = u64(std::upper_bound(dataPoints.begin(), dataPoints.end() - 1, limits.X.Max, startsAfter) - dataPoints.begin());
+
+            const auto maxDetailedEntries = u64(ImPlot::GetPlotSize().x / 4);
+            if (lastVisible - firstVisible <= maxDetailedEntries) {
+                for (u64 i = firstVisible; i < lastVisible; i += 1) {
+                    const auto &left = dataPoints[i];
+                    const auto &right = dataPoints[i + 1];
+
+                    {
+                        auto x = left.points[1].x + ((right.points[0].x - left.points[1].x) / 2);
+                        ImPlot::Annotation(x, 0.55F, left.color, {}, false, "%s", left.label.c_str());
+                        ImPlot::Annotation(x, 0.40F, left.color, {}, false, "%s", left.value.c_str());
+                    }
+
+                    {
+                        ImVec2 min = ImPlot::PlotToPixels(ImPlotPoint(left.points[0].x, 0));
+                        ImVec2 max = ImPlot::PlotToPixels(ImPlotPoint(right.points[1].x, 1));
+
+                        ImPlot::PushPlotClipRect();
+                        auto transparentColor = left.color;
+                        transparentColor.Value.w = 0.2F;
+                        ImPlot::GetPlotDrawList()->AddRectFilled(min, max, transparentColor);
+                        ImPlot::PopPlotClipRect();
+                    }
                 }
 
-                {
-                    ImVec2 min = ImPlot::PlotToPixels(ImPlotPoint(left.points[0].x, 0));
-                    ImVec2 max = ImPlot::PlotToPixels(ImPlotPoint(right.points[1].x, 1));
-
-                    ImPlot::PushPlotClipRect();
-                    auto transparentColor = left.color;
-                    transparentColor.Value.w = 0.2F;
-                    ImPlot::GetPlotDrawList()->AddRectFilled(min, max, transparentColor);
-                    ImPlot::PopPlotClipRect();
+                ImPlot::PushStyleVar(ImPlotStyleVar_LineWeight, 2_scaled);
+                ImPlot::PlotLineG("Signal", [](int idx, void *data) -> ImPlotPoint {
+                    return static_cast<const DataPoint*>(data)[idx / 2].points[idx % 2];
+                }, const_cast<DataPoint*>(&dataPoints[firstVisible]), int(lastVisible - firstVisible + 1) * 2);
+                ImPlot::PopStyleVar();
+            } else {
+                // Too many entries to tell apart, only show where the signal stays at one level and where it toggles
+                const auto color = ImPlot::GetColormapColor(0);
+                auto drawList = ImPlot::GetPlotDrawList();
+
+                ImPlot::PushPlotClipRect();
+                for (const auto &bucket : signalData->levels.query(firstVisible, lastVisible, maxDetailedEntries * 4)) {
+                    const auto startX = dataPoints[bucket.first].points[0].x;
+                    const auto endX   = dataPoints[bucket.first + bucket.count].points[0].x;
+
+                    if (bucket.min == bucket.max)
+                        drawList->AddLine(ImPlot::PlotToPixels(startX, bucket.min), ImPlot::PlotToPixels(endX, bucket.max), ImGui::GetColorU32(color), 2_scaled);
+                    else
+                        drawList->AddRectFilled(ImPlot::PlotToPixels(startX, bucket.max), ImPlot::PlotToPixels(endX, bucket.min), ImGui::GetColorU32(color));
                 }
+                ImPlot::PopPlotClipRect();
             }
 
-            ImPlot::PushStyleVar(ImPlotStyleVar_LineWeight, 2_scaled);
-            ImPlot::PlotLineG("Signal", [](int idx, void*) -> ImPlotPoint {
-                return dataPoints[idx / 2].points[idx % 2];
-            }, nullptr, dataPoints.size() * 2);
-            ImPlot::PopStyleVar();
-
             ImPlot::EndPlot();
         }
     }
@@ -1,129 +1,360 @@
 #include <content/visualizer_helpers.hpp>
 
+#include <hex/api/localization_manager.hpp>
 #include <hex/helpers/scaling.hpp>
 #include <hex/helpers/auto_reset.hpp>
 
 #include <imgui.h>
+#include <imgui_internal.h>
 #include <hex/ui/imgui_imhex_extensions.h>
 
+#include <cstring>
+#include <functional>
+#include <map>
+
 namespace hex::plugin::visualizers {
-    std::vector<u32> getIndices(pl::ptrn::Pattern *colorTablePattern, u64 width, u64 height);
-    ImGuiExt::Texture getTexture(pl::ptrn::Pattern *colorTablePattern, const std::vector<u32> &indices, u64 width, u64 height);
 
+    namespace {
 
-    void drawImageVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
-        static AutoReset<ImGuiExt::Texture> texture;
-        static float scale = 1.0F;
+        /**
+         * @brief Image that's decoded on a background task into a pyramid of downscaled levels.
+         * Each level is split into tiles and only the tiles that are visible at the current zoom level
+         * are uploaded to the GPU, so even huge images neither block the UI nor need one giant texture
+         */
+        class TiledImage {
+        public:
+            constexpr static u32 TileSize = 512;
+            constexpr static u32 MaxUploadsPerFrame = 4;
+            constexpr static size_t MaxCachedTiles = 64;
 
-        if (shouldReset) {
-            auto pattern  = arguments[0].toPattern();
+            struct Level {
+                u32 width = 0, height = 0;
+                std::vector<u8> pixels;
 
-            auto data = pattern->getBytes();
-            texture = ImGuiExt::Texture::fromImage(data.data(), data.size(), ImGuiExt::Texture::Filter::Nearest);
-            scale = 200_scaled / texture->getSize().x;
-        }
+                // Levels that aren't held in memory read their RGBA8 pixels straight from the data on demand instead
+                std::function<void(u32 x, u32 y, u32 width, u32 height, u8 *destination)> readPixels;
+
+                [[nodiscard]] bool isValid() const {
+                    return width > 0 && height > 0 && (readPixels != nullptr || pixels.size() >= size_t(width) * height * 4);
+                }
+
+                void read(u32 x, u32 y, u32 readWidth, u32 readHeight, u8 *destination) const {
+                    if (readPixels != nullptr) {
+                        readPixels(x, y, readWidth, readHeight, destination);
+                        return;
+                    }
+
+                    for (u32 row = 0; row < readHeight; row += 1)
+                        std::memcpy(&destination[size_t(row) * readWidth * 4], &pixels[(size_t(y + row) * width + x) * 4], size_t(readWidth) * 4);
+                }
+            };
 
-        if (texture.isValid())
-            ImGui::Image(*texture, texture->getSize() * scale);
+            using Decoder = std::function<Level(Task &)>;
 
-        if (ImGui::IsWindowHovered()) {
-            auto scrollDelta = ImGui::GetIO().MouseWheel;
-            if (scrollDelta != 0.0F) {
-                scale += scrollDelta * 0.1F;
-                scale = std::clamp(scale, 0.1F, 10.0F);
+            void load(Decoder decoder) {
+                this->reset();
+
+                m_levels.start([decoder = std::move(decoder)](Task &task) {
+                    std::vector<Level> levels;
+                    if (auto level = decoder(task); level.isValid()) {
+                        levels.push_back(std::move(level));
+
+                        while (levels.back().width > TileSize || levels.back().height > TileSize) {
+                            auto downscaled = downscale(levels.back(), task);
+                            levels.push_back(std::move(downscaled));
+                        }
+                    }
+
+                    return levels;
+                });
             }
-        }
-    }
 
-    void drawBitmapVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
-        static AutoReset<ImGuiExt::Texture> texture;
-        static float scale = 1.0F;
+            [[nodiscard]] bool isReady() {
+                const auto levels = m_levels.get();
+                return levels != nullptr && !levels->empty();
+            }
 
-        if (shouldReset) {
-            auto pattern  = arguments[0].toPattern();
-            auto width    = u64(arguments[1].toUnsigned());
-            auto height   = u64(arguments[2].toUnsigned());
-            bool hasColorTable = false;
+            [[nodiscard]] ImVec2 getSize() {
+                if (!this->isReady())
+                    return { };
 
-            if (arguments.size() == 4) {
-                auto colorTablePattern = arguments[3].toPattern();
+                const auto &level = m_levels.get()->front();
+                return { float(level.width), float(level.height) };
+            }
+
+            void draw(float scale) {
+                if (!this->isReady()) {
+                    if (m_levels.isRunning())
+                        ImGuiExt::TextSpinner("hex.visualizers.pl_visualizer.task.visualizing"_lang);
+                    return;
+                }
+
+                const auto &levels     = *m_levels.get();
+                const auto origin      = ImGui::GetCursorScreenPos();
+                const auto displaySize = this->getSize() * scale;
+                ImGui::Dummy(displaySize);
+                if (!ImGui::IsItemVisible())
+                    return;
+
+                auto drawList = ImGui::GetWindowDrawList();
+                const auto visibleMin = ImMax(drawList->GetClipRectMin(), origin);
+                const auto visibleMax = ImMin(drawList->GetClipRectMax(), origin + displaySize);
+                if (visibleMin.x >= visibleMax.x || visibleMin.y >= visibleMax.y)
+                    return;
+
+                // Use the smallest level that still has at least one texel per screen pixel
+                const auto pixelsPerTexel = scale * ImGui::GetIO().DisplayFramebufferScale.x;
+                u32 levelIndex = 0;
+                while (levelIndex + 1 < levels.size() && pixelsPerTexel * float(1U << (levelIndex + 1)) <= 1.0F)
+                    levelIndex += 1;
+
+                const auto &level = levels[levelIndex];
+                const ImVec2 levelSize  = { float(level.width), float(level.height) };
+                const ImVec2 levelScale = displaySize / levelSize;
+
+                const auto firstTileX = u32((visibleMin.x - origin.x) / levelScale.x) / TileSize;
+                const auto firstTileY = u32((visibleMin.y - origin.y) / levelScale.y) / TileSize;
+                const auto lastTileX  = std::min<u32>(u32((visibleMax.x - origin.x) / levelScale.x) / TileSize, (level.width - 1) / TileSize);
+                const auto lastTileY  = std::min<u32>(u32((visibleMax.y - origin.y) / levelScale.y) / TileSize, (level.height - 1) / TileSize);
+
+                m_uploadsThisFrame = 0;
+                for (u32 tileY = firstTileY; tileY <= lastTileY; tileY += 1) {
+                    for (u32 tileX = firstTileX; tileX <= lastTileX; tileX += 1) {
+                        const ImVec2 texelMin = { float(tileX * TileSize), float(tileY * TileSize) };
+                        const ImVec2 texelMax = ImMin(texelMin + ImVec2(TileSize, TileSize), levelSize);
+                        const auto screenMin = origin + texelMin * levelScale;
+                        const auto screenMax = origin + texelMax * levelScale;
+
+                        if (auto texture = this->getTile(levelIndex, tileX, tileY, false); texture != nullptr) {
+                            drawList->AddImage(*texture, screenMin, screenMax);
+                        } else {
+                            // Until the tile has been uploaded, fill its area from the smallest level which always fits into a single tile
+                            auto fallback = this->getTile(u32(levels.size() - 1), 0, 0, true);
+                            drawList->AddImage(*fallback, screenMin, screenMax, texelMin / levelSize, texelMax / levelSize);
+                        }
+                    }
+                }
 
-                if (colorTablePattern->getSize() > 0) {
-                    auto indices = getIndices(pattern.get(), width, height);
-                    texture = getTexture(colorTablePattern.get(), indices, width, height);
-                    hasColorTable = true;
+                // Free tiles that went out of view once the cache grows too large
+                if (m_tiles.size() > MaxCachedTiles) {
+                    const auto frame = ImGui::GetFrameCount();
+                    std::erase_if(m_tiles, [frame](const auto &entry) { return entry.second.lastUsedFrame != frame; });
                 }
             }
 
-            if (!hasColorTable) {
-                auto data = pattern->getBytes();
-                texture = ImGuiExt::Texture::fromBitmap(data.data(), data.size(), width, height, ImGuiExt::Texture::Filter::Nearest);
+            void reset() {
+                m_levels.reset();
+                m_tiles.clear();
+            }
+
+        private:
+            struct Tile {
+                ImGuiExt::Texture texture;
+                int lastUsedFrame = 0;
+            };
+
+            static Level downscale(const Level &source, Task &task) {
+                Level result;
+                result.width  = (source.width + 1) / 2;
+                result.height = (source.height + 1) / 2;
+                result.pixels.resize(size_t(result.width) * result.height * 4);
+
+                // Average each 2x2 block of pixels, repeating the last row and column for odd sizes.
+                // Only two rows of the source are needed at a time, so levels that aren't in memory are streamed
+                std::vector<u8> rows(size_t(source.width) * 2 * 4);
+                for (u32 y = 0; y < result.height; y += 1) {
+                    task.update();
+
+                    const auto rowCount = std::min(2U, source.height - y * 2);
+                    source.read(0, y * 2, source.width, rowCount, rows.data());
+
+                    const auto *row0 = &rows[0];
+                    const auto *row1 = &rows[size_t(rowCount - 1) * source.width * 4];
+                    auto *destination = &result.pixels[size_t(y) * result.width * 4];
+
+                    for (u32 x = 0; x < result.width; x += 1) {
+                        const auto x0 = size_t(x * 2) * 4;
+                        const auto x1 = size_t(std::min(x * 2 + 1, source.width - 1)) * 4;
+
+                        for (u32 channel = 0; channel < 4; channel += 1)
+                            destination[x * 4 + channel] = u8((row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel] + 2) / 4);
+                    }
+                }
+
+                return result;
             }
-        }
 
-        if (texture.isValid())
-            ImGui::Image(*texture, texture->getSize() * scale);
+            const ImGuiExt::Texture* getTile(u32 levelIndex, u32 tileX, u32 tileY, bool force) {
+                const auto key = (u64(levelIndex) << 48) | (u64(tileY) << 24) | u64(tileX);
+                if (auto it = m_tiles.find(key); it != m_tiles.end()) {
+                    it->second.lastUsedFrame = ImGui::GetFrameCount();
+                    return &it->second.texture;
+                }
+
+                // Limit the number of uploads per frame so zooming or scrolling into a new area doesn't stall the UI
+                if (!force && m_uploadsThisFrame >= MaxUploadsPerFrame)
+                    return nullptr;
+                m_uploadsThisFrame += 1;
+
+                const auto &level = (*m_levels.get())[levelIndex];
+                const auto startX = tileX * TileSize;
+                const auto startY = tileY * TileSize;
+                const auto width  = std::min(TileSize, level.width - startX);
+                const auto height = std::min(TileSize, level.height - startY);
+
+                std::vector<u8> pixels(size_t(width) * height * 4);
+                level.read(startX, startY, width, height, pixels.data());
+
+                auto &tile = m_tiles[key];
+                tile.texture = ImGuiExt::Texture::fromBitmap(pixels.data(), pixels.size(), width, height, levelIndex == 0 ? ImGuiExt::Texture::Filter::Nearest : ImGuiExt::Texture::Filter::Linear);
+                tile.lastUsedFrame = ImGui::GetFrameCount();
+
+                return &tile.texture;
+            }
+
+        private:
+            BackgroundResult<std::vector<Level>> m_levels;
+            std::map<u64, Tile> m_tiles;
+            u32 m_uploadsThisFrame = 0;
+        };
+
+        TiledImage::Level decodeIndexedBitmap(Task &task, const std::vector<u8> &bytes, const std::vector<u32> &colorTable, u32 width, u32 height) {
+            TiledImage::Level result;
+
+            const auto indexCount = u64(width) * height;
+            const auto byteCount  = bytes.size();
+            if (indexCount == 0 || byteCount == 0 || colorTable.empty())
+                return result;
+
+            // Indices are either one or two bytes each or two of them are packed into a single byte
+            u32 bytesPerIndex = 0;
+            if (byteCount >= indexCount) {
+                bytesPerIndex = byteCount / indexCount;
+                if (bytesPerIndex > 2)
+                    return result;
+            } else if (indexCount / byteCount != 2 || (indexCount + 1) / 2 > byteCount) {
+                return result;
+            }
+
+            result.width  = width;
+            result.height = height;
+            result.pixels.resize(indexCount * 4);
+
+            for (u32 y = 0; y < height; y += 1) {
+                task.update();
+
+                for (u32 x = 0; x < width; x += 1) {
+                    const auto i = u64(y) * width + x;
+
+                    u32 index;
+                    if (bytesPerIndex == 1) {
+                        index = bytes[i];
+                    } else if (bytesPerIndex == 2) {
+                        u16 value;
+                        std::memcpy(&value, &bytes[i * 2], sizeof(value));
+                        index = value;
+                    } else {
+                        index = (bytes[i / 2] >> ((i % 2) * 4)) & 0xF;
+                    }
+
+                    if (index >= colorTable.size())
+                        index = 0;
+
+                    std::memcpy(&result.pixels[i * 4], &colorTable[index], sizeof(u32));
+                }
+            }
+
+            return result;
+        }
 
-        if (ImGui::IsWindowHovered()) {
-            auto scrollDelta = ImGui::GetIO().MouseWheel;
+        void handleZoom(float &scale) {
+            if (ImGui::IsWindowHovered()) {
+                auto scrollDelta = ImGui::GetIO().MouseWheel;
 
-            if (scrollDelta != 0.0F) {
-                scale += scrollDelta * 0.1F;
-                scale = std::clamp(scale, 0.1F, 10.0F);
+                if (scrollDelta != 0.0F) {
+                    scale += scrollDelta * 0.1F;
+                    scale = std::clamp(scale, 0.1F, 10.0F);
+                }
             }
         }
+
     }
 
-    ImGuiExt::Texture getTexture(pl::ptrn::Pattern *colorTablePattern, const std::vector<u32> &indices, u64 width, u64 height) {
-        std::vector<u32> colorTable = patternToArray<u32>(colorTablePattern);
-        auto colorCount = colorTable.size();
-        auto indexCount = indices.size();
-        std::vector<u32> image(indexCount);
-        u32 *imageData = image.data();
+    void drawImageVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
+        static AutoReset<TiledImage> image;
+        static float scale = 1.0F;
+        static bool fitScale = false;
+
+        if (shouldReset) {
+            auto pattern = arguments[0].toPattern();
 
-        for (auto index : indices) {
+            image->load([pattern](Task &) {
+                const auto data = pattern->getBytes();
 
-            if (index >= colorCount)
-                index = 0;
-            *imageData++ = colorTable[index];
+                int width = 0, height = 0;
+                TiledImage::Level level;
+                level.pixels = ImGuiExt::Texture::decodeImage(std::as_bytes(std::span(data)), width, height);
+                level.width  = width;
+                level.height = height;
+
+                return level;
+            });
+            fitScale = true;
+        }
+
+        // The image size is only known once it has been decoded
+        if (fitScale && image->isReady()) {
+            scale = 200_scaled / image->getSize().x;
+            fitScale = false;
         }
 
-        void *tmp = image.data();
-        auto *data = static_cast<const ImU8 *>(tmp);
-        ImGuiExt::Texture texture = ImGuiExt::Texture::fromBitmap(data, indexCount * 4, width, height, ImGuiExt::Texture::Filter::Nearest);
-        return texture;
+        image->draw(scale);
+        handleZoom(scale);
     }
 
-    std::vector<u32> getIndices(pl::ptrn::Pattern *pattern, u64 width, u64 height) {
+    void drawBitmapVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
+        static AutoReset<TiledImage> image;
+        static float scale = 1.0F;
+
+        if (shouldReset) {
+            auto pattern  = arguments[0].toPattern();
+            auto width    = u32(arguments[1].toUnsigned());
+            auto height   = u32(arguments[2].toUnsigned());
 
-        std::vector<u32> indices;
+            std::shared_ptr<pl::ptrn::Pattern> colorTablePattern;
+            if (arguments.size() == 4) {
+                colorTablePattern = arguments[3].toPattern();
+                if (colorTablePattern->getSize() == 0)
+                    colorTablePattern = nullptr;
+            }
 
-        auto indexCount = (width * height);
-        auto byteCount =  pattern->getSize();
-        if (byteCount == 0 || indexCount == 0)
-            return indices;
+            image->load([pattern, colorTablePattern, width, height](Task &task) {
+                if (colorTablePattern != nullptr)
+                    return decodeIndexedBitmap(task, pattern->getBytes(), patternToArray<u32>(colorTablePattern.get()), width, height);
 
-        if (byteCount >= indexCount) {
-            auto bytesPerIndex = byteCount / indexCount;
+                // Without a color table, the data already is a RGBA8 bitmap. Instead of copying all of it,
+                // the full resolution level reads the rows of each tile from the data when the tile gets uploaded
+                TiledImage::Level level;
+                const auto byteCount = u64(width) * height * 4;
+                if (byteCount == 0 || pattern->getSize() < byteCount)
+                    return level;
 
-            if (bytesPerIndex == 1) {
-                auto bytes = patternToArray<u8>(pattern);
-                indices = std::vector<u32>(bytes.begin(), bytes.end());
-            } else if (bytesPerIndex == 2) {
-                auto shorts = patternToArray<u16>(pattern);
-                indices = std::vector<u32>(shorts.begin(), shorts.end());
-            }
-        } else {
-            auto indicesPerByte = indexCount / byteCount;
-            auto bytes = patternToArray<u8>(pattern);
-
-            if (indicesPerByte == 2) {
-                for (u8 byte : bytes) {
-                    indices.push_back(byte & 0xF);
-                    indices.push_back((byte >> 4) & 0xF);
-                }
-            }
+                level.width  = width;
+                level.height = height;
+                level.readPixels = [pattern, width](u32 x, u32 y, u32 readWidth, u32 readHeight, u8 *destination) {
+                    auto *evaluator = pattern->getEvaluator();
+                    for (u32 row = 0; row < readHeight; row += 1) {
+                        const auto offset = (u64(y + row) * width + x) * 4;
+                        evaluator->readData(pattern->getOffset() + offset, &destination[size_t(row) * readWidth * 4], u64(readWidth) * 4, pattern->getSection());
+                    }
+                };
+
+                return level;
+            });
         }
-        return indices;
+
+        image->draw(scale);
+        handleZoom(scale);
     }
+
 }
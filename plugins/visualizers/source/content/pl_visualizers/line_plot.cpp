@@ -1,30 +1,57 @@
 #include <hex/helpers/utils.hpp>
 
 #include <content/visualizer_helpers.hpp>
+#include <content/sample_pyramid.hpp>
 
 #include <implot.h>
 #include <imgui.h>
 
 #include <hex/ui/imgui_imhex_extensions.h>
+#include <hex/helpers/auto_reset.hpp>
 
 namespace hex::plugin::visualizers {
 
     void drawLinePlotVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
-        static std::vector<float> values;
+        static AutoReset<BackgroundResult<SamplePyramid>> values;
+        static bool fitAxes = false;
         auto dataPattern = arguments[0].toPattern();
 
-        if (ImPlot::BeginPlot("##plot", ImVec2(400, 250), ImPlotFlags_CanvasOnly)) {
-            ImPlot::SetupAxes("X", "Y", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+        if (shouldReset) {
+            values->start([dataPattern](Task &task) {
+                SamplePyramid pyramid;
+                readPatternChunked<float>(task, dataPattern.get(), [&](std::span<const float> chunk) {
+                    pyramid.append(chunk);
+                });
+                pyramid.finalize(task);
+
+                // Individual samples are only needed once the plot is zoomed in far enough, read them from the data then
+                pyramid.setSampleReader([dataPattern](u64 first, std::span<float> samples) {
+                    dataPattern->getEvaluator()->readData(dataPattern->getOffset() + first * sizeof(float), samples.data(), samples.size_bytes(), dataPattern->getSection());
+                });
+
+                return pyramid;
+            });
+            fitAxes = true;
+        }
 
-            if (shouldReset) {
-                values.clear();
-                values = sampleData(patternToArray<float>(dataPattern.get()), ImPlot::GetPlotSize().x * 4);
-            }
+        const auto pyramid = values->get();
+        if (pyramid == nullptr) {
+            if (values->isRunning())
+                ImGuiExt::TextSpinner("hex.visualizers.pl_visualizer.task.visualizing"_lang);
+            return;
+        }
+
+        if (ImPlot::BeginPlot("##plot", ImVec2(400, 250), ImPlotFlags_CanvasOnly)) {
+            // The X axis can be zoomed and panned freely, the Y axis always fits the currently visible samples
+            ImPlot::SetupAxes("X", "Y", ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit);
+            ImPlot::SetupAxisLimits(ImAxis_X1, 0, double(pyramid->getSampleCount()), fitAxes ? ImPlotCond_Always : ImPlotCond_Once);
+            ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, 0, double(pyramid->getSampleCount()));
+            fitAxes = false;
 
-            ImPlot::PlotLine("##line", values.data(), values.size());
+            plotSamples("##line", *pyramid);
 
             ImPlot::EndPlot();
         }
     }
 
-}
\ No newline at end of file
+}
@@ -1,4 +1,5 @@
 #include <content/visualizer_helpers.hpp>
+#include <content/sample_pyramid.hpp>
 
 #include <implot.h>
 #include <imgui.h>
@@ -8,111 +9,166 @@
 #include <hex/api/task_manager.hpp>
 
 #include <hex/ui/imgui_imhex_extensions.h>
+#include <hex/helpers/auto_reset.hpp>
 #include <hex/helpers/scaling.hpp>
 #include <hex/helpers/utils.hpp>
 
+#include <memory>
+
 namespace hex::plugin::visualizers {
 
+    namespace {
+
+        struct SoundData {
+            // Kept for playback, the plots read their individual samples from here as well instead of holding a copy
+            std::shared_ptr<const std::vector<i16>> waveData;
+            std::vector<SamplePyramid> channels;
+        };
+
+    }
+
     void drawSoundVisualizer(pl::ptrn::Pattern &, bool shouldReset, std::span<const pl::core::Token::Literal> arguments) {
         auto wavePattern = arguments[0].toPattern();
         auto channels    = u64(arguments[1].toUnsigned());
         auto sampleRate  = u64(arguments[2].toUnsigned());
-        u32 downSampling = wavePattern->getSize() /  300_scaled / 8 / channels;
 
-        static std::vector<i16> waveData;
-        static std::vector<std::vector<i16>> sampledData;
-        sampledData.resize(channels);
+        static AutoReset<BackgroundResult<SoundData>> sound;
         static ma_device audioDevice;
         static ma_device_config deviceConfig;
+        static bool deviceInitialized = false;
+        static bool fitAxes = false;
         static bool shouldStop = false;
         static u64 index = 0;
-        static TaskHolder resetTask;
 
         if (sampleRate == 0)
             throw std::logic_error(fmt::format("Invalid sample rate: {}", sampleRate));
         if (channels == 0)
             throw std::logic_error(fmt::format("Invalid channel count: {}", channels));
-        if (downSampling == 0)
-            throw std::logic_error(fmt::format("Invalid down sampling factor: {} / 2400 / {} = {}", wavePattern->getSize(), channels, downSampling));
-        u64 sampledIndex;
+
         if (shouldReset) {
-            waveData.clear();
+            // The audio device plays directly from the previous wave data, so it has to be released before that data goes away
+            if (deviceInitialized) {
+                ma_device_uninit(&audioDevice);
+                deviceInitialized = false;
+            }
+            index = 0;
 
-            resetTask = TaskManager::createTask("hex.visualizers.pl_visualizer.task.visualizing"_unlocalized, ProgressValue::None(), [=](Task &) {
-                ma_device_stop(&audioDevice);
-                waveData = patternToArray<i16>(wavePattern.get());
-                if (waveData.empty())
-                    return;
-                sampledData = sampleChannels(waveData, 300_scaled * 4, channels);
-                index = 0;
+            sound->start([wavePattern, channels](Task &task) {
+                SoundData result;
+                result.channels.resize(channels);
+
+                auto waveData = std::make_shared<std::vector<i16>>();
+                waveData->reserve(wavePattern->getSize() / sizeof(i16));
+
+                // Only the samples of the current chunk get converted, the pyramids summarize them right away
+                std::vector<std::vector<float>> channelSamples(channels);
+                readPatternChunked<i16>(task, wavePattern.get(), [&](std::span<const i16> chunk) {
+                    for (auto &samples : channelSamples)
+                        samples.clear();
 
-                deviceConfig = ma_device_config_init(ma_device_type_playback);
-                deviceConfig.playback.format   = ma_format_s16;
-                deviceConfig.playback.channels = channels;
-                deviceConfig.sampleRate        = sampleRate;
-                deviceConfig.pUserData         = &waveData;
-                deviceConfig.dataCallback      = [](ma_device *device, void *pOutput, const void *, ma_uint32 frameCount) {
-                    if (index >= waveData.size()) {
-                        index = 0;
-                        shouldStop = true;
-                        return;
+                    for (const auto sample : chunk) {
+                        channelSamples[waveData->size() % channels].push_back(sample);
+                        waveData->push_back(sample);
                     }
 
-                    ma_copy_pcm_frames(pOutput, waveData.data() + index, frameCount, device->playback.format, device->playback.channels);
-                    index += static_cast<u64>(frameCount) * device->playback.channels;
-                };
+                    for (u64 channel = 0; channel < channels; channel += 1)
+                        result.channels[channel].append(channelSamples[channel]);
+                });
+
+                for (u64 channel = 0; channel < channels; channel += 1) {
+                    auto &pyramid = result.channels[channel];
+                    pyramid.finalize(task);
+                    pyramid.setSampleReader([waveData, channel, channels](u64 first, std::span<float> samples) {
+                        for (u64 i = 0; i < samples.size(); i += 1)
+                            samples[i] = (*waveData)[(first + i) * channels + channel];
+                    });
+                }
+
+                result.waveData = std::move(waveData);
 
-                ma_device_init(nullptr, &deviceConfig, &audioDevice);
+                return result;
             });
+            fitAxes = true;
+        }
+
+        auto soundData = sound->get();
+        if (soundData != nullptr && !deviceInitialized && !soundData->waveData->empty()) {
+            deviceConfig = ma_device_config_init(ma_device_type_playback);
+            deviceConfig.playback.format   = ma_format_s16;
+            deviceConfig.playback.channels = channels;
+            deviceConfig.sampleRate        = sampleRate;
+            deviceConfig.pUserData         = const_cast<std::vector<i16>*>(soundData->waveData.get());
+            deviceConfig.dataCallback      = [](ma_device *device, void *pOutput, const void *, ma_uint32 frameCount) {
+                const auto &waveData = *static_cast<const std::vector<i16>*>(device->pUserData);
+                if (index >= waveData.size()) {
+                    index = 0;
+                    shouldStop = true;
+                    return;
+                }
+
+                ma_copy_pcm_frames(pOutput, waveData.data() + index, frameCount, device->playback.format, device->playback.channels);
+                index += static_cast<u64>(frameCount) * device->playback.channels;
+            };
+
+            deviceInitialized = ma_device_init(nullptr, &deviceConfig, &audioDevice) == MA_SUCCESS;
         }
-        sampledIndex = index / downSampling;
-        ImGui::BeginDisabled(resetTask.isRunning());
-        u32 waveDataSize = waveData.size();
-        u32 sampledDataSize = sampledData[0].size();
+
+        const u64 waveDataSize = soundData == nullptr ? 0 : soundData->waveData->size();
+        const u64 frameCount   = waveDataSize / channels;
+        const u64 playbackFrame = index / channels;
+        u64 frameIndex = playbackFrame;
+
+        ImGui::BeginDisabled(soundData == nullptr);
         auto subplotFlags = ImPlotSubplotFlags_LinkAllX | ImPlotSubplotFlags_LinkCols | ImPlotSubplotFlags_NoResize;
-        auto plotFlags = ImPlotFlags_CanvasOnly | ImPlotFlags_NoFrame | ImPlotFlags_NoInputs;
-        auto axisFlags = ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus | ImPlotAxisFlags_AutoFit;
+        auto plotFlags = ImPlotFlags_CanvasOnly | ImPlotFlags_NoFrame;
+        auto axisFlags = ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoMenus;
         ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
 
         if (ImPlot::BeginSubplots("##AxisLinking", channels, 1, scaled(ImVec2(300, 80 * channels)), subplotFlags)) {
             for (u32 i = 0; i < channels; i++) {
                 if (ImPlot::BeginPlot("##amplitude_plot", scaled(ImVec2(300, 80)), plotFlags)) {
+                    // Time can be zoomed and panned, the amplitude always fits the currently visible samples
+                    ImPlot::SetupAxes("##time", "##amplitude", axisFlags, axisFlags | ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit);
+                    ImPlot::SetupAxisLimits(ImAxis_X1, 0, double(frameCount), fitAxes ? ImPlotCond_Always : ImPlotCond_Once);
+                    ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, 0, double(frameCount));
 
-                    ImPlot::SetupAxes("##time", "##amplitude", axisFlags, axisFlags);
-                    double dragPos = sampledIndex;
-                    if (ImPlot::DragLineX(1, &dragPos, ImGui::GetStyleColorVec4(ImGuiCol_Text))) {
+                    double dragPos = frameIndex;
+                    if (ImPlot::DragLineX(1, &dragPos, ImGui::GetStyleColorVec4(ImGuiCol_Text)) && frameCount > 0) {
                         if (dragPos < 0) dragPos = 0;
-                        if (dragPos >= sampledDataSize) dragPos = sampledDataSize - 1;
+                        if (dragPos >= frameCount) dragPos = frameCount - 1;
 
-                        sampledIndex = dragPos;
+                        frameIndex = dragPos;
                     }
-                    ImPlot::PlotLine("##audio", sampledData[i].data(), sampledDataSize);
+
+                    if (soundData != nullptr)
+                        plotSamples("##audio", soundData->channels[i]);
 
                     ImPlot::EndPlot();
                 }
             }
             ImPlot::PopStyleVar();
+            fitAxes = false;
 
-            index = sampledIndex * downSampling;
             {
-                const u64 min = 0, max = sampledDataSize-1;
+                const u64 min = 0, max = frameCount == 0 ? 0 : frameCount - 1;
                 ImGui::PushItemWidth(300_scaled);
                 ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(0, 0));
-                ImGui::SliderScalar("##index", ImGuiDataType_U64, &sampledIndex, &min, &max, "");
+                ImGui::SliderScalar("##index", ImGuiDataType_U64, &frameIndex, &min, &max, "");
                 ImGui::PopStyleVar();
                 ImGui::PopItemWidth();
             }
-            index = sampledIndex * downSampling;
-
+            // Only seek if the position was changed here, the audio device keeps advancing it in the meantime
+            if (frameIndex != playbackFrame)
+                index = frameIndex * channels;
 
             if (shouldStop) {
                 shouldStop = false;
                 ma_device_stop(&audioDevice);
             }
 
-            bool playing = ma_device_is_started(&audioDevice);
+            bool playing = deviceInitialized && ma_device_is_started(&audioDevice);
 
-            if (ImGuiExt::IconButton(playing ? ICON_VS_DEBUG_PAUSE : ICON_VS_PLAY, ImGuiExt::GetCustomColorVec4(ImGuiCustomCol_ToolbarGreen))) {
+            if (ImGuiExt::IconButton(playing ? ICON_VS_DEBUG_PAUSE : ICON_VS_PLAY, ImGuiExt::GetCustomColorVec4(ImGuiCustomCol_ToolbarGreen)) && deviceInitialized) {
                 if (playing)
                     ma_device_stop(&audioDevice);
                 else
@@ -121,20 +177,18 @@ namespace hex::plugin::visualizers {
 
             ImGui::SameLine();
 
-            if (ImGuiExt::IconButton(ICON_VS_DEBUG_STOP, ImGuiExt::GetCustomColorVec4(ImGuiCustomCol_ToolbarRed))) {
+            if (ImGuiExt::IconButton(ICON_VS_DEBUG_STOP, ImGuiExt::GetCustomColorVec4(ImGuiCustomCol_ToolbarRed)) && deviceInitialized) {
                 index = 0;
-                sampledIndex = 0;
                 ma_device_stop(&audioDevice);
             }
 
             ImGui::EndDisabled();
 
             ImGui::SameLine();
-            index = sampledIndex * downSampling;
 
-            if (resetTask.isRunning())
+            if (sound->isRunning())
                 ImGuiExt::TextSpinner("");
-            else
+            else if (waveDataSize > 0)
                 ImGuiExt::TextFormatted("{:02d}:{:02d}:{:03d} / {:02d}:{:02d}:{:03d}",
                                         (index / sampleRate / channels) / 60, (index / sampleRate / channels) % 60, (index * 1000 / sampleRate / channels ) % 1000,
                                         ((waveDataSize-1) / sampleRate / channels) / 60, ((waveDataSize-1) / sampleRate / channels) % 60, ((waveDataSize-1) * 1000 / sampleRate / channels) % 1000);
@@ -142,4 +196,4 @@ namespace hex::plugin::visualizers {
         }
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,157 @@
+#include <content/sample_pyramid.hpp>
+
+#include <implot.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hex::plugin::visualizers {
+
+    void SamplePyramid::append(std::span<const float> samples) {
+        if (m_levels.empty())
+            m_levels.push_back({ .blockSize = FirstBlockSize, .min = {}, .max = {}, .mean = {} });
+
+        for (const auto sample : samples) {
+            if (m_pendingCount == 0) {
+                m_pendingMin = sample;
+                m_pendingMax = sample;
+                m_pendingSum = 0;
+            } else {
+                m_pendingMin = std::min(m_pendingMin, sample);
+                m_pendingMax = std::max(m_pendingMax, sample);
+            }
+
+            m_pendingSum   += sample;
+            m_pendingCount += 1;
+
+            if (m_pendingCount == FirstBlockSize)
+                this->flushPendingBlock();
+        }
+
+        m_sampleCount += samples.size();
+    }
+
+    void SamplePyramid::flushPendingBlock() {
+        if (m_pendingCount == 0)
+            return;
+
+        auto &level = m_levels.front();
+        level.min.push_back(m_pendingMin);
+        level.max.push_back(m_pendingMax);
+        level.mean.push_back(float(m_pendingSum / double(m_pendingCount)));
+
+        m_pendingCount = 0;
+    }
+
+    void SamplePyramid::finalize(Task &task) {
+        if (m_levels.empty())
+            return;
+
+        // The first level was built while the samples were added, only the last partial block is left
+        this->flushPendingBlock();
+        m_levels.resize(1);
+
+        // Every further level combines a few blocks of the previous one, weighting the means by how many samples they cover
+        while (m_levels.back().min.size() > 1) {
+            const auto &previous = m_levels.back();
+            const auto childCount = previous.min.size();
+
+            Level level = { .blockSize = previous.blockSize * BlockSizeFactor, .min = {}, .max = {}, .mean = {} };
+            const auto blockCount = (childCount + BlockSizeFactor - 1) / BlockSizeFactor;
+            level.min.resize(blockCount);
+            level.max.resize(blockCount);
+            level.mean.resize(blockCount);
+
+            for (u64 block = 0; block < blockCount; block += 1) {
+                if (block % 0x10000 == 0)
+                    task.update();
+
+                float min = std::numeric_limits<float>::max();
+                float max = std::numeric_limits<float>::lowest();
+                double sum = 0;
+                u64 count = 0;
+                for (u64 child = block * BlockSizeFactor; child < std::min(childCount, (block + 1) * BlockSizeFactor); child += 1) {
+                    const auto childSamples = std::min(previous.blockSize, m_sampleCount - child * previous.blockSize);
+
+                    min = std::min(min, previous.min[child]);
+                    max = std::max(max, previous.max[child]);
+                    sum += double(previous.mean[child]) * double(childSamples);
+                    count += childSamples;
+                }
+
+                level.min[block]  = min;
+                level.max[block]  = max;
+                level.mean[block] = float(sum / double(count));
+            }
+
+            m_levels.push_back(std::move(level));
+        }
+    }
+
+    std::vector<SamplePyramid::Bucket> SamplePyramid::query(u64 first, u64 last, u64 maxBuckets) const {
+        last  = std::min(last, m_sampleCount);
+        first = std::min(first, last);
+
+        std::vector<Bucket> result;
+        if (first == last || m_levels.empty())
+            return result;
+
+        const auto rangeSize = last - first;
+        if (rangeSize <= maxBuckets && m_sampleReader != nullptr) {
+            std::vector<float> samples(rangeSize);
+            m_sampleReader(first, samples);
+
+            result.reserve(rangeSize);
+            for (u64 i = 0; i < rangeSize; i += 1)
+                result.push_back({ first + i, 1, samples[i], samples[i], samples[i] });
+
+            return result;
+        }
+
+        auto level = std::find_if(m_levels.begin(), m_levels.end(), [&](const Level &candidate) {
+            return (rangeSize + candidate.blockSize - 1) / candidate.blockSize <= maxBuckets;
+        });
+        if (level == m_levels.end())
+            level = m_levels.end() - 1;
+
+        const auto firstBlock = first / level->blockSize;
+        const auto lastBlock  = std::min<u64>((last - 1) / level->blockSize, level->min.size() - 1);
+        result.reserve(lastBlock - firstBlock + 1);
+        for (u64 block = firstBlock; block <= lastBlock; block += 1) {
+            const auto blockStart = block * level->blockSize;
+            result.push_back({ blockStart, std::min(level->blockSize, m_sampleCount - blockStart), level->min[block], level->max[block], level->mean[block] });
+        }
+
+        return result;
+    }
+
+    void plotSamples(const char *label, const SamplePyramid &pyramid) {
+        const auto limits = ImPlot::GetPlotLimits();
+        const auto first  = u64(std::max(0.0, std::floor(limits.X.Min)));
+        const auto last   = u64(std::max(0.0, std::ceil(limits.X.Max) + 1));
+
+        // Two buckets per pixel are enough to show every peak without drawing more points than necessary
+        const auto buckets = pyramid.query(first, last, u64(std::max(1.0F, ImPlot::GetPlotSize().x * 2)));
+        if (buckets.empty())
+            return;
+
+        constexpr static auto getX = [](const SamplePyramid::Bucket &bucket) {
+            return double(bucket.first) + double(bucket.count - 1) / 2;
+        };
+
+        auto data = const_cast<SamplePyramid::Bucket*>(buckets.data());
+        if (buckets.front().count > 1) {
+            ImPlot::PlotShadedG(label,
+                [](int idx, void *userData) { const auto &bucket = static_cast<SamplePyramid::Bucket*>(userData)[idx]; return ImPlotPoint(getX(bucket), bucket.min); }, data,
+                [](int idx, void *userData) { const auto &bucket = static_cast<SamplePyramid::Bucket*>(userData)[idx]; return ImPlotPoint(getX(bucket), bucket.max); }, data,
+                int(buckets.size()));
+        }
+
+        ImPlot::PlotLineG(label, [](int idx, void *userData) {
+            const auto &bucket = static_cast<SamplePyramid::Bucket*>(userData)[idx];
+            return ImPlotPoint(getX(bucket), bucket.mean);
+        }, data, int(buckets.size()));
+    }
+
+}
@@ -0,0 +1,106 @@
+#include <hex/test/tests.hpp>
+#include <hex/api/task_manager.hpp>
+
+#include <content/sample_pyramid.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace hex;
+using namespace hex::plugin::visualizers;
+
+namespace {
+
+    std::vector<float> generateSamples(size_t count) {
+        std::mt19937 random(0x1234);
+        std::uniform_real_distribution<float> distribution(-100.0F, 100.0F);
+
+        std::vector<float> result(count);
+        for (auto &sample : result)
+            sample = distribution(random);
+
+        return result;
+    }
+
+    // Checks every bucket against the samples it claims to cover and that the buckets cover the queried range
+    bool bucketsMatch(const std::vector<SamplePyramid::Bucket> &buckets, const std::vector<float> &samples, u64 first, u64 last) {
+        if (buckets.empty())
+            return first == last;
+        if (buckets.front().first > first || buckets.back().first + buckets.back().count < last)
+            return false;
+
+        for (size_t i = 0; i < buckets.size(); i += 1) {
+            const auto &bucket = buckets[i];
+            if (i > 0 && buckets[i - 1].first + buckets[i - 1].count != bucket.first)
+                return false;
+
+            const auto begin = samples.begin() + bucket.first;
+            const auto end   = begin + bucket.count;
+            const auto [min, max] = std::minmax_element(begin, end);
+
+            double sum = 0;
+            for (auto it = begin; it != end; ++it)
+                sum += *it;
+
+            if (bucket.min != *min || bucket.max != *max || std::abs(bucket.mean - sum / double(bucket.count)) > 0.01)
+                return false;
+        }
+
+        return true;
+    }
+
+}
+
+TEST_SEQUENCE("Visualizers/SamplePyramid") {
+    Task task("hex.visualizers.pl_visualizer.task.visualizing"_unlocalized, ProgressValue::None(), true, false, [](Task &) { });
+
+    const auto samples = generateSamples(100'003);
+
+    // Samples arrive in chunks that don't line up with any block size
+    SamplePyramid pyramid;
+    for (size_t offset = 0, chunkSize = 1; offset < samples.size(); offset += chunkSize, chunkSize = chunkSize * 3 + 1)
+        pyramid.append(std::span(samples).subspan(offset, std::min(chunkSize, samples.size() - offset)));
+    pyramid.finalize(task);
+
+    TEST_ASSERT(pyramid.getSampleCount() == samples.size());
+
+    const std::vector<std::pair<u64, u64>> ranges = {
+        { 0, samples.size() }, { 0, 1 }, { 5, 13 }, { 7, 1'000 }, { 12'345, 67'890 }, { 99'990, samples.size() }, { 50, 50 }
+    };
+    for (const auto &[first, last] : ranges) {
+        for (const u64 maxBuckets : { 1, 16, 400, 100'000 }) {
+            const auto buckets = pyramid.query(first, last, maxBuckets);
+            TEST_ASSERT(bucketsMatch(buckets, samples, first, last), "range {}-{} with {} buckets", first, last, maxBuckets);
+
+            // Ranges that don't start on a block boundary may touch one more block than requested
+            TEST_ASSERT(buckets.size() <= maxBuckets + 1, "range {}-{} returned {} buckets", first, last, buckets.size());
+        }
+    }
+
+    // Queries past the end are clamped
+    TEST_ASSERT(bucketsMatch(pyramid.query(99'000, 200'000, 400), samples, 99'000, samples.size()));
+    TEST_ASSERT(pyramid.query(200'000, 300'000, 400).empty());
+
+    // Without a reader, small ranges are answered from the finest level, with one they're read sample by sample
+    TEST_ASSERT(pyramid.query(100, 110, 400).front().count > 1);
+
+    u64 readCount = 0;
+    pyramid.setSampleReader([&](u64 first, std::span<float> destination) {
+        readCount += destination.size();
+        std::copy_n(samples.begin() + first, destination.size(), destination.begin());
+    });
+
+    const auto buckets = pyramid.query(100, 110, 400);
+    TEST_ASSERT(buckets.size() == 10 && readCount == 10);
+    TEST_ASSERT(bucketsMatch(buckets, samples, 100, 110));
+    TEST_ASSERT(std::ranges::all_of(buckets, [](const auto &bucket) { return bucket.count == 1; }));
+
+    // An empty pyramid has nothing to return
+    SamplePyramid empty;
+    empty.finalize(task);
+    TEST_ASSERT(empty.getSampleCount() == 0 && empty.query(0, 10, 10).empty());
+
+    TEST_SUCCESS();
+};
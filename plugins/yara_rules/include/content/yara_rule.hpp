@@ -2,11 +2,15 @@
 
 #include <hex/providers/provider.hpp>
 
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
-#include <atomic>
 #include <wolv/utils/expected.hpp>
 
+struct YR_RULES;
+
 namespace hex::plugin::yara {
 
     class YaraRule {
@@ -18,6 +22,9 @@ namespace hex::plugin::yara {
         static void init();
         static void cleanup();
 
+        // libyara refuses to run more than YR_MAX_THREADS scans at the same time
+        constexpr static u32 MaxConcurrentMatches = 32;
+
         struct Match {
             std::string variable;
             Region region;
@@ -46,6 +53,13 @@ namespace hex::plugin::yara {
             std::string message;
         };
 
+        /**
+         * @brief Compiles the rule. A compiled rule can be matched against any number of providers, also from multiple threads at once
+         * @note match() compiles the rule itself if this hasn't been done yet
+         * @return The compilation error if the rule is invalid
+         */
+        std::optional<Error> compile();
+
         wolv::util::Expected<Result, Error> match(prv::Provider *provider, Region region);
         void interrupt();
         [[nodiscard]] bool isInterrupted() const;
@@ -53,6 +67,7 @@ namespace hex::plugin::yara {
     private:
         std::string m_content;
         std::fs::path m_filePath;
+        std::shared_ptr<YR_RULES> m_rules;
 
         std::atomic<bool> m_interrupted = false;
     };
@@ -0,0 +1,79 @@
+#include <hex/api/content_registry/batch_analysis.hpp>
+
+#include <content/yara_rule.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace hex::plugin::yara {
+
+    void registerBatchAnalyses() {
+        ContentRegistry::BatchAnalysis::addAnalysis("yara", "Matches the YARA rules in the given file", [](prv::Provider *provider, const std::string &argument) -> nlohmann::json {
+            if (argument.empty())
+                throw std::invalid_argument("No YARA rule file specified");
+
+            // Initializing libyara is not thread-safe, so make sure it only happens once
+            static std::once_flag initFlag;
+            std::call_once(initFlag, [] { YaraRule::init(); });
+
+            // The same rule file is usually matched against every analyzed file, so it's only compiled once.
+            // Rules that failed to compile are remembered as well so the error isn't generated again for every file
+            struct CompiledRule {
+                std::shared_ptr<YaraRule> rule;
+                std::string error;
+            };
+
+            static std::mutex rulesMutex;
+            static std::map<std::string, CompiledRule> compiledRules;
+
+            std::shared_ptr<YaraRule> rule;
+            {
+                std::scoped_lock lock(rulesMutex);
+
+                auto [it, inserted] = compiledRules.try_emplace(argument);
+                auto &compiledRule = it->second;
+                if (inserted) {
+                    compiledRule.rule = std::make_shared<YaraRule>(std::fs::path(reinterpret_cast<const char8_t*>(argument.c_str())));
+                    if (const auto error = compiledRule.rule->compile(); error.has_value()) {
+                        compiledRule.rule.reset();
+                        compiledRule.error = error->message;
+                    }
+                }
+
+                if (compiledRule.rule == nullptr)
+                    throw std::runtime_error(compiledRule.error);
+
+                rule = compiledRule.rule;
+            }
+
+            const auto result = rule->match(provider, { provider->getBaseAddress(), provider->getActualSize() });
+            if (!result.has_value())
+                throw std::runtime_error(result.error().message);
+
+            nlohmann::json matchedRules = nlohmann::json::array();
+            for (const auto &matchedRule : result->matchedRules) {
+                nlohmann::json matches = nlohmann::json::array();
+                for (const auto &match : matchedRule.matches) {
+                    matches.push_back({
+                        { "variable", match.variable        },
+                        { "address",  match.region.address  },
+                        { "size",     match.region.size     }
+                    });
+                }
+
+                matchedRules.push_back({
+                    { "identifier", matchedRule.identifier },
+                    { "tags",       matchedRule.tags       },
+                    { "metadata",   matchedRule.metadata   },
+                    { "matches",    std::move(matches)     }
+                });
+            }
+
+            return matchedRules;
+        }, YaraRule::MaxConcurrentMatches);
+    }
+
+}
@@ -1,5 +1,7 @@
 #include <content/yara_rule.hpp>
 
+#include <hex/helpers/fmt.hpp>
+
 #include <wolv/literals.hpp>
 #include <wolv/utils/guards.hpp>
 #include <wolv/utils/string.hpp>
@@ -26,6 +28,8 @@ namespace hex::plugin::yara {
 
     using namespace wolv::literals;
 
+    static_assert(YaraRule::MaxConcurrentMatches <= YR_MAX_THREADS);
+
     struct ResultContext {
         YaraRule *rule;
         std::vector<YaraRule::Rule> matchedRules;
@@ -103,15 +107,13 @@ namespace hex::plugin::yara {
         return resultContext.rule->isInterrupted() ? CALLBACK_ABORT : CALLBACK_CONTINUE;
     }
 
-    wolv::util::Expected<YaraRule::Result, YaraRule::Error> YaraRule::match(prv::Provider *provider, Region region) {
+    std::optional<YaraRule::Error> YaraRule::compile() {
         YR_COMPILER *compiler = nullptr;
         yr_compiler_create(&compiler);
         ON_SCOPE_EXIT {
             yr_compiler_destroy(compiler);
         };
 
-        m_interrupted = false;
-
         ResultContext resultContext = {};
         resultContext.rule = this;
 
@@ -138,12 +140,28 @@ namespace hex::plugin::yara {
             std::string errorMessage(0xFFFF, '\x00');
             yr_compiler_get_error_message(compiler, errorMessage.data(), errorMessage.size());
 
-            return wolv::util::Unexpected(Error { Error::Type::CompileError, errorMessage.c_str() });
+            return Error { Error::Type::CompileError, errorMessage.c_str() };
+        }
+
+        YR_RULES *yaraRules = nullptr;
+        if (yr_compiler_get_rules(compiler, &yaraRules) != ERROR_SUCCESS)
+            return Error { Error::Type::CompileError, "Failed to compile rules" };
+
+        m_rules = std::shared_ptr<YR_RULES>(yaraRules, yr_rules_destroy);
+
+        return std::nullopt;
+    }
+
+    wolv::util::Expected<YaraRule::Result, YaraRule::Error> YaraRule::match(prv::Provider *provider, Region region) {
+        if (m_rules == nullptr) {
+            if (auto error = this->compile(); error.has_value())
+                return wolv::util::Unexpected(std::move(*error));
         }
 
-        YR_RULES *yaraRules;
-        yr_compiler_get_rules(compiler, &yaraRules);
-        ON_SCOPE_EXIT { yr_rules_destroy(yaraRules); };
+        m_interrupted = false;
+
+        ResultContext resultContext = {};
+        resultContext.rule = this;
 
         YR_MEMORY_BLOCK_ITERATOR iterator;
 
@@ -204,12 +222,8 @@ namespace hex::plugin::yara {
             return &context.currBlock;
         };
 
-        if (yr_rules_scan_mem_blocks(yaraRules, &iterator, 0, scanFunction, &resultContext, 0) != ERROR_SUCCESS) {
-            std::string errorMessage(0xFFFF, '\x00');
-            yr_compiler_get_error_message(compiler, errorMessage.data(), errorMessage.size());
-
-            return wolv::util::Unexpected(Error { Error::Type::RuntimeError, errorMessage.c_str() });
-        }
+        if (const auto result = yr_rules_scan_mem_blocks(m_rules.get(), &iterator, 0, scanFunction, &resultContext, 0); result != ERROR_SUCCESS)
+            return wolv::util::Unexpected(Error { Error::Type::RuntimeError, fmt::format("Scanning failed with error code {}", result) });
 
         if (m_interrupted)
             return wolv::util::Unexpected(Error { Error::Type::Interrupted, "" });
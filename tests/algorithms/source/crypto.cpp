@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/literals.hpp>
 #include <hex/helpers/logger.hpp>
 #include <hex/test/test_provider.hpp>
 #include <hex/test/tests.hpp>
@@ -10,6 +11,7 @@
 #include <fmt/ranges.h>
 
 using std::string;
+using namespace hex::literals;
 
 struct EncodeChek {
   std::vector<u8> vec;
@@ -340,6 +342,208 @@ TEST_SEQUENCE("CRC8Random") {
     TEST_SUCCESS();
 };
 
+struct CrcStandard {
+    std::string name;
+    u32 width;
+
+    u64 poly;
+    u64 init;
+    u64 xorOut;
+    bool refIn;
+    bool refOut;
+
+    u64 check;
+};
+
+// source: Catalogue of parametrised CRC algorithms [https://reveng.sourceforge.io/crc-catalogue/all.htm]
+static const std::array CrcStandards = {
+    CrcStandard { .name="CRC-3/GSM",                .width= 3, .poly=0x0000000000000003, .init=0x0000000000000000, .xorOut=0x0000000000000007, .refIn=false, .refOut=false, .check=0x0000000000000004 },
+    CrcStandard { .name="CRC-3/ROHC",               .width= 3, .poly=0x0000000000000003, .init=0x0000000000000007, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000006 },
+    CrcStandard { .name="CRC-4/G-704",              .width= 4, .poly=0x0000000000000003, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000007 },
+    CrcStandard { .name="CRC-4/INTERLAKEN",         .width= 4, .poly=0x0000000000000003, .init=0x000000000000000f, .xorOut=0x000000000000000f, .refIn=false, .refOut=false, .check=0x000000000000000b },
+    CrcStandard { .name="CRC-5/EPC-C1G2",           .width= 5, .poly=0x0000000000000009, .init=0x0000000000000009, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000000 },
+    CrcStandard { .name="CRC-5/G-704",              .width= 5, .poly=0x0000000000000015, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000007 },
+    CrcStandard { .name="CRC-5/USB",                .width= 5, .poly=0x0000000000000005, .init=0x000000000000001f, .xorOut=0x000000000000001f, .refIn=true,  .refOut=true,  .check=0x0000000000000019 },
+    CrcStandard { .name="CRC-6/CDMA2000-A",         .width= 6, .poly=0x0000000000000027, .init=0x000000000000003f, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000000d },
+    CrcStandard { .name="CRC-6/CDMA2000-B",         .width= 6, .poly=0x0000000000000007, .init=0x000000000000003f, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000003b },
+    CrcStandard { .name="CRC-6/DARC",               .width= 6, .poly=0x0000000000000019, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000026 },
+    CrcStandard { .name="CRC-6/G-704",              .width= 6, .poly=0x0000000000000003, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000006 },
+    CrcStandard { .name="CRC-6/GSM",                .width= 6, .poly=0x000000000000002f, .init=0x0000000000000000, .xorOut=0x000000000000003f, .refIn=false, .refOut=false, .check=0x0000000000000013 },
+    CrcStandard { .name="CRC-7/MMC",                .width= 7, .poly=0x0000000000000009, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000075 },
+    CrcStandard { .name="CRC-7/ROHC",               .width= 7, .poly=0x000000000000004f, .init=0x000000000000007f, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000053 },
+    CrcStandard { .name="CRC-7/UMTS",               .width= 7, .poly=0x0000000000000045, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000061 },
+    CrcStandard { .name="CRC-8/AUTOSAR",            .width= 8, .poly=0x000000000000002f, .init=0x00000000000000ff, .xorOut=0x00000000000000ff, .refIn=false, .refOut=false, .check=0x00000000000000df },
+    CrcStandard { .name="CRC-8/BLUETOOTH",          .width= 8, .poly=0x00000000000000a7, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000026 },
+    CrcStandard { .name="CRC-8/CDMA2000",           .width= 8, .poly=0x000000000000009b, .init=0x00000000000000ff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000000da },
+    CrcStandard { .name="CRC-8/DARC",               .width= 8, .poly=0x0000000000000039, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000015 },
+    CrcStandard { .name="CRC-8/DVB-S2",             .width= 8, .poly=0x00000000000000d5, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000000bc },
+    CrcStandard { .name="CRC-8/GSM-A",              .width= 8, .poly=0x000000000000001d, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000037 },
+    CrcStandard { .name="CRC-8/GSM-B",              .width= 8, .poly=0x0000000000000049, .init=0x0000000000000000, .xorOut=0x00000000000000ff, .refIn=false, .refOut=false, .check=0x0000000000000094 },
+    CrcStandard { .name="CRC-8/I-432-1",            .width= 8, .poly=0x0000000000000007, .init=0x0000000000000000, .xorOut=0x0000000000000055, .refIn=false, .refOut=false, .check=0x00000000000000a1 },
+    CrcStandard { .name="CRC-8/I-CODE",             .width= 8, .poly=0x000000000000001d, .init=0x00000000000000fd, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000007e },
+    CrcStandard { .name="CRC-8/LTE",                .width= 8, .poly=0x000000000000009b, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000000ea },
+    CrcStandard { .name="CRC-8/MAXIM-DOW",          .width= 8, .poly=0x0000000000000031, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x00000000000000a1 },
+    CrcStandard { .name="CRC-8/MIFARE-MAD",         .width= 8, .poly=0x000000000000001d, .init=0x00000000000000c7, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000099 },
+    CrcStandard { .name="CRC-8/NRSC-5",             .width= 8, .poly=0x0000000000000031, .init=0x00000000000000ff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000000f7 },
+    CrcStandard { .name="CRC-8/OPENSAFETY",         .width= 8, .poly=0x000000000000002f, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000003e },
+    CrcStandard { .name="CRC-8/ROHC",               .width= 8, .poly=0x0000000000000007, .init=0x00000000000000ff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x00000000000000d0 },
+    CrcStandard { .name="CRC-8/SAE-J1850",          .width= 8, .poly=0x000000000000001d, .init=0x00000000000000ff, .xorOut=0x00000000000000ff, .refIn=false, .refOut=false, .check=0x000000000000004b },
+    CrcStandard { .name="CRC-8/SMBUS",              .width= 8, .poly=0x0000000000000007, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000000f4 },
+    CrcStandard { .name="CRC-8/TECH-3250",          .width= 8, .poly=0x000000000000001d, .init=0x00000000000000ff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000097 },
+    CrcStandard { .name="CRC-8/WCDMA",              .width= 8, .poly=0x000000000000009b, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000000025 },
+    CrcStandard { .name="CRC-10/ATM",               .width=10, .poly=0x0000000000000233, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000199 },
+    CrcStandard { .name="CRC-10/CDMA2000",          .width=10, .poly=0x00000000000003d9, .init=0x00000000000003ff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000233 },
+    CrcStandard { .name="CRC-10/GSM",               .width=10, .poly=0x0000000000000175, .init=0x0000000000000000, .xorOut=0x00000000000003ff, .refIn=false, .refOut=false, .check=0x000000000000012a },
+    CrcStandard { .name="CRC-11/FLEXRAY",           .width=11, .poly=0x0000000000000385, .init=0x000000000000001a, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000005a3 },
+    CrcStandard { .name="CRC-11/UMTS",              .width=11, .poly=0x0000000000000307, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000061 },
+    CrcStandard { .name="CRC-12/CDMA2000",          .width=12, .poly=0x0000000000000f13, .init=0x0000000000000fff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000d4d },
+    CrcStandard { .name="CRC-12/DECT",              .width=12, .poly=0x000000000000080f, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000f5b },
+    CrcStandard { .name="CRC-12/GSM",               .width=12, .poly=0x0000000000000d31, .init=0x0000000000000000, .xorOut=0x0000000000000fff, .refIn=false, .refOut=false, .check=0x0000000000000b34 },
+    CrcStandard { .name="CRC-12/UMTS",              .width=12, .poly=0x000000000000080f, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=true,  .check=0x0000000000000daf },
+    CrcStandard { .name="CRC-13/BBC",               .width=13, .poly=0x0000000000001cf5, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000004fa },
+    CrcStandard { .name="CRC-14/DARC",              .width=14, .poly=0x0000000000000805, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x000000000000082d },
+    CrcStandard { .name="CRC-14/GSM",               .width=14, .poly=0x000000000000202d, .init=0x0000000000000000, .xorOut=0x0000000000003fff, .refIn=false, .refOut=false, .check=0x00000000000030ae },
+    CrcStandard { .name="CRC-15/CAN",               .width=15, .poly=0x0000000000004599, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000059e },
+    CrcStandard { .name="CRC-15/MPT1327",           .width=15, .poly=0x0000000000006815, .init=0x0000000000000000, .xorOut=0x0000000000000001, .refIn=false, .refOut=false, .check=0x0000000000002566 },
+    CrcStandard { .name="CRC-16/ARC",               .width=16, .poly=0x0000000000008005, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x000000000000bb3d },
+    CrcStandard { .name="CRC-16/CDMA2000",          .width=16, .poly=0x000000000000c867, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000004c06 },
+    CrcStandard { .name="CRC-16/CMS",               .width=16, .poly=0x0000000000008005, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000aee7 },
+    CrcStandard { .name="CRC-16/DDS-110",           .width=16, .poly=0x0000000000008005, .init=0x000000000000800d, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000009ecf },
+    CrcStandard { .name="CRC-16/DECT-R",            .width=16, .poly=0x0000000000000589, .init=0x0000000000000000, .xorOut=0x0000000000000001, .refIn=false, .refOut=false, .check=0x000000000000007e },
+    CrcStandard { .name="CRC-16/DECT-X",            .width=16, .poly=0x0000000000000589, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000007f },
+    CrcStandard { .name="CRC-16/DNP",               .width=16, .poly=0x0000000000003d65, .init=0x0000000000000000, .xorOut=0x000000000000ffff, .refIn=true,  .refOut=true,  .check=0x000000000000ea82 },
+    CrcStandard { .name="CRC-16/EN-13757",          .width=16, .poly=0x0000000000003d65, .init=0x0000000000000000, .xorOut=0x000000000000ffff, .refIn=false, .refOut=false, .check=0x000000000000c2b7 },
+    CrcStandard { .name="CRC-16/GENIBUS",           .width=16, .poly=0x0000000000001021, .init=0x000000000000ffff, .xorOut=0x000000000000ffff, .refIn=false, .refOut=false, .check=0x000000000000d64e },
+    CrcStandard { .name="CRC-16/GSM",               .width=16, .poly=0x0000000000001021, .init=0x0000000000000000, .xorOut=0x000000000000ffff, .refIn=false, .refOut=false, .check=0x000000000000ce3c },
+    CrcStandard { .name="CRC-16/IBM-3740",          .width=16, .poly=0x0000000000001021, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000029b1 },
+    CrcStandard { .name="CRC-16/IBM-SDLC",          .width=16, .poly=0x0000000000001021, .init=0x000000000000ffff, .xorOut=0x000000000000ffff, .refIn=true,  .refOut=true,  .check=0x000000000000906e },
+    CrcStandard { .name="CRC-16/ISO-IEC-14443-3-A", .width=16, .poly=0x0000000000001021, .init=0x000000000000c6c6, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x000000000000bf05 },
+    CrcStandard { .name="CRC-16/KERMIT",            .width=16, .poly=0x0000000000001021, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000002189 },
+    CrcStandard { .name="CRC-16/LJ1200",            .width=16, .poly=0x0000000000006f63, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000bdf4 },
+    CrcStandard { .name="CRC-16/MAXIM-DOW",         .width=16, .poly=0x0000000000008005, .init=0x0000000000000000, .xorOut=0x000000000000ffff, .refIn=true,  .refOut=true,  .check=0x00000000000044c2 },
+    CrcStandard { .name="CRC-16/MCRF4XX",           .width=16, .poly=0x0000000000001021, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000006f91 },
+    CrcStandard { .name="CRC-16/MODBUS",            .width=16, .poly=0x0000000000008005, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000004b37 },
+    CrcStandard { .name="CRC-16/NRSC-5",            .width=16, .poly=0x000000000000080b, .init=0x000000000000ffff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x000000000000a066 },
+    CrcStandard { .name="CRC-16/OPENSAFETY-A",      .width=16, .poly=0x0000000000005935, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000005d38 },
+    CrcStandard { .name="CRC-16/OPENSAFETY-B",      .width=16, .poly=0x000000000000755b, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000020fe },
+    CrcStandard { .name="CRC-16/PROFIBUS",          .width=16, .poly=0x0000000000001dcf, .init=0x000000000000ffff, .xorOut=0x000000000000ffff, .refIn=false, .refOut=false, .check=0x000000000000a819 },
+    CrcStandard { .name="CRC-16/RIELLO",            .width=16, .poly=0x0000000000001021, .init=0x000000000000b2aa, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x00000000000063d0 },
+    CrcStandard { .name="CRC-16/SPI-FUJITSU",       .width=16, .poly=0x0000000000001021, .init=0x0000000000001d0f, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000e5cc },
+    CrcStandard { .name="CRC-16/T10-DIF",           .width=16, .poly=0x0000000000008bb7, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000d0db },
+    CrcStandard { .name="CRC-16/TELEDISK",          .width=16, .poly=0x000000000000a097, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000000fb3 },
+    CrcStandard { .name="CRC-16/TMS37157",          .width=16, .poly=0x0000000000001021, .init=0x00000000000089ec, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x00000000000026b1 },
+    CrcStandard { .name="CRC-16/UMTS",              .width=16, .poly=0x0000000000008005, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000000fee8 },
+    CrcStandard { .name="CRC-16/USB",               .width=16, .poly=0x0000000000008005, .init=0x000000000000ffff, .xorOut=0x000000000000ffff, .refIn=true,  .refOut=true,  .check=0x000000000000b4c8 },
+    CrcStandard { .name="CRC-16/XMODEM",            .width=16, .poly=0x0000000000001021, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000031c3 },
+    CrcStandard { .name="CRC-17/CAN-FD",            .width=17, .poly=0x000000000001685b, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000004f03 },
+    CrcStandard { .name="CRC-21/CAN-FD",            .width=21, .poly=0x0000000000102899, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000000ed841 },
+    CrcStandard { .name="CRC-24/BLE",               .width=24, .poly=0x000000000000065b, .init=0x0000000000555555, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x0000000000c25a56 },
+    CrcStandard { .name="CRC-24/FLEXRAY-A",         .width=24, .poly=0x00000000005d6dcb, .init=0x0000000000fedcba, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000007979bd },
+    CrcStandard { .name="CRC-24/FLEXRAY-B",         .width=24, .poly=0x00000000005d6dcb, .init=0x0000000000abcdef, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000001f23b8 },
+    CrcStandard { .name="CRC-24/INTERLAKEN",        .width=24, .poly=0x0000000000328b63, .init=0x0000000000ffffff, .xorOut=0x0000000000ffffff, .refIn=false, .refOut=false, .check=0x0000000000b4f3e6 },
+    CrcStandard { .name="CRC-24/LTE-A",             .width=24, .poly=0x0000000000864cfb, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x0000000000cde703 },
+    CrcStandard { .name="CRC-24/LTE-B",             .width=24, .poly=0x0000000000800063, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000023ef52 },
+    CrcStandard { .name="CRC-24/OPENPGP",           .width=24, .poly=0x0000000000864cfb, .init=0x0000000000b704ce, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000021cf02 },
+    CrcStandard { .name="CRC-24/OS-9",              .width=24, .poly=0x0000000000800063, .init=0x0000000000ffffff, .xorOut=0x0000000000ffffff, .refIn=false, .refOut=false, .check=0x0000000000200fa5 },
+    CrcStandard { .name="CRC-30/CDMA",              .width=30, .poly=0x000000002030b9c7, .init=0x000000003fffffff, .xorOut=0x000000003fffffff, .refIn=false, .refOut=false, .check=0x0000000004c34abf },
+    CrcStandard { .name="CRC-31/PHILIPS",           .width=31, .poly=0x0000000004c11db7, .init=0x000000007fffffff, .xorOut=0x000000007fffffff, .refIn=false, .refOut=false, .check=0x000000000ce9e46c },
+    CrcStandard { .name="CRC-32/AIXM",              .width=32, .poly=0x00000000814141ab, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000003010bf7f },
+    CrcStandard { .name="CRC-32/AUTOSAR",           .width=32, .poly=0x00000000f4acfb13, .init=0x00000000ffffffff, .xorOut=0x00000000ffffffff, .refIn=true,  .refOut=true,  .check=0x000000001697d06a },
+    CrcStandard { .name="CRC-32/BASE91-D",          .width=32, .poly=0x00000000a833982b, .init=0x00000000ffffffff, .xorOut=0x00000000ffffffff, .refIn=true,  .refOut=true,  .check=0x0000000087315576 },
+    CrcStandard { .name="CRC-32/BZIP2",             .width=32, .poly=0x0000000004c11db7, .init=0x00000000ffffffff, .xorOut=0x00000000ffffffff, .refIn=false, .refOut=false, .check=0x00000000fc891918 },
+    CrcStandard { .name="CRC-32/CD-ROM-EDC",        .width=32, .poly=0x000000008001801b, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x000000006ec2edc4 },
+    CrcStandard { .name="CRC-32/CKSUM",             .width=32, .poly=0x0000000004c11db7, .init=0x0000000000000000, .xorOut=0x00000000ffffffff, .refIn=false, .refOut=false, .check=0x00000000765e7680 },
+    CrcStandard { .name="CRC-32/ISCSI",             .width=32, .poly=0x000000001edc6f41, .init=0x00000000ffffffff, .xorOut=0x00000000ffffffff, .refIn=true,  .refOut=true,  .check=0x00000000e3069283 },
+    CrcStandard { .name="CRC-32/ISO-HDLC",          .width=32, .poly=0x0000000004c11db7, .init=0x00000000ffffffff, .xorOut=0x00000000ffffffff, .refIn=true,  .refOut=true,  .check=0x00000000cbf43926 },
+    CrcStandard { .name="CRC-32/JAMCRC",            .width=32, .poly=0x0000000004c11db7, .init=0x00000000ffffffff, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true,  .check=0x00000000340bc6d9 },
+    CrcStandard { .name="CRC-32/MPEG-2",            .width=32, .poly=0x0000000004c11db7, .init=0x00000000ffffffff, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x000000000376e6e7 },
+    CrcStandard { .name="CRC-32/XFER",              .width=32, .poly=0x00000000000000af, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x00000000bd0be338 },
+    CrcStandard { .name="CRC-40/GSM",               .width=40, .poly=0x0000000004820009, .init=0x0000000000000000, .xorOut=0x000000ffffffffff, .refIn=false, .refOut=false, .check=0x000000d4164fc646 },
+    CrcStandard { .name="CRC-64/ECMA-182",          .width=64, .poly=0x42f0e1eba9ea3693, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false, .check=0x6c40df5f0b497347 },
+    CrcStandard { .name="CRC-64/GO-ISO",            .width=64, .poly=0x000000000000001b, .init=0xffffffffffffffff, .xorOut=0xffffffffffffffff, .refIn=true,  .refOut=true,  .check=0xb90956c775a41001 },
+    CrcStandard { .name="CRC-64/WE",                .width=64, .poly=0x42f0e1eba9ea3693, .init=0xffffffffffffffff, .xorOut=0xffffffffffffffff, .refIn=false, .refOut=false, .check=0x62ec59e3f1a4f00a },
+    CrcStandard { .name="CRC-64/XZ",                .width=64, .poly=0x42f0e1eba9ea3693, .init=0xffffffffffffffff, .xorOut=0xffffffffffffffff, .refIn=true,  .refOut=true,  .check=0x995dc9bbdf1939fa },
+};
+
+static u64 reflectBits(u64 value, u32 bits) {
+    u64 result = 0;
+    for (u32 i = 0; i < bits; i++) {
+        result = (result << 1) | (value & 0b1);
+        value >>= 1;
+    }
+
+    return result;
+}
+
+static u64 calculateCrcBitwise(const CrcStandard &standard, const std::vector<u8> &data) {
+    const u64 mask = u64(-1) >> (64 - standard.width);
+    const u64 top  = 1ULL << (standard.width - 1);
+
+    u64 crc = standard.init;
+    for (u8 byte : data) {
+        if (standard.refIn)
+            byte = u8(reflectBits(byte, 8));
+
+        for (i32 bit = 7; bit >= 0; bit--) {
+            const bool feedback = ((byte >> bit) & 1) != ((crc & top) != 0);
+            crc = (crc << 1) & mask;
+            if (feedback)
+                crc ^= standard.poly;
+        }
+    }
+
+    if (standard.refOut)
+        crc = reflectBits(crc, standard.width);
+
+    return crc ^ standard.xorOut;
+}
+
+TEST_SEQUENCE("CRCStandards") {
+    std::vector<u8> checkData = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    // Large enough to take the carry-less multiplication path, with a tail that isn't a multiple of the block size
+    std::vector<u8> randomData(4_KiB + 13);
+    std::mt19937 gen(0x1234);
+    std::ranges::generate(randomData, [&] { return u8(gen()); });
+
+    for (const auto &standard : CrcStandards) {
+        hex::test::TestProvider checkProvider(&checkData);
+        hex::prv::Provider *provider = &checkProvider;
+
+        auto crc = hex::crypt::crc(provider, 0, checkData.size(), standard.width, standard.poly, standard.init, standard.xorOut, standard.refIn, standard.refOut);
+        TEST_ASSERT(crc == standard.check, "name: {} got: {:#x} expected: {:#x}", standard.name, crc, standard.check);
+
+        hex::test::TestProvider randomProvider(&randomData);
+        provider = &randomProvider;
+
+        crc = hex::crypt::crc(provider, 0, randomData.size(), standard.width, standard.poly, standard.init, standard.xorOut, standard.refIn, standard.refOut);
+        const auto expected = calculateCrcBitwise(standard, randomData);
+        TEST_ASSERT(crc == expected, "name: {} got: {:#x} expected: {:#x}", standard.name, crc, expected);
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("CRCLargeData") {
+    // Spans multiple chunks so the chunks are calculated in parallel and combined afterward
+    std::vector<u8> data(3_MiB + 5);
+    std::mt19937 gen(0x5678);
+    std::ranges::generate(data, [&] { return u8(gen()); });
+
+    hex::test::TestProvider testProvider(&data);
+    hex::prv::Provider *provider = &testProvider;
+
+    for (const auto &name : { "CRC-32/ISO-HDLC", "CRC-32/BZIP2", "CRC-64/XZ", "CRC-12/UMTS" }) {
+        const auto &standard = *std::ranges::find(CrcStandards, name, &CrcStandard::name);
+
+        const auto crc = hex::crypt::crc(provider, 0, data.size(), standard.width, standard.poly, standard.init, standard.xorOut, standard.refIn, standard.refOut);
+        const auto expected = calculateCrcBitwise(standard, data);
+        TEST_ASSERT(crc == expected, "name: {} got: {:#x} expected: {:#x}", standard.name, crc, expected);
+    }
+
+    TEST_SUCCESS();
+};
+
 struct HashCheck {
     std::string data;
     std::string result;
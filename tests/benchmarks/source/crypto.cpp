@@ -0,0 +1,66 @@
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/test_provider.hpp>
+
+#include <hex/helpers/crypto.hpp>
+#include <hex/helpers/literals.hpp>
+
+#include <array>
+#include <string>
+
+using namespace hex::literals;
+
+namespace {
+
+    struct CrcParameters {
+        std::string name;
+        u32 width;
+
+        u64 poly;
+        u64 init;
+        u64 xorOut;
+        bool refIn;
+        bool refOut;
+    };
+
+    // source: Catalogue of parametrised CRC algorithms [https://reveng.sourceforge.io/crc-catalogue/all.htm]
+    const std::array CrcBenchmarkStandards = {
+        CrcParameters { .name="CRC-8/SMBUS",     .width= 8, .poly=0x0000000000000007, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=false },
+        CrcParameters { .name="CRC-12/UMTS",     .width=12, .poly=0x000000000000080F, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=false, .refOut=true  },
+        CrcParameters { .name="CRC-16/ARC",      .width=16, .poly=0x0000000000008005, .init=0x0000000000000000, .xorOut=0x0000000000000000, .refIn=true,  .refOut=true  },
+        CrcParameters { .name="CRC-32/ISO-HDLC", .width=32, .poly=0x0000000004C11DB7, .init=0x00000000FFFFFFFF, .xorOut=0x00000000FFFFFFFF, .refIn=true,  .refOut=true  },
+        CrcParameters { .name="CRC-32/BZIP2",    .width=32, .poly=0x0000000004C11DB7, .init=0x00000000FFFFFFFF, .xorOut=0x00000000FFFFFFFF, .refIn=false, .refOut=false },
+        CrcParameters { .name="CRC-64/XZ",       .width=64, .poly=0x42F0E1EBA9EA3693, .init=0xFFFFFFFFFFFFFFFF, .xorOut=0xFFFFFFFFFFFFFFFF, .refIn=true,  .refOut=true  },
+    };
+
+}
+
+BENCHMARK("Crypto/CRC") {
+    auto data = hex::test::generateBenchmarkData(hex::test::BenchmarkData::Random, 64_MiB);
+    hex::test::TestProvider testProvider(&data);
+    hex::prv::Provider *provider = &testProvider;
+
+    for (const auto &standard : CrcBenchmarkStandards) {
+        state.measure(standard.name, data.size(), [&] {
+            hex::test::doNotOptimize(hex::crypt::crc(provider, 0, data.size(), standard.width, standard.poly, standard.init, standard.xorOut, standard.refIn, standard.refOut));
+        });
+    }
+}
+
+BENCHMARK("Crypto/Hash") {
+    auto data = hex::test::generateBenchmarkData(hex::test::BenchmarkData::Random, 64_MiB);
+    hex::test::TestProvider testProvider(&data);
+    hex::prv::Provider *provider = &testProvider;
+
+    state.measure("MD5", data.size(), [&] {
+        hex::test::doNotOptimize(hex::crypt::md5(provider, 0, data.size()));
+    });
+    state.measure("SHA-1", data.size(), [&] {
+        hex::test::doNotOptimize(hex::crypt::sha1(provider, 0, data.size()));
+    });
+    state.measure("SHA-256", data.size(), [&] {
+        hex::test::doNotOptimize(hex::crypt::sha256(provider, 0, data.size()));
+    });
+    state.measure("SHA-512", data.size(), [&] {
+        hex::test::doNotOptimize(hex::crypt::sha512(provider, 0, data.size()));
+    });
+}
@@ -0,0 +1,141 @@
+#include <hex/test/benchmarks.hpp>
+
+#include <hex/helpers/encoding_file.hpp>
+#include <hex/helpers/literals.hpp>
+#include <hex/helpers/utils.hpp>
+
+#include <fmt/format.h>
+
+#include <map>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace hex::literals;
+
+namespace {
+
+    struct ShiftJisTable {
+        std::string content;
+        std::vector<std::vector<u8>> sequences;
+    };
+
+    std::string toUtf8(u32 codepoint) {
+        std::string result;
+        if (codepoint < 0x80) {
+            result += char(codepoint);
+        } else if (codepoint < 0x800) {
+            result += char(0xC0 | (codepoint >> 6));
+            result += char(0x80 | (codepoint & 0x3F));
+        } else {
+            result += char(0xE0 | (codepoint >> 12));
+            result += char(0x80 | ((codepoint >> 6) & 0x3F));
+            result += char(0x80 | (codepoint & 0x3F));
+        }
+
+        return result;
+    }
+
+    // Builds a table laid out like Shift-JIS: ASCII, half-width katakana, two byte characters behind lead bytes
+    // 0x81-0x9F and 0xE0-0xEF and a few three byte control codes the way ROM hacking tables usually contain them
+    ShiftJisTable createShiftJisTable() {
+        ShiftJisTable table;
+        u32 codepoint = 0x4E00;
+
+        const auto addMapping = [&](const std::vector<u8> &sequence, const std::string &value) {
+            for (const auto byte : sequence)
+                table.content += fmt::format("{:02X}", byte);
+            table.content += "=" + value + "\n";
+            table.sequences.push_back(sequence);
+        };
+
+        for (u8 byte = 0x20; byte < 0x7F; byte += 1)
+            addMapping({ byte }, std::string(1, char(byte)));
+        for (u8 byte = 0xA1; byte <= 0xDF; byte += 1)
+            addMapping({ byte }, toUtf8(0xFF61 + (byte - 0xA1)));
+
+        for (u32 lead = 0x81; lead <= 0xEF; lead += 1) {
+            if (lead > 0x9F && lead < 0xE0)
+                continue;
+
+            for (u32 trail = 0x40; trail <= 0xFC; trail += 1) {
+                if (trail == 0x7F)
+                    continue;
+
+                addMapping({ u8(lead), u8(trail) }, toUtf8(codepoint++));
+            }
+        }
+
+        for (u8 code = 0x00; code < 0x40; code += 1)
+            addMapping({ 0xFF, 0x00, code }, fmt::format("<ctrl {:02X}>", code));
+
+        return table;
+    }
+
+    // Straightforward lookup trying every sequence length from the longest one down, used as reference
+    std::string decodeReference(const std::map<size_t, std::map<std::vector<u8>, std::string>> &mapping, std::span<const u8> buffer) {
+        std::string result;
+
+        while (!buffer.empty()) {
+            bool found = false;
+            for (auto it = mapping.rbegin(); it != mapping.rend(); ++it) {
+                const auto &[size, entries] = *it;
+                if (size > buffer.size())
+                    continue;
+
+                if (auto entry = entries.find(std::vector(buffer.begin(), buffer.begin() + size)); entry != entries.end()) {
+                    result += entry->second;
+                    buffer = buffer.subspan(size);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found) {
+                result += ".";
+                buffer = buffer.subspan(1);
+            }
+        }
+
+        return result;
+    }
+
+}
+
+BENCHMARK("EncodingFile/DecodeShiftJis") {
+    const auto table = createShiftJisTable();
+    hex::EncodingFile encodingFile(hex::EncodingFile::Type::Thingy, table.content);
+
+    std::map<size_t, std::map<std::vector<u8>, std::string>> referenceMapping;
+    for (const auto &line : table.content | std::views::split('\n')) {
+        const std::string_view entry(line.begin(), line.end());
+        if (const auto delimiter = entry.find('='); delimiter != std::string_view::npos) {
+            const auto bytes = hex::parseByteString(std::string(entry.substr(0, delimiter)));
+            referenceMapping[bytes.size()].insert({ bytes, std::string(entry.substr(delimiter + 1)) });
+        }
+    }
+
+    // Random text made of valid sequences with an occasional unmapped byte mixed in
+    std::vector<u8> data;
+    std::mt19937_64 gen(0x5EED);
+    while (data.size() < 8_MiB) {
+        if (gen() % 64 == 0) {
+            data.push_back(0x80);
+        } else {
+            const auto &sequence = table.sequences[gen() % table.sequences.size()];
+            data.insert(data.end(), sequence.begin(), sequence.end());
+        }
+    }
+
+    state.measure("Trie", data.size(), [&] {
+        hex::test::doNotOptimize(encodingFile.decodeAll(data));
+    });
+    state.setCounter("Mappings", table.sequences.size());
+
+    state.measure("Length buckets", data.size(), [&] {
+        hex::test::doNotOptimize(decodeReference(referenceMapping, data));
+    });
+    state.setCounter("Mappings", table.sequences.size());
+}
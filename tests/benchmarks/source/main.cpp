@@ -0,0 +1,183 @@
+#include <hex.hpp>
+
+#include <hex/api/imhex_api/system.hpp>
+#include <hex/api/events/events_lifecycle.hpp>
+#include <hex/api/plugin_manager.hpp>
+#include <hex/api/task_manager.hpp>
+#include <hex/helpers/default_paths.hpp>
+#include <hex/helpers/logger.hpp>
+#include <hex/helpers/utils.hpp>
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/tests.hpp>
+
+#include <wolv/io/file.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <nlohmann/json.hpp>
+#include <imgui.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+
+namespace {
+
+    struct Arguments {
+        std::string filter;
+        u32 repetitions = 5;
+        std::optional<std::fs::path> jsonPath;
+        bool listOnly = false;
+    };
+
+    std::optional<Arguments> parseArguments(int argc, char **argv) {
+        Arguments arguments;
+
+        for (int i = 1; i < argc; i += 1) {
+            const std::string_view argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--list") {
+                arguments.listOnly = true;
+            } else if (argument == "--filter" && hasValue) {
+                arguments.filter = argv[++i];
+            } else if (argument == "--repetitions" && hasValue) {
+                arguments.repetitions = u32(std::max(1, std::atoi(argv[++i])));
+            } else if (argument == "--json" && hasValue) {
+                arguments.jsonPath = std::fs::path(argv[++i]);
+            } else {
+                hex::log::fatal("Unknown argument '{}'", argument);
+                hex::log::info("usage: benchmarks [--list] [--filter <name>] [--repetitions <count>] [--json <path>]");
+                return std::nullopt;
+            }
+        }
+
+        return arguments;
+    }
+
+    // Benchmarks for code that lives in plugins are compiled into the plugins themselves and register when they get loaded
+    void loadPlugins() {
+        if (const auto pluginPath = hex::getEnvironmentVariable("IMHEX_BENCHMARK_PLUGIN_PATH"); pluginPath.has_value()) {
+            hex::PluginManager::addLoadPath(pluginPath.value());
+        } else {
+            for (const auto &dir : hex::paths::Plugins.read())
+                hex::PluginManager::addLoadPath(dir);
+        }
+
+        hex::PluginManager::loadLibraries();
+        hex::PluginManager::load();
+    }
+
+    void initializePlugins() {
+        if (hex::PluginManager::getPlugin("Built-in") == nullptr)
+            return;
+
+        if (!hex::test::initPluginImpl("Built-in"))
+            return;
+
+        for (const auto &plugin : hex::PluginManager::getPlugins()) {
+            if (!plugin.isInitialized() && !plugin.initializePlugin())
+                hex::log::error("Failed to initialize plugin '{}'", plugin.getPluginName());
+        }
+    }
+
+    nlohmann::json resultToJson(const hex::test::BenchmarkResult &result) {
+        nlohmann::json json = {
+            { "name",       result.name                          },
+            { "variant",    result.variant                       },
+            { "iterations", result.iterations                    },
+            { "bytes",      result.bytes                         },
+            { "min_ns",     result.minSeconds * 1'000'000'000    },
+            { "median_ns",  result.medianSeconds * 1'000'000'000 },
+            { "mean_ns",    result.meanSeconds * 1'000'000'000   },
+            { "counters",   result.counters                      }
+        };
+
+        if (result.bytes != 0 && result.medianSeconds > 0)
+            json["throughput_mib_s"] = (double(result.bytes) / (1024 * 1024)) / result.medianSeconds;
+
+        return json;
+    }
+
+    int runBenchmarks(const Arguments &arguments) {
+        std::vector<hex::test::BenchmarkResult> results;
+
+        for (const auto &[name, function] : hex::test::Benchmarks::get()) {
+            if (!arguments.filter.empty() && !name.contains(arguments.filter))
+                continue;
+
+            if (arguments.listOnly) {
+                hex::log::info("{}", name);
+                continue;
+            }
+
+            hex::log::info("Running {}", name);
+
+            hex::test::BenchmarkState state(name, arguments.repetitions);
+            function(state);
+
+            for (const auto &result : state.getResults()) {
+                if (result.bytes != 0)
+                    hex::log::info("    {:40} {:12.3f} ms {:10.1f} MiB/s", result.variant, result.medianSeconds * 1000, (double(result.bytes) / (1024 * 1024)) / result.medianSeconds);
+                else
+                    hex::log::info("    {:40} {:12.3f} ms", result.variant, result.medianSeconds * 1000);
+
+                for (const auto &[counter, value] : result.counters)
+                    hex::log::info("        {:36} {}", counter, value);
+            }
+
+            results.insert(results.end(), state.getResults().begin(), state.getResults().end());
+        }
+
+        if (arguments.listOnly || !arguments.jsonPath.has_value())
+            return EXIT_SUCCESS;
+
+        nlohmann::json json = {
+            { "version",      hex::ImHexApi::System::getImHexVersion().get() },
+            { "commit",       hex::ImHexApi::System::getCommitHash(true) },
+            { "os",           hex::ImHexApi::System::getOSName() },
+            { "architecture", hex::ImHexApi::System::getArchitecture() },
+            { "timestamp",    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count() },
+            { "repetitions",  arguments.repetitions },
+            { "benchmarks",   nlohmann::json::array() }
+        };
+
+        for (const auto &result : results)
+            json["benchmarks"].push_back(resultToJson(result));
+
+        wolv::io::File file(*arguments.jsonPath, wolv::io::File::Mode::Create);
+        if (!file.isValid()) {
+            hex::log::fatal("Failed to create '{}'", wolv::util::toUTF8String(*arguments.jsonPath));
+            return EXIT_FAILURE;
+        }
+
+        file.writeString(json.dump(4));
+        hex::log::info("Wrote {} results to '{}'", results.size(), wolv::util::toUTF8String(*arguments.jsonPath));
+
+        return EXIT_SUCCESS;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    const auto arguments = parseArguments(argc, argv);
+    if (!arguments.has_value())
+        return EXIT_FAILURE;
+
+    ImGui::CreateContext();
+    loadPlugins();
+    for (const auto &plugin : hex::PluginManager::getPlugins())
+        plugin.setImGuiContext(ImGui::GetCurrentContext());
+    initializePlugins();
+
+    const auto result = runBenchmarks(*arguments);
+
+    hex::TaskManager::exit();
+    ImGui::GetIO().Fonts->Locked = false;
+    hex::ImHexApi::System::impl::cleanup();
+    hex::EventImHexClosing::post();
+    hex::EventManager::clear();
+    hex::PluginManager::unload();
+    ImGui::DestroyContext();
+
+    return result;
+}
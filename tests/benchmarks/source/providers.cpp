@@ -0,0 +1,152 @@
+#include <hex/test/benchmarks.hpp>
+#include <hex/test/test_provider.hpp>
+
+#include <hex/helpers/literals.hpp>
+#include <hex/providers/buffered_reader.hpp>
+#include <hex/providers/cached_provider.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+using namespace hex::literals;
+
+namespace {
+
+    // Cached provider backed by a vector that counts how often the cache had to go to the source
+    class MemoryCachedProvider : public hex::prv::CachedProvider {
+    public:
+        MemoryCachedProvider(const std::vector<u8> &data, size_t blockSize, size_t maxBlocks) : CachedProvider(blockSize, maxBlocks), m_data(data) { }
+
+        [[nodiscard]] bool isAvailable() const override { return true; }
+        [[nodiscard]] bool isReadable() const override { return true; }
+        [[nodiscard]] bool isWritable() const override { return false; }
+        [[nodiscard]] bool isResizable() const override { return false; }
+        [[nodiscard]] bool isSavable() const override { return false; }
+
+        [[nodiscard]] std::string getName() const override { return ""; }
+        [[nodiscard]] const char* getIcon() const override { return ""; }
+        [[nodiscard]] hex::UnlocalizedString getTypeName() const override { return hex::UnlocalizedString("hex.test.provider.cached"); }
+
+        [[nodiscard]] u64 getSourceReads() const { return m_sourceReads; }
+
+    protected:
+        void readFromSource(u64 offset, void *buffer, size_t size) override {
+            m_sourceReads += 1;
+
+            const auto available = offset < m_data.size() ? std::min<u64>(size, m_data.size() - offset) : 0;
+            std::memcpy(buffer, m_data.data() + offset, available);
+            std::memset(static_cast<u8*>(buffer) + available, 0x00, size - available);
+        }
+
+        void writeToSource(u64, const void *, size_t) override { }
+
+        [[nodiscard]] u64 getSourceSize() const override { return m_data.size(); }
+
+    private:
+        const std::vector<u8> &m_data;
+        u64 m_sourceReads = 0;
+    };
+
+    std::vector<u64> generateOffsets(size_t count, u64 range, u64 seed) {
+        std::mt19937_64 random(seed);
+
+        std::vector<u64> offsets(count);
+        std::ranges::generate(offsets, [&] { return random() % range; });
+
+        return offsets;
+    }
+
+}
+
+BENCHMARK("Provider/ProviderReader") {
+    auto data = hex::test::generateBenchmarkData(hex::test::BenchmarkData::Random, 64_MiB);
+    hex::test::TestProvider provider(&data);
+
+    state.measure("Forward iteration", data.size(), [&] {
+        hex::prv::ProviderReader reader(&provider);
+
+        u64 sum = 0;
+        for (auto it = reader.begin(); it < reader.end(); it += 1)
+            sum += *it;
+
+        hex::test::doNotOptimize(sum);
+    });
+
+    state.measure("Reverse iteration", data.size(), [&] {
+        hex::prv::ProviderReader reader(&provider);
+
+        u64 sum = 0;
+        for (auto it = reader.rbegin(); it != reader.rend(); ++it)
+            sum += *it;
+
+        hex::test::doNotOptimize(sum);
+    });
+
+    state.measure("Chunked read (64 KiB)", data.size(), [&] {
+        std::vector<u8> buffer(64_KiB);
+
+        u64 sum = 0;
+        for (u64 offset = 0; offset < data.size(); offset += buffer.size()) {
+            provider.read(offset, buffer.data(), buffer.size());
+            sum += buffer.front();
+        }
+
+        hex::test::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK("Provider/CachedProvider") {
+    const auto data = hex::test::generateBenchmarkData(hex::test::BenchmarkData::Random, 64_MiB);
+
+    constexpr static auto BlockSize = 4_KiB;
+    constexpr static auto MaxBlocks = 1024;
+
+    // Working set fits into the cache, every read after the first pass is a hit
+    {
+        MemoryCachedProvider provider(data, BlockSize, MaxBlocks);
+        const auto workingSet = BlockSize * MaxBlocks / 2;
+        const auto offsets = generateOffsets(1'000'000, workingSet - 16, 1);
+
+        state.measure("Random 16 byte reads, hits", offsets.size() * 16, [&] {
+            std::array<u8, 16> buffer = { };
+            for (const auto offset : offsets) {
+                provider.read(offset, buffer.data(), buffer.size());
+                hex::test::doNotOptimize(buffer);
+            }
+        });
+        state.setCounter("source_reads", double(provider.getSourceReads()));
+    }
+
+    // Working set is much larger than the cache, almost every read is a miss
+    {
+        MemoryCachedProvider provider(data, BlockSize, MaxBlocks);
+        const auto offsets = generateOffsets(100'000, data.size() - 16, 2);
+
+        state.measure("Random 16 byte reads, misses", offsets.size() * 16, [&] {
+            std::array<u8, 16> buffer = { };
+            for (const auto offset : offsets) {
+                provider.read(offset, buffer.data(), buffer.size());
+                hex::test::doNotOptimize(buffer);
+            }
+        });
+        state.setCounter("source_reads", double(provider.getSourceReads()));
+    }
+
+    // Linear scan through the whole data, every block is read from the source exactly once per pass
+    {
+        MemoryCachedProvider provider(data, BlockSize, MaxBlocks);
+
+        state.measure("Sequential scan", data.size(), [&] {
+            hex::prv::ProviderReader reader(&provider, 64_KiB);
+
+            u64 sum = 0;
+            for (auto it = reader.begin(); it < reader.end(); it += 1)
+                sum += *it;
+
+            hex::test::doNotOptimize(sum);
+        });
+        state.setCounter("source_reads", double(provider.getSourceReads()));
+    }
+}
@@ -3,7 +3,11 @@
 #include <hex/test/test_provider.hpp>
 
 #include <hex/helpers/crypto.hpp>
+#include <hex/providers/concatenated_provider.hpp>
+#include <hex/providers/undo_redo/undo_buffer.hpp>
 
+#include <array>
+#include <random>
 #include <vector>
 
 TEST_SEQUENCE("TestSucceeding") {
@@ -77,3 +81,236 @@ TEST_SEQUENCE("TestProvider_write") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("ConcatenatedProvider_read") {
+    std::vector<u8> data1 { 0x00, 0x01, 0x02, 0x03 };
+    std::vector<u8> data2 { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15 };
+    hex::test::TestProvider provider1(&data1);
+    hex::test::TestProvider provider2(&data2);
+
+    hex::prv::ConcatenatedProvider provider({
+        { &provider1, { 1, 3 } },
+        { &provider2, { 0, 6 } },
+        { &provider1, { 0, 2 } }
+    });
+
+    TEST_ASSERT(provider.getActualSize() == 11);
+
+    std::array<u8, 11> buff = { };
+    provider.read(0, buff.data(), buff.size());
+    TEST_ASSERT(buff == std::array<u8, 11>{ 0x01, 0x02, 0x03, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x00, 0x01 });
+
+    std::ranges::fill(buff, 22);
+    provider.read(2, buff.data(), 3);
+    TEST_ASSERT(buff[0] == 0x03);
+    TEST_ASSERT(buff[1] == 0x10);
+    TEST_ASSERT(buff[2] == 0x11);
+    TEST_ASSERT(buff[3] == 22);    // should be unchanged
+
+    std::ranges::fill(buff, 22);
+    provider.read(9, buff.data(), 2);
+    TEST_ASSERT(buff[0] == 0x00);
+    TEST_ASSERT(buff[1] == 0x01);
+
+    auto [region, valid] = provider.getRegionValidity(4);
+    TEST_ASSERT(valid);
+    TEST_ASSERT(region.getStartAddress() == 4 && region.getSize() == 5, "{} {}", region.getStartAddress(), region.getSize());
+
+    std::tie(region, valid) = provider.getRegionValidity(11);
+    TEST_ASSERT(!valid);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("UndoBuffer_RunLength") {
+    using hex::prv::undo::UndoBuffer;
+
+    std::mt19937 random(1234);
+
+    // Runs of all lengths mixed with short literals, including single bytes between runs which are the worst case for the encoding
+    std::vector<u8> data;
+    while (data.size() < 0x4000) {
+        data.insert(data.end(), random() % 200, u8(random()));
+        for (auto i = random() % 4; i > 0; i -= 1)
+            data.push_back(u8(random()));
+    }
+
+    const UndoBuffer buffer(data);
+    TEST_ASSERT(buffer.getSize() == data.size());
+    TEST_ASSERT(buffer.getMemoryUsage() < data.size());
+    TEST_ASSERT(buffer.get() == data);
+
+    for (const size_t size : { 0, 1, 2, 3, 64, 129, 130, 131, 1000, 0x3FFF }) {
+        const auto prefix = buffer.get(size);
+        TEST_ASSERT(std::ranges::equal(prefix, std::span(data).first(std::min(size, data.size()))), "size: {}", size);
+    }
+
+    // Data that doesn't compress is stored as-is
+    std::vector<u8> noise(0x1000);
+    for (auto &byte : noise)
+        byte = u8(random());
+
+    const UndoBuffer noiseBuffer(noise);
+    TEST_ASSERT(noiseBuffer.getMemoryUsage() == noise.size());
+    TEST_ASSERT(noiseBuffer.get() == noise);
+    TEST_ASSERT(std::ranges::equal(noiseBuffer.get(10), std::span(noise).first(10)));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("UndoBuffer_Offload") {
+    using hex::prv::undo::UndoBuffer;
+
+    std::mt19937 random(1234);
+    const auto makeData = [&](size_t size, bool compressible) {
+        std::vector<u8> data(size);
+        for (auto &byte : data)
+            byte = compressible ? u8(random() % 64 == 0 ? random() : 0x00) : u8(random());
+
+        return data;
+    };
+
+    // Offloaded buffers free their memory and read back the same data, both encoded and raw
+    std::vector<std::vector<u8>> data;
+    std::vector<UndoBuffer> buffers;
+    for (size_t i = 0; i < 48; i += 1) {
+        data.push_back(makeData(1024 * 1024, i % 2 == 0));
+        buffers.emplace_back(data.back());
+
+        buffers.back().offload();
+        TEST_ASSERT(buffers.back().isOffloaded());
+        TEST_ASSERT(buffers.back().getMemoryUsage() == 0);
+    }
+
+    for (size_t i = 0; i < buffers.size(); i += 1) {
+        TEST_ASSERT(buffers[i].get() == data[i], "buffer: {}", i);
+        TEST_ASSERT(std::ranges::equal(buffers[i].get(64), std::span(data[i]).first(64)), "buffer: {}", i);
+    }
+
+    // Copies share the offloaded data
+    auto copy = buffers.front();
+    TEST_ASSERT(copy.isOffloaded() && copy.get() == data.front());
+
+    // Releasing most of the buffers compacts the file
+    const auto fullSize = UndoBuffer::getOffloadFileSize();
+    TEST_ASSERT(fullSize > 0);
+
+    for (size_t i = 1; i < 40; i += 1)
+        buffers[i] = UndoBuffer();
+
+    TEST_ASSERT(UndoBuffer::getOffloadFileSize() < fullSize / 2, "{} {}", UndoBuffer::getOffloadFileSize(), fullSize);
+    TEST_ASSERT(buffers.front().get() == data.front());
+    for (size_t i = 40; i < buffers.size(); i += 1)
+        TEST_ASSERT(buffers[i].get() == data[i], "buffer: {}", i);
+
+    // The file gets emptied once nothing references it anymore
+    buffers.clear();
+    TEST_ASSERT(copy.get() == data.front());
+    TEST_ASSERT(UndoBuffer::getOffloadFileSize() > 0);
+
+    copy = UndoBuffer();
+    TEST_ASSERT(UndoBuffer::getOffloadFileSize() == 0);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("LazyOverlay") {
+    using hex::prv::LazyOverlay;
+
+    std::vector<u8> data(0x100);
+    for (size_t i = 0; i < data.size(); i += 1)
+        data[i] = u8(i);
+
+    const auto applied = [&](const LazyOverlay &overlay) {
+        auto result = data;
+        overlay.apply(0, result);
+        return result;
+    };
+
+    // Only the bytes inside of the region change and the key starts at its beginning
+    const LazyOverlay xorOverlay(LazyOverlay::Type::Xor, { 0x10, 0x21 }, { 0x0F, 0xF0, 0xAA });
+    auto result = applied(xorOverlay);
+    for (size_t i = 0; i < data.size(); i += 1) {
+        const auto expected = i >= 0x10 && i <= 0x30 ? u8(data[i] ^ std::array<u8, 3>{ 0x0F, 0xF0, 0xAA }[(i - 0x10) % 3]) : data[i];
+        TEST_ASSERT(result[i] == expected, "index: 0x{:X}", i);
+    }
+
+    // Buffers starting in the middle of the overlay continue the key where it left off
+    std::vector<u8> buffer(data.begin() + 0x15, data.begin() + 0x25);
+    xorOverlay.apply(0x15, buffer);
+    TEST_ASSERT(std::ranges::equal(buffer, std::span(result).subspan(0x15, 0x10)));
+
+    // Pieces produce the same bytes as the overlay they were cut from, no matter the type
+    for (const auto type : { LazyOverlay::Type::Fill, LazyOverlay::Type::Random, LazyOverlay::Type::Xor, LazyOverlay::Type::Add }) {
+        const LazyOverlay overlay(type, { 0x20, 0x40 }, { 0x12, 0x34, 0x56 });
+        const auto piece = overlay.slice({ 0x2B, 0x10 });
+        TEST_ASSERT(piece.getId() == overlay.getId());
+
+        const auto full = applied(overlay);
+        const auto sliced = applied(piece);
+        for (size_t i = 0; i < data.size(); i += 1) {
+            const auto expected = i >= 0x2B && i < 0x3B ? full[i] : data[i];
+            TEST_ASSERT(sliced[i] == expected, "type: {}, index: 0x{:X}", u8(type), i);
+        }
+
+        // Moved pieces take their key position with them
+        auto movedPiece = piece;
+        movedPiece.move(0x40);
+        TEST_ASSERT(movedPiece.getRegion().getStartAddress() == 0x6B && movedPiece.getRegion().getSize() == 0x10);
+        TEST_ASSERT(movedPiece.getOrigin() == overlay.getOrigin() + 0x40);
+
+        auto movedData = std::vector<u8>(data.begin() + 0x2B, data.begin() + 0x3B);
+        movedPiece.apply(0x6B, movedData);
+        TEST_ASSERT(std::ranges::equal(movedData, std::span(full).subspan(0x2B, 0x10)), "type: {}", u8(type));
+    }
+
+    // Providers apply their overlays in the order they were created in
+    hex::test::TestProvider provider(&data);
+    const auto original = data;
+    const auto readData = [&] {
+        std::vector<u8> result(data.size());
+        provider.read(0, result.data(), result.size());
+        return result;
+    };
+
+    const LazyOverlay fillOverlay(LazyOverlay::Type::Fill, { 0x20, 0x20 }, { 0xAA, 0xBB });
+    provider.addLazyOverlay(fillOverlay);
+    provider.addLazyOverlay(xorOverlay);
+    auto expected = applied(xorOverlay);
+    fillOverlay.apply(0, expected);
+    TEST_ASSERT(readData() == expected);
+    TEST_ASSERT(provider.getLazyOverlays()->front().getId() == xorOverlay.getId());
+    TEST_ASSERT(provider.hasLazyOverlays({ 0x3F, 1 }) && !provider.hasLazyOverlays({ 0x40, 0x10 }));
+
+    // Moving the overlays splits the ones that span the offset
+    provider.moveLazyOverlays(0x28, 0x10);
+    TEST_ASSERT(provider.getLazyOverlays()->size() == 4);
+    TEST_ASSERT(!provider.hasLazyOverlays({ 0x28, 0x10 }));
+    const auto movedData = readData();
+    for (size_t i = 0x38; i < 0x50; i += 1)
+        TEST_ASSERT(movedData[i] == (i % 2 == 0 ? 0xAA : 0xBB), "index: 0x{:X}", i);
+
+    provider.moveLazyOverlays(0x38, -0x10);
+    TEST_ASSERT(provider.getLazyOverlays()->size() == 4);
+    TEST_ASSERT(readData() == expected);
+
+    // Materializing writes the overlays to the data and cuts them out of the region
+    const auto removedPieces = provider.materializeLazyOverlays({ 0x18, 0x10 });
+    TEST_ASSERT(removedPieces.size() == 2);
+    TEST_ASSERT(readData() == expected);
+    TEST_ASSERT(std::ranges::equal(std::span(data).subspan(0x18, 0x10), std::span(expected).subspan(0x18, 0x10)));
+    TEST_ASSERT(!provider.hasLazyOverlays({ 0x18, 0x10 }));
+
+    provider.materializeLazyOverlays();
+    TEST_ASSERT(provider.getLazyOverlays()->empty());
+    TEST_ASSERT(data == expected);
+
+    // Adding the removed pieces back on top of the original data restores everything
+    data = original;
+    for (const auto &piece : removedPieces)
+        provider.addLazyOverlay(piece);
+    const auto restoredData = readData();
+    TEST_ASSERT(std::ranges::equal(std::span(restoredData).subspan(0x18, 0x10), std::span(expected).subspan(0x18, 0x10)));
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,26 @@
+#include <hex/test/tests.hpp>
+
+#include <hex/helpers/encoding_file.hpp>
+
+#include <span>
+#include <string>
+#include <vector>
+
+TEST_SEQUENCE("EncodingFileLongestMatch") {
+    hex::EncodingFile encodingFile(hex::EncodingFile::Type::Thingy, std::string("41=A\n4142=AB\n414243=ABC\n42=B\nFF00=<end>\n41=X\n"));
+
+    TEST_ASSERT(encodingFile.getShortestSequence() == 1);
+    TEST_ASSERT(encodingFile.getLongestSequence() == 3);
+
+    const std::vector<u8> data = { 0x41, 0x42, 0x43, 0x41, 0x42, 0x44, 0x42, 0xFF, 0x00, 0x41, 0xFF };
+    TEST_ASSERT(encodingFile.decodeAll(data) == "ABCAB.B<end>A.", "got: {}", encodingFile.decodeAll(data));
+
+    // Sequences longer than the buffer can't match
+    const auto [character, size] = encodingFile.getEncodingFor(std::span(data).subspan(0, 2));
+    TEST_ASSERT(character == "AB" && size == 2);
+
+    hex::EncodingFile copy = encodingFile;
+    TEST_ASSERT(copy.decodeAll(data) == encodingFile.decodeAll(data));
+
+    TEST_SUCCESS();
+};
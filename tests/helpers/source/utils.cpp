@@ -1,6 +1,19 @@
 #include <hex/test/tests.hpp>
+#include <hex/test/test_provider.hpp>
 
 #include <hex/helpers/utils.hpp>
+#include <hex/helpers/interval_set.hpp>
+#include <hex/helpers/profiler.hpp>
+#include <hex/helpers/binary_pattern.hpp>
+#include <hex/helpers/search.hpp>
+#include <hex/api/task_manager.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <random>
 
 using namespace std::literals::string_literals;
 
@@ -12,3 +25,154 @@ TEST_SEQUENCE("ExtractBits") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("IntervalSet") {
+    hex::IntervalSet set;
+
+    set.insert({ 0x10, 0x05 });
+    set.insert({ 0x20, 0x05 });
+    TEST_ASSERT(set.size() == 2);
+
+    // Adjacent regions get merged into a single interval
+    set.insert({ 0x15, 0x0B });
+    TEST_ASSERT(set.size() == 1);
+    TEST_ASSERT(set.find(0x12) == hex::Region(0x10, 0x15));
+
+    // Erasing from the middle splits the interval
+    set.erase({ 0x12, 0x02 });
+    TEST_ASSERT(set.size() == 2);
+    TEST_ASSERT(set.contains(0x11) && !set.contains(0x12) && !set.contains(0x13) && set.contains(0x14));
+    TEST_ASSERT(set.getTotalSize() == 0x13);
+
+    const auto overlapping = set.getOverlapping({ 0x11, 0x0A });
+    TEST_ASSERT(overlapping.size() == 2);
+    TEST_ASSERT(overlapping[0] == hex::Region(0x11, 0x01));
+    TEST_ASSERT(overlapping[1] == hex::Region(0x14, 0x07));
+
+    TEST_ASSERT(set.findNext(0x00) == hex::Region(0x10, 0x02));
+    TEST_ASSERT(!set.findNext(0x25).has_value());
+    TEST_ASSERT(!set.overlaps({ 0x00, 0x10 }));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("Profiler") {
+    using namespace hex;
+
+    prof::reset();
+
+    // Nothing gets recorded while the profiler is disabled
+    prof::setEnabled(false);
+    {
+        prof::ScopedTimer timer(prof::Category::ProviderRead, "Provider", 1, 0x100);
+    }
+    TEST_ASSERT(prof::getStatistics().empty());
+
+    prof::setEnabled(true);
+    prof::record(prof::Category::ProviderRead, "Provider", 1, 1, 20'000, 0x100);
+    prof::record(prof::Category::ProviderRead, "Provider", 1, 30'000, 50'000, 0x200);
+    prof::record(prof::Category::ProviderRead, "Provider", 2, 1, 1'000, 0x10);
+    prof::setEnabled(false);
+
+    const auto statistics = prof::getStatistics();
+    TEST_ASSERT(statistics.size() == 2);
+    TEST_ASSERT(statistics[0].id == 1 && statistics[0].count == 2 && statistics[0].bytes == 0x300);
+    TEST_ASSERT(statistics[0].totalNanoseconds == 70'000 && statistics[0].maxNanoseconds == 50'000);
+    TEST_ASSERT(statistics[0].sampleCount == 2 && statistics[0].samples[1] == 50.0F);
+
+    // Only events above the trace threshold end up in the trace, next to the thread name metadata
+    const auto trace = nlohmann::json::parse(prof::exportChromeTrace());
+    const auto durationEvents = std::ranges::count_if(trace["traceEvents"], [](const auto &event) { return event["ph"] == "X"; });
+    TEST_ASSERT(durationEvents == 2, "{}", durationEvents);
+    TEST_ASSERT(trace["traceEvents"].back()["dur"] == 50.0);
+
+    prof::reset();
+    TEST_ASSERT(prof::getStatistics().empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("SequenceSearcher") {
+    using namespace hex;
+
+    // Few distinct bytes so that partial matches are common
+    std::mt19937 random(1234);
+    std::vector<u8> data(0x2'0000);
+    for (auto &byte : data)
+        byte = "aAbB"[random() % 4];
+
+    hex::test::TestProvider provider(&data);
+
+    const auto fold = [](u8 byte) { return u8(std::tolower(byte)); };
+    for (const auto sequenceSize : { 1, 2, 3, 8, 31, 32, 33, 40 }) {
+        for (const auto ignoreCase : { false, true }) {
+            // Take the sequence from the data so there's at least one occurrence
+            const auto sequenceOffset = random() % (data.size() - sequenceSize);
+            const std::vector<u8> sequence(data.begin() + sequenceOffset, data.begin() + sequenceOffset + sequenceSize);
+
+            std::vector<u64> expected;
+            for (size_t i = 0; i + sequence.size() <= data.size(); i += 1) {
+                if (std::ranges::equal(std::span(data).subspan(i, sequence.size()), sequence, {}, ignoreCase ? fold : std::identity(), ignoreCase ? fold : std::identity()))
+                    expected.push_back(i);
+            }
+
+            const SequenceSearcher searcher(sequence, ignoreCase);
+            Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+
+            TEST_ASSERT(searcher.findFirst(data) == expected.front(), "size {}", sequenceSize);
+            TEST_ASSERT(searcher.findLast(data) == expected.back(), "size {}", sequenceSize);
+
+            // A region that doesn't start or end on a chunk boundary
+            const auto region = Region { .address = 0x123, .size = data.size() - 0x456 };
+            std::vector<u64> expectedInRegion;
+            std::ranges::copy_if(expected, std::back_inserter(expectedInRegion), [&](u64 address) {
+                return address >= region.getStartAddress() && address + sequence.size() - 1 <= region.getEndAddress();
+            });
+
+            TEST_ASSERT(searcher.findAll(task, &provider, region, 0x1000) == expectedInRegion, "size {}, ignore case {}", sequenceSize, ignoreCase);
+            TEST_ASSERT(searcher.findNext(task, &provider, region, 0x1000) == expectedInRegion.front());
+            TEST_ASSERT(searcher.findPrevious(task, &provider, region, 0x1000) == expectedInRegion.back());
+        }
+    }
+
+    const std::vector<u8> missing = { 'c', 'c' };
+    Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+    TEST_ASSERT(!SequenceSearcher(missing).findNext(task, &provider, { 0x00, data.size() }).has_value());
+    TEST_ASSERT(!SequenceSearcher(missing).findPrevious(task, &provider, { 0x00, data.size() }).has_value());
+    TEST_ASSERT(SequenceSearcher(missing).findAll(task, &provider, { 0x00, data.size() }).empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("BinaryPatternSearcher") {
+    using namespace hex;
+
+    std::mt19937 random(5678);
+    std::vector<u8> data(0x2'0000);
+    for (auto &byte : data)
+        byte = std::array<u8, 6>{ 0x00, 0x00, 0x4D, 0x5A, 0x50, 0x45 }[random() % 6];
+
+    hex::test::TestProvider provider(&data);
+
+    // Patterns with a literal anchor, with only partially specified bytes and with nothing but wildcards
+    for (const auto &string : { "4D 5A ?? ?? 50 45", "00 ?? 00 00 ?0", "4? ?? 5? ?A", "?? ??", "\"MZ\" ?? 5? 00" }) {
+        const BinaryPattern pattern(string);
+        TEST_ASSERT(pattern.isValid(), "{}", string);
+
+        const BinaryPatternSearcher searcher(pattern);
+        for (const auto alignment : { 1, 3, 4 }) {
+            const auto region = Region { .address = 0x123, .size = data.size() - 0x456 };
+
+            std::vector<u64> expected;
+            for (u64 address = region.getStartAddress(); address + pattern.getSize() - 1 <= region.getEndAddress(); address += alignment) {
+                if (pattern.matches({ data.begin() + address, data.begin() + address + pattern.getSize() }))
+                    expected.push_back(address);
+            }
+
+            Task task("hex.builtin.view.find.searching"_unlocalized, ProgressValue::Size(data.size()), true, false, [](Task &) { });
+            TEST_ASSERT(searcher.findAll(task, &provider, region, alignment, 0x1000) == expected, "{}, alignment {}", string, alignment);
+        }
+    }
+
+    TEST_SUCCESS();
+};